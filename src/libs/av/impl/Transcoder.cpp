@@ -99,6 +99,16 @@ namespace lms::av
             args.emplace_back(oss.str());
         }
 
+        // input Duration
+        if (_inputParams.duration)
+        {
+            args.emplace_back("-t");
+
+            std::ostringstream oss;
+            oss << std::fixed << std::showpoint << std::setprecision(3) << (_inputParams.duration->count() / float{ 1'000 });
+            args.emplace_back(oss.str());
+        }
+
         // Input file
         args.emplace_back("-i");
         args.emplace_back(_inputParams.file.string());
@@ -160,6 +170,24 @@ namespace lms::av
             args.emplace_back("webm");
             break;
 
+        case OutputFormat::MPEGTS_AAC:
+        {
+            args.emplace_back("-acodec");
+            args.emplace_back("aac");
+
+            // keep segments contiguous on the timeline
+            // Note segments are encoded independently: each one starts with its own AAC encoder priming samples,
+            // so playback is not gapless at segment boundaries
+            args.emplace_back("-output_ts_offset");
+            std::ostringstream oss;
+            oss << std::fixed << std::showpoint << std::setprecision(3) << (_inputParams.offset.count() / float{ 1'000 });
+            args.emplace_back(oss.str());
+
+            args.emplace_back("-f");
+            args.emplace_back("mpegts");
+            break;
+        }
+
         default:
             throw Exception{ "Unhandled format (" + std::to_string(static_cast<int>(_outputParams.format)) + ")" };
         }
@@ -211,6 +239,8 @@ namespace lms::av
             return "audio/ogg";
         case OutputFormat::WEBM_VORBIS:
             return "audio/webm";
+        case OutputFormat::MPEGTS_AAC:
+            return "video/mp2t";
         }
 
         return "application/octet-stream"; // default, should not happen
@@ -223,4 +253,15 @@ namespace lms::av
         return _childProcess->finished();
     }
 
+    bool Transcoder::succeeded()
+    {
+        assert(_childProcess);
+
+        const std::optional<int> exitCode{ _childProcess->getExitCode() };
+        if (exitCode != 0)
+            LOG(ERROR, "Transcoder exited abnormally" << (exitCode ? ", exit code = " + std::to_string(*exitCode) : std::string{}));
+
+        return exitCode == 0;
+    }
+
 } // namespace lms::av
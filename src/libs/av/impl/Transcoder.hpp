@@ -44,6 +44,7 @@ namespace lms::av
         const OutputParameters& getOutputParameters() const override { return _outputParams; }
 
         bool finished() const override;
+        bool succeeded() override;
         static void init();
         void start();
 
@@ -30,9 +30,10 @@ namespace lms::av
 {
     struct InputParameters
     {
-        std::filesystem::path file;             // Path to the input file
-        std::chrono::milliseconds offset{};     // Offset in the input file to start transcoding from
-        std::optional<std::size_t> streamIndex; // Index of the stream to be transcoded (select "best" audio stream if not set)
+        std::filesystem::path file;                        // Path to the input file
+        std::chrono::milliseconds offset{};                // Offset in the input file to start transcoding from
+        std::optional<std::chrono::milliseconds> duration; // Duration to transcode from offset (until the end if not set)
+        std::optional<std::size_t> streamIndex;            // Index of the stream to be transcoded (select "best" audio stream if not set)
     };
 
     enum class OutputFormat
@@ -42,6 +43,7 @@ namespace lms::av
         MATROSKA_OPUS,
         OGG_VORBIS,
         WEBM_VORBIS,
+        MPEGTS_AAC, // for segmented streaming, timestamps start at input offset
     };
 
     struct OutputParameters
@@ -65,6 +67,8 @@ namespace lms::av
         virtual const OutputParameters& getOutputParameters() const = 0;
 
         virtual bool finished() const = 0;
+        // Only once finished: true if the whole output has been produced (transcoder exited with status 0)
+        virtual bool succeeded() = 0;
     };
 
     std::unique_ptr<ITranscoder> createTranscoder(const InputParameters& inputParameters, const OutputParameters& outputParameters);
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/io_context.hpp>
+
+#include "core/IChildProcessManager.hpp"
+
+namespace lms::core
+{
+    namespace
+    {
+        const std::filesystem::path echoPath{ "/bin/echo" };
+
+        // Simulates a process with a large resident set (db cache, artwork cache, sessions, etc.)
+        std::vector<std::byte> residentMemory;
+
+        void allocateResidentMemory(std::size_t size)
+        {
+            residentMemory.resize(size);
+            std::memset(residentMemory.data(), 0xAB, residentMemory.size()); // make sure pages are actually mapped
+        }
+
+        void spawnAndWait(IChildProcessManager& childProcessManager)
+        {
+            const std::unique_ptr<IChildProcess> childProcess{ childProcessManager.spawnChildProcess(echoPath, { "echo", "foo" }) };
+
+            std::array<std::byte, 64> buffer;
+            while (childProcess->readSome(buffer.data(), buffer.size()) > 0)
+                ;
+        }
+    } // namespace
+
+    static void BM_ChildProcess_spawn(benchmark::State& state)
+    {
+        boost::asio::io_context ioContext;
+        const auto childProcessManager{ createChildProcessManager(ioContext) };
+
+        // other threads wait for the first thread to reach the loop
+        if (state.thread_index() == 0)
+            allocateResidentMemory(static_cast<std::size_t>(state.range(0)) * 1024 * 1024);
+
+        for (auto _ : state)
+            spawnAndWait(*childProcessManager);
+
+        if (state.thread_index() == 0)
+            std::vector<std::byte>{}.swap(residentMemory);
+    }
+
+    BENCHMARK(BM_ChildProcess_spawn)->ArgName("rssMiB")->Arg(0)->Arg(512)->Arg(2048)->Threads(1)->Threads(std::thread::hardware_concurrency())->UseRealTime();
+
+} // namespace lms::core
+
+BENCHMARK_MAIN();
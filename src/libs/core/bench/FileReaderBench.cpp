@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "FileReader.hpp"
+
+namespace lms::core
+{
+    namespace
+    {
+        constexpr std::size_t chunkSize{ 262'144 };         // same as FileResourceHandler
+        constexpr std::size_t fileSize{ 32 * 1024 * 1024 }; // typical FLAC file size
+        constexpr std::size_t clientCountPerThread{ 8 };    // number of concurrent clients served by each thread
+
+        // Discards everything, stands for the HTTP response stream
+        class NullStreamBuf : public std::streambuf
+        {
+        protected:
+            std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+            int_type overflow(int_type ch) override { return traits_type::not_eof(ch); }
+        };
+
+        class TestFile
+        {
+        public:
+            TestFile()
+                : _path{ std::filesystem::temp_directory_path() / "lms-bench-file-reader.flac" }
+            {
+                std::ofstream ofs{ _path, std::ios::binary };
+                const std::vector<char> buffer(1024 * 1024, 'a');
+                for (std::size_t written{}; written < fileSize; written += buffer.size())
+                    ofs.write(buffer.data(), buffer.size());
+            }
+            ~TestFile()
+            {
+                std::error_code ec;
+                std::filesystem::remove(_path, ec);
+            }
+            TestFile(const TestFile&) = delete;
+            TestFile& operator=(const TestFile&) = delete;
+
+            const std::filesystem::path& getPath() const { return _path; }
+
+        private:
+            const std::filesystem::path _path;
+        };
+
+        const TestFile testFile;
+
+        // Previous implementation: ifstream + a new buffer per chunk
+        struct StreamClient
+        {
+            std::ifstream ifs{ testFile.getPath(), std::ios::in | std::ios::binary };
+
+            bool serveChunk(std::ostream& out)
+            {
+                std::vector<char> buf(chunkSize);
+                ifs.read(buf.data(), buf.size());
+                out.write(buf.data(), ifs.gcount());
+                return ifs.good();
+            }
+        };
+
+        // Current implementation: pread + reused buffer + readahead hints
+        struct FileReaderClient
+        {
+            FileReader reader{ testFile.getPath() };
+            std::uint64_t offset{};
+
+            FileReaderClient()
+            {
+                reader.adviseSequential(0, reader.getFileSize());
+            }
+
+            bool serveChunk(std::ostream& out, std::span<std::byte> buffer)
+            {
+                const std::size_t pieceSize{ std::min<std::size_t>(reader.getFileSize() - offset, buffer.size()) };
+                const std::optional<std::size_t> res{ reader.read(offset, buffer.first(pieceSize)) };
+                if (!res || *res == 0)
+                    return false;
+
+                offset += *res;
+                reader.adviseWillNeed(offset, chunkSize);
+                out.write(reinterpret_cast<const char*>(buffer.data()), *res);
+                return offset < reader.getFileSize();
+            }
+        };
+    } // namespace
+
+    static void BM_FileServing_stream(benchmark::State& state)
+    {
+        NullStreamBuf streamBuf;
+        std::ostream out{ &streamBuf };
+
+        for (auto _ : state)
+        {
+            std::array<StreamClient, clientCountPerThread> clients;
+
+            // interleave clients, as the HTTP server does with continuations
+            bool remaining{ true };
+            while (remaining)
+            {
+                remaining = false;
+                for (StreamClient& client : clients)
+                    remaining |= client.serveChunk(out);
+            }
+        }
+
+        state.SetBytesProcessed(state.iterations() * fileSize * clientCountPerThread);
+    }
+
+    static void BM_FileServing_fileReader(benchmark::State& state)
+    {
+        NullStreamBuf streamBuf;
+        std::ostream out{ &streamBuf };
+        std::vector<std::byte> buffer(chunkSize);
+
+        for (auto _ : state)
+        {
+            std::array<FileReaderClient, clientCountPerThread> clients;
+
+            // interleave clients, as the HTTP server does with continuations
+            bool remaining{ true };
+            while (remaining)
+            {
+                remaining = false;
+                for (FileReaderClient& client : clients)
+                    remaining |= client.serveChunk(out, buffer);
+            }
+        }
+
+        state.SetBytesProcessed(state.iterations() * fileSize * clientCountPerThread);
+    }
+
+    BENCHMARK(BM_FileServing_stream)->Threads(1)->Threads(std::thread::hardware_concurrency())->UseRealTime();
+    BENCHMARK(BM_FileServing_fileReader)->Threads(1)->Threads(std::thread::hardware_concurrency())->UseRealTime();
+} // namespace lms::core
+
+BENCHMARK_MAIN();
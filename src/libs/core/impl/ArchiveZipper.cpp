@@ -183,6 +183,21 @@ namespace lms::zip
         }
     }
 
+    std::optional<std::uint64_t> ArchiveZipper::getTotalSize() const
+    {
+        return std::nullopt; // compressed on the fly
+    }
+
+    void ArchiveZipper::setRange(std::uint64_t, std::uint64_t)
+    {
+        throw Exception{ "Range not supported" };
+    }
+
+    std::optional<std::string> ArchiveZipper::getETag() const
+    {
+        return std::nullopt;
+    }
+
     static ::mode_t permsToMode(const std::filesystem::perms p)
     {
         using std::filesystem::perms;
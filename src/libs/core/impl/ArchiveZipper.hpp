@@ -44,6 +44,9 @@ namespace lms::zip
         std::uint64_t writeSome(std::ostream& output) override;
         bool isComplete() const override;
         void abort() override;
+        std::optional<std::uint64_t> getTotalSize() const override;
+        void setRange(std::uint64_t offset, std::uint64_t endOffset) override;
+        std::optional<std::string> getETag() const override;
 
         class ArchiveDeleter
         {
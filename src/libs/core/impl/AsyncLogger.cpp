@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AsyncLogger.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "core/Exception.hpp"
+
+namespace lms::core::logging
+{
+    namespace
+    {
+        // Exiting threads release their buffer only if the logger that gave it is still alive
+        std::mutex activeLoggerMutex;
+        std::uint64_t activeLoggerId{};
+        std::atomic<std::uint64_t> nextLoggerId{ 1 };
+    } // namespace
+
+    thread_local AsyncLogger::ThreadBufferRef AsyncLogger::_currentThreadBuffer;
+
+    std::unique_ptr<ILogger> createAsyncLogger(Severity minSeverity, const std::filesystem::path& logFilePath, std::size_t maxPendingLogsPerThread)
+    {
+        return std::make_unique<AsyncLogger>(minSeverity, logFilePath, maxPendingLogsPerThread);
+    }
+
+    AsyncLogger::ThreadBuffer::ThreadBuffer(std::size_t capacity)
+        : entries(capacity)
+    {
+    }
+
+    bool AsyncLogger::ThreadBuffer::tryPush(Entry&& entry)
+    {
+        const std::size_t currentWriteIndex{ writeIndex.load(std::memory_order_relaxed) };
+        if (currentWriteIndex - readIndex.load(std::memory_order_acquire) == entries.size())
+        {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        entries[currentWriteIndex % entries.size()] = std::move(entry);
+        writeIndex.store(currentWriteIndex + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename Func>
+    void AsyncLogger::ThreadBuffer::popAll(Func&& func)
+    {
+        std::size_t currentReadIndex{ readIndex.load(std::memory_order_relaxed) };
+        const std::size_t currentWriteIndex{ writeIndex.load(std::memory_order_acquire) };
+
+        for (; currentReadIndex != currentWriteIndex; ++currentReadIndex)
+            func(std::move(entries[currentReadIndex % entries.size()]));
+
+        readIndex.store(currentReadIndex, std::memory_order_release);
+    }
+
+    AsyncLogger::ThreadBufferRef::~ThreadBufferRef()
+    {
+        std::scoped_lock lock{ activeLoggerMutex };
+        if (buffer && loggerId == activeLoggerId)
+            buffer->released.store(true, std::memory_order_release);
+    }
+
+    AsyncLogger::AsyncLogger(Severity minSeverity, const std::filesystem::path& logFilePath, std::size_t maxPendingLogsPerThread)
+        : _sink{ minSeverity, logFilePath }
+        , _maxPendingLogsPerThread{ maxPendingLogsPerThread }
+        , _id{ nextLoggerId++ }
+    {
+        if (_maxPendingLogsPerThread == 0)
+            throw LmsException{ "AsyncLogger must be configured with at least one pending log per thread" };
+
+        {
+            std::scoped_lock lock{ activeLoggerMutex };
+            activeLoggerId = _id;
+        }
+
+        _writerThread = std::thread{ [this] { writerLoop(); } };
+    }
+
+    AsyncLogger::~AsyncLogger()
+    {
+        {
+            std::scoped_lock lock{ activeLoggerMutex };
+            if (activeLoggerId == _id)
+                activeLoggerId = 0;
+        }
+
+        {
+            std::scoped_lock lock{ _writerMutex };
+            _stopRequested = true;
+        }
+        _writerCondition.notify_one();
+        _writerThread.join();
+    }
+
+    std::size_t AsyncLogger::getDroppedLogCount() const
+    {
+        return _droppedLogCount.load(std::memory_order_relaxed);
+    }
+
+    bool AsyncLogger::isSeverityActive(Severity severity) const
+    {
+        const ILogger& sink{ _sink };
+        return sink.isSeverityActive(severity);
+    }
+
+    void AsyncLogger::processLog(const Log& log)
+    {
+        assert(isSeverityActive(log.getSeverity())); // should have been filtered out by a isSeverityActive call
+        push(Entry{ Wt::WDateTime::currentDateTime(), std::this_thread::get_id(), log.getModule(), log.getSeverity(), log.getMessage() });
+    }
+
+    void AsyncLogger::processLog(Module module, Severity severity, std::string_view message)
+    {
+        assert(isSeverityActive(severity)); // should have been filtered out by a isSeverityActive call
+        push(Entry{ Wt::WDateTime::currentDateTime(), std::this_thread::get_id(), module, severity, std::string{ message } });
+    }
+
+    AsyncLogger::ThreadBuffer& AsyncLogger::getThreadBuffer()
+    {
+        // the current thread may still reference a buffer given by a previous logger
+        if (_currentThreadBuffer.loggerId == _id)
+            return *_currentThreadBuffer.buffer;
+
+        ThreadBuffer* buffer{};
+        {
+            std::scoped_lock lock{ _buffersMutex };
+            if (!_freeBuffers.empty())
+            {
+                buffer = _freeBuffers.back();
+                _freeBuffers.pop_back();
+            }
+            else
+                buffer = &_buffers.emplace_back(_maxPendingLogsPerThread);
+
+            buffer->ownerThreadId = std::this_thread::get_id();
+        }
+
+        _currentThreadBuffer.loggerId = _id;
+        _currentThreadBuffer.buffer = buffer;
+        return *buffer;
+    }
+
+    void AsyncLogger::push(Entry&& entry)
+    {
+        ThreadBuffer& buffer{ getThreadBuffer() };
+
+        if (entry.severity != Severity::FATAL)
+        {
+            buffer.tryPush(std::move(entry));
+            return;
+        }
+
+        // Fatal logs are likely the last ones before the process exits: make sure they are written before returning
+        if (!buffer.tryPush(std::move(entry)))
+        {
+            flush();
+            buffer.tryPush(std::move(entry));
+        }
+        flush();
+    }
+
+    void AsyncLogger::flush()
+    {
+        std::unique_lock lock{ _writerMutex };
+
+        if (!_writerExited)
+        {
+            const std::uint64_t flushRequest{ ++_flushRequestCount };
+            _writerCondition.notify_one();
+            _flushedCondition.wait(lock, [&] { return _flushDoneCount >= flushRequest || _writerExited; });
+
+            if (_flushDoneCount >= flushRequest)
+                return;
+        }
+
+        // The writer thread has exited (logger being destroyed): write from the calling thread, serialized by _writerMutex
+        std::vector<Entry> batch;
+        writePendingLogs(batch);
+    }
+
+    void AsyncLogger::writerLoop()
+    {
+        std::vector<Entry> batch;
+
+        while (true)
+        {
+            bool stopRequested{};
+            std::uint64_t flushRequest{};
+            {
+                std::unique_lock lock{ _writerMutex };
+                _writerCondition.wait_for(lock, writePeriod, [this] { return _stopRequested || _flushDoneCount != _flushRequestCount; });
+
+                stopRequested = _stopRequested;
+                flushRequest = _flushRequestCount;
+            }
+
+            writePendingLogs(batch);
+
+            {
+                std::scoped_lock lock{ _writerMutex };
+                _flushDoneCount = flushRequest;
+                _writerExited = stopRequested;
+            }
+            _flushedCondition.notify_all();
+
+            if (stopRequested)
+                break;
+        }
+    }
+
+    void AsyncLogger::writePendingLogs(std::vector<Entry>& batch)
+    {
+        {
+            std::scoped_lock lock{ _buffersMutex };
+
+            for (ThreadBuffer& buffer : _buffers)
+            {
+                // must be read before popping, so that the last logs of an exited thread are not missed
+                const bool released{ buffer.released.load(std::memory_order_acquire) };
+
+                buffer.popAll([&](Entry&& entry) { batch.push_back(std::move(entry)); });
+
+                if (const std::size_t droppedCount{ buffer.droppedCount.exchange(0, std::memory_order_relaxed) }; droppedCount > 0)
+                {
+                    _droppedLogCount.fetch_add(droppedCount, std::memory_order_relaxed);
+                    if (isSeverityActive(Severity::WARNING))
+                        batch.push_back(Entry{ Wt::WDateTime::currentDateTime(), buffer.ownerThreadId, Module::UTILS, Severity::WARNING, "AsyncLogger: dropped " + std::to_string(droppedCount) + " log(s), buffer full" });
+                }
+
+                if (released)
+                {
+                    buffer.released.store(false, std::memory_order_relaxed);
+                    _freeBuffers.push_back(&buffer);
+                }
+            }
+        }
+
+        if (batch.empty())
+            return;
+
+        // keep the logs of the different threads ordered in the output
+        std::stable_sort(std::begin(batch), std::end(batch), [](const Entry& lhs, const Entry& rhs) { return lhs.time < rhs.time; });
+
+        for (const Entry& entry : batch)
+            _sink.write(entry.time, entry.threadId, entry.module, entry.severity, entry.message);
+        _sink.flush();
+
+        batch.clear();
+    }
+} // namespace lms::core::logging
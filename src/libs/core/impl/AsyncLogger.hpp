@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Wt/WDateTime.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/ILogger.hpp"
+
+#include "Logger.hpp"
+
+namespace lms::core::logging
+{
+    class AsyncLogger final : public ILogger
+    {
+    public:
+        AsyncLogger(Severity minSeverity, const std::filesystem::path& logFilePath, std::size_t maxPendingLogsPerThread);
+        ~AsyncLogger() override;
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        std::size_t getDroppedLogCount() const;
+
+    private:
+        bool isSeverityActive(Severity severity) const override;
+        void processLog(const Log& log) override;
+        void processLog(Module module, Severity severity, std::string_view message) override;
+
+        struct Entry
+        {
+            Wt::WDateTime time;
+            std::thread::id threadId;
+            Module module;
+            Severity severity;
+            std::string message;
+        };
+
+        // Single producer (the owning thread), single consumer (the writer thread) ring buffer
+        struct alignas(64) ThreadBuffer
+        {
+            ThreadBuffer(std::size_t capacity);
+
+            bool tryPush(Entry&& entry); // entry is left untouched on failure
+            template<typename Func>
+            void popAll(Func&& func);
+
+            std::vector<Entry> entries;
+            std::thread::id ownerThreadId; // protected by _buffersMutex
+            alignas(64) std::atomic<std::size_t> writeIndex{};
+            alignas(64) std::atomic<std::size_t> readIndex{};
+            std::atomic<std::size_t> droppedCount{};
+            std::atomic<bool> released{}; // set when the owning thread exits
+        };
+
+        struct ThreadBufferRef
+        {
+            ~ThreadBufferRef();
+
+            std::uint64_t loggerId{};
+            ThreadBuffer* buffer{};
+        };
+
+        ThreadBuffer& getThreadBuffer();
+        void push(Entry&& entry);
+        void flush(); // blocks until all the logs pushed so far are written
+        void writerLoop();
+        void writePendingLogs(std::vector<Entry>& batch);
+
+        static constexpr std::chrono::milliseconds writePeriod{ 50 };
+
+        Logger _sink;
+        const std::size_t _maxPendingLogsPerThread;
+        const std::uint64_t _id;
+
+        std::mutex _buffersMutex;
+        std::list<ThreadBuffer> _buffers; // never shrinks, so that addresses remain stable
+        std::vector<ThreadBuffer*> _freeBuffers;
+        std::atomic<std::size_t> _droppedLogCount{};
+
+        std::mutex _writerMutex;
+        std::condition_variable _writerCondition;
+        std::condition_variable _flushedCondition;
+        bool _stopRequested{};
+        bool _writerExited{}; // no more logs will be written by the writer thread
+        std::uint64_t _flushRequestCount{};
+        std::uint64_t _flushDoneCount{};
+        std::thread _writerThread;
+
+        static thread_local ThreadBufferRef _currentThreadBuffer;
+    };
+} // namespace lms::core::logging
@@ -21,6 +21,7 @@
 
 #include <fcntl.h>
 #include <signal.h>
+#include <spawn.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -30,12 +31,16 @@
 #include <cstddef>
 #include <mutex>
 #include <system_error>
+#include <utility>
+#include <vector>
 
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/read.hpp>
 
 #include "core/ILogger.hpp"
 
+extern char** environ;
+
 namespace lms::core
 {
     namespace
@@ -53,6 +58,73 @@ namespace lms::core
             {
             }
         };
+
+        class PosixSpawnFileActions
+        {
+        public:
+            PosixSpawnFileActions()
+            {
+                if (const int res{ ::posix_spawn_file_actions_init(&_actions) }; res != 0)
+                    throw SystemException{ std::error_code{ res, std::generic_category() }, "posix_spawn_file_actions_init failed!" };
+            }
+            ~PosixSpawnFileActions()
+            {
+                ::posix_spawn_file_actions_destroy(&_actions);
+            }
+            PosixSpawnFileActions(const PosixSpawnFileActions&) = delete;
+            PosixSpawnFileActions& operator=(const PosixSpawnFileActions&) = delete;
+
+            void addOpen(int fd, const char* path, int flags)
+            {
+                if (const int res{ ::posix_spawn_file_actions_addopen(&_actions, fd, path, flags, 0) }; res != 0)
+                    throw SystemException{ std::error_code{ res, std::generic_category() }, "posix_spawn_file_actions_addopen failed!" };
+            }
+
+            void addDup2(int fd, int newFd)
+            {
+                if (const int res{ ::posix_spawn_file_actions_adddup2(&_actions, fd, newFd) }; res != 0)
+                    throw SystemException{ std::error_code{ res, std::generic_category() }, "posix_spawn_file_actions_adddup2 failed!" };
+            }
+
+            const ::posix_spawn_file_actions_t* get() const { return &_actions; }
+
+        private:
+            ::posix_spawn_file_actions_t _actions;
+        };
+
+        // Closes the owned file descriptor on destruction, unless released
+        class UniqueFd
+        {
+        public:
+            UniqueFd() = default;
+            explicit UniqueFd(int fd)
+                : _fd{ fd }
+            {
+            }
+            ~UniqueFd() { reset(); }
+            UniqueFd(const UniqueFd&) = delete;
+            UniqueFd& operator=(const UniqueFd&) = delete;
+
+            int get() const { return _fd; }
+            int release() { return std::exchange(_fd, -1); }
+            void reset()
+            {
+                if (_fd != -1)
+                    ::close(std::exchange(_fd, -1));
+            }
+
+        private:
+            int _fd{ -1 };
+        };
+
+        void killAndReap(::pid_t pid)
+        {
+            ::kill(pid, SIGKILL);
+
+            int wstatus{};
+            while (::waitpid(pid, &wstatus, 0) == -1 && errno == EINTR)
+                ;
+        }
     } // namespace
 
     ChildProcess::ChildProcess(boost::asio::io_context& ioContext, const std::filesystem::path& path, const Args& args)
@@ -60,22 +132,38 @@ namespace lms::core
         , _childStdout{ _ioContext }
 
     {
-        // make sure only one thread is executing this part of code
+        int pipefd[2];
+
+#if defined(__linux__)
+        // Make sure the pipe is never inherited by other concurrently spawned children
+        // Only the write end is explicitly dup2ed in the child (dup2 clears FD_CLOEXEC)
+        if (::pipe2(pipefd, O_CLOEXEC) == -1)
+            throw SystemException{ std::error_code{ errno, std::generic_category() }, "pipe2 failed!" };
+        UniqueFd readFd{ pipefd[0] };
+        UniqueFd writeFd{ pipefd[1] };
+#else
+        // No atomic way to create a close-on-exec pipe: make sure only one thread is executing this part of code
         static std::mutex mutex;
         const std::scoped_lock lock{ mutex };
 
-        int pipefd[2];
-
-        // Use 'pipe' instead of 'pipe2', more portable
-        if (pipe(pipefd) == -1)
+        if (::pipe(pipefd) == -1)
             throw SystemException{ std::error_code{ errno, std::generic_category() }, "pipe failed!" };
+        UniqueFd readFd{ pipefd[0] };
+        UniqueFd writeFd{ pipefd[1] };
+
+        for (const int fd : { readFd.get(), writeFd.get() })
+        {
+            if (::fcntl(fd, F_SETFD, FD_CLOEXEC) == -1)
+                throw SystemException{ std::error_code{ errno, std::generic_category() }, "fcntl failed to set FD_CLOEXEC!" };
+        }
+#endif
 
         // Only set O_NONBLOCK on read end - usually programs don't expect stdout to be non-blocking
-        if (fcntl(pipefd[0], F_SETFL, O_NONBLOCK) == -1)
+        if (fcntl(readFd.get(), F_SETFL, O_NONBLOCK) == -1)
             throw SystemException{ std::error_code{ errno, std::generic_category() }, "fcntl failed to set O_NONBLOCK!" };
 
 #if defined(__linux__) && defined(F_SETPIPE_SZ)
-        for (const int fd : { pipefd[0], pipefd[1] })
+        for (const int fd : { readFd.get(), writeFd.get() })
         {
             constexpr int targetPipeSize{ 65'536 * 4 };
             int currentPipeSize{ 65'536 }; // common default value
@@ -102,47 +190,38 @@ namespace lms::core
         }
 #endif
 
-        const int res{ fork() };
-        if (res == -1)
-            throw SystemException{ std::error_code{ errno, std::generic_category() }, "fork failed!" };
+        // posix_spawn does not duplicate the parent's address space (vfork/clone(CLONE_VM) semantics on Linux)
+        // so the spawn cost does not depend on our RSS and no process-wide lock is needed
+        PosixSpawnFileActions fileActions;
 
-        if (res == 0) // CHILD
-        {
-            // Never close stdin/out/err, most programs expect these to exist;
-            // rather connect them to /dev/null if unwanted
-            const int nullFd{ open("/dev/null", O_RDWR) };
-            // Ignore errors, worst thing is stderr writes to the same fd as lms
-            if (nullFd != -1)
-            {
-                dup2(nullFd, STDIN_FILENO);
-                dup2(nullFd, STDERR_FILENO);
-                close(nullFd);
-            }
+        // Never close stdin/out/err, most programs expect these to exist;
+        // rather connect them to /dev/null if unwanted
+        fileActions.addOpen(STDIN_FILENO, "/dev/null", O_RDONLY);
+        fileActions.addOpen(STDERR_FILENO, "/dev/null", O_WRONLY);
+        // Replace stdout with pipe write (read and write ends are closed on exec)
+        fileActions.addDup2(writeFd.get(), STDOUT_FILENO);
 
-            // Replace stdout with pipe write
-            if (dup2(pipefd[1], STDOUT_FILENO) == -1)
-                exit(-1);
-            // Close pipe: read end not needed, write end was dup2ed
-            close(pipefd[0]);
-            close(pipefd[1]);
+        std::vector<char*> execArgs;
+        std::transform(std::cbegin(args), std::cend(args), std::back_inserter(execArgs), [](const std::string& arg) { return const_cast<char*>(arg.c_str()); });
+        execArgs.push_back(nullptr);
 
-            std::vector<const char*> execArgs;
-            std::transform(std::cbegin(args), std::cend(args), std::back_inserter(execArgs), [](const std::string& arg) { return arg.c_str(); });
-            execArgs.push_back(nullptr);
+        ::pid_t pid{};
+        const int res{ ::posix_spawn(&pid, path.c_str(), fileActions.get(), nullptr, execArgs.data(), environ) };
+        writeFd.reset();
+        if (res != 0)
+            throw SystemException{ std::error_code{ res, std::generic_category() }, "posix_spawn failed!" };
+        _childPID = pid;
 
-            execv(path.string().c_str(), (char* const*)&execArgs[0]);
-            exit(-1);
-        }
-        else // PARENT
         {
-            close(pipefd[1]);
+            boost::system::error_code assignError;
+            _childStdout.assign(readFd.get(), assignError);
+            if (assignError)
             {
-                boost::system::error_code assignError;
-                _childStdout.assign(pipefd[0], assignError);
-                if (assignError)
-                    throw SystemException{ assignError, "assigning read end of pipe to asio stream failed!" };
+                // the destructor won't be called: make sure the child does not outlive us as a zombie
+                killAndReap(pid);
+                throw SystemException{ assignError, "assigning read end of pipe to asio stream failed!" };
             }
-            _childPID = res;
+            readFd.release(); // now owned by _childStdout
         }
     }
 
@@ -159,7 +238,8 @@ namespace lms::core
         if (!_finished)
             kill();
 
-        wait(true);
+        if (!_waited)
+            wait(true);
     }
 
     void ChildProcess::kill()
@@ -237,4 +317,15 @@ namespace lms::core
     {
         return _finished;
     }
+
+    std::optional<int> ChildProcess::getExitCode()
+    {
+        assert(finished());
+
+        // the process has closed its output: should not block for long
+        if (!_waited)
+            wait(true);
+
+        return _exitCode;
+    }
 } // namespace lms::core
\ No newline at end of file
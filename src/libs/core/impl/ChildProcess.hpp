@@ -46,6 +46,7 @@ namespace lms::core
         void asyncRead(std::byte* data, std::size_t bufferSize, ReadCallback callback) override;
         std::size_t readSome(std::byte* data, std::size_t bufferSize) override;
         bool finished() const override;
+        std::optional<int> getExitCode() override;
 
         void kill();
         bool wait(bool block); // return true if waited
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FileReader.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+
+#include "core/ILogger.hpp"
+
+namespace lms::core
+{
+#if defined(POSIX_FADV_NORMAL)
+    namespace
+    {
+        void advise(int fd, std::uint64_t offset, std::uint64_t size, int advice)
+        {
+            if (const int res{ ::posix_fadvise(fd, static_cast<::off_t>(offset), static_cast<::off_t>(size), advice) }; res != 0)
+                LMS_LOG(UTILS, DEBUG, "posix_fadvise failed: " << (std::error_code{ res, std::generic_category() }.message()));
+        }
+    } // namespace
+#endif
+
+    FileReader::FileReader(const std::filesystem::path& path)
+        : _fd{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) }
+    {
+        if (_fd == -1)
+        {
+            const int err{ errno };
+            LMS_LOG(UTILS, ERROR, "Cannot open " << path << ": " << (std::error_code{ err, std::generic_category() }.message()));
+            return;
+        }
+
+        struct ::stat fileStat;
+        if (::fstat(_fd, &fileStat) == -1)
+        {
+            const int err{ errno };
+            LMS_LOG(UTILS, ERROR, "Cannot stat " << path << ": " << (std::error_code{ err, std::generic_category() }.message()));
+            ::close(_fd);
+            _fd = -1;
+            return;
+        }
+
+        _fileSize = static_cast<std::uint64_t>(fileStat.st_size);
+    }
+
+    FileReader::~FileReader()
+    {
+        if (_fd != -1)
+            ::close(_fd);
+    }
+
+    void FileReader::adviseSequential(std::uint64_t offset, std::uint64_t size)
+    {
+#if defined(POSIX_FADV_NORMAL)
+        advise(_fd, offset, size, POSIX_FADV_SEQUENTIAL);
+#else
+        (void)offset;
+        (void)size;
+#endif
+    }
+
+    void FileReader::adviseWillNeed(std::uint64_t offset, std::uint64_t size)
+    {
+#if defined(POSIX_FADV_NORMAL)
+        advise(_fd, offset, size, POSIX_FADV_WILLNEED);
+#else
+        (void)offset;
+        (void)size;
+#endif
+    }
+
+    std::optional<std::size_t> FileReader::read(std::uint64_t offset, std::span<std::byte> buffer)
+    {
+        std::size_t totalRead{};
+        while (totalRead < buffer.size())
+        {
+            const ::ssize_t res{ ::pread(_fd, buffer.data() + totalRead, buffer.size() - totalRead, static_cast<::off_t>(offset + totalRead)) };
+            if (res == -1)
+            {
+                const int err{ errno };
+                if (err == EINTR)
+                    continue;
+
+                LMS_LOG(UTILS, ERROR, "pread failed: " << (std::error_code{ err, std::generic_category() }.message()));
+                return std::nullopt;
+            }
+            if (res == 0)
+                break; // end of file
+
+            totalRead += static_cast<std::size_t>(res);
+        }
+
+        return totalRead;
+    }
+} // namespace lms::core
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+namespace lms::core
+{
+    // Positional file reader (no shared file offset, no user-space buffering)
+    class FileReader
+    {
+    public:
+        explicit FileReader(const std::filesystem::path& path);
+        ~FileReader();
+        FileReader(const FileReader&) = delete;
+        FileReader& operator=(const FileReader&) = delete;
+
+        bool isOpen() const { return _fd != -1; }
+        std::uint64_t getFileSize() const { return _fileSize; }
+
+        // Hints the kernel that [offset, offset + size) is going to be read sequentially
+        void adviseSequential(std::uint64_t offset, std::uint64_t size);
+        // Hints the kernel to start reading ahead [offset, offset + size)
+        void adviseWillNeed(std::uint64_t offset, std::uint64_t size);
+
+        // returns the number of bytes actually read (0 means end of file), or nullopt on error
+        std::optional<std::size_t> read(std::uint64_t offset, std::span<std::byte> buffer);
+
+    private:
+        int _fd{ -1 };
+        std::uint64_t _fileSize{};
+    };
+} // namespace lms::core
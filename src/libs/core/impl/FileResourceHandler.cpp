@@ -20,12 +20,40 @@
 #include "FileResourceHandler.hpp"
 
 #include <algorithm>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
 
 #include "core/ILogger.hpp"
 #include "core/MimeTypes.hpp"
 
 namespace lms::core
 {
+    namespace
+    {
+        // Read buffers are reused across requests served by the same thread, instead of being allocated for each chunk
+        std::span<std::byte> getThreadReadBuffer(std::size_t size)
+        {
+            static constexpr std::align_val_t alignment{ 4096 };
+            struct AlignedDeleter
+            {
+                void operator()(std::byte* ptr) const { ::operator delete[](ptr, alignment); }
+            };
+
+            thread_local std::unique_ptr<std::byte[], AlignedDeleter> buffer;
+            thread_local std::size_t bufferSize{};
+
+            if (bufferSize < size)
+            {
+                buffer.reset(static_cast<std::byte*>(::operator new[](size, alignment)));
+                bufferSize = size;
+            }
+
+            return std::span<std::byte>{ buffer.get(), size };
+        }
+    } // namespace
+
     std::unique_ptr<IResourceHandler> createFileResourceHandler(const std::filesystem::path& path, std::string_view mimeType)
     {
         return std::make_unique<FileResourceHandler>(path, mimeType.empty() ? getMimeType(path.extension()) : mimeType);
@@ -33,24 +61,19 @@ namespace lms::core
 
     FileResourceHandler::FileResourceHandler(const std::filesystem::path& path, std::string_view mimeType)
         : _mimeType{ mimeType }
-        , _ifs{ path, std::ios::in | std::ios::binary }
+        , _fileReader{ path }
     {
-        if (!_ifs)
-            LMS_LOG(UTILS, ERROR, "Cannot open file stream for " << path);
-        else
-        {
-            _ifs.seekg(0, std::ios::end);
-            if (!_ifs.fail())
-                _fileSize = static_cast<::uint64_t>(_ifs.tellg());
-            LMS_LOG(UTILS, DEBUG, "File " << path << ", fileSize = " << _fileSize);
-        }
+        if (_fileReader.isOpen())
+            LMS_LOG(UTILS, DEBUG, "File " << path << ", fileSize = " << _fileReader.getFileSize());
     }
 
     Wt::Http::ResponseContinuation* FileResourceHandler::processRequest(const Wt::Http::Request& request, Wt::Http::Response& response)
     {
+        const ::uint64_t fileSize{ _fileReader.getFileSize() };
+
         if (_offset == 0)
         {
-            if (!_ifs)
+            if (!_fileReader.isOpen())
             {
                 response.setStatus(404);
                 return {};
@@ -58,11 +81,11 @@ namespace lms::core
 
             response.addHeader("Accept-Ranges", "bytes");
 
-            const Wt::Http::Request::ByteRangeSpecifier ranges{ request.getRanges(_fileSize) };
+            const Wt::Http::Request::ByteRangeSpecifier ranges{ request.getRanges(fileSize) };
             if (!ranges.isSatisfiable())
             {
                 std::ostringstream contentRange;
-                contentRange << "bytes */" << _fileSize;
+                contentRange << "bytes */" << fileSize;
                 response.setStatus(416); // Requested range not satisfiable
                 response.addHeader("Content-Range", contentRange.str());
 
@@ -80,7 +103,7 @@ namespace lms::core
 
                 std::ostringstream contentRange;
                 contentRange << "bytes " << _offset << "-"
-                             << _beyondLastByte - 1 << "/" << _fileSize;
+                             << _beyondLastByte - 1 << "/" << fileSize;
 
                 response.addHeader("Content-Range", contentRange.str());
                 response.setContentLength(_beyondLastByte - _offset);
@@ -90,36 +113,39 @@ namespace lms::core
                 LMS_LOG(UTILS, DEBUG, "No range requested");
 
                 response.setStatus(200);
-                _beyondLastByte = _fileSize;
+                _beyondLastByte = fileSize;
                 response.setContentLength(_beyondLastByte);
             }
 
             LMS_LOG(UTILS, DEBUG, "Mimetype set to '" << _mimeType << "'");
             response.setMimeType(_mimeType);
 
-            _ifs.seekg(static_cast<std::istream::pos_type>(_offset));
+            _fileReader.adviseSequential(_offset, _beyondLastByte - _offset);
         } // end initial response setup
 
-        ::uint64_t restSize = _beyondLastByte - _offset;
-        ::uint64_t pieceSize = std::min(restSize, static_cast<::uint64_t>(_chunkSize));
+        const ::uint64_t restSize{ _beyondLastByte - _offset };
+        const ::uint64_t pieceSize{ std::min(restSize, static_cast<::uint64_t>(_chunkSize)) };
+
+        const std::span<std::byte> buffer{ getThreadReadBuffer(_chunkSize).first(pieceSize) };
+        const std::optional<std::size_t> actualPieceSize{ _fileReader.read(_offset, buffer) };
 
-        std::vector<char> buf(pieceSize);
+        // Start fetching the next chunk while this one is being sent
+        if (actualPieceSize && *actualPieceSize == pieceSize && pieceSize < restSize)
+            _fileReader.adviseWillNeed(_offset + pieceSize, std::min(restSize - pieceSize, static_cast<::uint64_t>(_chunkSize)));
 
-        _ifs.read(buf.data(), buf.size());
-        const ::uint64_t actualPieceSize{ static_cast<::uint64_t>(_ifs.gcount()) };
-        if (actualPieceSize > 0)
+        if (actualPieceSize && *actualPieceSize > 0)
         {
-            response.out().write(buf.data(), actualPieceSize);
-            LMS_LOG(UTILS, DEBUG, "Written " << actualPieceSize << " bytes, range = " << _offset << "-" << _offset + actualPieceSize - 1 << "");
+            response.out().write(reinterpret_cast<const char*>(buffer.data()), *actualPieceSize);
+            LMS_LOG(UTILS, DEBUG, "Written " << *actualPieceSize << " bytes, range = " << _offset << "-" << _offset + *actualPieceSize - 1 << "");
         }
         else
             LMS_LOG(UTILS, DEBUG, "Written 0 byte");
 
-        if (!_ifs.good())
+        if (!actualPieceSize || *actualPieceSize != pieceSize)
             LMS_LOG(UTILS, WARNING, "Error reading from file!");
-        else if (actualPieceSize < restSize)
+        else if (*actualPieceSize < restSize)
         {
-            _offset += actualPieceSize;
+            _offset += *actualPieceSize;
             LMS_LOG(UTILS, DEBUG, "Job not complete! Remaining range: " << _offset << "-" << _beyondLastByte - 1);
 
             return response.createContinuation();
@@ -20,12 +20,13 @@
 #pragma once
 
 #include <filesystem>
-#include <fstream>
 #include <string>
 #include <string_view>
 
 #include "core/IResourceHandler.hpp"
 
+#include "FileReader.hpp"
+
 namespace lms::core
 {
     class FileResourceHandler final : public IResourceHandler
@@ -42,7 +43,6 @@ namespace lms::core
         std::string _mimeType;
         ::uint64_t _beyondLastByte{};
         ::uint64_t _offset{};
-        ::uint64_t _fileSize{};
-        std::ifstream _ifs;
+        FileReader _fileReader;
     };
 } // namespace lms::core
\ No newline at end of file
@@ -41,6 +41,8 @@ namespace lms::core::logging
             return "AUTH";
         case Module::AV:
             return "AV";
+        case Module::CATALOG:
+            return "CATALOG";
         case Module::CHILDPROCESS:
             return "CHILDPROC";
         case Module::COVER:
@@ -99,6 +101,14 @@ namespace lms::core::logging
         return "";
     }
 
+    namespace
+    {
+        void writeLog(std::ostream& os, const Wt::WDateTime& time, std::thread::id threadId, Module module, Severity severity, std::string_view message)
+        {
+            os << stringUtils::toISO8601String(time) << " " << threadId << " [" << getSeverityName(severity) << "] [" << getModuleName(module) << "] " << message << '\n';
+        }
+    } // namespace
+
     Log::Log(ILogger& logger, Module module, Severity severity)
         : _logger{ logger }
         , _module{ module }
@@ -204,7 +214,25 @@ namespace lms::core::logging
         const Wt::WDateTime now{ Wt::WDateTime::currentDateTime() };
 
         std::unique_lock lock{ outputStream->mutex };
-        outputStream->stream << stringUtils::toISO8601String(now) << " " << std::this_thread::get_id() << " [" << getSeverityName(severity) << "] [" << getModuleName(module) << "] " << message << std::endl;
+        writeLog(outputStream->stream, now, std::this_thread::get_id(), module, severity, message);
+        outputStream->stream.flush();
+    }
+
+    void Logger::write(const Wt::WDateTime& time, std::thread::id threadId, Module module, Severity severity, std::string_view message)
+    {
+        assert(isSeverityActive(severity));
+        OutputStream* outputStream{ _severityToOutputStreamMap.at(severity) };
+
+        std::unique_lock lock{ outputStream->mutex };
+        writeLog(outputStream->stream, time, threadId, module, severity, message);
     }
 
-} // namespace lms::core::logging
\ No newline at end of file
+    void Logger::flush()
+    {
+        for (OutputStream& outputStream : _outputStreams)
+        {
+            std::unique_lock lock{ outputStream.mutex };
+            outputStream.stream.flush();
+        }
+    }
+} // namespace lms::core::logging
@@ -23,10 +23,17 @@
 #include <iosfwd>
 #include <list>
 #include <mutex>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 
 #include "core/ILogger.hpp"
 
+namespace Wt
+{
+    class WDateTime;
+}
+
 namespace lms::core::logging
 {
     class Logger final : public ILogger
@@ -37,6 +44,11 @@ namespace lms::core::logging
         Logger(const Logger&) = delete;
         Logger& operator=(const Logger&) = delete;
 
+        // Writes a log emitted by another thread, at another time
+        // Streams are not flushed, call flush() once a batch of logs is written
+        void write(const Wt::WDateTime& time, std::thread::id threadId, Module module, Severity severity, std::string_view message);
+        void flush();
+
     private:
         bool isSeverityActive(Severity severity) const override;
         void processLog(const Log& log) override;
@@ -0,0 +1,553 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StoreZipper.hpp"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <ctime>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <sstream>
+#include <system_error>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include "core/Crc32Calculator.hpp"
+#include "core/ILogger.hpp"
+#include "core/LruCache.hpp"
+#include "core/XxHash3.hpp"
+
+namespace lms::zip
+{
+    std::unique_ptr<IZipper> createStoreZipper(const EntryContainer& entries)
+    {
+        return std::make_unique<StoreZipper>(entries);
+    }
+
+    namespace
+    {
+        class FileException : public Exception
+        {
+        public:
+            FileException(const std::filesystem::path& p, std::string_view message)
+                : Exception{ "File '" + p.string() + "': " + std::string{ message } }
+            {
+            }
+        };
+
+        constexpr std::uint32_t localFileHeaderSignature{ 0x04034b50 };
+        constexpr std::uint32_t centralDirectoryHeaderSignature{ 0x02014b50 };
+        constexpr std::uint32_t endOfCentralDirectorySignature{ 0x06054b50 };
+        constexpr std::uint32_t zip64EndOfCentralDirectorySignature{ 0x06064b50 };
+        constexpr std::uint32_t zip64EndOfCentralDirectoryLocatorSignature{ 0x07064b50 };
+        constexpr std::uint16_t zip64ExtraFieldId{ 0x0001 };
+
+        constexpr std::size_t localFileHeaderSize{ 30 };
+        constexpr std::size_t centralDirectoryHeaderSize{ 46 };
+        constexpr std::size_t endOfCentralDirectorySize{ 22 };
+        constexpr std::size_t zip64EndOfCentralDirectorySize{ 56 };
+        constexpr std::size_t zip64EndOfCentralDirectoryLocatorSize{ 20 };
+
+        constexpr std::uint16_t versionStore{ 10 };
+        constexpr std::uint16_t versionZip64{ 45 };
+        constexpr std::uint16_t versionMadeBy{ (3 << 8) | versionZip64 }; // 3 = UNIX (external attributes hold the file mode)
+        constexpr std::uint16_t flagUTF8{ 1 << 11 };
+        constexpr std::uint16_t methodStore{ 0 };
+
+        constexpr std::uint32_t max32{ std::numeric_limits<std::uint32_t>::max() };
+        constexpr std::uint16_t max16{ std::numeric_limits<std::uint16_t>::max() };
+
+        class ByteWriter
+        {
+        public:
+            ByteWriter(std::vector<std::byte>& output)
+                : _output{ output } {}
+
+            void write16(std::uint16_t value) { writeLE(value, 2); }
+            void write32(std::uint32_t value) { writeLE(value, 4); }
+            void write64(std::uint64_t value) { writeLE(value, 8); }
+            void writeString(std::string_view str)
+            {
+                std::transform(std::cbegin(str), std::cend(str), std::back_inserter(_output), [](char c) { return static_cast<std::byte>(c); });
+            }
+
+        private:
+            void writeLE(std::uint64_t value, std::size_t byteCount)
+            {
+                for (std::size_t i{}; i < byteCount; ++i)
+                    _output.push_back(static_cast<std::byte>((value >> (i * 8)) & 0xFF));
+            }
+
+            std::vector<std::byte>& _output;
+        };
+
+        bool needsZip64Sizes(std::uint64_t fileSize)
+        {
+            return fileSize >= max32;
+        }
+
+        std::size_t getLocalFileHeaderSize(std::string_view fileName, std::uint64_t fileSize)
+        {
+            return localFileHeaderSize + fileName.size() + (needsZip64Sizes(fileSize) ? 20 : 0);
+        }
+
+        std::size_t getCentralDirectoryZip64ExtraFieldCount(std::uint64_t fileSize, std::uint64_t localHeaderOffset)
+        {
+            return (needsZip64Sizes(fileSize) ? 2 : 0) + (localHeaderOffset >= max32 ? 1 : 0);
+        }
+
+        std::size_t getCentralDirectoryHeaderSize(std::string_view fileName, std::uint64_t fileSize, std::uint64_t localHeaderOffset)
+        {
+            const std::size_t zip64FieldCount{ getCentralDirectoryZip64ExtraFieldCount(fileSize, localHeaderOffset) };
+            return centralDirectoryHeaderSize + fileName.size() + (zip64FieldCount > 0 ? 4 + zip64FieldCount * 8 : 0);
+        }
+
+        bool needsZip64EndOfCentralDirectory(std::size_t entryCount, std::uint64_t centralDirectoryOffset, std::uint64_t centralDirectorySize)
+        {
+            return entryCount >= max16 || centralDirectoryOffset >= max32 || centralDirectorySize >= max32;
+        }
+
+        void toDosDateTime(std::time_t time, std::uint16_t& dosTime, std::uint16_t& dosDate)
+        {
+            std::tm tm{};
+            if (!::localtime_r(&time, &tm) || tm.tm_year < 80)
+            {
+                dosTime = 0;
+                dosDate = (1 << 5) | 1; // 1980-01-01
+                return;
+            }
+
+            dosTime = static_cast<std::uint16_t>((tm.tm_hour << 11) | (tm.tm_min << 5) | (tm.tm_sec / 2));
+            dosDate = static_cast<std::uint16_t>(((tm.tm_year - 80) << 9) | ((tm.tm_mon + 1) << 5) | tm.tm_mday);
+        }
+
+        boost::asio::thread_pool& getCrcThreadPool()
+        {
+            constexpr std::size_t crcThreadCount{ 2 };
+            static boost::asio::thread_pool threadPool{ crcThreadCount };
+            return threadPool;
+        }
+
+        // CRCs are only reused if the file has neither been resized nor modified
+        class CrcCache
+        {
+        public:
+            std::optional<std::uint32_t> get(const std::filesystem::path& filePath, std::uint64_t fileSize, std::uint64_t modificationTime)
+            {
+                const std::scoped_lock lock{ _mutex };
+
+                const Entry* entry{ _entries.find(filePath.string()) };
+                if (!entry || entry->fileSize != fileSize || entry->modificationTime != modificationTime)
+                    return std::nullopt;
+
+                return entry->crc;
+            }
+
+            void set(const std::filesystem::path& filePath, std::uint64_t fileSize, std::uint64_t modificationTime, std::uint32_t crc)
+            {
+                const std::scoped_lock lock{ _mutex };
+                _entries.set(filePath.string(), Entry{ fileSize, modificationTime, crc });
+            }
+
+        private:
+            struct Entry
+            {
+                std::uint64_t fileSize;
+                std::uint64_t modificationTime;
+                std::uint32_t crc;
+            };
+
+            std::mutex _mutex;
+            core::LruCache<std::string, Entry> _entries{ 8192 };
+        };
+
+        CrcCache& getCrcCache()
+        {
+            static CrcCache crcCache;
+            return crcCache;
+        }
+    } // namespace
+
+    StoreZipper::StoreZipper(const EntryContainer& entries)
+        : _readBuffer(_writeBlockSize)
+    {
+        _entries.reserve(entries.size());
+        for (const Entry& entry : entries)
+        {
+            struct ::stat fileStat;
+            if (::stat(entry.filePath.c_str(), &fileStat) == -1)
+                throw FileException{ entry.filePath, std::error_code{ errno, std::generic_category() }.message() };
+            if (!S_ISREG(fileStat.st_mode))
+                throw FileException{ entry.filePath, "not a regular file" };
+
+            EntryInfo& entryInfo{ _entries.emplace_back() };
+            entryInfo.fileName = entry.fileName;
+            entryInfo.filePath = entry.filePath;
+            entryInfo.fileSize = static_cast<std::uint64_t>(fileStat.st_size);
+            entryInfo.mode = static_cast<std::uint32_t>(fileStat.st_mode);
+            entryInfo.modificationTime = static_cast<std::uint64_t>(fileStat.st_mtim.tv_sec) * 1'000'000'000 + static_cast<std::uint64_t>(fileStat.st_mtim.tv_nsec);
+            toDosDateTime(fileStat.st_mtime, entryInfo.dosTime, entryInfo.dosDate);
+        }
+
+        computeLayout();
+        computeETag();
+        _endOffset = _totalSize;
+
+        scheduleCrcComputations(0, _crcReadAheadEntryCount);
+    }
+
+    StoreZipper::~StoreZipper()
+    {
+        // pending CRC computations will stop early
+        *_aborted = true;
+    }
+
+    void StoreZipper::computeLayout()
+    {
+        std::uint64_t offset{};
+        for (EntryInfo& entry : _entries)
+        {
+            entry.localHeaderOffset = offset;
+            entry.dataOffset = offset + getLocalFileHeaderSize(entry.fileName, entry.fileSize);
+            offset = entry.dataOffset + entry.fileSize;
+        }
+
+        _centralDirectoryOffset = offset;
+
+        std::uint64_t centralDirectorySize{};
+        for (const EntryInfo& entry : _entries)
+            centralDirectorySize += getCentralDirectoryHeaderSize(entry.fileName, entry.fileSize, entry.localHeaderOffset);
+
+        _totalSize = _centralDirectoryOffset + centralDirectorySize + endOfCentralDirectorySize;
+        if (needsZip64EndOfCentralDirectory(_entries.size(), _centralDirectoryOffset, centralDirectorySize))
+            _totalSize += zip64EndOfCentralDirectorySize + zip64EndOfCentralDirectoryLocatorSize;
+    }
+
+    void StoreZipper::computeETag()
+    {
+        std::vector<std::byte> buffer;
+        ByteWriter writer{ buffer };
+        for (const EntryInfo& entry : _entries)
+        {
+            writer.writeString(entry.fileName);
+            writer.write16(0);
+            writer.writeString(entry.filePath.native());
+            writer.write16(0);
+            writer.write64(entry.fileSize);
+            writer.write64(entry.modificationTime);
+        }
+
+        std::ostringstream oss;
+        oss << std::hex << std::setfill('0') << std::setw(16) << core::xxHash3_64(buffer);
+        _etag = oss.str();
+    }
+
+    std::uint64_t StoreZipper::writeSome(std::ostream& output)
+    {
+        std::uint64_t written{};
+        while (written == 0 && !isComplete())
+        {
+            const std::uint64_t maxSize{ std::min(_endOffset - _offset, static_cast<std::uint64_t>(_writeBlockSize)) };
+
+            if (_offset >= _centralDirectoryOffset)
+            {
+                written = writeCentralDirectoryData(output, maxSize);
+            }
+            else
+            {
+                // find the entry that contains the current offset
+                const auto it{ std::upper_bound(std::cbegin(_entries), std::cend(_entries), _offset, [](std::uint64_t offset, const EntryInfo& entry) { return offset < entry.localHeaderOffset; }) };
+                assert(it != std::cbegin(_entries));
+                const std::size_t entryIndex{ static_cast<std::size_t>(std::distance(std::cbegin(_entries), it)) - 1 };
+
+                // keep reading ahead upcoming entries
+                scheduleCrcComputations(entryIndex, _crcReadAheadEntryCount);
+
+                if (_offset < _entries[entryIndex].dataOffset)
+                    written = writeHeaderData(output, entryIndex, maxSize);
+                else
+                    written = writeFileData(output, entryIndex, maxSize);
+            }
+
+            if (!output)
+                throw Exception{ "Failed to write " + std::to_string(written) + " bytes in final archive output!" };
+
+            _offset += written;
+        }
+
+        return written;
+    }
+
+    bool StoreZipper::isComplete() const
+    {
+        return *_aborted || _offset >= _endOffset;
+    }
+
+    void StoreZipper::abort()
+    {
+        LMS_LOG(UTILS, DEBUG, "Aborting zip creation");
+        *_aborted = true;
+    }
+
+    std::optional<std::uint64_t> StoreZipper::getTotalSize() const
+    {
+        return _totalSize;
+    }
+
+    void StoreZipper::setRange(std::uint64_t offset, std::uint64_t endOffset)
+    {
+        if (offset > endOffset || endOffset > _totalSize)
+            throw Exception{ "Invalid range" };
+
+        _offset = offset;
+        _endOffset = endOffset;
+    }
+
+    std::optional<std::string> StoreZipper::getETag() const
+    {
+        return _etag;
+    }
+
+    std::uint32_t StoreZipper::getCrc(std::size_t entryIndex)
+    {
+        EntryInfo& entry{ _entries[entryIndex] };
+        if (!entry.crc)
+        {
+            if (!entry.crcFuture.valid())
+                scheduleCrcComputations(entryIndex, 1);
+
+            entry.crc = entry.crcFuture.get(); // may rethrow
+        }
+
+        return *entry.crc;
+    }
+
+    void StoreZipper::scheduleCrcComputations(std::size_t firstEntryIndex, std::size_t count)
+    {
+        const std::size_t lastEntryIndex{ std::min(firstEntryIndex + count, _entries.size()) };
+        for (std::size_t entryIndex{ firstEntryIndex }; entryIndex < lastEntryIndex; ++entryIndex)
+        {
+            EntryInfo& entry{ _entries[entryIndex] };
+            if (entry.crc || entry.crcFuture.valid())
+                continue;
+
+            entry.crc = getCrcCache().get(entry.filePath, entry.fileSize, entry.modificationTime);
+            if (entry.crc)
+                continue;
+
+            auto task{ std::make_shared<std::packaged_task<std::uint32_t()>>([aborted = _aborted, filePath = entry.filePath, fileSize = entry.fileSize, modificationTime = entry.modificationTime] {
+                const std::uint32_t crc{ computeCrc(filePath, fileSize, *aborted) };
+                getCrcCache().set(filePath, fileSize, modificationTime, crc);
+                return crc;
+            }) };
+            entry.crcFuture = task->get_future();
+
+            boost::asio::post(getCrcThreadPool(), [task] { (*task)(); });
+        }
+    }
+
+    std::uint32_t StoreZipper::computeCrc(const std::filesystem::path& filePath, std::uint64_t fileSize, const std::atomic<bool>& aborted)
+    {
+        core::FileReader reader{ filePath };
+        if (!reader.isOpen())
+            throw FileException{ filePath, "cannot open file" };
+        if (reader.getFileSize() != fileSize)
+            throw FileException{ filePath, "size changed" };
+
+        reader.adviseSequential(0, fileSize);
+
+        std::vector<std::byte> buffer(_writeBlockSize);
+        core::Crc32Calculator crc;
+        for (std::uint64_t offset{}; offset < fileSize;)
+        {
+            if (aborted)
+                throw Exception{ "Aborted" };
+
+            const std::size_t bytesToRead{ static_cast<std::size_t>(std::min(fileSize - offset, static_cast<std::uint64_t>(buffer.size()))) };
+            const std::optional<std::size_t> bytesRead{ reader.read(offset, std::span{ buffer }.first(bytesToRead)) };
+            if (!bytesRead || *bytesRead != bytesToRead)
+                throw FileException{ filePath, "read failed" };
+
+            crc.processBytes(buffer.data(), bytesToRead);
+            offset += bytesToRead;
+        }
+
+        return crc.getResult();
+    }
+
+    std::uint64_t StoreZipper::writeHeaderData(std::ostream& output, std::size_t entryIndex, std::uint64_t maxSize)
+    {
+        const EntryInfo& entry{ _entries[entryIndex] };
+        const bool zip64{ needsZip64Sizes(entry.fileSize) };
+
+        std::vector<std::byte> header;
+        header.reserve(entry.dataOffset - entry.localHeaderOffset);
+
+        ByteWriter writer{ header };
+        writer.write32(localFileHeaderSignature);
+        writer.write16(zip64 ? versionZip64 : versionStore);
+        writer.write16(flagUTF8);
+        writer.write16(methodStore);
+        writer.write16(entry.dosTime);
+        writer.write16(entry.dosDate);
+        writer.write32(getCrc(entryIndex));
+        writer.write32(zip64 ? max32 : static_cast<std::uint32_t>(entry.fileSize)); // compressed size
+        writer.write32(zip64 ? max32 : static_cast<std::uint32_t>(entry.fileSize)); // uncompressed size
+        writer.write16(static_cast<std::uint16_t>(entry.fileName.size()));
+        writer.write16(zip64 ? 20 : 0);
+        writer.writeString(entry.fileName);
+        if (zip64)
+        {
+            writer.write16(zip64ExtraFieldId);
+            writer.write16(16);
+            writer.write64(entry.fileSize); // uncompressed size
+            writer.write64(entry.fileSize); // compressed size
+        }
+        assert(header.size() == entry.dataOffset - entry.localHeaderOffset);
+
+        const std::uint64_t headerOffset{ _offset - entry.localHeaderOffset };
+        const std::uint64_t size{ std::min(maxSize, header.size() - headerOffset) };
+        output.write(reinterpret_cast<const char*>(header.data() + headerOffset), size);
+
+        return size;
+    }
+
+    std::uint64_t StoreZipper::writeFileData(std::ostream& output, std::size_t entryIndex, std::uint64_t maxSize)
+    {
+        const EntryInfo& entry{ _entries[entryIndex] };
+
+        if (_currentFileReaderEntryIndex != entryIndex)
+        {
+            _currentFileReader = std::make_unique<core::FileReader>(entry.filePath);
+            _currentFileReaderEntryIndex = entryIndex;
+
+            if (!_currentFileReader->isOpen())
+                throw FileException{ entry.filePath, "cannot open file" };
+            if (_currentFileReader->getFileSize() != entry.fileSize)
+                throw FileException{ entry.filePath, "size changed" };
+        }
+
+        const std::uint64_t fileOffset{ _offset - entry.dataOffset };
+        const std::size_t bytesToRead{ static_cast<std::size_t>(std::min(maxSize, entry.fileSize - fileOffset)) };
+
+        const std::optional<std::size_t> bytesRead{ _currentFileReader->read(fileOffset, std::span{ _readBuffer }.first(bytesToRead)) };
+        if (!bytesRead || *bytesRead != bytesToRead)
+            throw FileException{ entry.filePath, "read failed" };
+
+        output.write(reinterpret_cast<const char*>(_readBuffer.data()), bytesToRead);
+
+        return bytesToRead;
+    }
+
+    std::uint64_t StoreZipper::writeCentralDirectoryData(std::ostream& output, std::uint64_t maxSize)
+    {
+        if (_centralDirectory.empty())
+        {
+            // make sure all the missing CRCs are computed in parallel
+            scheduleCrcComputations(0, _entries.size());
+
+            ByteWriter writer{ _centralDirectory };
+            for (std::size_t entryIndex{}; entryIndex < _entries.size(); ++entryIndex)
+            {
+                const EntryInfo& entry{ _entries[entryIndex] };
+                const bool zip64Sizes{ needsZip64Sizes(entry.fileSize) };
+                const bool zip64Offset{ entry.localHeaderOffset >= max32 };
+                const std::size_t zip64FieldCount{ getCentralDirectoryZip64ExtraFieldCount(entry.fileSize, entry.localHeaderOffset) };
+
+                writer.write32(centralDirectoryHeaderSignature);
+                writer.write16(versionMadeBy);
+                writer.write16(zip64FieldCount > 0 ? versionZip64 : versionStore);
+                writer.write16(flagUTF8);
+                writer.write16(methodStore);
+                writer.write16(entry.dosTime);
+                writer.write16(entry.dosDate);
+                writer.write32(getCrc(entryIndex));
+                writer.write32(zip64Sizes ? max32 : static_cast<std::uint32_t>(entry.fileSize)); // compressed size
+                writer.write32(zip64Sizes ? max32 : static_cast<std::uint32_t>(entry.fileSize)); // uncompressed size
+                writer.write16(static_cast<std::uint16_t>(entry.fileName.size()));
+                writer.write16(static_cast<std::uint16_t>(zip64FieldCount > 0 ? 4 + zip64FieldCount * 8 : 0));
+                writer.write16(0); // comment length
+                writer.write16(0); // disk number start
+                writer.write16(0); // internal attributes
+                writer.write32(entry.mode << 16);
+                writer.write32(zip64Offset ? max32 : static_cast<std::uint32_t>(entry.localHeaderOffset));
+                writer.writeString(entry.fileName);
+                if (zip64FieldCount > 0)
+                {
+                    writer.write16(zip64ExtraFieldId);
+                    writer.write16(static_cast<std::uint16_t>(zip64FieldCount * 8));
+                    if (zip64Sizes)
+                    {
+                        writer.write64(entry.fileSize); // uncompressed size
+                        writer.write64(entry.fileSize); // compressed size
+                    }
+                    if (zip64Offset)
+                        writer.write64(entry.localHeaderOffset);
+                }
+            }
+
+            const std::uint64_t centralDirectorySize{ _centralDirectory.size() };
+            const bool zip64{ needsZip64EndOfCentralDirectory(_entries.size(), _centralDirectoryOffset, centralDirectorySize) };
+            if (zip64)
+            {
+                const std::uint64_t zip64EndOfCentralDirectoryOffset{ _centralDirectoryOffset + centralDirectorySize };
+
+                writer.write32(zip64EndOfCentralDirectorySignature);
+                writer.write64(zip64EndOfCentralDirectorySize - 12); // size of the remaining record
+                writer.write16(versionMadeBy);
+                writer.write16(versionZip64);
+                writer.write32(0); // number of this disk
+                writer.write32(0); // disk where central directory starts
+                writer.write64(_entries.size());
+                writer.write64(_entries.size());
+                writer.write64(centralDirectorySize);
+                writer.write64(_centralDirectoryOffset);
+
+                writer.write32(zip64EndOfCentralDirectoryLocatorSignature);
+                writer.write32(0); // disk where zip64 end of central directory starts
+                writer.write64(zip64EndOfCentralDirectoryOffset);
+                writer.write32(1); // total number of disks
+            }
+
+            writer.write32(endOfCentralDirectorySignature);
+            writer.write16(0); // number of this disk
+            writer.write16(0); // disk where central directory starts
+            writer.write16(zip64 ? max16 : static_cast<std::uint16_t>(_entries.size()));
+            writer.write16(zip64 ? max16 : static_cast<std::uint16_t>(_entries.size()));
+            writer.write32(zip64 ? max32 : static_cast<std::uint32_t>(centralDirectorySize));
+            writer.write32(zip64 ? max32 : static_cast<std::uint32_t>(_centralDirectoryOffset));
+            writer.write16(0); // comment length
+
+            assert(_centralDirectoryOffset + _centralDirectory.size() == _totalSize);
+        }
+
+        const std::uint64_t centralDirectoryOffset{ _offset - _centralDirectoryOffset };
+        const std::uint64_t size{ std::min(maxSize, _centralDirectory.size() - centralDirectoryOffset) };
+        output.write(reinterpret_cast<const char*>(_centralDirectory.data() + centralDirectoryOffset), size);
+
+        return size;
+    }
+} // namespace lms::zip
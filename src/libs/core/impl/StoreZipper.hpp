@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/IZipper.hpp"
+
+#include "FileReader.hpp"
+
+namespace lms::zip
+{
+    // Zip archive with uncompressed (STORE) entries:
+    // - the whole layout (and then the total size) is computed up front
+    // - any byte range of the archive can be generated
+    // - entry CRCs are computed ahead of time by a background pool shared by all the archives, which also warms up the page cache for the upcoming entries
+    // - computed CRCs are kept in a process wide cache, so that resuming a download does not need to read all the files again
+    class StoreZipper : public IZipper
+    {
+    public:
+        StoreZipper(const EntryContainer& entries);
+        ~StoreZipper() override;
+        StoreZipper(const StoreZipper&) = delete;
+        StoreZipper& operator=(const StoreZipper&) = delete;
+
+    private:
+        std::uint64_t writeSome(std::ostream& output) override;
+        bool isComplete() const override;
+        void abort() override;
+        std::optional<std::uint64_t> getTotalSize() const override;
+        void setRange(std::uint64_t offset, std::uint64_t endOffset) override;
+        std::optional<std::string> getETag() const override;
+
+        struct EntryInfo
+        {
+            std::string fileName;
+            std::filesystem::path filePath;
+            std::uint64_t fileSize{};
+            std::uint64_t modificationTime{}; // in ns
+            std::uint16_t dosTime{};
+            std::uint16_t dosDate{};
+            std::uint32_t mode{};
+            std::uint64_t localHeaderOffset{};
+            std::uint64_t dataOffset{};
+
+            std::future<std::uint32_t> crcFuture;
+            std::optional<std::uint32_t> crc;
+        };
+
+        void computeLayout();
+        void computeETag();
+        std::uint32_t getCrc(std::size_t entryIndex);
+        void scheduleCrcComputations(std::size_t firstEntryIndex, std::size_t count);
+        static std::uint32_t computeCrc(const std::filesystem::path& filePath, std::uint64_t fileSize, const std::atomic<bool>& aborted);
+
+        std::uint64_t writeHeaderData(std::ostream& output, std::size_t entryIndex, std::uint64_t maxSize);
+        std::uint64_t writeFileData(std::ostream& output, std::size_t entryIndex, std::uint64_t maxSize);
+        std::uint64_t writeCentralDirectoryData(std::ostream& output, std::uint64_t maxSize);
+
+        static inline constexpr std::size_t _writeBlockSize{ 262'144 };
+        static inline constexpr std::size_t _crcReadAheadEntryCount{ 4 };
+
+        std::vector<EntryInfo> _entries;
+        std::string _etag;
+
+        std::uint64_t _centralDirectoryOffset{};
+        std::uint64_t _totalSize{};
+        std::vector<std::byte> _centralDirectory; // lazily built, along with the end of central directory records
+
+        std::uint64_t _offset{};
+        std::uint64_t _endOffset{};
+
+        std::vector<std::byte> _readBuffer;
+        std::optional<std::size_t> _currentFileReaderEntryIndex;
+        std::unique_ptr<core::FileReader> _currentFileReader;
+
+        // shared with the pending CRC computations, that may outlive the zipper
+        const std::shared_ptr<std::atomic<bool>> _aborted{ std::make_shared<std::atomic<bool>>(false) };
+    };
+} // namespace lms::zip
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <filesystem>
 #include <memory>
 #include <sstream>
@@ -42,6 +43,7 @@ namespace lms::core::logging
         API_SUBSONIC,
         AUTH,
         AV,
+        CATALOG,
         CHILDPROCESS,
         COVER,
         DB,
@@ -100,6 +102,11 @@ namespace lms::core::logging
 
     static constexpr Severity defaultMinSeverity{ Severity::INFO };
     std::unique_ptr<ILogger> createLogger(Severity minSeverity = defaultMinSeverity, const std::filesystem::path& logFilePath = {});
+
+    // Logs are queued in per-thread buffers and written by a dedicated thread
+    // Logs emitted while the buffer of their thread is full are dropped (and counted)
+    static constexpr std::size_t defaultMaxPendingLogsPerThread{ 1024 };
+    std::unique_ptr<ILogger> createAsyncLogger(Severity minSeverity = defaultMinSeverity, const std::filesystem::path& logFilePath = {}, std::size_t maxPendingLogsPerThread = defaultMaxPendingLogsPerThread);
 } // namespace lms::core::logging
 
 #define LMS_LOG(module, severity, message)                                                                                                                               \
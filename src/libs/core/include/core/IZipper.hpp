@@ -21,6 +21,8 @@
 
 #include <filesystem>
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 #include "Exception.hpp"
@@ -48,7 +50,16 @@ namespace lms::zip
         virtual std::uint64_t writeSome(std::ostream& output) = 0;
         virtual bool isComplete() const = 0;
         virtual void abort() = 0;
+
+        // Total archive size, if it can be known before the archive is generated
+        virtual std::optional<std::uint64_t> getTotalSize() const = 0;
+        // Restrict the output to [offset, endOffset), only supported if the total size is known
+        virtual void setRange(std::uint64_t offset, std::uint64_t endOffset) = 0;
+        // Identifies the archive content (entry names, files, sizes and modification times), if range requests are supported
+        virtual std::optional<std::string> getETag() const = 0;
     };
 
     std::unique_ptr<IZipper> createArchiveZipper(const EntryContainer& entries);
+    // No compression, total size known up front and range requests supported
+    std::unique_ptr<IZipper> createStoreZipper(const EntryContainer& entries);
 } // namespace lms::zip
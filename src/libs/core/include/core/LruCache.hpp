@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace lms::core
+{
+    // Bounded key/value cache, evicting the least recently used entries first
+    // Not thread safe
+    template<typename Key, typename Value, typename Hash = std::hash<Key>>
+    class LruCache
+    {
+    public:
+        LruCache(std::size_t maxEntryCount)
+            : _maxEntryCount{ maxEntryCount }
+        {
+            assert(_maxEntryCount > 0);
+        }
+
+        std::size_t getMaxEntryCount() const { return _maxEntryCount; }
+        std::size_t size() const { return _index.size(); }
+
+        // Makes the entry the most recently used one
+        Value* find(const Key& key)
+        {
+            auto it{ _index.find(key) };
+            if (it == std::end(_index))
+                return nullptr;
+
+            _entries.splice(std::begin(_entries), _entries, it->second);
+            return &it->second->second;
+        }
+
+        // Evicts the least recently used entry if the cache is full
+        Value& set(const Key& key, Value value)
+        {
+            if (Value * existingValue{ find(key) })
+            {
+                *existingValue = std::move(value);
+                return *existingValue;
+            }
+
+            if (_index.size() == _maxEntryCount)
+            {
+                _index.erase(_entries.back().first);
+                _entries.pop_back();
+            }
+
+            _entries.emplace_front(key, std::move(value));
+            _index.emplace(key, std::begin(_entries));
+            return _entries.front().second;
+        }
+
+        bool erase(const Key& key)
+        {
+            auto it{ _index.find(key) };
+            if (it == std::end(_index))
+                return false;
+
+            _entries.erase(it->second);
+            _index.erase(it);
+            return true;
+        }
+
+        void clear()
+        {
+            _index.clear();
+            _entries.clear();
+        }
+
+    private:
+        using Entry = std::pair<Key, Value>;
+
+        std::size_t _maxEntryCount;
+        std::list<Entry> _entries; // most recently used first
+        std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> _index;
+    };
+} // namespace lms::core
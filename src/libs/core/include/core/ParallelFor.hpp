@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include "core/IJob.hpp"
+#include "core/IJobScheduler.hpp"
+
+namespace lms::core
+{
+    namespace details
+    {
+        template<typename Func>
+        class ParallelForJob : public IJob
+        {
+        public:
+            ParallelForJob(Func& func, std::size_t begin, std::size_t end, std::exception_ptr& exception)
+                : _func{ func }
+                , _begin{ begin }
+                , _end{ end }
+                , _exception{ exception }
+            {
+            }
+
+        private:
+            LiteralString getName() const override { return "ParallelFor"; }
+            void run() override
+            {
+                try
+                {
+                    _func(_begin, _end);
+                }
+                catch (...)
+                {
+                    _exception = std::current_exception();
+                }
+            }
+
+            Func& _func;
+            const std::size_t _begin;
+            const std::size_t _end;
+            std::exception_ptr& _exception;
+        };
+    } // namespace details
+
+    // Calls func(begin, end) on contiguous chunks of [0, count), one chunk per thread of the job scheduler
+    // The job scheduler must not be shared with other callers: all its jobs are waited for, and it must not abort them
+    // Blocks until all the chunks are processed, rethrows the first exception raised by func
+    template<typename Func>
+    void parallelFor(IJobScheduler& jobScheduler, std::size_t count, Func func)
+    {
+        const std::size_t chunkCount{ std::clamp<std::size_t>(jobScheduler.getThreadCount(), 1, std::max<std::size_t>(count, 1)) };
+        if (chunkCount == 1)
+        {
+            func(std::size_t{ 0 }, count);
+            return;
+        }
+
+        std::vector<std::exception_ptr> exceptions(chunkCount);
+
+        const std::size_t chunkSize{ (count + chunkCount - 1) / chunkCount };
+        for (std::size_t i{}; i < chunkCount; ++i)
+            jobScheduler.scheduleJob(std::make_unique<details::ParallelForJob<Func>>(func, std::min(count, i * chunkSize), std::min(count, (i + 1) * chunkSize), exceptions[i]));
+
+        jobScheduler.wait();
+
+        std::vector<std::unique_ptr<IJob>> doneJobs;
+        jobScheduler.popJobsDone(doneJobs, chunkCount);
+
+        for (const std::exception_ptr& exception : exceptions)
+        {
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+    }
+} // namespace lms::core
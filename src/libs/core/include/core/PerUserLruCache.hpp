@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+
+#include "core/LruCache.hpp"
+
+namespace lms::core
+{
+    // Bounded, thread safe cache of per user values
+    // Values are tagged with the backend they have been computed for: switching the backend of a user drops all their values
+    // Both users and values are evicted on a least recently used basis
+    template<typename UserIdType, typename BackendType, typename Key, typename Value, typename Hash = std::hash<Key>>
+    class PerUserLruCache
+    {
+    public:
+        PerUserLruCache(std::size_t maxUserCount, std::size_t maxEntryCountPerUser)
+            : _maxEntryCountPerUser{ maxEntryCountPerUser }
+            , _users{ maxUserCount > 0 ? maxUserCount : 1 }
+            , _enabled{ maxUserCount > 0 && maxEntryCountPerUser > 0 }
+        {
+        }
+        PerUserLruCache(const PerUserLruCache&) = delete;
+        PerUserLruCache& operator=(const PerUserLruCache&) = delete;
+
+        // To be read before querying the source of the values, and given back to set
+        // Prevents from caching values that have been invalidated in the meantime
+        std::uint64_t getGeneration() const
+        {
+            const std::scoped_lock lock{ _mutex };
+            return _generation;
+        }
+
+        std::optional<Value> get(UserIdType userId, BackendType backend, const Key& key)
+        {
+            const std::scoped_lock lock{ _mutex };
+
+            UserEntry* userEntry{ _users.find(userId) };
+            if (!userEntry || userEntry->backend != backend)
+                return std::nullopt;
+
+            if (const Value * value{ userEntry->values.find(key) })
+                return *value;
+
+            return std::nullopt;
+        }
+
+        void set(std::uint64_t generation, UserIdType userId, BackendType backend, const Key& key, const Value& value)
+        {
+            const std::scoped_lock lock{ _mutex };
+
+            if (generation != _generation || !_enabled)
+                return;
+
+            UserEntry* userEntry{ _users.find(userId) };
+            if (!userEntry)
+                userEntry = &_users.set(userId, UserEntry{ backend, ValueCache{ _maxEntryCountPerUser } });
+            else if (userEntry->backend != backend)
+            {
+                userEntry->backend = backend;
+                userEntry->values.clear();
+            }
+
+            userEntry->values.set(key, value);
+        }
+
+        void invalidate(UserIdType userId)
+        {
+            invalidate(std::span{ &userId, 1 });
+        }
+
+        void invalidate(std::span<const UserIdType> userIds)
+        {
+            const std::scoped_lock lock{ _mutex };
+
+            _generation++;
+            for (const UserIdType userId : userIds)
+                _users.erase(userId);
+        }
+
+    private:
+        using ValueCache = LruCache<Key, Value, Hash>;
+        struct UserEntry
+        {
+            BackendType backend;
+            ValueCache values;
+        };
+
+        const std::size_t _maxEntryCountPerUser;
+
+        mutable std::mutex _mutex;
+        std::uint64_t _generation{};
+        LruCache<UserIdType, UserEntry> _users;
+        const bool _enabled;
+    };
+} // namespace lms::core
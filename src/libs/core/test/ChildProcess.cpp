@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <functional>
+#include <string>
+
+#include <boost/asio/io_context.hpp>
+#include <gtest/gtest.h>
+
+#include "core/IChildProcess.hpp"
+#include "core/IChildProcessManager.hpp"
+
+namespace lms::core::tests
+{
+    namespace
+    {
+        // reads the whole output of the process
+        std::string readAll(boost::asio::io_context& ioContext, IChildProcess& childProcess)
+        {
+            std::string output;
+            std::array<std::byte, 16> buffer;
+
+            std::function<void()> readNext;
+            readNext = [&] {
+                childProcess.asyncRead(buffer.data(), buffer.size(), [&](IChildProcess::ReadResult res, std::size_t readCount) {
+                    output.append(reinterpret_cast<const char*>(buffer.data()), readCount);
+                    if (res == IChildProcess::ReadResult::Success)
+                        readNext();
+                });
+            };
+            readNext();
+            ioContext.run();
+
+            return output;
+        }
+
+        std::unique_ptr<IChildProcess> spawnShell(IChildProcessManager& childProcessManager, const std::string& command)
+        {
+            return childProcessManager.spawnChildProcess("/bin/sh", { "/bin/sh", "-c", command });
+        }
+    } // namespace
+
+    TEST(ChildProcess, exitCode)
+    {
+        boost::asio::io_context ioContext;
+        auto childProcessManager{ createChildProcessManager(ioContext) };
+
+        auto childProcess{ spawnShell(*childProcessManager, "printf 'some output'") };
+        EXPECT_EQ(readAll(ioContext, *childProcess), "some output");
+        ASSERT_TRUE(childProcess->finished());
+        EXPECT_EQ(childProcess->getExitCode(), 0);
+    }
+
+    TEST(ChildProcess, failure)
+    {
+        boost::asio::io_context ioContext;
+        auto childProcessManager{ createChildProcessManager(ioContext) };
+
+        // output may have been produced before the failure
+        auto childProcess{ spawnShell(*childProcessManager, "printf 'partial output'; exit 3") };
+        EXPECT_EQ(readAll(ioContext, *childProcess), "partial output");
+        ASSERT_TRUE(childProcess->finished());
+        EXPECT_EQ(childProcess->getExitCode(), 3);
+    }
+
+    TEST(ChildProcess, killed)
+    {
+        boost::asio::io_context ioContext;
+        auto childProcessManager{ createChildProcessManager(ioContext) };
+
+        auto childProcess{ spawnShell(*childProcessManager, "kill -9 $$") };
+        EXPECT_EQ(readAll(ioContext, *childProcess), "");
+        ASSERT_TRUE(childProcess->finished());
+        EXPECT_EQ(childProcess->getExitCode(), std::nullopt);
+    }
+} // namespace lms::core::tests
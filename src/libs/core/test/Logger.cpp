@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/ILogger.hpp"
+#include "core/Random.hpp"
+
+namespace lms::core::logging::tests
+{
+    namespace
+    {
+        class TemporaryLogFile
+        {
+        public:
+            TemporaryLogFile()
+                : _path{ std::filesystem::temp_directory_path() / ("lms-test-logger-" + std::to_string(core::random::getRandom(0, std::numeric_limits<int>::max()))) }
+            {
+            }
+            ~TemporaryLogFile()
+            {
+                std::error_code ec;
+                std::filesystem::remove(_path, ec);
+            }
+            TemporaryLogFile(const TemporaryLogFile&) = delete;
+            TemporaryLogFile& operator=(const TemporaryLogFile&) = delete;
+
+            const std::filesystem::path& getPath() const { return _path; }
+
+            std::size_t countLines(std::string_view pattern) const
+            {
+                std::ifstream ifs{ _path };
+
+                std::size_t count{};
+                std::string line;
+                while (std::getline(ifs, line))
+                {
+                    if (line.find(pattern) != std::string::npos)
+                        count++;
+                }
+                return count;
+            }
+
+        private:
+            const std::filesystem::path _path;
+        };
+    } // namespace
+
+    TEST(AsyncLogger, MultipleThreads)
+    {
+        TemporaryLogFile logFile;
+
+        {
+            auto logger{ createAsyncLogger(Severity::INFO, logFile.getPath()) };
+
+            std::vector<std::thread> threads;
+            for (std::size_t i{}; i < 16; ++i)
+            {
+                threads.emplace_back([&] {
+                    for (std::size_t j{}; j < 100; ++j)
+                    {
+                        logger->processLog(Module::UTILS, Severity::INFO, "MyLoggedMessage");
+                        if (logger->isSeverityActive(Severity::DEBUG))
+                            logger->processLog(Module::UTILS, Severity::DEBUG, "MyNotLoggedMessage");
+                    }
+                });
+            }
+
+            for (std::thread& t : threads)
+                t.join();
+        } // all logs must be written on destruction
+
+        EXPECT_EQ(logFile.countLines("[info] [UTILS] MyLoggedMessage"), 16 * 100);
+        EXPECT_EQ(logFile.countLines("MyNotLoggedMessage"), 0);
+    }
+
+    TEST(AsyncLogger, FatalIsWrittenImmediately)
+    {
+        TemporaryLogFile logFile;
+
+        auto logger{ createAsyncLogger(Severity::INFO, logFile.getPath()) };
+
+        logger->processLog(Module::UTILS, Severity::INFO, "MyInfoMessage");
+        logger->processLog(Module::UTILS, Severity::FATAL, "MyFatalMessage");
+
+        EXPECT_EQ(logFile.countLines("[info] [UTILS] MyInfoMessage"), 1);
+        EXPECT_EQ(logFile.countLines("[fatal] [UTILS] MyFatalMessage"), 1);
+    }
+
+    TEST(AsyncLogger, DroppedLogs)
+    {
+        TemporaryLogFile logFile;
+
+        {
+            auto logger{ createAsyncLogger(Severity::INFO, logFile.getPath(), 1) };
+
+            // the writer thread may drain the buffer at any time, at most 1000 logs are written
+            for (std::size_t i{}; i < 1000; ++i)
+                logger->processLog(Module::UTILS, Severity::INFO, "MyMessage");
+        }
+
+        EXPECT_GE(logFile.countLines("MyMessage"), 1);
+        EXPECT_LE(logFile.countLines("MyMessage"), 1000);
+        EXPECT_EQ(logFile.countLines("MyMessage") < 1000, logFile.countLines("AsyncLogger: dropped") > 0);
+    }
+} // namespace lms::core::logging::tests
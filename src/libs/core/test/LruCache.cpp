@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "core/LruCache.hpp"
+#include "core/PerUserLruCache.hpp"
+
+namespace lms::core::tests
+{
+    TEST(LruCache, findSet)
+    {
+        LruCache<int, std::string> cache{ 2 };
+        EXPECT_EQ(cache.find(1), nullptr);
+
+        cache.set(1, "one");
+        ASSERT_NE(cache.find(1), nullptr);
+        EXPECT_EQ(*cache.find(1), "one");
+
+        cache.set(1, "uno");
+        EXPECT_EQ(*cache.find(1), "uno");
+        EXPECT_EQ(cache.size(), 1);
+
+        EXPECT_TRUE(cache.erase(1));
+        EXPECT_FALSE(cache.erase(1));
+        EXPECT_EQ(cache.find(1), nullptr);
+    }
+
+    TEST(LruCache, eviction)
+    {
+        LruCache<int, int> cache{ 2 };
+
+        cache.set(1, 1);
+        cache.set(2, 2);
+        EXPECT_NE(cache.find(1), nullptr);
+        // 2 is now the least recently used entry
+        cache.set(3, 3);
+
+        EXPECT_EQ(cache.size(), 2);
+        EXPECT_NE(cache.find(1), nullptr);
+        EXPECT_EQ(cache.find(2), nullptr);
+        EXPECT_NE(cache.find(3), nullptr);
+    }
+
+    namespace
+    {
+        enum class Backend
+        {
+            Internal,
+            External,
+        };
+        using TestPerUserCache = PerUserLruCache<int /* user */, Backend, int, std::string>;
+    } // namespace
+
+    TEST(PerUserLruCache, getSet)
+    {
+        TestPerUserCache cache{ 64, 16 };
+
+        EXPECT_FALSE(cache.get(1, Backend::Internal, 2));
+
+        cache.set(cache.getGeneration(), 1, Backend::Internal, 2, "value");
+        const auto value{ cache.get(1, Backend::Internal, 2) };
+        ASSERT_TRUE(value);
+        EXPECT_EQ(*value, "value");
+
+        EXPECT_FALSE(cache.get(1, Backend::External, 2));
+        EXPECT_FALSE(cache.get(2, Backend::Internal, 2));
+    }
+
+    TEST(PerUserLruCache, invalidate)
+    {
+        TestPerUserCache cache{ 64, 16 };
+
+        cache.set(cache.getGeneration(), 1, Backend::Internal, 3, "value");
+        cache.set(cache.getGeneration(), 2, Backend::Internal, 3, "value");
+
+        // values read before an invalidation must not be cached
+        const std::uint64_t generation{ cache.getGeneration() };
+        cache.invalidate(1);
+        cache.set(generation, 1, Backend::Internal, 3, "value");
+
+        EXPECT_FALSE(cache.get(1, Backend::Internal, 3));
+        EXPECT_TRUE(cache.get(2, Backend::Internal, 3));
+
+        const int userIds[]{ 1, 2 };
+        cache.invalidate(userIds);
+        EXPECT_FALSE(cache.get(2, Backend::Internal, 3));
+    }
+
+    TEST(PerUserLruCache, backendChange)
+    {
+        TestPerUserCache cache{ 64, 16 };
+
+        cache.set(cache.getGeneration(), 1, Backend::Internal, 1, "value1");
+        cache.set(cache.getGeneration(), 1, Backend::External, 2, "value2");
+
+        EXPECT_FALSE(cache.get(1, Backend::Internal, 1));
+        EXPECT_FALSE(cache.get(1, Backend::External, 1));
+        EXPECT_TRUE(cache.get(1, Backend::External, 2));
+    }
+
+    TEST(PerUserLruCache, eviction)
+    {
+        TestPerUserCache cache{ 2 /* maxUserCount */, 2 /* maxEntryCountPerUser */ };
+
+        for (int i{ 1 }; i <= 3; ++i)
+            cache.set(cache.getGeneration(), 1, Backend::Internal, i, "value");
+
+        EXPECT_FALSE(cache.get(1, Backend::Internal, 1));
+        EXPECT_TRUE(cache.get(1, Backend::Internal, 2));
+        EXPECT_TRUE(cache.get(1, Backend::Internal, 3));
+
+        cache.set(cache.getGeneration(), 2, Backend::Internal, 1, "value");
+        EXPECT_TRUE(cache.get(1, Backend::Internal, 2));
+        // user 2 is now the least recently used one
+        cache.set(cache.getGeneration(), 3, Backend::Internal, 1, "value");
+
+        EXPECT_TRUE(cache.get(1, Backend::Internal, 2));
+        EXPECT_FALSE(cache.get(2, Backend::Internal, 1));
+        EXPECT_TRUE(cache.get(3, Backend::Internal, 1));
+    }
+
+    TEST(PerUserLruCache, disabled)
+    {
+        TestPerUserCache cache{ 0, 0 };
+
+        cache.set(cache.getGeneration(), 1, Backend::Internal, 1, "value");
+        EXPECT_FALSE(cache.get(1, Backend::Internal, 1));
+    }
+} // namespace lms::core::tests
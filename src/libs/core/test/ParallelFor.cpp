@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/IJobScheduler.hpp"
+#include "core/ParallelFor.hpp"
+
+namespace lms::core::tests
+{
+    TEST(ParallelFor, coverage)
+    {
+        for (const std::size_t count : { 0, 1, 7, 100 })
+        {
+            for (const std::size_t threadCount : { 1, 3, 8 })
+            {
+                const std::unique_ptr<IJobScheduler> jobScheduler{ createJobScheduler("Test", threadCount) };
+
+                std::vector<std::atomic<int>> visitCounts(count);
+                std::atomic<std::size_t> callCount{};
+                parallelFor(*jobScheduler, count, [&](std::size_t begin, std::size_t end) {
+                    ASSERT_LE(begin, end);
+                    ASSERT_LE(end, count);
+                    callCount++;
+                    for (std::size_t i{ begin }; i < end; ++i)
+                        visitCounts[i]++;
+                });
+
+                EXPECT_GE(callCount, 1);
+                EXPECT_EQ(jobScheduler->getJobsDoneCount(), 0);
+                for (const std::atomic<int>& visitCount : visitCounts)
+                    EXPECT_EQ(visitCount, 1) << "count = " << count << ", threadCount = " << threadCount;
+            }
+        }
+    }
+
+    TEST(ParallelFor, reuseJobScheduler)
+    {
+        const std::unique_ptr<IJobScheduler> jobScheduler{ createJobScheduler("Test", 4) };
+
+        std::atomic<std::size_t> sum{};
+        for (std::size_t i{}; i < 100; ++i)
+        {
+            parallelFor(*jobScheduler, 10, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t j{ begin }; j < end; ++j)
+                    sum += j;
+            });
+        }
+
+        EXPECT_EQ(sum, 100 * 45);
+    }
+
+    TEST(ParallelFor, exception)
+    {
+        const std::unique_ptr<IJobScheduler> jobScheduler{ createJobScheduler("Test", 4) };
+
+        EXPECT_THROW(parallelFor(*jobScheduler, 10, [](std::size_t begin, std::size_t) {
+            if (begin == 0)
+                throw std::runtime_error{ "failure" };
+        }),
+                     std::runtime_error);
+    }
+} // namespace lms::core::tests
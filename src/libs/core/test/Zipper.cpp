@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "core/Crc32Calculator.hpp"
+#include "core/IZipper.hpp"
+#include "core/Random.hpp"
+
+namespace lms::zip::tests
+{
+    namespace
+    {
+        class TemporaryFile
+        {
+        public:
+            TemporaryFile(std::size_t size)
+                : _path{ std::filesystem::temp_directory_path() / ("lms-test-zipper-" + std::to_string(core::random::getRandom(0, std::numeric_limits<int>::max()))) }
+            {
+                std::ofstream ofs{ _path, std::ios::binary };
+                for (std::size_t i{}; i < size; ++i)
+                    _content.push_back(static_cast<char>(i * 7));
+                ofs.write(_content.data(), _content.size());
+            }
+            ~TemporaryFile()
+            {
+                std::error_code ec;
+                std::filesystem::remove(_path, ec);
+            }
+            TemporaryFile(const TemporaryFile&) = delete;
+            TemporaryFile& operator=(const TemporaryFile&) = delete;
+
+            const std::filesystem::path& getPath() const { return _path; }
+            const std::string& getContent() const { return _content; }
+
+        private:
+            const std::filesystem::path _path;
+            std::string _content;
+        };
+
+        std::string writeAll(IZipper& zipper)
+        {
+            std::ostringstream oss;
+            while (!zipper.isComplete())
+                zipper.writeSome(oss);
+
+            return oss.str();
+        }
+
+        std::uint32_t read32(std::string_view data, std::size_t offset)
+        {
+            std::uint32_t res{};
+            for (std::size_t i{}; i < 4; ++i)
+                res |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[offset + i])) << (i * 8);
+            return res;
+        }
+
+        std::uint16_t read16(std::string_view data, std::size_t offset)
+        {
+            return static_cast<std::uint16_t>(static_cast<unsigned char>(data[offset]) | (static_cast<unsigned char>(data[offset + 1]) << 8));
+        }
+    } // namespace
+
+    TEST(StoreZipper, empty)
+    {
+        auto zipper{ createStoreZipper({}) };
+        ASSERT_TRUE(zipper->getTotalSize());
+        EXPECT_EQ(*zipper->getTotalSize(), 22);
+
+        const std::string archive{ writeAll(*zipper) };
+        ASSERT_EQ(archive.size(), 22);
+        EXPECT_EQ(read32(archive, 0), 0x06054b50);
+    }
+
+    TEST(StoreZipper, layout)
+    {
+        const TemporaryFile file1{ 1'000'000 };
+        const TemporaryFile file2{ 0 };
+        const TemporaryFile file3{ 1'234 };
+
+        auto zipper{ createStoreZipper({ { "dir/file1.flac", file1.getPath() }, { "file2.flac", file2.getPath() }, { "file3.flac", file3.getPath() } }) };
+        ASSERT_TRUE(zipper->getTotalSize());
+
+        const std::string archive{ writeAll(*zipper) };
+        ASSERT_EQ(archive.size(), *zipper->getTotalSize());
+
+        // first entry: local header immediately followed by the file content
+        EXPECT_EQ(read32(archive, 0), 0x04034b50);
+        EXPECT_EQ(read16(archive, 8), 0); // STORE
+        EXPECT_EQ(read32(archive, 18), file1.getContent().size());
+        EXPECT_EQ(read16(archive, 26), std::string_view{ "dir/file1.flac" }.size());
+        EXPECT_EQ(archive.substr(30, 14), "dir/file1.flac");
+        EXPECT_EQ(archive.substr(44, file1.getContent().size()), file1.getContent());
+
+        core::Crc32Calculator crc;
+        crc.processBytes(reinterpret_cast<const std::byte*>(file1.getContent().data()), file1.getContent().size());
+        EXPECT_EQ(read32(archive, 14), crc.getResult());
+
+        // end of central directory
+        const std::size_t eocdOffset{ archive.size() - 22 };
+        EXPECT_EQ(read32(archive, eocdOffset), 0x06054b50);
+        EXPECT_EQ(read16(archive, eocdOffset + 10), 3);
+        const std::uint32_t centralDirectoryOffset{ read32(archive, eocdOffset + 16) };
+        EXPECT_EQ(read32(archive, centralDirectoryOffset), 0x02014b50);
+        EXPECT_EQ(centralDirectoryOffset + read32(archive, eocdOffset + 12), eocdOffset);
+    }
+
+    TEST(StoreZipper, range)
+    {
+        const TemporaryFile file1{ 500'000 };
+        const TemporaryFile file2{ 300'000 };
+
+        const EntryContainer entries{ { "file1.flac", file1.getPath() }, { "file2.flac", file2.getPath() } };
+        const std::string archive{ writeAll(*createStoreZipper(entries)) };
+
+        struct TestCase
+        {
+            std::uint64_t offset;
+            std::uint64_t endOffset;
+        };
+
+        const TestCase tests[]{
+            { 0, 0 },
+            { 0, 10 },
+            { 10, 500'100 },
+            { 500'030, 500'060 },
+            { 400'000, archive.size() },
+            { archive.size() - 30, archive.size() },
+        };
+
+        for (const TestCase& test : tests)
+        {
+            auto zipper{ createStoreZipper(entries) };
+            zipper->setRange(test.offset, test.endOffset);
+
+            EXPECT_EQ(writeAll(*zipper), archive.substr(test.offset, test.endOffset - test.offset)) << "range = " << test.offset << "-" << test.endOffset;
+        }
+    }
+
+    TEST(StoreZipper, etag)
+    {
+        const TemporaryFile file1{ 1'000 };
+        const TemporaryFile file2{ 2'000 };
+
+        const std::optional<std::string> etag{ createStoreZipper({ { "file1.flac", file1.getPath() }, { "file2.flac", file2.getPath() } })->getETag() };
+        ASSERT_TRUE(etag);
+        EXPECT_FALSE(etag->empty());
+
+        EXPECT_EQ(createStoreZipper({ { "file1.flac", file1.getPath() }, { "file2.flac", file2.getPath() } })->getETag(), etag);
+        EXPECT_NE(createStoreZipper({ { "file2.flac", file2.getPath() }, { "file1.flac", file1.getPath() } })->getETag(), etag);
+        EXPECT_NE(createStoreZipper({ { "other.flac", file1.getPath() }, { "file2.flac", file2.getPath() } })->getETag(), etag);
+
+        std::filesystem::last_write_time(file1.getPath(), std::filesystem::last_write_time(file1.getPath()) - std::chrono::hours{ 1 });
+        EXPECT_NE(createStoreZipper({ { "file1.flac", file1.getPath() }, { "file2.flac", file2.getPath() } })->getETag(), etag);
+    }
+
+    TEST(StoreZipper, modifiedFileCrc)
+    {
+        const TemporaryFile file{ 1'000 };
+        const EntryContainer entries{ { "file.flac", file.getPath() } };
+        const std::string archive{ writeAll(*createStoreZipper(entries)) };
+
+        // same size, but different content and modification time: the CRC computed for the first archive must not be reused
+        {
+            std::ofstream ofs{ file.getPath(), std::ios::binary };
+            const std::string content(1'000, 'a');
+            ofs.write(content.data(), content.size());
+        }
+        std::filesystem::last_write_time(file.getPath(), std::filesystem::last_write_time(file.getPath()) + std::chrono::hours{ 1 });
+
+        const std::string newArchive{ writeAll(*createStoreZipper(entries)) };
+        ASSERT_EQ(newArchive.size(), archive.size());
+
+        core::Crc32Calculator crc;
+        crc.processBytes(reinterpret_cast<const std::byte*>(newArchive.data() + 30 + 9), 1'000);
+        EXPECT_EQ(read32(newArchive, 14), crc.getResult());
+        EXPECT_NE(read32(newArchive, 14), read32(archive, 14));
+    }
+
+    TEST(StoreZipper, fileChanged)
+    {
+        std::optional<TemporaryFile> file{ std::in_place, 1'000 };
+        auto zipper{ createStoreZipper({ { "file.flac", file->getPath() } }) };
+        file.reset();
+
+        EXPECT_THROW(writeAll(*zipper), Exception);
+    }
+
+    TEST(StoreZipper, missingFile)
+    {
+        EXPECT_THROW(createStoreZipper({ { "file.flac", "/this/file/does/not/exist" } }), Exception);
+    }
+} // namespace lms::zip::tests
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FeatureValuesEncoding.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "core/ILogger.hpp"
+
+namespace lms::db::featureValuesEncoding
+{
+    namespace
+    {
+        constexpr unsigned char formatVersion{ 1 };
+
+        class Writer
+        {
+        public:
+            void writeFeature(std::string_view name, std::span<const double> values)
+            {
+                if (name.size() > std::numeric_limits<std::uint16_t>::max() || values.size() > std::numeric_limits<std::uint32_t>::max())
+                    return;
+
+                write(static_cast<std::uint16_t>(name.size()));
+                _buffer.insert(std::end(_buffer), std::cbegin(name), std::cend(name));
+                write(static_cast<std::uint32_t>(values.size()));
+                for (const double value : values)
+                    write(value);
+            }
+
+            std::vector<unsigned char> release()
+            {
+                return std::move(_buffer);
+            }
+
+        private:
+            template<typename T>
+            void write(T value)
+            {
+                unsigned char bytes[sizeof(T)];
+                std::memcpy(bytes, &value, sizeof(T));
+                _buffer.insert(std::end(_buffer), std::cbegin(bytes), std::cend(bytes));
+            }
+
+            std::vector<unsigned char> _buffer{ formatVersion };
+        };
+
+        class Reader
+        {
+        public:
+            Reader(std::span<const unsigned char> buffer)
+                : _buffer{ buffer } {}
+
+            bool isEndReached() const { return _offset == _buffer.size(); }
+
+            template<typename T>
+            bool read(T& value)
+            {
+                if (_buffer.size() - _offset < sizeof(T))
+                    return false;
+
+                std::memcpy(&value, _buffer.data() + _offset, sizeof(T));
+                _offset += sizeof(T);
+                return true;
+            }
+
+            bool read(std::size_t size, std::span<const unsigned char>& bytes)
+            {
+                if (_buffer.size() - _offset < size)
+                    return false;
+
+                bytes = _buffer.subspan(_offset, size);
+                _offset += size;
+                return true;
+            }
+
+        private:
+            std::span<const unsigned char> _buffer;
+            std::size_t _offset{};
+        };
+
+        bool getNumericValue(const boost::property_tree::ptree& node, double& value)
+        {
+            if (!node.empty())
+                return false;
+
+            const boost::optional<double> res{ node.get_value_optional<double>() };
+            if (!res)
+                return false;
+
+            value = *res;
+            return true;
+        }
+
+        void extractFeatures(const boost::property_tree::ptree& node, const std::string& name, Writer& writer, std::vector<double>& values)
+        {
+            values.clear();
+
+            double value;
+            if (getNumericValue(node, value))
+            {
+                values.push_back(value);
+                writer.writeFeature(name, values);
+                return;
+            }
+
+            // Arrays of scalars
+            const bool isArray{ !node.empty() && std::all_of(std::cbegin(node), std::cend(node), [](const auto& child) { return child.first.empty(); }) };
+            if (isArray)
+            {
+                for (const auto& [childName, child] : node)
+                {
+                    if (!getNumericValue(child, value))
+                        return; // not supported (arrays of arrays, etc.)
+
+                    values.push_back(value);
+                }
+
+                writer.writeFeature(name, values);
+                return;
+            }
+
+            for (const auto& [childName, child] : node)
+                extractFeatures(child, name.empty() ? childName : name + "." + childName, writer, values);
+        }
+    } // namespace
+
+    std::vector<unsigned char> encode(std::string_view jsonEncodedFeatures)
+    {
+        Writer writer;
+
+        try
+        {
+            std::istringstream iss{ std::string{ jsonEncodedFeatures } };
+            boost::property_tree::ptree root;
+            boost::property_tree::read_json(iss, root);
+
+            std::vector<double> values;
+            extractFeatures(root, "", writer, values);
+        }
+        catch (const boost::property_tree::ptree_error& error)
+        {
+            LMS_LOG(DB, ERROR, "Cannot extract features: ptree exception: " << error.what());
+            return {};
+        }
+
+        return writer.release();
+    }
+
+    bool decode(std::span<const unsigned char> encodedFeatureValues, const std::unordered_set<FeatureName>& featureNames, FeatureValuesMap& featureValuesMap)
+    {
+        Reader reader{ encodedFeatureValues };
+
+        unsigned char version;
+        if (!reader.read(version) || version != formatVersion)
+            return false;
+
+        std::size_t foundFeatureCount{};
+        while (!reader.isEndReached() && foundFeatureCount < featureNames.size())
+        {
+            std::uint16_t nameSize;
+            std::span<const unsigned char> name;
+            std::uint32_t valueCount;
+            std::span<const unsigned char> values;
+            if (!reader.read(nameSize)
+                || !reader.read(nameSize, name)
+                || !reader.read(valueCount)
+                || !reader.read(static_cast<std::size_t>(valueCount) * sizeof(double), values))
+            {
+                return false;
+            }
+
+            const std::string_view featureName{ reinterpret_cast<const char*>(name.data()), name.size() };
+            const auto itFeatureName{ std::find_if(std::cbegin(featureNames), std::cend(featureNames), [&](const FeatureName& requestedName) { return requestedName == featureName; }) };
+            if (itFeatureName == std::cend(featureNames))
+                continue;
+
+            FeatureValues& featureValues{ featureValuesMap[*itFeatureName] };
+            featureValues.resize(valueCount);
+            std::memcpy(featureValues.data(), values.data(), values.size());
+
+            foundFeatureCount++;
+        }
+
+        return foundFeatureCount == featureNames.size();
+    }
+} // namespace lms::db::featureValuesEncoding
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <span>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "database/objects/TrackFeatures.hpp"
+
+namespace lms::db::featureValuesEncoding
+{
+    // Extracts all the numeric features (scalars and arrays of scalars) from json encoded features, using their full path as name
+    // Encoded format: a version byte, then for each feature: name size (u16), name, value count (u32), values (double), using native byte order
+    std::vector<unsigned char> encode(std::string_view jsonEncodedFeatures);
+
+    // Only decodes the requested features, returns false if at least one of them is missing
+    bool decode(std::span<const unsigned char> encodedFeatureValues, const std::unordered_set<FeatureName>& featureNames, FeatureValuesMap& featureValuesMap);
+} // namespace lms::db::featureValuesEncoding
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ListenStats.hpp"
+
+#include <Wt/Dbo/Session.h>
+
+#include "Utils.hpp"
+
+namespace lms::db::listenStats
+{
+    void createTableAndTriggers(Wt::Dbo::Session& session)
+    {
+        utils::executeCommand(session, R"(CREATE TABLE IF NOT EXISTS "listen_track_stats" (
+  "user_id" bigint not null,
+  "backend" integer not null,
+  "track_id" bigint not null,
+  "listen_count" integer not null,
+  "last_listened_date_time" text not null,
+  primary key ("user_id", "backend", "track_id")) WITHOUT ROWID)");
+
+        utils::executeCommand(session, R"(CREATE TRIGGER IF NOT EXISTS listen_track_stats_on_insert AFTER INSERT ON listen
+WHEN NEW.user_id IS NOT NULL AND NEW.track_id IS NOT NULL
+BEGIN
+  INSERT INTO listen_track_stats (user_id, backend, track_id, listen_count, last_listened_date_time) VALUES (NEW.user_id, NEW.backend, NEW.track_id, 1, NEW.date_time)
+    ON CONFLICT (user_id, backend, track_id) DO UPDATE SET listen_count = listen_count + 1, last_listened_date_time = MAX(last_listened_date_time, excluded.last_listened_date_time);
+END)");
+
+        utils::executeCommand(session, R"(CREATE TRIGGER IF NOT EXISTS listen_track_stats_on_delete AFTER DELETE ON listen
+WHEN OLD.user_id IS NOT NULL AND OLD.track_id IS NOT NULL
+BEGIN
+  UPDATE listen_track_stats SET listen_count = listen_count - 1,
+    last_listened_date_time = IFNULL((SELECT MAX(l.date_time) FROM listen l WHERE l.user_id = OLD.user_id AND l.track_id = OLD.track_id AND l.backend = OLD.backend), last_listened_date_time)
+    WHERE user_id = OLD.user_id AND backend = OLD.backend AND track_id = OLD.track_id;
+  DELETE FROM listen_track_stats WHERE user_id = OLD.user_id AND backend = OLD.backend AND track_id = OLD.track_id AND listen_count <= 0;
+END)");
+
+        // Dbo rewrites all the fields on each update (sync state changes): only react to actual changes
+        utils::executeCommand(session, R"(CREATE TRIGGER IF NOT EXISTS listen_track_stats_on_update AFTER UPDATE OF user_id, backend, track_id, date_time ON listen
+WHEN OLD.user_id IS NOT NEW.user_id OR OLD.backend IS NOT NEW.backend OR OLD.track_id IS NOT NEW.track_id OR OLD.date_time IS NOT NEW.date_time
+BEGIN
+  UPDATE listen_track_stats SET listen_count = listen_count - 1,
+    last_listened_date_time = IFNULL((SELECT MAX(l.date_time) FROM listen l WHERE l.user_id = OLD.user_id AND l.track_id = OLD.track_id AND l.backend = OLD.backend), last_listened_date_time)
+    WHERE user_id = OLD.user_id AND backend = OLD.backend AND track_id = OLD.track_id;
+  DELETE FROM listen_track_stats WHERE user_id = OLD.user_id AND backend = OLD.backend AND track_id = OLD.track_id AND listen_count <= 0;
+  INSERT INTO listen_track_stats (user_id, backend, track_id, listen_count, last_listened_date_time) SELECT NEW.user_id, NEW.backend, NEW.track_id, 1, NEW.date_time WHERE NEW.user_id IS NOT NULL AND NEW.track_id IS NOT NULL
+    ON CONFLICT (user_id, backend, track_id) DO UPDATE SET listen_count = listen_count + 1, last_listened_date_time = MAX(last_listened_date_time, excluded.last_listened_date_time);
+END)");
+    }
+
+    void rebuild(Wt::Dbo::Session& session)
+    {
+        utils::executeCommand(session, "DELETE FROM listen_track_stats");
+        utils::executeCommand(session, "INSERT INTO listen_track_stats (user_id, backend, track_id, listen_count, last_listened_date_time)"
+                                       " SELECT user_id, backend, track_id, COUNT(*), MAX(date_time) FROM listen"
+                                       " WHERE user_id IS NOT NULL AND track_id IS NOT NULL"
+                                       " GROUP BY user_id, backend, track_id");
+    }
+} // namespace lms::db::listenStats
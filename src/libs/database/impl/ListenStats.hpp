@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace Wt::Dbo
+{
+    class Session;
+}
+
+namespace lms::db::listenStats
+{
+    // Per user/backend/track listen count and last listen date time, kept up to date by triggers on the listen table
+    // (listens are also deleted by cascade when tracks or users are removed)
+    // Release and artist stats are aggregated from this table, since the tracks of a release/artist change on each scan
+    void createTableAndTriggers(Wt::Dbo::Session& session);
+
+    // Recomputes everything from the listen table
+    void rebuild(Wt::Dbo::Session& session);
+} // namespace lms::db::listenStats
@@ -28,13 +28,15 @@
 #include "database/objects/ScanSettings.hpp"
 
 #include "Db.hpp"
+#include "FeatureValuesEncoding.hpp"
+#include "ListenStats.hpp"
 #include "Utils.hpp"
 
 namespace lms::db
 {
     namespace
     {
-        static constexpr Version LMS_DATABASE_VERSION{ 100 };
+        static constexpr Version LMS_DATABASE_VERSION{ 102 };
     }
 
     VersionInfo::VersionInfo()
@@ -1581,6 +1583,34 @@ FROM track)");
   constraint "fk_podcast_episode_podcast" foreign key ("podcast_id") references "podcast" ("id") on delete cascade deferrable initially deferred))");
     }
 
+    void migrateFromV100(Session& session)
+    {
+        // Extract the numeric features once, in a compact binary form
+        utils::executeCommand(*session.getDboSession(), "ALTER TABLE track_features ADD COLUMN feature_values BLOB NOT NULL DEFAULT x''");
+
+        long long lastRetrievedId{};
+        bool endReached{};
+        while (!endReached)
+        {
+            constexpr std::size_t batchSize{ 100 };
+            const auto trackFeatures{ utils::fetchQueryResults(session.getDboSession()->query<std::tuple<long long, std::string>>("SELECT id, data FROM track_features").where("id > ?").bind(lastRetrievedId).orderBy("id").limit(static_cast<int>(batchSize))) };
+            for (const auto& [id, data] : trackFeatures)
+            {
+                utils::executeCommand(*session.getDboSession(), "UPDATE track_features SET feature_values = ? WHERE id = ?", featureValuesEncoding::encode(data), id);
+                lastRetrievedId = id;
+            }
+
+            endReached = trackFeatures.size() < batchSize;
+        }
+    }
+
+    void migrateFromV101(Session& session)
+    {
+        // Materialized listen stats, backfilled from the existing listens
+        listenStats::createTableAndTriggers(*session.getDboSession());
+        listenStats::rebuild(*session.getDboSession());
+    }
+
     bool doDbMigration(Session& session)
     {
         constexpr std::string_view outdatedMsg{ "Outdated database, please rebuild it (delete the .db file and restart)" };
@@ -1657,6 +1687,8 @@ FROM track)");
             { 97, migrateFromV97 },
             { 98, migrateFromV98 },
             { 99, migrateFromV99 },
+            { 100, migrateFromV100 },
+            { 101, migrateFromV101 },
         };
 
         bool migrationPerformed{};
@@ -58,6 +58,7 @@
 #include "database/objects/User.hpp"
 
 #include "Db.hpp"
+#include "ListenStats.hpp"
 #include "Migration.hpp"
 #include "TransactionChecker.hpp"
 #include "Utils.hpp"
@@ -150,6 +151,7 @@ namespace lms::db
         {
             auto transaction{ createWriteTransaction() };
             _session.createTables();
+            listenStats::createTableAndTriggers(_session);
             LMS_LOG(DB, INFO, "Tables created");
         }
         catch (Wt::Dbo::Exception& e)
@@ -238,6 +240,8 @@ namespace lms::db
             utils::executeCommand(_session, "CREATE INDEX IF NOT EXISTS listen_user_backend_date_time_idx ON listen(user_id, backend, date_time DESC)");
             utils::executeCommand(_session, "CREATE INDEX IF NOT EXISTS listen_track_user_backend_idx ON listen(track_id,user_id,backend)");
             utils::executeCommand(_session, "CREATE INDEX IF NOT EXISTS listen_user_track_backend_date_time_idx ON listen(user_id,track_id,backend,date_time)");
+            utils::executeCommand(_session, "CREATE INDEX IF NOT EXISTS listen_track_stats_track_idx ON listen_track_stats(track_id)");
+            utils::executeCommand(_session, "CREATE INDEX IF NOT EXISTS listen_track_stats_user_backend_date_time_idx ON listen_track_stats(user_id, backend, last_listened_date_time DESC)");
 
             utils::executeCommand(_session, "CREATE INDEX IF NOT EXISTS media_library_id_idx ON media_library(id)");
 
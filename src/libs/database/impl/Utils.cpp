@@ -33,4 +33,17 @@ namespace lms::db::utils
         // force second resolution
         return Wt::WDateTime::fromTime_t(dateTime.toTime_t());
     }
+
+    std::size_t deleteByIdsQuery(Wt::Dbo::Session& session, std::string_view table, std::string_view idsQuery, std::size_t maxCount)
+    {
+        std::string command{ "DELETE FROM " };
+        command += table;
+        command += " WHERE id IN (";
+        command += idsQuery;
+        command += " LIMIT ?)";
+
+        executeCommand(session, command, static_cast<long long>(maxCount));
+
+        return static_cast<std::size_t>(fetchQuerySingleResult(session.query<int>("SELECT changes()")));
+    }
 } // namespace lms::db::utils
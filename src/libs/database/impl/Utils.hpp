@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -164,6 +165,24 @@ namespace lms::db::utils
         return res;
     }
 
+    // Splits values so that each chunk can be bound as a reasonably sized "IN (...)" list
+    // func(std::span<const T> chunk, std::string_view placeholders), placeholders being "?, ?, ..." for this chunk
+    template<typename T, typename Func>
+    void forEachInListChunk(std::span<const T> values, Func&& func)
+    {
+        constexpr std::size_t maxValueCountPerQuery{ 500 };
+        for (std::size_t offset{}; offset < values.size(); offset += maxValueCountPerQuery)
+        {
+            const std::span<const T> chunk{ values.subspan(offset, std::min(maxValueCountPerQuery, values.size() - offset)) };
+
+            std::string placeholders;
+            for (std::size_t i{}; i < chunk.size(); ++i)
+                placeholders += (i == 0 ? "?" : ", ?");
+
+            func(chunk, std::string_view{ placeholders });
+        }
+    }
+
     template<typename Query, typename UnaryFunc>
     void forEachQueryRangeResult(Query& query, std::optional<Range> range, UnaryFunc&& func)
     {
@@ -210,4 +229,8 @@ namespace lms::db::utils
             call.run();
         }
     }
+
+    // Deletes at most maxCount rows of the table, among the ones whose ids are selected by idsQuery
+    // Returns the number of deleted rows
+    std::size_t deleteByIdsQuery(Wt::Dbo::Session& session, std::string_view table, std::string_view idsQuery, std::size_t maxCount);
 } // namespace lms::db::utils
\ No newline at end of file
@@ -205,6 +205,19 @@ namespace lms::db
 
             return createQuery<ResultType>(session, itemToSelect, params);
         }
+
+        constexpr std::string_view orphanIdsQuery{ R"(SELECT DISTINCT a.id FROM artist a 
+WHERE NOT EXISTS (
+    SELECT 1 
+    FROM track t 
+    INNER JOIN track_artist_link t_a_l 
+    ON t_a_l.artist_id = a.id 
+    WHERE t.id = t_a_l.track_id
+)
+AND NOT EXISTS (
+    SELECT 1 
+    FROM artist_info ai 
+    WHERE ai.artist_id = a.id))" };
     } // namespace
 
     Artist::Artist(const std::string& name, const std::optional<core::UUID>& mbid)
@@ -313,21 +326,17 @@ namespace lms::db
     RangeResults<ArtistId> Artist::findOrphanIds(Session& session, std::optional<Range> range)
     {
         session.checkReadTransaction();
-        auto query{ session.getDboSession()->query<ArtistId>(R"(SELECT DISTINCT a.id FROM artist a 
-WHERE NOT EXISTS (
-    SELECT 1 
-    FROM track t 
-    INNER JOIN track_artist_link t_a_l 
-    ON t_a_l.artist_id = a.id 
-    WHERE t.id = t_a_l.track_id
-)
-AND NOT EXISTS (
-    SELECT 1 
-    FROM artist_info ai 
-    WHERE ai.artist_id = a.id))") };
+        auto query{ session.getDboSession()->query<ArtistId>(std::string{ orphanIdsQuery }) };
         return utils::execRangeQuery<ArtistId>(query, range);
     }
 
+    std::size_t Artist::removeOrphans(Session& session, std::size_t maxCount)
+    {
+        session.checkWriteTransaction();
+
+        return utils::deleteByIdsQuery(*session.getDboSession(), session.getDboSession()->tableName<Artist>(), orphanIdsQuery, maxCount);
+    }
+
     bool Artist::exists(Session& session, ArtistId id)
     {
         session.checkReadTransaction();
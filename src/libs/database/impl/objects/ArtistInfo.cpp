@@ -76,6 +76,16 @@ namespace lms::db
         find(session, id, std::nullopt, func);
     }
 
+    void ArtistInfo::find(Session& session, DirectoryId id, const std::function<void(const pointer&)>& func)
+    {
+        session.checkReadTransaction();
+
+        auto query{ session.getDboSession()->query<Wt::Dbo::ptr<ArtistInfo>>("SELECT a_i from artist_info a_i").where("a_i.directory_id = ?").bind(id) };
+        utils::forEachQueryResult(query, [&](const ArtistInfo::pointer& entry) {
+            func(entry);
+        });
+    }
+
     void ArtistInfo::find(Session& session, ArtistInfoId& lastRetrievedId, std::size_t count, const std::function<void(const pointer&)>& func)
     {
         session.checkReadTransaction();
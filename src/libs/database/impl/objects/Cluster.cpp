@@ -45,6 +45,20 @@ namespace lms::db
 {
     namespace
     {
+        // Only the clusters whose counts changed are written
+        std::string createUpdateStatsCommand(std::string_view clusterFilter)
+        {
+            return R"(UPDATE cluster SET track_count = stats.track_count, release_count = stats.release_count
+FROM (SELECT c.id AS cluster_id, COUNT(t.id) AS track_count, COUNT(DISTINCT t.release_id) AS release_count
+    FROM cluster c
+    LEFT JOIN track_cluster t_c ON t_c.cluster_id = c.id
+    LEFT JOIN track t ON t.id = t_c.track_id
+    )" + std::string{ clusterFilter }
+                   + R"(
+    GROUP BY c.id) AS stats
+WHERE cluster.id = stats.cluster_id AND (cluster.track_count <> stats.track_count OR cluster.release_count <> stats.release_count))";
+        }
+
         template<typename ResultType>
         Wt::Dbo::Query<ResultType> createQuery(Session& session, std::string_view itemToSelect, const Cluster::FindParameters& params)
         {
@@ -102,6 +116,10 @@ namespace lms::db
 
             return createQuery<ResultType>(session, itemToSelect, params);
         }
+
+        constexpr std::string_view orphanClusterIdsQuery{ "SELECT DISTINCT c.id FROM cluster c WHERE NOT EXISTS(SELECT 1 FROM track_cluster t_c WHERE t_c.cluster_id = c.id)" };
+
+        constexpr std::string_view orphanClusterTypeIdsQuery{ "SELECT c_t.id FROM cluster_type c_t LEFT OUTER JOIN cluster c ON c_t.id = c.cluster_type_id WHERE c.id IS NULL" };
     } // namespace
 
     Cluster::Cluster(ObjectPtr<ClusterType> type, std::string_view name)
@@ -152,11 +170,18 @@ namespace lms::db
     RangeResults<ClusterId> Cluster::findOrphanIds(Session& session, std::optional<Range> range)
     {
         session.checkReadTransaction();
-        auto query{ session.getDboSession()->query<ClusterId>("SELECT DISTINCT c.id FROM cluster c WHERE NOT EXISTS(SELECT 1 FROM track_cluster t_c WHERE t_c.cluster_id = c.id)") };
+        auto query{ session.getDboSession()->query<ClusterId>(std::string{ orphanClusterIdsQuery }) };
 
         return utils::execRangeQuery<ClusterId>(query, range);
     }
 
+    std::size_t Cluster::removeOrphans(Session& session, std::size_t maxCount)
+    {
+        session.checkWriteTransaction();
+
+        return utils::deleteByIdsQuery(*session.getDboSession(), session.getDboSession()->tableName<Cluster>(), orphanClusterIdsQuery, maxCount);
+    }
+
     Cluster::pointer Cluster::find(Session& session, ClusterId id)
     {
         session.checkReadTransaction();
@@ -178,6 +203,26 @@ namespace lms::db
         return utils::fetchQuerySingleResult(session.getDboSession()->query<int>("SELECT COUNT(DISTINCT t.release_id) FROM track t INNER JOIN track_cluster t_c ON t_c.track_id = t.id").where("t_c.cluster_id = ?").bind(id));
     }
 
+    void Cluster::updateStats(Session& session)
+    {
+        session.checkWriteTransaction();
+
+        utils::executeCommand(*session.getDboSession(), createUpdateStatsCommand(""));
+    }
+
+    void Cluster::updateStats(Session& session, std::span<const ClusterId> clusterIds)
+    {
+        session.checkWriteTransaction();
+
+        utils::forEachInListChunk(clusterIds, [&](std::span<const ClusterId> chunk, std::string_view placeholders) {
+            Wt::Dbo::Call call{ session.getDboSession()->execute(createUpdateStatsCommand("WHERE c.id IN (" + std::string{ placeholders } + ")")) };
+            for (const ClusterId id : chunk)
+                call.bind(id);
+
+            call.run();
+        });
+    }
+
     void Cluster::addTrack(ObjectPtr<Track> track)
     {
         _tracks.insert(getDboPtr(track));
@@ -216,14 +261,18 @@ namespace lms::db
     {
         session.checkReadTransaction();
 
-        auto query{ session.getDboSession()->query<ClusterTypeId>(
-                                               "SELECT c_t.id from cluster_type c_t"
-                                               " LEFT OUTER JOIN cluster c ON c_t.id = c.cluster_type_id")
-                        .where("c.id IS NULL") };
+        auto query{ session.getDboSession()->query<ClusterTypeId>(std::string{ orphanClusterTypeIdsQuery }) };
 
         return utils::execRangeQuery<ClusterTypeId>(query, range);
     }
 
+    std::size_t ClusterType::removeOrphans(Session& session, std::size_t maxCount)
+    {
+        session.checkWriteTransaction();
+
+        return utils::deleteByIdsQuery(*session.getDboSession(), session.getDboSession()->tableName<ClusterType>(), orphanClusterTypeIdsQuery, maxCount);
+    }
+
     RangeResults<ClusterTypeId> ClusterType::findUsed(Session& session, std::optional<Range> range)
     {
         session.checkReadTransaction();
@@ -115,6 +115,20 @@ namespace lms::db
 
             return std::filesystem::path{ pathStr };
         }
+
+        constexpr std::string_view orphanIdsQuery{ "SELECT d.id FROM directory d"
+                                                   " LEFT JOIN directory d_child ON d.id = d_child.parent_directory_id"
+                                                   " LEFT JOIN track t ON d.id = t.directory_id"
+                                                   " LEFT JOIN image i ON d.id = i.directory_id"
+                                                   " LEFT JOIN track_lyrics l_lrc ON d.id = l_lrc.directory_id"
+                                                   " LEFT JOIN playlist_file pl_f ON d.id = pl_f.directory_id"
+                                                   " LEFT JOIN artist_info a_i ON d.id = a_i.directory_id"
+                                                   " WHERE d_child.id IS NULL"
+                                                   " AND t.directory_id IS NULL"
+                                                   " AND i.directory_id IS NULL"
+                                                   " AND l_lrc.directory_id IS NULL"
+                                                   " AND pl_f.directory_id IS NULL"
+                                                   " AND a_i.directory_id IS NULL" };
     } // namespace
 
     Directory::Directory(const std::filesystem::path& p)
@@ -178,23 +192,18 @@ namespace lms::db
     {
         session.checkReadTransaction();
 
-        auto query{ session.getDboSession()->query<DirectoryId>("SELECT d.id FROM directory d") };
-        query.leftJoin("directory d_child ON d.id = d_child.parent_directory_id");
-        query.leftJoin("track t ON d.id = t.directory_id");
-        query.leftJoin("image i ON d.id = i.directory_id");
-        query.leftJoin("track_lyrics l_lrc ON d.id = l_lrc.directory_id");
-        query.leftJoin("playlist_file pl_f ON d.id = pl_f.directory_id");
-        query.leftJoin("artist_info a_i ON d.id = a_i.directory_id");
-        query.where("d_child.id IS NULL");
-        query.where("t.directory_id IS NULL");
-        query.where("i.directory_id IS NULL");
-        query.where("l_lrc.directory_id IS NULL");
-        query.where("pl_f.directory_id IS NULL");
-        query.where("a_i.directory_id IS NULL");
+        auto query{ session.getDboSession()->query<DirectoryId>(std::string{ orphanIdsQuery }) };
 
         return utils::execRangeQuery<DirectoryId>(query, range);
     }
 
+    std::size_t Directory::removeOrphans(Session& session, std::size_t maxCount)
+    {
+        session.checkWriteTransaction();
+
+        return utils::deleteByIdsQuery(*session.getDboSession(), session.getDboSession()->tableName<Directory>(), orphanIdsQuery, maxCount);
+    }
+
     RangeResults<DirectoryId> Directory::findMismatchedLibrary(Session& session, std::optional<Range> range, const std::filesystem::path& rootPath, MediaLibraryId expectedLibraryId)
     {
         session.checkReadTransaction();
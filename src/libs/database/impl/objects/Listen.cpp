@@ -38,7 +38,7 @@ namespace lms::db
     {
         Wt::Dbo::Query<ArtistId> createArtistsQuery(Session& session, const Listen::ArtistStatsFindParameters& params)
         {
-            auto query{ session.getDboSession()->query<ArtistId>("SELECT a.id from artist a").join("track_artist_link t_a_l ON t_a_l.artist_id = a.id").join("listen l ON l.track_id = t_a_l.track_id") };
+            auto query{ session.getDboSession()->query<ArtistId>("SELECT a.id from artist a").join("track_artist_link t_a_l ON t_a_l.artist_id = a.id").join("listen_track_stats l ON l.track_id = t_a_l.track_id") };
 
             if (params.user.isValid())
                 query.where("l.user_id = ?").bind(params.user);
@@ -117,7 +117,7 @@ namespace lms::db
 
         Wt::Dbo::Query<ReleaseId> createReleasesQuery(Session& session, const Listen::StatsFindParameters& params)
         {
-            auto query{ session.getDboSession()->query<ReleaseId>("SELECT r.id from release r").join("track t ON t.release_id = r.id").join("listen l ON l.track_id = t.id") };
+            auto query{ session.getDboSession()->query<ReleaseId>("SELECT r.id from release r").join("track t ON t.release_id = r.id").join("listen_track_stats l ON l.track_id = t.id") };
 
             if (params.user.isValid())
                 query.where("l.user_id = ?").bind(params.user);
@@ -176,7 +176,7 @@ namespace lms::db
 
         Wt::Dbo::Query<TrackId> createTracksQuery(Session& session, const Listen::StatsFindParameters& params)
         {
-            auto query{ session.getDboSession()->query<TrackId>("SELECT t.id from track t").join("listen l ON l.track_id = t.id") };
+            auto query{ session.getDboSession()->query<TrackId>("SELECT t.id from track t").join("listen_track_stats l ON l.track_id = t.id") };
 
             if (params.user.isValid())
                 query.where("l.user_id = ?").bind(params.user);
@@ -284,13 +284,41 @@ namespace lms::db
         return utils::fetchQuerySingleResult(session.getDboSession()->find<Listen>().where("user_id = ?").bind(userId).where("track_id = ?").bind(trackId).where("backend = ?").bind(backend).where("date_time = ?").bind(Wt::WDateTime::fromTime_t(dateTime.toTime_t())));
     }
 
+    void Listen::find(Session& session, UserId userId, ScrobblingBackend backend, std::span<const Wt::WDateTime> dateTimes, const std::function<void(const pointer&)>& func)
+    {
+        session.checkReadTransaction();
+
+        utils::forEachInListChunk(dateTimes, [&](std::span<const Wt::WDateTime> chunk, std::string_view placeholders) {
+            auto query{ session.getDboSession()->query<Wt::Dbo::ptr<Listen>>("SELECT l FROM listen l").where("l.user_id = ?").bind(userId).where("l.backend = ?").bind(backend).where("l.date_time IN (" + std::string{ placeholders } + ")") };
+            for (const Wt::WDateTime& dateTime : chunk)
+                query.bind(Wt::WDateTime::fromTime_t(dateTime.toTime_t()));
+
+            utils::forEachQueryResult(query, [&](const pointer& listen) { func(listen); });
+        });
+    }
+
+    void Listen::getTrackStats(Session& session, UserId userId, ScrobblingBackend backend, std::span<const TrackId> trackIds, const std::function<void(TrackId trackId, std::size_t listenCount, const Wt::WDateTime& lastListenDateTime)>& func)
+    {
+        session.checkReadTransaction();
+
+        utils::forEachInListChunk(trackIds, [&](std::span<const TrackId> chunk, std::string_view placeholders) {
+            auto query{ session.getDboSession()->query<std::tuple<TrackId, int, Wt::WDateTime>>("SELECT l.track_id, l.listen_count, l.last_listened_date_time FROM listen_track_stats l").where("l.user_id = ?").bind(userId).where("l.backend = ?").bind(backend).where("l.track_id IN (" + std::string{ placeholders } + ")") };
+            for (const TrackId trackId : chunk)
+                query.bind(trackId);
+
+            utils::forEachQueryResult(query, [&](const std::tuple<TrackId, int, Wt::WDateTime>& res) {
+                func(std::get<0>(res), static_cast<std::size_t>(std::get<1>(res)), std::get<2>(res));
+            });
+        });
+    }
+
     RangeResults<ArtistId> Listen::getTopArtists(Session& session, const ArtistStatsFindParameters& params)
     {
         session.checkReadTransaction();
         auto query{ createArtistsQuery(session, params) };
 
         auto collection{ query
-                             .orderBy("COUNT(a.id) DESC")
+                             .orderBy("SUM(l.listen_count) DESC")
                              .groupBy("a.id") };
 
         return utils::execRangeQuery<ArtistId>(query, params.range);
@@ -300,7 +328,7 @@ namespace lms::db
     {
         session.checkReadTransaction();
         auto query{ createReleasesQuery(session, params)
-                        .orderBy("COUNT(r.id) DESC")
+                        .orderBy("SUM(l.listen_count) DESC")
                         .groupBy("r.id") };
 
         return utils::execRangeQuery<ReleaseId>(query, params.range);
@@ -310,7 +338,7 @@ namespace lms::db
     {
         session.checkReadTransaction();
         auto query{ createTracksQuery(session, params)
-                        .orderBy("COUNT(t.id) DESC")
+                        .orderBy("SUM(l.listen_count) DESC")
                         .groupBy("t.id") };
 
         return utils::execRangeQuery<TrackId>(query, params.range);
@@ -321,8 +349,7 @@ namespace lms::db
         session.checkReadTransaction();
         auto query{ createArtistsQuery(session, params)
                         .groupBy("a.id")
-                        .having("l.date_time = MAX(l.date_time)")
-                        .orderBy("l.date_time DESC") };
+                        .orderBy("MAX(l.last_listened_date_time) DESC") };
 
         return utils::execRangeQuery<ArtistId>(query, params.range);
     }
@@ -332,8 +359,7 @@ namespace lms::db
         session.checkReadTransaction();
         auto query{ createReleasesQuery(session, params)
                         .groupBy("r.id")
-                        .having("l.date_time = MAX(l.date_time)")
-                        .orderBy("l.date_time DESC") };
+                        .orderBy("MAX(l.last_listened_date_time) DESC") };
 
         return utils::execRangeQuery<ReleaseId>(query, params.range);
     }
@@ -343,8 +369,7 @@ namespace lms::db
         session.checkReadTransaction();
         auto query{ createTracksQuery(session, params)
                         .groupBy("t.id")
-                        .having("l.date_time = MAX(l.date_time)")
-                        .orderBy("l.date_time DESC") };
+                        .orderBy("MAX(l.last_listened_date_time) DESC") };
 
         return utils::execRangeQuery<TrackId>(query, params.range);
     }
@@ -353,7 +378,7 @@ namespace lms::db
     {
         session.checkReadTransaction();
 
-        return utils::fetchQuerySingleResult(session.getDboSession()->query<int>("SELECT COUNT(*) from listen l").join("user u ON u.id = l.user_id").where("l.track_id = ?").bind(trackId).where("l.user_id = ?").bind(userId).where("l.backend = u.scrobbling_backend"));
+        return utils::fetchQuerySingleResult(session.getDboSession()->query<int>("SELECT IFNULL(SUM(l.listen_count), 0) from listen_track_stats l").join("user u ON u.id = l.user_id").where("l.track_id = ?").bind(trackId).where("l.user_id = ?").bind(userId).where("l.backend = u.scrobbling_backend"));
     }
 
     std::size_t Listen::getCount(Session& session, UserId userId, ReleaseId releaseId)
@@ -363,11 +388,10 @@ namespace lms::db
         return utils::fetchQuerySingleResult(session.getDboSession()->query<int>(
                                                                         "SELECT IFNULL(MIN(count_result), 0)"
                                                                         " FROM ("
-                                                                        " SELECT COUNT(l.track_id) AS count_result"
+                                                                        " SELECT IFNULL(l.listen_count, 0) AS count_result"
                                                                         " FROM track t"
-                                                                        " LEFT JOIN listen l ON t.id = l.track_id AND l.backend = (SELECT scrobbling_backend FROM user WHERE id = ?) AND l.user_id = ?"
-                                                                        " WHERE t.release_id = ?"
-                                                                        " GROUP BY t.id)")
+                                                                        " LEFT JOIN listen_track_stats l ON t.id = l.track_id AND l.backend = (SELECT scrobbling_backend FROM user WHERE id = ?) AND l.user_id = ?"
+                                                                        " WHERE t.release_id = ?)")
                                                  .bind(userId)
                                                  .bind(userId)
                                                  .bind(releaseId));
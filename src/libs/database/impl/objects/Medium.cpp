@@ -41,6 +41,11 @@ DBO_INSTANTIATE_TEMPLATES(lms::db::Medium);
 
 namespace lms::db
 {
+    namespace
+    {
+        constexpr std::string_view orphanIdsQuery{ "SELECT m.id FROM medium m LEFT OUTER JOIN track t ON m.id = t.medium_id WHERE t.id IS NULL" };
+    } // namespace
+
     Medium::Medium(ObjectPtr<Release> release)
         : _release(getDboPtr(release))
     {
@@ -111,10 +116,17 @@ namespace lms::db
         session.checkReadTransaction();
 
         // select the mediums that have no track
-        auto query{ session.getDboSession()->query<MediumId>("select m.id from medium m LEFT OUTER JOIN track t ON m.id = t.medium_id WHERE t.id IS NULL") };
+        auto query{ session.getDboSession()->query<MediumId>(std::string{ orphanIdsQuery }) };
         return utils::execRangeQuery<MediumId>(query, range);
     }
 
+    std::size_t Medium::removeOrphans(Session& session, std::size_t maxCount)
+    {
+        session.checkWriteTransaction();
+
+        return utils::deleteByIdsQuery(*session.getDboSession(), session.getDboSession()->tableName<Medium>(), orphanIdsQuery, maxCount);
+    }
+
     void Medium::updatePreferredArtwork(Session& session, MediumId mediumId, ArtworkId artworkId)
     {
         session.checkWriteTransaction();
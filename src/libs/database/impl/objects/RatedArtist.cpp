@@ -74,6 +74,19 @@ namespace lms::db
         utils::forEachQueryRangeResult(query, params.range, func);
     }
 
+    void RatedArtist::getRatings(Session& session, UserId userId, std::span<const ArtistId> artistIds, const std::function<void(ArtistId artistId, Rating rating)>& func)
+    {
+        session.checkReadTransaction();
+
+        utils::forEachInListChunk(artistIds, [&](std::span<const ArtistId> chunk, std::string_view placeholders) {
+            auto query{ session.getDboSession()->query<std::tuple<ArtistId, Rating>>("SELECT r_a.artist_id, r_a.rating FROM rated_artist r_a").where("r_a.user_id = ?").bind(userId).where("r_a.artist_id IN (" + std::string{ placeholders } + ")") };
+            for (const ArtistId id : chunk)
+                query.bind(id);
+
+            utils::forEachQueryResult(query, [&](const std::tuple<ArtistId, Rating>& res) { func(std::get<0>(res), std::get<1>(res)); });
+        });
+    }
+
     void RatedArtist::setLastUpdated(const Wt::WDateTime& lastUpdated)
     {
         _lastUpdated = utils::normalizeDateTime(lastUpdated);
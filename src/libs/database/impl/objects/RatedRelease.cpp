@@ -74,6 +74,19 @@ namespace lms::db
         utils::forEachQueryRangeResult(query, params.range, func);
     }
 
+    void RatedRelease::getRatings(Session& session, UserId userId, std::span<const ReleaseId> releaseIds, const std::function<void(ReleaseId releaseId, Rating rating)>& func)
+    {
+        session.checkReadTransaction();
+
+        utils::forEachInListChunk(releaseIds, [&](std::span<const ReleaseId> chunk, std::string_view placeholders) {
+            auto query{ session.getDboSession()->query<std::tuple<ReleaseId, Rating>>("SELECT r_r.release_id, r_r.rating FROM rated_release r_r").where("r_r.user_id = ?").bind(userId).where("r_r.release_id IN (" + std::string{ placeholders } + ")") };
+            for (const ReleaseId id : chunk)
+                query.bind(id);
+
+            utils::forEachQueryResult(query, [&](const std::tuple<ReleaseId, Rating>& res) { func(std::get<0>(res), std::get<1>(res)); });
+        });
+    }
+
     void RatedRelease::setLastUpdated(const Wt::WDateTime& lastUpdated)
     {
         _lastUpdated = utils::normalizeDateTime(lastUpdated);
@@ -74,6 +74,19 @@ namespace lms::db
         utils::forEachQueryRangeResult(query, params.range, func);
     }
 
+    void RatedTrack::getRatings(Session& session, UserId userId, std::span<const TrackId> trackIds, const std::function<void(TrackId trackId, Rating rating)>& func)
+    {
+        session.checkReadTransaction();
+
+        utils::forEachInListChunk(trackIds, [&](std::span<const TrackId> chunk, std::string_view placeholders) {
+            auto query{ session.getDboSession()->query<std::tuple<TrackId, Rating>>("SELECT r_t.track_id, r_t.rating FROM rated_track r_t").where("r_t.user_id = ?").bind(userId).where("r_t.track_id IN (" + std::string{ placeholders } + ")") };
+            for (const TrackId id : chunk)
+                query.bind(id);
+
+            utils::forEachQueryResult(query, [&](const std::tuple<TrackId, Rating>& res) { func(std::get<0>(res), std::get<1>(res)); });
+        });
+    }
+
     void RatedTrack::setLastUpdated(const Wt::WDateTime& lastUpdated)
     {
         _lastUpdated = utils::normalizeDateTime(lastUpdated);
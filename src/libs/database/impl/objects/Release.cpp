@@ -282,6 +282,13 @@ namespace lms::db
             return query;
         };
 
+        constexpr std::string_view orphanCountryIdsQuery{ "SELECT c.id FROM country c LEFT OUTER JOIN release_country r_c ON c.id = r_c.country_id WHERE r_c.release_id IS NULL" };
+
+        constexpr std::string_view orphanLabelIdsQuery{ "SELECT l.id FROM label l LEFT OUTER JOIN release_label r_l ON l.id = r_l.label_id WHERE r_l.release_id IS NULL" };
+
+        constexpr std::string_view orphanReleaseTypeIdsQuery{ "SELECT r_t.id FROM release_type r_t LEFT OUTER JOIN release_release_type r_r_t ON r_t.id = r_r_t.release_type_id WHERE r_r_t.release_id IS NULL" };
+
+        constexpr std::string_view orphanReleaseIdsQuery{ "SELECT r.id FROM release r LEFT OUTER JOIN track t ON r.id = t.release_id WHERE t.id IS NULL" };
     } // namespace
 
     Country::Country(std::string_view name)
@@ -324,10 +331,17 @@ namespace lms::db
         session.checkReadTransaction();
 
         // select the labels that have no releases
-        auto query{ session.getDboSession()->query<CountryId>("select c.id from country c LEFT OUTER JOIN release_country r_c ON c.id = r_c.country_id WHERE r_c.release_id IS NULL") };
+        auto query{ session.getDboSession()->query<CountryId>(std::string{ orphanCountryIdsQuery }) };
         return utils::execRangeQuery<CountryId>(query, range);
     }
 
+    std::size_t Country::removeOrphans(Session& session, std::size_t maxCount)
+    {
+        session.checkWriteTransaction();
+
+        return utils::deleteByIdsQuery(*session.getDboSession(), session.getDboSession()->tableName<Country>(), orphanCountryIdsQuery, maxCount);
+    }
+
     Label::Label(std::string_view name)
         : _name{ name }
     {
@@ -386,10 +400,17 @@ namespace lms::db
         session.checkReadTransaction();
 
         // select the labels that have no releases
-        auto query{ session.getDboSession()->query<LabelId>("select l.id from label l LEFT OUTER JOIN release_label r_l ON l.id = r_l.label_id WHERE r_l.release_id IS NULL") };
+        auto query{ session.getDboSession()->query<LabelId>(std::string{ orphanLabelIdsQuery }) };
         return utils::execRangeQuery<LabelId>(query, range);
     }
 
+    std::size_t Label::removeOrphans(Session& session, std::size_t maxCount)
+    {
+        session.checkWriteTransaction();
+
+        return utils::deleteByIdsQuery(*session.getDboSession(), session.getDboSession()->tableName<Label>(), orphanLabelIdsQuery, maxCount);
+    }
+
     ReleaseType::ReleaseType(std::string_view name)
         : _name{ name }
     {
@@ -448,10 +469,17 @@ namespace lms::db
         session.checkReadTransaction();
 
         // select the release types that have no releases
-        auto query{ session.getDboSession()->query<ReleaseTypeId>("select r_t.id from release_type r_t LEFT OUTER JOIN release_release_type r_r_t ON r_t.id = r_r_t.release_type_id WHERE r_r_t.release_id IS NULL") };
+        auto query{ session.getDboSession()->query<ReleaseTypeId>(std::string{ orphanReleaseTypeIdsQuery }) };
         return utils::execRangeQuery<ReleaseTypeId>(query, range);
     }
 
+    std::size_t ReleaseType::removeOrphans(Session& session, std::size_t maxCount)
+    {
+        session.checkWriteTransaction();
+
+        return utils::deleteByIdsQuery(*session.getDboSession(), session.getDboSession()->tableName<ReleaseType>(), orphanReleaseTypeIdsQuery, maxCount);
+    }
+
     Release::Release(const std::string& name, const std::optional<core::UUID>& MBID)
         : _name{ std::string(name, 0, _maxNameLength) }
         , _MBID{ MBID ? MBID->getAsString() : "" }
@@ -494,10 +522,17 @@ namespace lms::db
     {
         session.checkReadTransaction();
 
-        auto query{ session.getDboSession()->query<ReleaseId>("select r.id from release r LEFT OUTER JOIN Track t ON r.id = t.release_id WHERE t.id IS NULL") };
+        auto query{ session.getDboSession()->query<ReleaseId>(std::string{ orphanReleaseIdsQuery }) };
         return utils::execRangeQuery<ReleaseId>(query, range);
     }
 
+    std::size_t Release::removeOrphans(Session& session, std::size_t maxCount)
+    {
+        session.checkWriteTransaction();
+
+        return utils::deleteByIdsQuery(*session.getDboSession(), session.getDboSession()->tableName<Release>(), orphanReleaseIdsQuery, maxCount);
+    }
+
     void Release::find(Session& session, ReleaseId& lastRetrievedRelease, std::size_t count, const std::function<void(const Release::pointer&)>& func, MediaLibraryId library)
     {
         session.checkReadTransaction();
@@ -537,6 +572,30 @@ namespace lms::db
         return IdRange<ReleaseId>{ .first = std::get<0>(res), .last = std::get<1>(res) };
     }
 
+    void Release::findLabelIds(Session& session, const IdRange<ReleaseId>& idRange, const std::function<void(ReleaseId releaseId, LabelId labelId)>& func)
+    {
+        assert(idRange.isValid());
+        session.checkReadTransaction();
+
+        auto query{ session.getDboSession()->query<std::tuple<ReleaseId, LabelId>>("SELECT r_l.release_id, r_l.label_id FROM release_label r_l").where("r_l.release_id BETWEEN ? AND ?").bind(idRange.first).bind(idRange.last) };
+
+        utils::forEachQueryResult(query, [&](const auto& res) {
+            func(std::get<0>(res), std::get<1>(res));
+        });
+    }
+
+    void Release::findReleaseTypeIds(Session& session, const IdRange<ReleaseId>& idRange, const std::function<void(ReleaseId releaseId, ReleaseTypeId releaseTypeId)>& func)
+    {
+        assert(idRange.isValid());
+        session.checkReadTransaction();
+
+        auto query{ session.getDboSession()->query<std::tuple<ReleaseId, ReleaseTypeId>>("SELECT r_r_t.release_id, r_r_t.release_type_id FROM release_release_type r_r_t").where("r_r_t.release_id BETWEEN ? AND ?").bind(idRange.first).bind(idRange.last) };
+
+        utils::forEachQueryResult(query, [&](const auto& res) {
+            func(std::get<0>(res), std::get<1>(res));
+        });
+    }
+
     RangeResults<Release::pointer> Release::find(Session& session, const FindParameters& params)
     {
         session.checkReadTransaction();
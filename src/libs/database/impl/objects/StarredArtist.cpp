@@ -69,6 +69,19 @@ namespace lms::db
         return utils::fetchQuerySingleResult(session.getDboSession()->find<StarredArtist>().where("artist_id = ?").bind(artistId).where("user_id = ?").bind(userId).where("backend = ?").bind(backend));
     }
 
+    void StarredArtist::getDateTimes(Session& session, UserId userId, FeedbackBackend backend, std::span<const ArtistId> artistIds, const std::function<void(ArtistId artistId, const Wt::WDateTime& dateTime)>& func)
+    {
+        session.checkReadTransaction();
+
+        utils::forEachInListChunk(artistIds, [&](std::span<const ArtistId> chunk, std::string_view placeholders) {
+            auto query{ session.getDboSession()->query<std::tuple<ArtistId, Wt::WDateTime>>("SELECT s_a.artist_id, s_a.date_time FROM starred_artist s_a").where("s_a.user_id = ?").bind(userId).where("s_a.backend = ?").bind(backend).where("s_a.sync_state <> ?").bind(SyncState::PendingRemove).where("s_a.artist_id IN (" + std::string{ placeholders } + ")") };
+            for (const ArtistId id : chunk)
+                query.bind(id);
+
+            utils::forEachQueryResult(query, [&](const std::tuple<ArtistId, Wt::WDateTime>& res) { func(std::get<0>(res), std::get<1>(res)); });
+        });
+    }
+
     void StarredArtist::setDateTime(const Wt::WDateTime& dateTime)
     {
         _dateTime = utils::normalizeDateTime(dateTime);
@@ -69,6 +69,19 @@ namespace lms::db
         return utils::fetchQuerySingleResult(session.getDboSession()->find<StarredRelease>().where("release_id = ?").bind(releaseId).where("user_id = ?").bind(userId).where("backend = ?").bind(backend));
     }
 
+    void StarredRelease::getDateTimes(Session& session, UserId userId, FeedbackBackend backend, std::span<const ReleaseId> releaseIds, const std::function<void(ReleaseId releaseId, const Wt::WDateTime& dateTime)>& func)
+    {
+        session.checkReadTransaction();
+
+        utils::forEachInListChunk(releaseIds, [&](std::span<const ReleaseId> chunk, std::string_view placeholders) {
+            auto query{ session.getDboSession()->query<std::tuple<ReleaseId, Wt::WDateTime>>("SELECT s_r.release_id, s_r.date_time FROM starred_release s_r").where("s_r.user_id = ?").bind(userId).where("s_r.backend = ?").bind(backend).where("s_r.sync_state <> ?").bind(SyncState::PendingRemove).where("s_r.release_id IN (" + std::string{ placeholders } + ")") };
+            for (const ReleaseId id : chunk)
+                query.bind(id);
+
+            utils::forEachQueryResult(query, [&](const std::tuple<ReleaseId, Wt::WDateTime>& res) { func(std::get<0>(res), std::get<1>(res)); });
+        });
+    }
+
     void StarredRelease::setDateTime(const Wt::WDateTime& dateTime)
     {
         _dateTime = utils::normalizeDateTime(dateTime);
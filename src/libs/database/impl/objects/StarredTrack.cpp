@@ -90,6 +90,19 @@ namespace lms::db
         return utils::execRangeQuery<StarredTrackId>(query, params.range);
     }
 
+    void StarredTrack::getDateTimes(Session& session, UserId userId, FeedbackBackend backend, std::span<const TrackId> trackIds, const std::function<void(TrackId trackId, const Wt::WDateTime& dateTime)>& func)
+    {
+        session.checkReadTransaction();
+
+        utils::forEachInListChunk(trackIds, [&](std::span<const TrackId> chunk, std::string_view placeholders) {
+            auto query{ session.getDboSession()->query<std::tuple<TrackId, Wt::WDateTime>>("SELECT s_t.track_id, s_t.date_time FROM starred_track s_t").where("s_t.user_id = ?").bind(userId).where("s_t.backend = ?").bind(backend).where("s_t.sync_state <> ?").bind(SyncState::PendingRemove).where("s_t.track_id IN (" + std::string{ placeholders } + ")") };
+            for (const TrackId id : chunk)
+                query.bind(id);
+
+            utils::forEachQueryResult(query, [&](const std::tuple<TrackId, Wt::WDateTime>& res) { func(std::get<0>(res), std::get<1>(res)); });
+        });
+    }
+
     void StarredTrack::setDateTime(const Wt::WDateTime& dateTime)
     {
         _dateTime = utils::normalizeDateTime(dateTime);
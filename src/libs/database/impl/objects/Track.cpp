@@ -52,6 +52,33 @@ namespace lms::db
 {
     namespace
     {
+        void findIdsByMBIDColumn(Session& session, std::string_view column, std::span<const core::UUID> MBIDs, const std::function<void(const core::UUID& MBID, TrackId trackId)>& func)
+        {
+            session.checkReadTransaction();
+
+            // keep the number of bound parameters reasonable
+            constexpr std::size_t maxMBIDCountPerQuery{ 500 };
+            for (std::size_t offset{}; offset < MBIDs.size(); offset += maxMBIDCountPerQuery)
+            {
+                const std::span<const core::UUID> queryMBIDs{ MBIDs.subspan(offset, std::min(maxMBIDCountPerQuery, MBIDs.size() - offset)) };
+
+                std::ostringstream oss;
+                oss << "SELECT t." << column << ", t.id FROM track t WHERE t." << column << " IN (";
+                for (std::size_t i{}; i < queryMBIDs.size(); ++i)
+                    oss << (i == 0 ? "?" : ", ?");
+                oss << ")";
+
+                auto query{ session.getDboSession()->query<std::tuple<std::string, TrackId>>(oss.str()) };
+                for (const core::UUID& MBID : queryMBIDs)
+                    query.bind(std::string{ MBID.getAsString() });
+
+                utils::forEachQueryResult(query, [&](const auto& res) {
+                    if (const std::optional<core::UUID> MBID{ core::UUID::fromString(std::get<0>(res)) })
+                        func(*MBID, std::get<1>(res));
+                });
+            }
+        }
+
         template<typename ResultType>
         Wt::Dbo::Query<ResultType> createQuery(Session& session, std::string_view itemToSelect, const Track::FindParameters& params)
         {
@@ -336,6 +363,54 @@ namespace lms::db
         });
     }
 
+    void Track::findReleaseIds(Session& session, const IdRange<TrackId>& idRange, const std::function<void(TrackId trackId, ReleaseId releaseId)>& func)
+    {
+        assert(idRange.isValid());
+        session.checkReadTransaction();
+
+        auto query{ session.getDboSession()->query<std::tuple<TrackId, ReleaseId>>("SELECT t.id, t.release_id FROM track t").where("t.id BETWEEN ? AND ?").bind(idRange.first).bind(idRange.last).where("t.release_id IS NOT NULL") };
+
+        utils::forEachQueryResult(query, [&](const auto& res) {
+            func(std::get<0>(res), std::get<1>(res));
+        });
+    }
+
+    void Track::findClusterIds(Session& session, const IdRange<TrackId>& idRange, const std::function<void(TrackId trackId, ClusterId clusterId)>& func)
+    {
+        assert(idRange.isValid());
+        session.checkReadTransaction();
+
+        auto query{ session.getDboSession()->query<std::tuple<TrackId, ClusterId>>("SELECT t_c.track_id, t_c.cluster_id FROM track_cluster t_c").where("t_c.track_id BETWEEN ? AND ?").bind(idRange.first).bind(idRange.last) };
+
+        utils::forEachQueryResult(query, [&](const auto& res) {
+            func(std::get<0>(res), std::get<1>(res));
+        });
+    }
+
+    void Track::findDurations(Session& session, const IdRange<TrackId>& idRange, const std::function<void(TrackId trackId, std::chrono::milliseconds duration)>& func)
+    {
+        assert(idRange.isValid());
+        session.checkReadTransaction();
+
+        auto query{ session.getDboSession()->query<std::tuple<TrackId, std::chrono::duration<int, std::milli>>>("SELECT t.id, t.duration FROM track t").where("t.id BETWEEN ? AND ?").bind(idRange.first).bind(idRange.last) };
+
+        utils::forEachQueryResult(query, [&](const auto& res) {
+            func(std::get<0>(res), std::get<1>(res));
+        });
+    }
+
+    void Track::findMediaLibraryIds(Session& session, const IdRange<TrackId>& idRange, const std::function<void(TrackId trackId, MediaLibraryId mediaLibraryId)>& func)
+    {
+        assert(idRange.isValid());
+        session.checkReadTransaction();
+
+        auto query{ session.getDboSession()->query<std::tuple<TrackId, MediaLibraryId>>("SELECT t.id, t.media_library_id FROM track t").where("t.id BETWEEN ? AND ?").bind(idRange.first).bind(idRange.last).where("t.media_library_id IS NOT NULL") };
+
+        utils::forEachQueryResult(query, [&](const auto& res) {
+            func(std::get<0>(res), std::get<1>(res));
+        });
+    }
+
     IdRange<TrackId> Track::findNextIdRange(Session& session, TrackId lastRetrievedId, std::size_t count)
     {
         auto query{ session.getDboSession()->query<std::tuple<TrackId, TrackId>>("SELECT MIN(sub.id) AS first_id, MAX(sub.id) AS last_id FROM (SELECT t.id FROM track t WHERE t.id > ? ORDER BY t.id LIMIT ?) sub") };
@@ -367,6 +442,16 @@ namespace lms::db
         return utils::fetchQueryResults<Track::pointer>(session.getDboSession()->query<Wt::Dbo::ptr<Track>>("SELECT t from track t").where("t.recording_mbid = ?").bind(mbid.getAsString()));
     }
 
+    void Track::findIdsByRecordingMBID(Session& session, std::span<const core::UUID> MBIDs, const std::function<void(const core::UUID& MBID, TrackId trackId)>& func)
+    {
+        findIdsByMBIDColumn(session, "recording_mbid", MBIDs, func);
+    }
+
+    void Track::findIdsByMBID(Session& session, std::span<const core::UUID> MBIDs, const std::function<void(const core::UUID& MBID, TrackId trackId)>& func)
+    {
+        findIdsByMBIDColumn(session, "mbid", MBIDs, func);
+    }
+
     RangeResults<TrackId> Track::findIdsTrackMBIDDuplicates(Session& session, std::optional<Range> range)
     {
         session.checkReadTransaction();
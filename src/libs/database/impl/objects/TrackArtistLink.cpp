@@ -19,6 +19,8 @@
 
 #include "database/objects/TrackArtistLink.hpp"
 
+#include <cassert>
+
 #include <Wt/Dbo/Impl.h>
 
 #include "core/ILogger.hpp"
@@ -91,6 +93,20 @@ namespace lms::db
         return create(session, track, artist, type, std::string_view{}, artistMBIDMatched);
     }
 
+    void TrackArtistLink::find(Session& session, const IdRange<TrackId>& trackIdRange, const std::function<void(TrackId trackId, ArtistId artistId, TrackArtistLinkType type)>& func)
+    {
+        assert(trackIdRange.isValid());
+        session.checkReadTransaction();
+
+        using ResultType = std::tuple<TrackId, ArtistId, TrackArtistLinkType>;
+
+        const auto query{ session.getDboSession()->query<ResultType>("SELECT t_a_l.track_id, t_a_l.artist_id, t_a_l.type FROM track_artist_link t_a_l").where("t_a_l.track_id BETWEEN ? AND ?").bind(trackIdRange.first).bind(trackIdRange.last) };
+
+        utils::forEachQueryResult(query, [&](const ResultType& result) {
+            func(std::get<0>(result), std::get<1>(result), std::get<2>(result));
+        });
+    }
+
     TrackArtistLink::pointer TrackArtistLink::find(Session& session, TrackArtistLinkId id)
     {
         session.checkReadTransaction();
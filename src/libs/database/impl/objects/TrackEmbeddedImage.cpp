@@ -107,6 +107,8 @@ namespace lms::db
 
             return query;
         }
+
+        constexpr std::string_view orphanIdsQuery{ "SELECT t_e_i.id FROM track_embedded_image t_e_i LEFT JOIN track_embedded_image_link t_e_i_l ON t_e_i.id = t_e_i_l.track_embedded_image_id WHERE t_e_i_l.track_embedded_image_id IS NULL" };
     } // namespace
 
     TrackEmbeddedImage::pointer TrackEmbeddedImage::create(Session& session)
@@ -148,8 +150,15 @@ namespace lms::db
     {
         session.checkReadTransaction();
 
-        auto query{ session.getDboSession()->query<TrackEmbeddedImageId>("SELECT t_e_i.id FROM track_embedded_image t_e_i LEFT JOIN track_embedded_image_link t_e_i_l ON t_e_i.id = t_e_i_l.track_embedded_image_id WHERE t_e_i_l.track_embedded_image_id IS NULL") };
+        auto query{ session.getDboSession()->query<TrackEmbeddedImageId>(std::string{ orphanIdsQuery }) };
         return utils::execRangeQuery<TrackEmbeddedImageId>(query, range);
     }
 
+    std::size_t TrackEmbeddedImage::removeOrphans(Session& session, std::size_t maxCount)
+    {
+        session.checkWriteTransaction();
+
+        return utils::deleteByIdsQuery(*session.getDboSession(), session.getDboSession()->tableName<TrackEmbeddedImage>(), orphanIdsQuery, maxCount);
+    }
+
 } // namespace lms::db
@@ -28,6 +28,7 @@
 #include "database/objects/Directory.hpp"
 #include "database/objects/Track.hpp"
 
+#include "FeatureValuesEncoding.hpp"
 #include "Utils.hpp"
 #include "traits/IdTypeTraits.hpp"
 
@@ -38,6 +39,7 @@ namespace lms::db
 
     TrackFeatures::TrackFeatures(ObjectPtr<Track> track, const std::string& jsonEncodedFeatures)
         : _data{ jsonEncodedFeatures }
+        , _featureValues{ featureValuesEncoding::encode(jsonEncodedFeatures) }
         , _track{ getDboPtr(track) }
     {
     }
@@ -77,6 +79,26 @@ namespace lms::db
         return utils::execRangeQuery<TrackFeaturesId>(query, range);
     }
 
+    void TrackFeatures::find(Session& session, TrackFeaturesId& lastRetrievedId, std::size_t count, const std::unordered_set<FeatureName>& featureNames, const std::function<void(TrackId trackId, const FeatureValuesMap& featureValuesMap)>& func)
+    {
+        session.checkReadTransaction();
+
+        auto query{ session.getDboSession()->query<std::tuple<TrackFeaturesId, TrackId, std::vector<unsigned char>>>("SELECT t_f.id, t_f.track_id, t_f.feature_values FROM track_features t_f").orderBy("t_f.id").where("t_f.id > ?").bind(lastRetrievedId).limit(static_cast<int>(count)) };
+
+        FeatureValuesMap featureValuesMap;
+        utils::forEachQueryResult(query, [&](const auto& res) {
+            featureValuesMap.clear();
+            if (!featureValuesEncoding::decode(std::get<2>(res), featureNames, featureValuesMap))
+            {
+                LMS_LOG(DB, DEBUG, "Track " << std::get<1>(res).toString() << ": missing features");
+                featureValuesMap.clear();
+            }
+
+            func(std::get<1>(res), featureValuesMap);
+            lastRetrievedId = std::get<0>(res);
+        });
+    }
+
     FeatureValues TrackFeatures::getFeatureValues(const FeatureName& featureNode) const
     {
         FeatureValuesMap featuresValuesMap{ getFeatureValuesMap({ featureNode }) };
@@ -87,6 +109,17 @@ namespace lms::db
     {
         FeatureValuesMap res;
 
+        if (!_featureValues.empty())
+        {
+            if (!featureValuesEncoding::decode(_featureValues, featureNames, res))
+            {
+                LMS_LOG(DB, ERROR, "Track " << _track.id() << ": missing features");
+                res.clear();
+            }
+
+            return res;
+        }
+
         try
         {
             std::istringstream iss{ _data };
@@ -45,6 +45,9 @@ namespace lms::db
             if (params.track.isValid())
                 query.where("t_lrc.track_id = ?").bind(params.track);
 
+            if (params.directory.isValid())
+                query.where("t_lrc.directory_id = ?").bind(params.directory);
+
             if (params.external.has_value())
                 query.where("t_lrc.absolute_file_path " + std::string{ *params.external ? "<>" : "=" } + " ''");
 
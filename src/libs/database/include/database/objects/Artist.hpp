@@ -135,6 +135,7 @@ namespace lms::db
         static IdRange<ArtistId> findNextIdRange(Session& session, ArtistId lastRetrievedId, std::size_t count);
         static RangeResults<ArtistId> findIds(Session& session, const FindParameters& params);
         static RangeResults<ArtistId> findOrphanIds(Session& session, std::optional<Range> range = std::nullopt); // No track related
+        static std::size_t removeOrphans(Session& session, std::size_t maxCount);
         static bool exists(Session& session, ArtistId id);
 
         // Updates
@@ -49,6 +49,7 @@ namespace lms::db
         static pointer find(Session& session, ArtistInfoId id);
         static void find(Session& session, ArtistId id, std::optional<Range> range, const std::function<void(const pointer&)>& func);
         static void find(Session& session, ArtistId id, const std::function<void(const pointer&)>& func);
+        static void find(Session& session, DirectoryId id, const std::function<void(const pointer&)>& func);
         static pointer find(Session& session, const std::filesystem::path& path);
         static void find(Session& session, ArtistInfoId& lastRetrievedId, std::size_t count, const std::function<void(const pointer&)>& func);
         static void findArtistNameNoLongerMatch(Session& session, std::optional<Range> range, const std::function<void(const pointer&)>& func);
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -95,11 +96,18 @@ namespace lms::db
         static void find(Session& session, const FindParameters& params, std::function<void(const pointer& cluster)> _func);
         static pointer find(Session& session, ClusterId id);
         static RangeResults<ClusterId> findOrphanIds(Session& session, std::optional<Range> range = std::nullopt);
+        static std::size_t removeOrphans(Session& session, std::size_t maxCount);
 
         // May be very slow
         static std::size_t computeTrackCount(Session& session, ClusterId id);
         static std::size_t computeReleaseCount(Session& session, ClusterId id);
 
+        // Updates
+        // Recomputes the track and release counts of all clusters at once, only the clusters whose counts changed are written
+        static void updateStats(Session& session);
+        // Same, restricted to the given clusters
+        static void updateStats(Session& session, std::span<const ClusterId> clusterIds);
+
         // Accessors
         std::string_view getName() const { return _name; }
         ObjectPtr<ClusterType> getType() const { return _clusterType; }
@@ -150,6 +158,7 @@ namespace lms::db
         static pointer find(Session& session, std::string_view name);
         static pointer find(Session& session, ClusterTypeId id);
         static RangeResults<ClusterTypeId> findOrphanIds(Session& session, std::optional<Range> range = std::nullopt);
+        static std::size_t removeOrphans(Session& session, std::size_t maxCount);
         static RangeResults<ClusterTypeId> findUsed(Session& session, std::optional<Range> range = std::nullopt);
 
         static void remove(Session& session, const std::string& name);
@@ -19,7 +19,9 @@
 
 #pragma once
 
+#include <functional>
 #include <optional>
+#include <span>
 
 #include <Wt/Dbo/Field.h>
 #include <Wt/WDateTime.h>
@@ -78,6 +80,8 @@ namespace lms::db
         static pointer find(Session& session, ListenId id);
         static pointer find(Session& session, UserId userId, TrackId trackId, ScrobblingBackend backend, const Wt::WDateTime& dateTime);
         static RangeResults<ListenId> find(Session& session, const FindParameters& parameters);
+        // func is called for each listen of the user/backend made at one of the given date times (second precision)
+        static void find(Session& session, UserId userId, ScrobblingBackend backend, std::span<const Wt::WDateTime> dateTimes, const std::function<void(const pointer&)>& func);
 
         // Stats
         struct StatsFindParameters
@@ -145,10 +149,13 @@ namespace lms::db
 
         static pointer getMostRecentListen(Session& session, UserId userId, ScrobblingBackend backend, ReleaseId releaseId);
         static pointer getMostRecentListen(Session& session, UserId userId, ScrobblingBackend backend, TrackId releaseId);
+        // func(trackId, listenCount, lastListenDateTime) is only called for the tracks that have been listened to
+        static void getTrackStats(Session& session, UserId userId, ScrobblingBackend backend, std::span<const TrackId> trackIds, const std::function<void(TrackId trackId, std::size_t listenCount, const Wt::WDateTime& lastListenDateTime)>& func);
 
         SyncState getSyncState() const { return _syncState; }
         ObjectPtr<User> getUser() const { return _user; }
         ObjectPtr<Track> getTrack() const { return _track; }
+        TrackId getTrackId() const { return _track.id(); }
         const Wt::WDateTime& getDateTime() const { return _dateTime; }
 
         void setSyncState(SyncState state) { _syncState = state; }
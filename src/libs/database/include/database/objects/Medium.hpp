@@ -78,6 +78,7 @@ namespace lms::db
         static void find(Session& session, const IdRange<MediumId>& idRange, const std::function<void(const Medium::pointer&)>& func);
         static IdRange<MediumId> findNextIdRange(Session& session, MediumId lastRetrievedId, std::size_t count);
         static RangeResults<MediumId> findOrphanIds(Session& session, std::optional<Range> range = std::nullopt);
+        static std::size_t removeOrphans(Session& session, std::size_t maxCount);
 
         // Updates
         static void updatePreferredArtwork(Session& session, MediumId mediumId, ArtworkId artworkId);
@@ -19,7 +19,9 @@
 
 #pragma once
 
+#include <functional>
 #include <optional>
+#include <span>
 
 #include <Wt/Dbo/Field.h>
 #include <Wt/WDateTime.h>
@@ -62,6 +64,8 @@ namespace lms::db
         static std::size_t getCount(Session& session);
         static pointer find(Session& session, RatedArtistId id);
         static pointer find(Session& session, ArtistId artistId, UserId userId);
+        // func(artistId, rating) for each of the given objects rated by the user
+        static void getRatings(Session& session, UserId userId, std::span<const ArtistId> artistIds, const std::function<void(ArtistId artistId, Rating rating)>& func);
         static void find(Session& session, const FindParameters& findParams, std::function<void(const pointer&)> func);
 
         // Accessors
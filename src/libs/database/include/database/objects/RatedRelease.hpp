@@ -19,7 +19,9 @@
 
 #pragma once
 
+#include <functional>
 #include <optional>
+#include <span>
 
 #include <Wt/Dbo/Field.h>
 #include <Wt/WDateTime.h>
@@ -62,6 +64,8 @@ namespace lms::db
         static std::size_t getCount(Session& session);
         static pointer find(Session& session, RatedReleaseId id);
         static pointer find(Session& session, ReleaseId releaseId, UserId userId);
+        // func(releaseId, rating) for each of the given objects rated by the user
+        static void getRatings(Session& session, UserId userId, std::span<const ReleaseId> releaseIds, const std::function<void(ReleaseId releaseId, Rating rating)>& func);
         static void find(Session& session, const FindParameters& findParams, std::function<void(const pointer&)> func);
 
         // Accessors
@@ -66,6 +66,7 @@ namespace lms::db
         static pointer find(Session& session, CountryId id);
         static pointer find(Session& session, std::string_view name);
         static RangeResults<CountryId> findOrphanIds(Session& session, std::optional<Range> range = std::nullopt);
+        static std::size_t removeOrphans(Session& session, std::size_t maxCount);
 
         // Accessors
         std::string_view getName() const { return _name; }
@@ -98,6 +99,7 @@ namespace lms::db
         static pointer find(Session& session, std::string_view name);
         static void find(Session& session, LabelSortMethod sortMethod, std::function<void(const Label::pointer& label)> func);
         static RangeResults<LabelId> findOrphanIds(Session& session, std::optional<Range> range = std::nullopt);
+        static std::size_t removeOrphans(Session& session, std::size_t maxCount);
 
         // Accessors
         std::string_view getName() const { return _name; }
@@ -130,6 +132,7 @@ namespace lms::db
         static pointer find(Session& session, std::string_view name);
         static void find(Session& session, ReleaseTypeSortMethod sortMethod, std::function<void(const ReleaseType::pointer& releaseType)> func);
         static RangeResults<ReleaseTypeId> findOrphanIds(Session& session, std::optional<Range> range = std::nullopt);
+        static std::size_t removeOrphans(Session& session, std::size_t maxCount);
 
         // Accessors
         std::string_view getName() const { return _name; }
@@ -254,11 +257,14 @@ namespace lms::db
         static void find(Session& session, ReleaseId& lastRetrievedRelease, std::size_t count, const std::function<void(const Release::pointer&)>& func, MediaLibraryId library = {});
         static void find(Session& session, const IdRange<ReleaseId>& idRange, const std::function<void(const Release::pointer&)>& func);
         static IdRange<ReleaseId> findNextIdRange(Session& session, ReleaseId lastRetrievedId, std::size_t count);
+        static void findLabelIds(Session& session, const IdRange<ReleaseId>& idRange, const std::function<void(ReleaseId releaseId, LabelId labelId)>& func);
+        static void findReleaseTypeIds(Session& session, const IdRange<ReleaseId>& idRange, const std::function<void(ReleaseId releaseId, ReleaseTypeId releaseTypeId)>& func);
         static RangeResults<pointer> find(Session& session, const FindParameters& parameters);
         static void find(Session& session, const FindParameters& parameters, const std::function<void(const pointer&)>& func);
         static RangeResults<ReleaseId> findIds(Session& session, const FindParameters& parameters);
         static std::size_t getCount(Session& session, const FindParameters& parameters);
         static RangeResults<ReleaseId> findOrphanIds(Session& session, std::optional<Range> range = std::nullopt); // not track related
+        static std::size_t removeOrphans(Session& session, std::size_t maxCount);
 
         // Updates
         static void updatePreferredArtwork(Session& session, ReleaseId id, ArtworkId artworkId);
@@ -19,6 +19,9 @@
 
 #pragma once
 
+#include <functional>
+#include <span>
+
 #include <Wt/Dbo/Field.h>
 #include <Wt/WDateTime.h>
 
@@ -44,6 +47,8 @@ namespace lms::db
         static pointer find(Session& session, StarredArtistId id);
         static pointer find(Session& session, ArtistId artistId, UserId userId); // current backend
         static pointer find(Session& session, ArtistId artistId, UserId userId, FeedbackBackend backend);
+        // func(artistId, dateTime) for each of the given objects starred by the user (pending removals are skipped)
+        static void getDateTimes(Session& session, UserId userId, FeedbackBackend backend, std::span<const ArtistId> artistIds, const std::function<void(ArtistId artistId, const Wt::WDateTime& dateTime)>& func);
 
         // Accessors
         ObjectPtr<Artist> getArtist() const { return _artist; }
@@ -19,6 +19,9 @@
 
 #pragma once
 
+#include <functional>
+#include <span>
+
 #include <Wt/Dbo/Field.h>
 #include <Wt/WDateTime.h>
 
@@ -44,6 +47,8 @@ namespace lms::db
         static pointer find(Session& session, StarredReleaseId id);
         static pointer find(Session& session, ReleaseId releaseId, UserId userId); // current feedback backend
         static pointer find(Session& session, ReleaseId releaseId, UserId userId, FeedbackBackend backend);
+        // func(releaseId, dateTime) for each of the given objects starred by the user (pending removals are skipped)
+        static void getDateTimes(Session& session, UserId userId, FeedbackBackend backend, std::span<const ReleaseId> releaseIds, const std::function<void(ReleaseId releaseId, const Wt::WDateTime& dateTime)>& func);
 
         // Accessors
         ObjectPtr<Release> getRelease() const { return _release; }
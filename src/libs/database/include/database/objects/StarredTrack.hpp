@@ -19,7 +19,9 @@
 
 #pragma once
 
+#include <functional>
 #include <optional>
+#include <span>
 
 #include <Wt/Dbo/Field.h>
 #include <Wt/WDateTime.h>
@@ -71,6 +73,8 @@ namespace lms::db
         static pointer find(Session& session, StarredTrackId id);
         static pointer find(Session& session, TrackId trackId, UserId userId); // current feedback backend
         static pointer find(Session& session, TrackId trackId, UserId userId, FeedbackBackend backend);
+        // func(trackId, dateTime) for each of the given objects starred by the user (pending removals are skipped)
+        static void getDateTimes(Session& session, UserId userId, FeedbackBackend backend, std::span<const TrackId> trackIds, const std::function<void(TrackId trackId, const Wt::WDateTime& dateTime)>& func);
         static bool exists(Session& session, TrackId trackId, UserId userId, FeedbackBackend backend);
         static RangeResults<StarredTrackId> find(Session& session, const FindParameters& findParams);
 
@@ -23,6 +23,7 @@
 #include <filesystem>
 #include <optional>
 #include <ostream>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -199,10 +200,17 @@ namespace lms::db
         static void find(Session& session, const IdRange<TrackId>& idRange, const std::function<void(const Track::pointer&)>& func);
         static IdRange<TrackId> findNextIdRange(Session& session, TrackId lastRetrievedId, std::size_t count);
         static void findAbsoluteFilePath(Session& session, TrackId& lastRetrievedId, std::size_t count, const std::function<void(TrackId trackId, const std::filesystem::path& absoluteFilePath)>& func);
+        static void findReleaseIds(Session& session, const IdRange<TrackId>& idRange, const std::function<void(TrackId trackId, ReleaseId releaseId)>& func);
+        static void findClusterIds(Session& session, const IdRange<TrackId>& idRange, const std::function<void(TrackId trackId, ClusterId clusterId)>& func);
+        static void findDurations(Session& session, const IdRange<TrackId>& idRange, const std::function<void(TrackId trackId, std::chrono::milliseconds duration)>& func);
+        static void findMediaLibraryIds(Session& session, const IdRange<TrackId>& idRange, const std::function<void(TrackId trackId, MediaLibraryId mediaLibraryId)>& func);
 
         static bool exists(Session& session, TrackId id);
         static std::vector<pointer> findByRecordingMBID(Session& session, const core::UUID& MBID);
         static std::vector<pointer> findByMBID(Session& session, const core::UUID& MBID);
+        // func is called for each track that has one of the given MBIDs
+        static void findIdsByRecordingMBID(Session& session, std::span<const core::UUID> MBIDs, const std::function<void(const core::UUID& MBID, TrackId trackId)>& func);
+        static void findIdsByMBID(Session& session, std::span<const core::UUID> MBIDs, const std::function<void(const core::UUID& MBID, TrackId trackId)>& func);
         static RangeResults<TrackId> findSimilarTrackIds(Session& session, const std::vector<TrackId>& trackIds, std::optional<Range> range = std::nullopt);
 
         static RangeResults<TrackId> findIds(Session& session, const FindParameters& parameters);
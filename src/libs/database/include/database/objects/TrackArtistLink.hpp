@@ -26,6 +26,7 @@
 #include <Wt/Dbo/Field.h>
 
 #include "core/EnumSet.hpp"
+#include "database/IdRange.hpp"
 #include "database/IdType.hpp"
 #include "database/Object.hpp"
 #include "database/Types.hpp"
@@ -84,6 +85,7 @@ namespace lms::db
 
         static void find(Session& session, TrackId trackId, const std::function<void(const pointer&, const ObjectPtr<Artist>&)>& func);
         static void find(Session& session, const FindParameters& parameters, const std::function<void(const pointer&)>& func);
+        static void find(Session& session, const IdRange<TrackId>& trackIdRange, const std::function<void(TrackId trackId, ArtistId artistId, TrackArtistLinkType type)>& func);
         static pointer find(Session& session, TrackArtistLinkId linkId);
         static std::size_t getCount(Session& session);
         static pointer create(Session& session, const ObjectPtr<Track>& track, const ObjectPtr<Artist>& artist, TrackArtistLinkType type, std::string_view subType, bool artistMBIDMatched = false);
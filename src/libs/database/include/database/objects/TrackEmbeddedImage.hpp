@@ -98,6 +98,7 @@ namespace lms::db
         static void find(Session& session, const FindParameters& params, const std::function<void(const pointer&)>& func);
         static pointer find(Session& session, std::size_t size, ImageHashType hash);
         static RangeResults<TrackEmbeddedImageId> findOrphanIds(Session& session, std::optional<Range> range);
+        static std::size_t removeOrphans(Session& session, std::size_t maxCount);
 
         // getters
         ImageHashType getHash() const { return _hash; }
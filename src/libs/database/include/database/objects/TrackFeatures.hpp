@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <functional>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -53,6 +54,8 @@ namespace lms::db
         static pointer find(Session& session, TrackFeaturesId id);
         static pointer find(Session& session, TrackId trackId);
         static RangeResults<TrackFeaturesId> find(Session& session, std::optional<Range> range = std::nullopt);
+        // Sequential scan, only the requested features are decoded (map is empty if some features are missing)
+        static void find(Session& session, TrackFeaturesId& lastRetrievedId, std::size_t count, const std::unordered_set<FeatureName>& featureNames, const std::function<void(TrackId trackId, const FeatureValuesMap& featureValuesMap)>& func);
 
         FeatureValues getFeatureValues(const FeatureName& feature) const;
         FeatureValuesMap getFeatureValuesMap(const std::unordered_set<FeatureName>& featureNames) const;
@@ -64,6 +67,7 @@ namespace lms::db
         void persist(Action& a)
         {
             Wt::Dbo::field(a, _data, "data");
+            Wt::Dbo::field(a, _featureValues, "feature_values");
             Wt::Dbo::belongsTo(a, _track, "track", Wt::Dbo::OnDeleteCascade);
         }
 
@@ -72,7 +76,8 @@ namespace lms::db
         TrackFeatures(ObjectPtr<Track> track, const std::string& jsonEncodedFeatures);
         static pointer create(Session& session, ObjectPtr<Track> track, const std::string& jsonEncodedFeatures);
 
-        std::string _data;
+        std::string _data;                        // json encoded, as fetched
+        std::vector<unsigned char> _featureValues; // numeric features extracted from _data, binary encoded
         Wt::Dbo::ptr<Track> _track;
     };
 
@@ -31,6 +31,7 @@
 #include "database/IdType.hpp"
 #include "database/Object.hpp"
 #include "database/Types.hpp"
+#include "database/objects/DirectoryId.hpp"
 #include "database/objects/TrackId.hpp"
 
 LMS_DECLARE_IDTYPE(TrackLyricsId)
@@ -50,6 +51,7 @@ namespace lms::db
         {
             std::optional<Range> range;
             TrackId track;
+            DirectoryId directory;
             std::optional<bool> external; // if set, true means external, false means embedded
             TrackLyricsSortMethod sortMethod{ TrackLyricsSortMethod::None };
 
@@ -63,6 +65,11 @@ namespace lms::db
                 track = _track;
                 return *this;
             }
+            FindParameters& setDirectory(DirectoryId _directory)
+            {
+                directory = _directory;
+                return *this;
+            }
             FindParameters& setExternal(std::optional<bool> _external)
             {
                 external = _external;
@@ -934,4 +934,31 @@ namespace lms::db::tests
             EXPECT_EQ(artist->getPreferredArtwork(), Artwork::pointer{});
         }
     }
+
+    TEST_F(DatabaseFixture, Artist_removeOrphans)
+    {
+        ScopedTrack track{ session };
+        ScopedArtist artist{ session, "MyArtist" };
+        ScopedArtist orphanArtist1{ session, "MyOrphanArtist1" };
+        ScopedArtist orphanArtist2{ session, "MyOrphanArtist2" };
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+
+            TrackArtistLink::create(session, track.get(), artist.get(), TrackArtistLinkType::Artist);
+        }
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+
+            // at most maxCount artists are removed per call
+            EXPECT_EQ(Artist::removeOrphans(session, 1), 1);
+            EXPECT_EQ(Artist::removeOrphans(session, 10), 1);
+            EXPECT_EQ(Artist::removeOrphans(session, 10), 0);
+
+            EXPECT_EQ(Artist::find(session, orphanArtist1.getId()), Artist::pointer{});
+            EXPECT_EQ(Artist::find(session, orphanArtist2.getId()), Artist::pointer{});
+            EXPECT_NE(Artist::find(session, artist.getId()), Artist::pointer{});
+        }
+    }
 } // namespace lms::db::tests
@@ -20,7 +20,9 @@
 #include "Common.hpp"
 
 #include <algorithm>
+#include <array>
 #include <list>
+#include <span>
 
 namespace lms::db::tests
 {
@@ -359,6 +361,115 @@ namespace lms::db::tests
         }
     }
 
+    TEST_F(DatabaseFixture, Cluster_removeOrphans)
+    {
+        ScopedTrack track{ session };
+        ScopedClusterType clusterType{ session, "MyClusterType" };
+        ScopedClusterType orphanClusterType{ session, "MyOrphanClusterType" };
+        ScopedCluster cluster{ session, clusterType.lockAndGet(), "MyCluster" };
+        ScopedCluster orphanCluster{ session, clusterType.lockAndGet(), "MyOrphanCluster" };
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+
+            cluster.get().modify()->addTrack(track.get());
+        }
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+
+            EXPECT_EQ(Cluster::removeOrphans(session, 10), 1);
+            EXPECT_EQ(Cluster::find(session, orphanCluster.getId()), Cluster::pointer{});
+            EXPECT_NE(Cluster::find(session, cluster.getId()), Cluster::pointer{});
+            EXPECT_EQ(Cluster::removeOrphans(session, 10), 0);
+
+            EXPECT_EQ(ClusterType::removeOrphans(session, 10), 1);
+            EXPECT_EQ(ClusterType::find(session, orphanClusterType.getId()), ClusterType::pointer{});
+            EXPECT_NE(ClusterType::find(session, clusterType.getId()), ClusterType::pointer{});
+            EXPECT_EQ(ClusterType::removeOrphans(session, 10), 0);
+        }
+    }
+
+    TEST_F(DatabaseFixture, Cluster_updateStats)
+    {
+        ScopedTrack track1{ session };
+        ScopedTrack track2{ session };
+        ScopedTrack track3{ session };
+        ScopedRelease release{ session, "MyRelease" };
+        ScopedClusterType clusterType{ session, "MyClusterType" };
+        ScopedCluster cluster1{ session, clusterType.lockAndGet(), "MyCluster1" };
+        ScopedCluster cluster2{ session, clusterType.lockAndGet(), "MyCluster2" };
+        ScopedCluster unusedCluster{ session, clusterType.lockAndGet(), "MyClusterUnused" };
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+
+            track1.get().modify()->setRelease(release.get());
+            track2.get().modify()->setRelease(release.get());
+            cluster1.get().modify()->addTrack(track1.get());
+            cluster1.get().modify()->addTrack(track2.get());
+            cluster1.get().modify()->addTrack(track3.get());
+            cluster2.get().modify()->addTrack(track3.get());
+            unusedCluster.get().modify()->setTrackCount(42);
+        }
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+            Cluster::updateStats(session);
+        }
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            EXPECT_EQ(cluster1.get()->getTrackCount(), 3);
+            EXPECT_EQ(cluster1.get()->getReleasesCount(), 1);
+            EXPECT_EQ(cluster2.get()->getTrackCount(), 1);
+            EXPECT_EQ(cluster2.get()->getReleasesCount(), 0);
+            EXPECT_EQ(unusedCluster.get()->getTrackCount(), 0);
+            EXPECT_EQ(unusedCluster.get()->getReleasesCount(), 0);
+        }
+    }
+
+    TEST_F(DatabaseFixture, Cluster_updateStats_restricted)
+    {
+        ScopedTrack track1{ session };
+        ScopedTrack track2{ session };
+        ScopedClusterType clusterType{ session, "MyClusterType" };
+        ScopedCluster cluster1{ session, clusterType.lockAndGet(), "MyCluster1" };
+        ScopedCluster cluster2{ session, clusterType.lockAndGet(), "MyCluster2" };
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+
+            cluster1.get().modify()->addTrack(track1.get());
+            cluster2.get().modify()->addTrack(track1.get());
+            cluster2.get().modify()->addTrack(track2.get());
+        }
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+            const std::array<ClusterId, 1> clusterIds{ cluster2.getId() };
+            Cluster::updateStats(session, clusterIds);
+        }
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            EXPECT_EQ(cluster1.get()->getTrackCount(), 0);
+            EXPECT_EQ(cluster2.get()->getTrackCount(), 2);
+        }
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+            Cluster::updateStats(session, std::span<const ClusterId>{});
+        }
+
+        {
+            auto transaction{ session.createReadTransaction() };
+            EXPECT_EQ(cluster1.get()->getTrackCount(), 0);
+        }
+    }
+
     TEST_F(DatabaseFixture, Cluster_singleTrackSingleReleaseSingleCluster)
     {
         ScopedTrack track{ session };
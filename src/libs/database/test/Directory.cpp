@@ -167,6 +167,39 @@ namespace lms::db::tests
         }
     }
 
+    TEST_F(DatabaseFixture, Directory_removeOrphans)
+    {
+        ScopedDirectory parent{ session, "/path/to/dir/" };
+        ScopedDirectory child{ session, "/path/to/dir/child" };
+        ScopedDirectory trackDirectory{ session, "/path/to/other/" };
+        ScopedTrack track{ session };
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+
+            child.get().modify()->setParent(parent.get());
+            track.get().modify()->setDirectory(trackDirectory.get());
+        }
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+
+            // parent still has a child
+            EXPECT_EQ(Directory::removeOrphans(session, 10), 1);
+            EXPECT_EQ(Directory::find(session, child.getId()), Directory::pointer{});
+            EXPECT_NE(Directory::find(session, parent.getId()), Directory::pointer{});
+        }
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+
+            EXPECT_EQ(Directory::removeOrphans(session, 10), 1);
+            EXPECT_EQ(Directory::find(session, parent.getId()), Directory::pointer{});
+            EXPECT_EQ(Directory::removeOrphans(session, 10), 0);
+            EXPECT_NE(Directory::find(session, trackDirectory.getId()), Directory::pointer{});
+        }
+    }
+
     TEST_F(DatabaseFixture, Directory_findRootDirectories)
     {
         ScopedDirectory parent1{ session, "/root1" };
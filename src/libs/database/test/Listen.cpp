@@ -17,6 +17,8 @@
  * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <array>
+
 #include "database/objects/Listen.hpp"
 
 #include "Common.hpp"
@@ -1479,6 +1481,95 @@ namespace lms::db::tests
         }
     }
 
+    TEST_F(DatabaseFixture, Listen_stats_followListens)
+    {
+        ScopedTrack track1{ session };
+        ScopedTrack track2{ session };
+        ScopedUser user{ session, "MyUser" };
+
+        auto getCount{ [&](const ScopedTrack& track) {
+            auto transaction{ session.createReadTransaction() };
+            return Listen::getCount(session, user->getId(), track.getId());
+        } };
+
+        auto getRecentTracks{ [&] {
+            auto transaction{ session.createReadTransaction() };
+
+            Listen::StatsFindParameters params;
+            params.setUser(user->getId());
+            params.setScrobblingBackend(ScrobblingBackend::Internal);
+            return Listen::getRecentTracks(session, params).results;
+        } };
+
+        ScopedListen listen1{ session, user.lockAndGet(), track1.lockAndGet(), ScrobblingBackend::Internal, Wt::WDateTime{ Wt::WDate{ 2000, 1, 2 }, Wt::WTime{ 12, 0, 1 } } };
+        ScopedListen listen2{ session, user.lockAndGet(), track2.lockAndGet(), ScrobblingBackend::Internal, Wt::WDateTime{ Wt::WDate{ 2000, 1, 2 }, Wt::WTime{ 13, 0, 1 } } };
+        {
+            ScopedListen listen3{ session, user.lockAndGet(), track1.lockAndGet(), ScrobblingBackend::Internal, Wt::WDateTime{ Wt::WDate{ 2000, 1, 2 }, Wt::WTime{ 14, 0, 1 } } };
+
+            EXPECT_EQ(getCount(track1), 2);
+            EXPECT_EQ(getCount(track2), 1);
+            EXPECT_EQ(getRecentTracks(), (std::vector<TrackId>{ track1.getId(), track2.getId() }));
+        }
+
+        // removing the most recent listen must also update the last listen date time
+        EXPECT_EQ(getCount(track1), 1);
+        EXPECT_EQ(getRecentTracks(), (std::vector<TrackId>{ track2.getId(), track1.getId() }));
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+            track2.get().remove();
+        }
+        EXPECT_EQ(getRecentTracks(), (std::vector<TrackId>{ track1.getId() }));
+    }
+
+    TEST_F(DatabaseFixture, Listen_getTrackStats)
+    {
+        ScopedTrack track1{ session };
+        ScopedTrack track2{ session };
+        ScopedTrack track3{ session };
+        ScopedUser user{ session, "MyUser" };
+
+        const Wt::WDateTime dateTime1{ Wt::WDate{ 2000, 1, 2 }, Wt::WTime{ 12, 0, 1 } };
+        const Wt::WDateTime dateTime2{ Wt::WDate{ 2000, 1, 2 }, Wt::WTime{ 13, 0, 1 } };
+        ScopedListen listen1{ session, user.lockAndGet(), track1.lockAndGet(), ScrobblingBackend::Internal, dateTime1 };
+        ScopedListen listen2{ session, user.lockAndGet(), track1.lockAndGet(), ScrobblingBackend::Internal, dateTime2 };
+        ScopedListen listen3{ session, user.lockAndGet(), track2.lockAndGet(), ScrobblingBackend::ListenBrainz, dateTime1 };
+
+        struct Stats
+        {
+            TrackId trackId;
+            std::size_t listenCount;
+            Wt::WDateTime lastListenDateTime;
+        };
+
+        auto getTrackStats{ [&](ScrobblingBackend backend) {
+            std::vector<Stats> res;
+
+            auto transaction{ session.createReadTransaction() };
+            const std::array<TrackId, 3> trackIds{ track1.getId(), track2.getId(), track3.getId() };
+            Listen::getTrackStats(session, user.getId(), backend, trackIds, [&](TrackId trackId, std::size_t listenCount, const Wt::WDateTime& lastListenDateTime) {
+                res.push_back(Stats{ trackId, listenCount, lastListenDateTime });
+            });
+            return res;
+        } };
+
+        {
+            const auto stats{ getTrackStats(ScrobblingBackend::Internal) };
+            ASSERT_EQ(stats.size(), 1);
+            EXPECT_EQ(stats[0].trackId, track1.getId());
+            EXPECT_EQ(stats[0].listenCount, 2);
+            EXPECT_EQ(stats[0].lastListenDateTime, dateTime2);
+        }
+
+        {
+            const auto stats{ getTrackStats(ScrobblingBackend::ListenBrainz) };
+            ASSERT_EQ(stats.size(), 1);
+            EXPECT_EQ(stats[0].trackId, track2.getId());
+            EXPECT_EQ(stats[0].listenCount, 1);
+            EXPECT_EQ(stats[0].lastListenDateTime, dateTime1);
+        }
+    }
+
     TEST_F(DatabaseFixture, Listen_getCount_release)
     {
         ScopedTrack track1{ session };
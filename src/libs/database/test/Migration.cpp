@@ -61,7 +61,7 @@ namespace lms::db::tests
 
     TEST(Database, migration)
     {
-        TmpDatabase tmpDatabase;
+        TmpDatabase tmpDatabase{ TmpDatabase::Schema::Empty };
 
         auto& db{ tmpDatabase.getDb() };
 
@@ -52,4 +52,33 @@ namespace lms::db::tests
             EXPECT_EQ(RatedTrack::getCount(session), 1);
         }
     }
+
+    TEST_F(DatabaseFixture, RatedTrack_getRatings)
+    {
+        ScopedTrack track1{ session };
+        ScopedTrack track2{ session };
+        ScopedUser user{ session, "MyUser" };
+        ScopedUser user2{ session, "MyUser2" };
+
+        ScopedRatedTrack ratedTrack1{ session, track1.lockAndGet(), user.lockAndGet() };
+        ScopedRatedTrack ratedTrack2{ session, track2.lockAndGet(), user2.lockAndGet() };
+        {
+            auto transaction{ session.createWriteTransaction() };
+            ratedTrack1.get().modify()->setRating(3);
+        }
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            const std::vector<TrackId> trackIds{ track1.getId(), track2.getId() };
+            std::vector<std::pair<TrackId, Rating>> ratings;
+            RatedTrack::getRatings(session, user.getId(), trackIds, [&](TrackId trackId, Rating rating) {
+                ratings.emplace_back(trackId, rating);
+            });
+
+            ASSERT_EQ(ratings.size(), 1);
+            EXPECT_EQ(ratings[0].first, track1.getId());
+            EXPECT_EQ(ratings[0].second, 3);
+        }
+    }
 } // namespace lms::db::tests
\ No newline at end of file
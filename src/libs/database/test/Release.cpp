@@ -262,6 +262,42 @@ namespace lms::db::tests
         }
     }
 
+    TEST_F(DatabaseFixture, Release_findLabelAndReleaseTypeIds)
+    {
+        ScopedRelease release1{ session, "MyRelease1" };
+        ScopedRelease release2{ session, "MyRelease2" };
+        ScopedLabel label{ session, "MyLabel" };
+        ScopedReleaseType releaseType{ session, "album" };
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+            release2.get().modify()->addLabel(label.get());
+            release2.get().modify()->addReleaseType(releaseType.get());
+        }
+
+        const IdRange<ReleaseId> idRange{ .first = release1.getId(), .last = release2.getId() };
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            std::vector<std::pair<ReleaseId, LabelId>> visitedLabels;
+            Release::findLabelIds(session, idRange, [&](ReleaseId releaseId, LabelId labelId) {
+                visitedLabels.emplace_back(releaseId, labelId);
+            });
+            ASSERT_EQ(visitedLabels.size(), 1);
+            EXPECT_EQ(visitedLabels[0].first, release2.getId());
+            EXPECT_EQ(visitedLabels[0].second, label.getId());
+
+            std::vector<std::pair<ReleaseId, ReleaseTypeId>> visitedReleaseTypes;
+            Release::findReleaseTypeIds(session, idRange, [&](ReleaseId releaseId, ReleaseTypeId releaseTypeId) {
+                visitedReleaseTypes.emplace_back(releaseId, releaseTypeId);
+            });
+            ASSERT_EQ(visitedReleaseTypes.size(), 1);
+            EXPECT_EQ(visitedReleaseTypes[0].first, release2.getId());
+            EXPECT_EQ(visitedReleaseTypes[0].second, releaseType.getId());
+        }
+    }
+
     TEST_F(DatabaseFixture, Release_singleTrack)
     {
         ScopedRelease release{ session, "MyRelease" };
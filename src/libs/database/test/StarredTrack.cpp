@@ -136,4 +136,38 @@ namespace lms::db::tests
             EXPECT_EQ(tracks.results[1], starredTrack1->getTrack()->getId());
         }
     }
+
+    TEST_F(DatabaseFixture, StarredTrack_getDateTimes)
+    {
+        ScopedTrack track1{ session };
+        ScopedTrack track2{ session };
+        ScopedTrack track3{ session };
+        ScopedUser user{ session, "MyUser" };
+
+        ScopedStarredTrack starredTrack1{ session, track1.lockAndGet(), user.lockAndGet(), FeedbackBackend::Internal };
+        ScopedStarredTrack starredTrack2{ session, track2.lockAndGet(), user.lockAndGet(), FeedbackBackend::Internal };
+        ScopedStarredTrack starredTrack3{ session, track3.lockAndGet(), user.lockAndGet(), FeedbackBackend::ListenBrainz };
+
+        const Wt::WDateTime dateTime{ Wt::WDate{ 1950, 1, 2 }, Wt::WTime{ 12, 30, 1 } };
+        {
+            auto transaction{ session.createWriteTransaction() };
+
+            starredTrack1.get().modify()->setDateTime(dateTime);
+            starredTrack2.get().modify()->setSyncState(SyncState::PendingRemove);
+        }
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            const std::vector<TrackId> trackIds{ track1.getId(), track2.getId(), track3.getId() };
+            std::vector<std::pair<TrackId, Wt::WDateTime>> dateTimes;
+            StarredTrack::getDateTimes(session, user.getId(), FeedbackBackend::Internal, trackIds, [&](TrackId trackId, const Wt::WDateTime& starredDateTime) {
+                dateTimes.emplace_back(trackId, starredDateTime);
+            });
+
+            ASSERT_EQ(dateTimes.size(), 1);
+            EXPECT_EQ(dateTimes[0].first, track1.getId());
+            EXPECT_EQ(dateTimes[0].second, dateTime);
+        }
+    }
 } // namespace lms::db::tests
\ No newline at end of file
@@ -262,6 +262,118 @@ namespace lms::db::tests
         }
     }
 
+    TEST_F(DatabaseFixture, Track_findReleaseAndClusterIds)
+    {
+        ScopedTrack track1{ session };
+        ScopedTrack track2{ session };
+        ScopedRelease release{ session, "MyRelease" };
+        ScopedClusterType clusterType{ session, "MyType" };
+        ScopedCluster cluster1{ session, clusterType.lockAndGet(), "MyCluster1" };
+        ScopedCluster cluster2{ session, clusterType.lockAndGet(), "MyCluster2" };
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+            track1.get().modify()->setRelease(release.get());
+            cluster1.get().modify()->addTrack(track1.get());
+            cluster2.get().modify()->addTrack(track1.get());
+            cluster2.get().modify()->addTrack(track2.get());
+        }
+
+        const IdRange<TrackId> idRange{ .first = track1.getId(), .last = track2.getId() };
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            std::vector<std::pair<TrackId, ReleaseId>> visitedReleases;
+            Track::findReleaseIds(session, idRange, [&](TrackId trackId, ReleaseId releaseId) {
+                visitedReleases.emplace_back(trackId, releaseId);
+            });
+            ASSERT_EQ(visitedReleases.size(), 1);
+            EXPECT_EQ(visitedReleases[0].first, track1.getId());
+            EXPECT_EQ(visitedReleases[0].second, release.getId());
+        }
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            std::vector<std::pair<TrackId, ClusterId>> visitedClusters;
+            Track::findClusterIds(session, idRange, [&](TrackId trackId, ClusterId clusterId) {
+                visitedClusters.emplace_back(trackId, clusterId);
+            });
+            std::sort(std::begin(visitedClusters), std::end(visitedClusters));
+
+            const std::vector<std::pair<TrackId, ClusterId>> expectedClusters{
+                { track1.getId(), cluster1.getId() },
+                { track1.getId(), cluster2.getId() },
+                { track2.getId(), cluster2.getId() },
+            };
+            EXPECT_EQ(visitedClusters, expectedClusters);
+        }
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            std::size_t count{};
+            Track::findClusterIds(session, IdRange<TrackId>{ .first = track2.getId(), .last = track2.getId() }, [&](TrackId trackId, ClusterId clusterId) {
+                count++;
+                EXPECT_EQ(trackId, track2.getId());
+                EXPECT_EQ(clusterId, cluster2.getId());
+            });
+            EXPECT_EQ(count, 1);
+        }
+    }
+
+    TEST_F(DatabaseFixture, Track_findDurations)
+    {
+        ScopedTrack track1{ session };
+        ScopedTrack track2{ session };
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+            track1.get().modify()->setDuration(std::chrono::seconds{ 42 });
+        }
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            std::vector<std::pair<TrackId, std::chrono::milliseconds>> visitedDurations;
+            Track::findDurations(session, IdRange<TrackId>{ .first = track1.getId(), .last = track2.getId() }, [&](TrackId trackId, std::chrono::milliseconds duration) {
+                visitedDurations.emplace_back(trackId, duration);
+            });
+            std::sort(std::begin(visitedDurations), std::end(visitedDurations));
+
+            const std::vector<std::pair<TrackId, std::chrono::milliseconds>> expectedDurations{
+                { track1.getId(), std::chrono::seconds{ 42 } },
+                { track2.getId(), std::chrono::milliseconds{ 0 } },
+            };
+            EXPECT_EQ(visitedDurations, expectedDurations);
+        }
+    }
+
+    TEST_F(DatabaseFixture, Track_findMediaLibraryIds)
+    {
+        ScopedTrack track1{ session };
+        ScopedTrack track2{ session };
+        ScopedMediaLibrary library{ session, "MyLibrary", "/root" };
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+            track1.get().modify()->setMediaLibrary(library.get());
+        }
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            std::vector<std::pair<TrackId, MediaLibraryId>> visitedLibraries;
+            Track::findMediaLibraryIds(session, IdRange<TrackId>{ .first = track1.getId(), .last = track2.getId() }, [&](TrackId trackId, MediaLibraryId mediaLibraryId) {
+                visitedLibraries.emplace_back(trackId, mediaLibraryId);
+            });
+            ASSERT_EQ(visitedLibraries.size(), 1);
+            EXPECT_EQ(visitedLibraries[0].first, track1.getId());
+            EXPECT_EQ(visitedLibraries[0].second, library.getId());
+        }
+    }
+
     TEST_F(DatabaseFixture, Track_MediaLibrary)
     {
         ScopedTrack track{ session };
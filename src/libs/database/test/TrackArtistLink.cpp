@@ -18,6 +18,10 @@
  */
 
 #include "Common.hpp"
+
+#include <algorithm>
+#include <tuple>
+
 #include "database/Types.hpp"
 
 #include "database/objects/TrackArtistLink.hpp"
@@ -183,4 +187,36 @@ namespace lms::db::tests
             }
         }
     }
-} // namespace lms::db::tests
\ No newline at end of file
+
+    TEST_F(DatabaseFixture, TrackArtistLink_findByTrackIdRange)
+    {
+        ScopedTrack track1{ session };
+        ScopedTrack track2{ session };
+        ScopedTrack track3{ session };
+        ScopedArtist artist1{ session, "MyArtist1" };
+        ScopedArtist artist2{ session, "MyArtist2" };
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+            TrackArtistLink::create(session, track1.get(), artist1.get(), TrackArtistLinkType::Artist);
+            TrackArtistLink::create(session, track2.get(), artist2.get(), TrackArtistLinkType::Composer);
+            TrackArtistLink::create(session, track3.get(), artist1.get(), TrackArtistLinkType::Artist);
+        }
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            std::vector<std::tuple<TrackId, ArtistId, TrackArtistLinkType>> visitedLinks;
+            TrackArtistLink::find(session, IdRange<TrackId>{ .first = track1.getId(), .last = track2.getId() }, [&](TrackId trackId, ArtistId artistId, TrackArtistLinkType linkType) {
+                visitedLinks.emplace_back(trackId, artistId, linkType);
+            });
+            std::sort(std::begin(visitedLinks), std::end(visitedLinks));
+
+            const std::vector<std::tuple<TrackId, ArtistId, TrackArtistLinkType>> expectedLinks{
+                { track1.getId(), artist1.getId(), TrackArtistLinkType::Artist },
+                { track2.getId(), artist2.getId(), TrackArtistLinkType::Composer },
+            };
+            EXPECT_EQ(visitedLinks, expectedLinks);
+        }
+    }
+} // namespace lms::db::tests
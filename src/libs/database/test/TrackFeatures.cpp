@@ -46,4 +46,42 @@ namespace lms::db::tests
             EXPECT_EQ(allTrackFeatures.results.front(), trackFeatures.getId());
         }
     }
+
+    TEST_F(DatabaseFixture, TrackFeatures_featureValues)
+    {
+        ScopedTrack track{ session };
+        ScopedTrackFeatures trackFeatures{ session, track.lockAndGet(), R"({"lowlevel": {"average_loudness": 0.5, "barkbands": {"mean": [1, 2.5, 3]}, "key": "C"}})" };
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            const FeatureValuesMap featureValuesMap{ trackFeatures.get()->getFeatureValuesMap({ "lowlevel.average_loudness", "lowlevel.barkbands.mean" }) };
+            ASSERT_EQ(featureValuesMap.size(), 2);
+            EXPECT_EQ(featureValuesMap.at("lowlevel.average_loudness"), (FeatureValues{ 0.5 }));
+            EXPECT_EQ(featureValuesMap.at("lowlevel.barkbands.mean"), (FeatureValues{ 1, 2.5, 3 }));
+
+            EXPECT_TRUE(trackFeatures.get()->getFeatureValuesMap({ "lowlevel.key" }).empty());
+            EXPECT_TRUE(trackFeatures.get()->getFeatureValuesMap({ "lowlevel.average_loudness", "lowlevel.missing" }).empty());
+        }
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            TrackFeaturesId lastRetrievedId;
+            std::size_t visitedCount{};
+            TrackFeatures::find(session, lastRetrievedId, 10, { "lowlevel.barkbands.mean" }, [&](TrackId trackId, const FeatureValuesMap& featureValuesMap) {
+                visitedCount++;
+                EXPECT_EQ(trackId, track.getId());
+                ASSERT_EQ(featureValuesMap.size(), 1);
+                EXPECT_EQ(featureValuesMap.at("lowlevel.barkbands.mean"), (FeatureValues{ 1, 2.5, 3 }));
+            });
+            EXPECT_EQ(visitedCount, 1);
+            EXPECT_EQ(lastRetrievedId, trackFeatures.getId());
+
+            TrackFeatures::find(session, lastRetrievedId, 10, { "lowlevel.barkbands.mean" }, [&](TrackId, const FeatureValuesMap&) {
+                visitedCount++;
+            });
+            EXPECT_EQ(visitedCount, 1);
+        }
+    }
 } // namespace lms::db::tests
\ No newline at end of file
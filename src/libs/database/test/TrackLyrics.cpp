@@ -19,11 +19,13 @@
 
 #include "Common.hpp"
 
+#include "database/objects/Directory.hpp"
 #include "database/objects/Track.hpp"
 #include "database/objects/TrackLyrics.hpp"
 
 namespace lms::db::tests
 {
+    using ScopedDirectory = ScopedEntity<db::Directory>;
     using ScopedTrackLyrics = ScopedEntity<db::TrackLyrics>;
 
     TEST_F(DatabaseFixture, TrackLyrics_findAbsoluteFilePath)
@@ -226,4 +228,31 @@ namespace lms::db::tests
             }
         }
     }
-} // namespace lms::db::tests
\ No newline at end of file
+
+    TEST_F(DatabaseFixture, TrackLyrics_findByDirectory)
+    {
+        ScopedDirectory directory1{ session, "/tmp/dir1" };
+        ScopedDirectory directory2{ session, "/tmp/dir2" };
+        ScopedTrackLyrics lyrics1{ session };
+        ScopedTrackLyrics lyrics2{ session };
+
+        {
+            auto transaction{ session.createWriteTransaction() };
+            lyrics1.get().modify()->setAbsoluteFilePath("/tmp/dir1/test.lrc");
+            lyrics1.get().modify()->setDirectory(directory1.get());
+            lyrics2.get().modify()->setAbsoluteFilePath("/tmp/dir2/test.lrc");
+            lyrics2.get().modify()->setDirectory(directory2.get());
+        }
+
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            std::vector<TrackLyricsId> visitedLyrics;
+            TrackLyrics::find(session, TrackLyrics::FindParameters{}.setDirectory(directory1.getId()), [&](const TrackLyrics::pointer& lyrics) {
+                visitedLyrics.push_back(lyrics->getId());
+            });
+            ASSERT_EQ(visitedLyrics.size(), 1);
+            EXPECT_EQ(visitedLyrics.front(), lyrics1.getId());
+        }
+    }
+} // namespace lms::db::tests
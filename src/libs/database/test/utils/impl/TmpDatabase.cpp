@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "database/test/TmpDatabase.hpp"
+
+#include <limits>
+#include <string>
+#include <system_error>
+
+#include "core/Random.hpp"
+#include "database/Session.hpp"
+
+namespace lms::db::tests
+{
+    TmpDatabase::TmpDatabase(Schema schema)
+        : _path{ std::filesystem::temp_directory_path() / ("lms-test-" + std::to_string(core::random::getRandom(0, std::numeric_limits<int>::max())) + ".db") }
+        , _db{ createDb(_path) }
+    {
+        if (schema == Schema::Current)
+        {
+            Session session{ *_db };
+            session.prepareTablesIfNeeded();
+            session.createIndexesIfNeeded();
+        }
+    }
+
+    TmpDatabase::~TmpDatabase()
+    {
+        _db.reset();
+
+        std::error_code ec;
+        std::filesystem::remove(_path, ec);
+    }
+
+    IDb& TmpDatabase::getDb()
+    {
+        return *_db;
+    }
+} // namespace lms::db::tests
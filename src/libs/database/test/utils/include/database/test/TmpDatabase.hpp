@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+
+#include "database/IDb.hpp"
+
+namespace lms::db::tests
+{
+    // Database in a temporary file, removed on destruction
+    class TmpDatabase final
+    {
+    public:
+        enum class Schema
+        {
+            Empty,
+            Current, // all the tables and indexes created
+        };
+
+        TmpDatabase(Schema schema = Schema::Current);
+        ~TmpDatabase();
+        TmpDatabase(const TmpDatabase&) = delete;
+        TmpDatabase& operator=(const TmpDatabase&) = delete;
+
+        IDb& getDb();
+
+    private:
+        const std::filesystem::path _path;
+        std::unique_ptr<IDb> _db;
+    };
+} // namespace lms::db::tests
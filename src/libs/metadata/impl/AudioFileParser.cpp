@@ -392,6 +392,32 @@ namespace lms::metadata
         parseImages(*imageReader, std::move(visitor));
     }
 
+    std::unique_ptr<Track> AudioFileParser::parseMetaDataAndImages(const std::filesystem::path& p, ImageVisitor visitor) const
+    {
+        switch (_params.backend)
+        {
+        case ParserBackend::TagLib:
+            {
+                // Images are read from the file already parsed for the tags
+                taglib::TagLibTagReader tagReader{ p, _params.readStyle, _params.debug };
+                parseImages(taglib::TagLibImageReader{ tagReader.getFile() }, std::move(visitor));
+
+                return parseMetaData(tagReader);
+            }
+
+        case ParserBackend::AvFormat:
+            {
+                // The avformat readers cannot share the same opened file
+                std::unique_ptr<Track> track{ parseMetaData(p) };
+                parseImages(p, std::move(visitor));
+
+                return track;
+            }
+        }
+
+        throw AudioFileParsingException{ "Unhandled parser backend" };
+    }
+
     std::unique_ptr<Track> AudioFileParser::parseMetaData(const ITagReader& tagReader) const
     {
         auto track{ std::make_unique<Track>() };
@@ -43,6 +43,7 @@ namespace lms::metadata
 
     private:
         void parseImages(const std::filesystem::path& p, ImageVisitor visitor) const override;
+        std::unique_ptr<Track> parseMetaDataAndImages(const std::filesystem::path& p, ImageVisitor visitor) const override;
         std::span<const std::filesystem::path> getSupportedExtensions() const override;
 
         void processTags(const ITagReader& reader, Track& track) const;
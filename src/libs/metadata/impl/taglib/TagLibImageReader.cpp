@@ -350,7 +350,8 @@ namespace lms::metadata::taglib
     } // namespace
 
     TagLibImageReader::TagLibImageReader(const std::filesystem::path& p)
-        : _file{ utils::parseFile(p, TagLib::AudioProperties::ReadStyle::Fast, utils::ReadAudioProperties{ false }) }
+        : _ownedFile{ utils::parseFile(p, TagLib::AudioProperties::ReadStyle::Fast, utils::ReadAudioProperties{ false }) }
+        , _file{ _ownedFile.get() }
     {
         if (!_file)
         {
@@ -359,27 +360,32 @@ namespace lms::metadata::taglib
         }
     }
 
+    TagLibImageReader::TagLibImageReader(TagLib::File& file)
+        : _file{ &file }
+    {
+    }
+
     void TagLibImageReader::visitImages(ImageVisitor visitor) const
     {
         // MP3
-        if (TagLib::MPEG::File * mp3File{ dynamic_cast<TagLib::MPEG::File*>(_file.get()) })
+        if (TagLib::MPEG::File * mp3File{ dynamic_cast<TagLib::MPEG::File*>(_file) })
         {
             if (mp3File->hasID3v2Tag())
                 visitID3V2Images(*mp3File->ID3v2Tag(), std::move(visitor));
         }
         // MP4
-        else if (TagLib::MP4::File * mp4File{ dynamic_cast<TagLib::MP4::File*>(_file.get()) })
+        else if (TagLib::MP4::File * mp4File{ dynamic_cast<TagLib::MP4::File*>(_file) })
         {
             visitMP4Images(*mp4File, std::move(visitor));
         }
         // WMA
-        else if (TagLib::ASF::File * asfFile{ dynamic_cast<TagLib::ASF::File*>(_file.get()) })
+        else if (TagLib::ASF::File * asfFile{ dynamic_cast<TagLib::ASF::File*>(_file) })
         {
             if (const TagLib::ASF::Tag * tag{ asfFile->tag() })
                 visitASFImages(*tag, std::move(visitor));
         }
         // FLAC
-        else if (TagLib::FLAC::File * flacFile{ dynamic_cast<TagLib::FLAC::File*>(_file.get()) })
+        else if (TagLib::FLAC::File * flacFile{ dynamic_cast<TagLib::FLAC::File*>(_file) })
         {
             if (flacFile->hasID3v2Tag()) // usage discouraged
                 visitID3V2Images(*flacFile->ID3v2Tag(), std::move(visitor));
@@ -387,35 +393,35 @@ namespace lms::metadata::taglib
                 visitFLACImages(flacFile->pictureList(), std::move(visitor));
         }
         // Ogg vorbis
-        else if (TagLib::Ogg::Vorbis::File * vorbisFile{ dynamic_cast<TagLib::Ogg::Vorbis::File*>(_file.get()) })
+        else if (TagLib::Ogg::Vorbis::File * vorbisFile{ dynamic_cast<TagLib::Ogg::Vorbis::File*>(_file) })
         {
             visitFLACImages(vorbisFile->tag()->pictureList(), std::move(visitor));
         }
         // Ogg Opus
-        else if (TagLib::Ogg::Opus::File * opusFile{ dynamic_cast<TagLib::Ogg::Opus::File*>(_file.get()) })
+        else if (TagLib::Ogg::Opus::File * opusFile{ dynamic_cast<TagLib::Ogg::Opus::File*>(_file) })
         {
             visitFLACImages(opusFile->tag()->pictureList(), std::move(visitor));
         }
         // Aiff
-        else if (TagLib::RIFF::AIFF::File * aiffFile{ dynamic_cast<TagLib::RIFF::AIFF::File*>(_file.get()) })
+        else if (TagLib::RIFF::AIFF::File * aiffFile{ dynamic_cast<TagLib::RIFF::AIFF::File*>(_file) })
         {
             if (aiffFile->hasID3v2Tag())
                 visitID3V2Images(*aiffFile->tag(), std::move(visitor));
         }
         // Wav
-        else if (TagLib::RIFF::WAV::File * wavFile{ dynamic_cast<TagLib::RIFF::WAV::File*>(_file.get()) })
+        else if (TagLib::RIFF::WAV::File * wavFile{ dynamic_cast<TagLib::RIFF::WAV::File*>(_file) })
         {
             if (wavFile->hasID3v2Tag())
                 visitID3V2Images(*wavFile->ID3v2Tag(), std::move(visitor));
         }
         // MPC
-        else if (TagLib::MPC::File * mpcFile{ dynamic_cast<TagLib::MPC::File*>(_file.get()) })
+        else if (TagLib::MPC::File * mpcFile{ dynamic_cast<TagLib::MPC::File*>(_file) })
         {
             if (mpcFile->hasAPETag())
                 visitAPEImages(*mpcFile->APETag(), std::move(visitor));
         }
         // WavPack
-        else if (TagLib::WavPack::File * wavPackFile{ dynamic_cast<TagLib::WavPack::File*>(_file.get()) })
+        else if (TagLib::WavPack::File * wavPackFile{ dynamic_cast<TagLib::WavPack::File*>(_file) })
         {
             if (wavPackFile->hasAPETag())
                 visitAPEImages(*wavPackFile->APETag(), std::move(visitor));
@@ -29,9 +29,12 @@ namespace lms::metadata::taglib
     {
     public:
         TagLibImageReader(const std::filesystem::path& p);
+        TagLibImageReader(TagLib::File& file); // file already parsed, must outlive this reader
 
         void visitImages(ImageVisitor visitor) const override;
 
-        std::unique_ptr<TagLib::File> _file;
+    private:
+        std::unique_ptr<TagLib::File> _ownedFile;
+        TagLib::File* _file{};
     };
 } // namespace lms::metadata::taglib
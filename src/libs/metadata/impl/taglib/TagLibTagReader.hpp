@@ -39,6 +39,8 @@ namespace lms::metadata::taglib
         TagLibTagReader(const TagLibTagReader&) = delete;
         TagLibTagReader& operator=(const TagLibTagReader&) = delete;
 
+        TagLib::File& getFile() { return *_file; }
+
     private:
         void computeAudioProperties();
         void visitTagValues(TagType tag, TagValueVisitor visitor) const override;
@@ -39,6 +39,10 @@ namespace lms::metadata
         using ImageVisitor = std::function<void(const Image&)>;
         virtual void parseImages(const std::filesystem::path& p, ImageVisitor visitor) const = 0;
 
+        // Same as parseMetaData + parseImages, but the file is opened and parsed only once when the backend allows it
+        // Images are visited before the track is returned
+        virtual std::unique_ptr<Track> parseMetaDataAndImages(const std::filesystem::path& p, ImageVisitor visitor) const = 0;
+
         virtual std::span<const std::filesystem::path> getSupportedExtensions() const = 0;
     };
 
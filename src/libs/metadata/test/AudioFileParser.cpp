@@ -17,12 +17,19 @@
  * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include <gtest/gtest.h>
 
 #include <Wt/WTime.h>
 
+#include "core/Random.hpp"
+
 #include "AudioFileParser.hpp"
 #include "TestTagReader.hpp"
 
@@ -930,4 +937,133 @@ namespace lms::metadata::tests
         doTest("2020/01", core::PartialDateTime{ 2020, 1 });
         doTest("2020", core::PartialDateTime{ 2020 });
     }
+
+    namespace
+    {
+        // Minimal MP3 file: an ID3v2.3 tag with a few text frames and two pictures, followed by silent MPEG frames
+        std::vector<char> createTestMp3File()
+        {
+            std::vector<char> frames;
+            auto addFrame{ [&](std::string_view id, std::string_view payload) {
+                frames.insert(std::end(frames), std::cbegin(id), std::cend(id));
+                for (const unsigned shift : { 24, 16, 8, 0 })
+                    frames.push_back(static_cast<char>((payload.size() >> shift) & 0xFF));
+                frames.insert(std::end(frames), { 0, 0 }); // flags
+                frames.insert(std::end(frames), std::cbegin(payload), std::cend(payload));
+            } };
+            auto addTextFrame{ [&](std::string_view id, std::string_view text) {
+                addFrame(id, std::string{ '\0' } /* ISO-8859-1 */ + std::string{ text });
+            } };
+            auto addPictureFrame{ [&](char pictureType, std::string_view description, std::string_view data) {
+                using namespace std::string_literals;
+                addFrame("APIC", "\0image/png\0"s + pictureType + std::string{ description } + '\0' + std::string{ data });
+            } };
+
+            addTextFrame("TIT2", "MyTitle");
+            addTextFrame("TPE1", "MyArtist");
+            addTextFrame("TALB", "MyRelease");
+            addTextFrame("TRCK", "3/10");
+            addTextFrame("TCON", "Rock");
+            addPictureFrame(0x03, "Front", "\x89PNG front data");
+            addPictureFrame(0x04, "Back", "\x89PNG back data");
+
+            std::vector<char> file{ 'I', 'D', '3', 0x03, 0x00, 0x00 };
+            for (const unsigned shift : { 21, 14, 7, 0 })
+                file.push_back(static_cast<char>((frames.size() >> shift) & 0x7F)); // synchsafe size
+            file.insert(std::end(file), std::cbegin(frames), std::cend(frames));
+
+            // MPEG-1 layer III, 128 kbps, 44.1 kHz, joint stereo: 417 bytes per frame
+            constexpr std::size_t mpegFrameSize{ 417 };
+            for (std::size_t i{}; i < 40; ++i)
+            {
+                std::vector<char> mpegFrame(mpegFrameSize, 0);
+                mpegFrame[0] = static_cast<char>(0xFF);
+                mpegFrame[1] = static_cast<char>(0xFB);
+                mpegFrame[2] = static_cast<char>(0x90);
+                mpegFrame[3] = static_cast<char>(0x64);
+                file.insert(std::end(file), std::cbegin(mpegFrame), std::cend(mpegFrame));
+            }
+
+            return file;
+        }
+
+        class TemporaryAudioFile
+        {
+        public:
+            TemporaryAudioFile(const std::vector<char>& content)
+                : _path{ std::filesystem::temp_directory_path() / ("lms-test-parser-" + std::to_string(core::random::getRandom(0, std::numeric_limits<int>::max())) + ".mp3") }
+            {
+                std::ofstream ofs{ _path, std::ios::binary };
+                ofs.write(content.data(), static_cast<std::streamsize>(content.size()));
+            }
+            ~TemporaryAudioFile()
+            {
+                std::error_code ec;
+                std::filesystem::remove(_path, ec);
+            }
+            TemporaryAudioFile(const TemporaryAudioFile&) = delete;
+            TemporaryAudioFile& operator=(const TemporaryAudioFile&) = delete;
+
+            const std::filesystem::path& getPath() const { return _path; }
+
+        private:
+            const std::filesystem::path _path;
+        };
+
+        // Image data is only valid during the visit
+        struct ParsedImage
+        {
+            Image::Type type;
+            std::string mimeType;
+            std::string description;
+            std::vector<std::byte> data;
+
+            bool operator==(const ParsedImage&) const = default;
+        };
+
+        IAudioFileParser::ImageVisitor createImageCollector(std::vector<ParsedImage>& images)
+        {
+            return [&images](const Image& image) {
+                images.push_back(ParsedImage{ image.type, image.mimeType, image.description, std::vector<std::byte>(std::cbegin(image.data), std::cend(image.data)) });
+            };
+        }
+    } // namespace
+
+    TEST(AudioFileParser, parseMetaDataAndImages)
+    {
+        const TemporaryAudioFile file{ createTestMp3File() };
+
+        for (const ParserBackend backend : { ParserBackend::TagLib, ParserBackend::AvFormat })
+        {
+            AudioFileParserParameters params;
+            params.backend = backend;
+            const std::unique_ptr<IAudioFileParser> parser{ createAudioFileParser(params) };
+
+            const std::unique_ptr<Track> track{ parser->parseMetaData(file.getPath()) };
+            std::vector<ParsedImage> images;
+            parser->parseImages(file.getPath(), createImageCollector(images));
+
+            std::vector<ParsedImage> imagesFromSinglePass;
+            const std::unique_ptr<Track> trackFromSinglePass{ parser->parseMetaDataAndImages(file.getPath(), createImageCollector(imagesFromSinglePass)) };
+
+            ASSERT_TRUE(track);
+            ASSERT_TRUE(trackFromSinglePass);
+            EXPECT_EQ(track->title, "MyTitle");
+            EXPECT_EQ(images.size(), 2);
+
+            EXPECT_EQ(trackFromSinglePass->title, track->title);
+            EXPECT_EQ(trackFromSinglePass->artistDisplayName, track->artistDisplayName);
+            EXPECT_EQ(trackFromSinglePass->artists, track->artists);
+            EXPECT_EQ(trackFromSinglePass->medium, track->medium);
+            EXPECT_EQ(trackFromSinglePass->position, track->position);
+            EXPECT_EQ(trackFromSinglePass->genres, track->genres);
+            EXPECT_EQ(trackFromSinglePass->date, track->date);
+            EXPECT_EQ(trackFromSinglePass->audioProperties.bitrate, track->audioProperties.bitrate);
+            EXPECT_EQ(trackFromSinglePass->audioProperties.channelCount, track->audioProperties.channelCount);
+            EXPECT_EQ(trackFromSinglePass->audioProperties.duration, track->audioProperties.duration);
+            EXPECT_EQ(trackFromSinglePass->audioProperties.sampleRate, track->audioProperties.sampleRate);
+
+            EXPECT_EQ(imagesFromSinglePass, images);
+        }
+    }
 } // namespace lms::metadata::tests
@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CatalogService.hpp"
+
+#include <chrono>
+#include <optional>
+
+#include <boost/asio/post.hpp>
+
+#include "core/ILogger.hpp"
+#include "database/IDb.hpp"
+#include "database/Session.hpp"
+#include "database/objects/Artist.hpp"
+#include "database/objects/Release.hpp"
+#include "database/objects/Track.hpp"
+#include "database/objects/TrackArtistLink.hpp"
+
+namespace lms::catalog
+{
+    namespace
+    {
+        void loadTrackIds(db::Session& session, CatalogSnapshot::Builder& builder)
+        {
+            using namespace db;
+
+            Track::FindParameters params;
+            params.setSortMethod(TrackSortMethod::Id);
+            for (const TrackId trackId : Track::findIds(session, params).results)
+                builder.addTrack(trackId);
+
+            for (const TrackSortMethod sortMethod : { TrackSortMethod::AddedDesc, TrackSortMethod::LastWrittenDesc })
+            {
+                params.setSortMethod(sortMethod);
+                builder.setTrackOrder(sortMethod, Track::findIds(session, params).results);
+            }
+        }
+
+        void loadReleaseIds(db::Session& session, CatalogSnapshot::Builder& builder)
+        {
+            using namespace db;
+
+            Release::FindParameters params;
+            params.setSortMethod(ReleaseSortMethod::Id);
+            for (const ReleaseId releaseId : Release::findIds(session, params).results)
+                builder.addRelease(releaseId);
+
+            for (const ReleaseSortMethod sortMethod : { ReleaseSortMethod::SortName, ReleaseSortMethod::AddedDesc, ReleaseSortMethod::LastWrittenDesc })
+            {
+                params.setSortMethod(sortMethod);
+                builder.setReleaseOrder(sortMethod, Release::findIds(session, params).results);
+            }
+        }
+
+        void loadArtistIds(db::Session& session, CatalogSnapshot::Builder& builder)
+        {
+            using namespace db;
+
+            Artist::FindParameters params;
+            params.setSortMethod(ArtistSortMethod::Id);
+            for (const ArtistId artistId : Artist::findIds(session, params).results)
+                builder.addArtist(artistId);
+
+            for (const ArtistSortMethod sortMethod : { ArtistSortMethod::SortName, ArtistSortMethod::AddedDesc, ArtistSortMethod::LastWrittenDesc })
+            {
+                params.setSortMethod(sortMethod);
+                builder.setArtistOrder(sortMethod, Artist::findIds(session, params).results);
+            }
+        }
+
+        std::optional<CatalogSnapshot> loadCatalogSnapshot(db::Session& session, const std::atomic<bool>& refreshCancelled)
+        {
+            using namespace db;
+
+            CatalogSnapshot::Builder builder;
+
+            {
+                // all the orders must be consistent with each other
+                auto transaction{ session.createReadTransaction() };
+
+                loadTrackIds(session, builder);
+                loadReleaseIds(session, builder);
+                loadArtistIds(session, builder);
+            }
+
+            constexpr std::size_t batchSize{ 1'000 };
+
+            TrackId lastRetrievedTrackId;
+            while (true)
+            {
+                if (refreshCancelled)
+                    return std::nullopt;
+
+                auto transaction{ session.createReadTransaction() };
+
+                const IdRange<TrackId> trackIdRange{ Track::findNextIdRange(session, lastRetrievedTrackId, batchSize) };
+                if (!trackIdRange.isValid())
+                    break;
+
+                Track::findReleaseIds(session, trackIdRange, [&](TrackId trackId, ReleaseId releaseId) {
+                    builder.setTrackRelease(trackId, releaseId);
+                });
+                Track::findMediaLibraryIds(session, trackIdRange, [&](TrackId trackId, MediaLibraryId mediaLibraryId) {
+                    builder.setTrackMediaLibrary(trackId, mediaLibraryId);
+                });
+                Track::findClusterIds(session, trackIdRange, [&](TrackId trackId, ClusterId clusterId) {
+                    builder.addTrackCluster(trackId, clusterId);
+                });
+                TrackArtistLink::find(session, trackIdRange, [&](TrackId trackId, ArtistId artistId, TrackArtistLinkType linkType) {
+                    builder.addTrackArtist(trackId, artistId, linkType);
+                });
+
+                lastRetrievedTrackId = trackIdRange.last;
+            }
+
+            ReleaseId lastRetrievedReleaseId;
+            while (true)
+            {
+                if (refreshCancelled)
+                    return std::nullopt;
+
+                auto transaction{ session.createReadTransaction() };
+
+                const IdRange<ReleaseId> releaseIdRange{ Release::findNextIdRange(session, lastRetrievedReleaseId, batchSize) };
+                if (!releaseIdRange.isValid())
+                    break;
+
+                Release::findLabelIds(session, releaseIdRange, [&](ReleaseId releaseId, LabelId labelId) {
+                    builder.addReleaseLabel(releaseId, labelId);
+                });
+                Release::findReleaseTypeIds(session, releaseIdRange, [&](ReleaseId releaseId, ReleaseTypeId releaseTypeId) {
+                    builder.addReleaseType(releaseId, releaseTypeId);
+                });
+
+                lastRetrievedReleaseId = releaseIdRange.last;
+            }
+
+            return builder.build();
+        }
+    } // namespace
+
+    std::unique_ptr<ICatalogService> createCatalogService(boost::asio::io_context& ioContext, db::IDb& db)
+    {
+        return std::make_unique<CatalogService>(ioContext, db);
+    }
+
+    CatalogService::CatalogService(boost::asio::io_context& ioContext, db::IDb& db)
+        : _ioContext{ ioContext }
+        , _db{ db }
+    {
+        refresh();
+    }
+
+    CatalogService::~CatalogService()
+    {
+        std::unique_lock lock{ _refreshMutex };
+
+        _shuttingDown = true;
+        _refreshCancelled = true;
+        _refreshCv.wait(lock, [this] { return !_refreshInProgress; });
+    }
+
+    void CatalogService::refresh()
+    {
+        {
+            const std::scoped_lock lock{ _refreshMutex };
+
+            if (_shuttingDown)
+                return;
+
+            {
+                const std::unique_lock snapshotLock{ _snapshotMutex };
+                _snapshot.reset();
+            }
+
+            _refreshRequested = true;
+            if (_refreshInProgress)
+            {
+                // the current refresh will start over once cancelled
+                _refreshCancelled = true;
+                return;
+            }
+
+            _refreshInProgress = true;
+        }
+
+        boost::asio::post(_ioContext, [this] { processRefreshRequests(); });
+    }
+
+    void CatalogService::waitForRefresh()
+    {
+        std::unique_lock lock{ _refreshMutex };
+        _refreshCv.wait(lock, [this] { return !_refreshInProgress; });
+    }
+
+    void CatalogService::processRefreshRequests()
+    {
+        while (true)
+        {
+            {
+                const std::scoped_lock lock{ _refreshMutex };
+
+                if (!_refreshRequested || _shuttingDown)
+                {
+                    _refreshInProgress = false;
+                    _refreshCv.notify_all();
+                    return;
+                }
+
+                _refreshRequested = false;
+                _refreshCancelled = false;
+            }
+
+            try
+            {
+                doRefresh();
+            }
+            catch (const std::exception& e)
+            {
+                LMS_LOG(CATALOG, ERROR, "Cannot refresh catalog snapshot: " << e.what());
+            }
+        }
+    }
+
+    void CatalogService::doRefresh()
+    {
+        const auto start{ std::chrono::steady_clock::now() };
+        std::optional<CatalogSnapshot> loadedSnapshot{ loadCatalogSnapshot(_db.getTLSSession(), _refreshCancelled) };
+        if (!loadedSnapshot)
+        {
+            LMS_LOG(CATALOG, DEBUG, "Catalog snapshot refresh cancelled");
+            return;
+        }
+
+        auto snapshot{ std::make_shared<const CatalogSnapshot>(std::move(*loadedSnapshot)) };
+        const auto duration{ std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start) };
+
+        LMS_LOG(CATALOG, INFO, "Catalog snapshot loaded in " << duration.count() << " ms: " << snapshot->getTrackCount() << " tracks, " << snapshot->getReleaseCount() << " releases, " << snapshot->getArtistCount() << " artists, " << (snapshot->getMemoryUsage() / 1024) << " KiB");
+
+        // A refresh requested in the meantime means this snapshot is already stale
+        const std::scoped_lock lock{ _refreshMutex };
+        if (_refreshCancelled)
+        {
+            LMS_LOG(CATALOG, DEBUG, "Catalog snapshot refresh cancelled");
+            return;
+        }
+
+        const std::unique_lock snapshotLock{ _snapshotMutex };
+        _snapshot = snapshot;
+        _refreshStats.refreshCount++;
+        _refreshStats.lastRefreshDateTime = Wt::WDateTime::currentDateTime();
+        _refreshStats.lastRefreshDuration = duration;
+    }
+
+    std::shared_ptr<const CatalogSnapshot> CatalogService::getSnapshot() const
+    {
+        const std::shared_lock lock{ _snapshotMutex };
+        return _snapshot;
+    }
+
+    ICatalogService::RefreshStats CatalogService::getRefreshStats() const
+    {
+        const std::shared_lock lock{ _snapshotMutex };
+        return _refreshStats;
+    }
+} // namespace lms::catalog
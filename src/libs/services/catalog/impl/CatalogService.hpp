@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#include "services/catalog/ICatalogService.hpp"
+
+namespace lms::catalog
+{
+    class CatalogService : public ICatalogService
+    {
+    public:
+        CatalogService(boost::asio::io_context& ioContext, db::IDb& db);
+        ~CatalogService() override;
+        CatalogService(const CatalogService&) = delete;
+        CatalogService& operator=(const CatalogService&) = delete;
+
+    private:
+        void refresh() override;
+        void waitForRefresh() override;
+        std::shared_ptr<const CatalogSnapshot> getSnapshot() const override;
+        RefreshStats getRefreshStats() const override;
+
+        void processRefreshRequests(); // on the io context
+        void doRefresh();
+
+        boost::asio::io_context& _ioContext;
+        db::IDb& _db;
+
+        std::mutex _refreshMutex;
+        std::condition_variable _refreshCv;
+        bool _refreshInProgress{};
+        bool _refreshRequested{}; // another refresh is to be done once the current one is over
+        bool _shuttingDown{};
+        std::atomic<bool> _refreshCancelled{};
+
+        mutable std::shared_mutex _snapshotMutex;
+        std::shared_ptr<const CatalogSnapshot> _snapshot;
+        RefreshStats _refreshStats;
+    };
+} // namespace lms::catalog
@@ -0,0 +1,515 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "services/catalog/CatalogSnapshot.hpp"
+
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+
+#include "core/Random.hpp"
+
+namespace lms::catalog
+{
+    // Dense set of ordinals, used for the release and artist results
+    class CatalogSnapshot::Bitset
+    {
+    public:
+        Bitset(std::size_t size)
+            : _words((size + bitsPerWord - 1) / bitsPerWord)
+        {
+        }
+
+        Bitset(std::size_t size, const OrdinalBitmap& bitmap)
+            : Bitset{ size }
+        {
+            bitmap.visit([this](Ordinal ordinal) { set(ordinal); });
+        }
+
+        void set(Ordinal ordinal) { _words[ordinal / bitsPerWord] |= Word{ 1 } << (ordinal % bitsPerWord); }
+        bool test(Ordinal ordinal) const { return _words[ordinal / bitsPerWord] & (Word{ 1 } << (ordinal % bitsPerWord)); }
+
+        Bitset& operator&=(const Bitset& other)
+        {
+            for (std::size_t i{}; i < _words.size(); ++i)
+                _words[i] &= other._words[i];
+            return *this;
+        }
+
+    private:
+        using Word = std::uint64_t;
+        static constexpr std::size_t bitsPerWord{ 64 };
+
+        std::vector<Word> _words;
+    };
+
+    namespace
+    {
+        template<typename IdType>
+        void sortAndRemoveDuplicates(std::vector<IdType>& ids)
+        {
+            std::sort(std::begin(ids), std::end(ids));
+            ids.erase(std::unique(std::begin(ids), std::end(ids)), std::end(ids));
+        }
+
+        template<typename KeyType>
+        std::unordered_map<KeyType, OrdinalBitmap> toBitmaps(std::unordered_map<KeyType, std::vector<OrdinalBitmap::Value>>& index)
+        {
+            std::unordered_map<KeyType, OrdinalBitmap> res;
+            for (auto& [key, ordinals] : index)
+            {
+                sortAndRemoveDuplicates(ordinals);
+                res.emplace(key, OrdinalBitmap::fromSortedValues(ordinals));
+            }
+            index.clear();
+
+            return res;
+        }
+
+        // std::nullopt if there is no bitmap
+        std::optional<OrdinalBitmap> intersect(std::vector<const OrdinalBitmap*>& bitmaps)
+        {
+            if (bitmaps.empty())
+                return std::nullopt;
+            if (std::find(std::cbegin(bitmaps), std::cend(bitmaps), nullptr) != std::cend(bitmaps))
+                return OrdinalBitmap{};
+
+            // start with the smallest bitmaps to keep the intermediate results small
+            std::sort(std::begin(bitmaps), std::end(bitmaps), [](const OrdinalBitmap* bitmap1, const OrdinalBitmap* bitmap2) { return bitmap1->getCount() < bitmap2->getCount(); });
+
+            OrdinalBitmap res{ *bitmaps.front() };
+            for (std::size_t i{ 1 }; i < bitmaps.size() && !res.isEmpty(); ++i)
+                res = res & *bitmaps[i];
+
+            return res;
+        }
+
+        template<typename KeyType>
+        std::size_t getMemoryUsage(const std::unordered_map<KeyType, OrdinalBitmap>& index)
+        {
+            std::size_t res{ index.bucket_count() * sizeof(void*) };
+            for (const auto& [key, bitmap] : index)
+                res += sizeof(std::pair<const KeyType, OrdinalBitmap>) + sizeof(void*) + bitmap.getMemoryUsage();
+
+            return res;
+        }
+    } // namespace
+
+    template<typename IdType, typename SortMethodType>
+    CatalogSnapshot::Ordinal CatalogSnapshot::Objects<IdType, SortMethodType>::findOrdinal(IdType id) const
+    {
+        const auto it{ std::lower_bound(std::cbegin(ids), std::cend(ids), id) };
+        if (it == std::cend(ids) || *it != id)
+            return invalidOrdinal;
+
+        return static_cast<Ordinal>(std::distance(std::cbegin(ids), it));
+    }
+
+    template<typename IdType, typename SortMethodType>
+    const std::vector<CatalogSnapshot::Ordinal>* CatalogSnapshot::Objects<IdType, SortMethodType>::findOrder(SortMethodType sortMethod) const
+    {
+        const auto it{ std::find_if(std::cbegin(orders), std::cend(orders), [&](const auto& order) { return order.first == sortMethod; }) };
+        return it != std::cend(orders) ? &it->second : nullptr;
+    }
+
+    template<typename IdType, typename SortMethodType>
+    std::size_t CatalogSnapshot::Objects<IdType, SortMethodType>::getMemoryUsage() const
+    {
+        std::size_t res{ ids.capacity() * sizeof(IdType) + orders.capacity() * sizeof(std::pair<SortMethodType, std::vector<Ordinal>>) };
+        for (const auto& [sortMethod, ordinals] : orders)
+            res += ordinals.capacity() * sizeof(Ordinal);
+
+        return res;
+    }
+
+    void CatalogSnapshot::Builder::addTrack(db::TrackId trackId)
+    {
+        _trackIds.push_back(trackId);
+    }
+
+    void CatalogSnapshot::Builder::setTrackRelease(db::TrackId trackId, db::ReleaseId releaseId)
+    {
+        _trackReleases.emplace_back(trackId, releaseId);
+    }
+
+    void CatalogSnapshot::Builder::setTrackMediaLibrary(db::TrackId trackId, db::MediaLibraryId mediaLibraryId)
+    {
+        _trackMediaLibraries.emplace_back(trackId, mediaLibraryId);
+    }
+
+    void CatalogSnapshot::Builder::addTrackCluster(db::TrackId trackId, db::ClusterId clusterId)
+    {
+        _trackClusters.emplace_back(trackId, clusterId);
+    }
+
+    void CatalogSnapshot::Builder::addTrackArtist(db::TrackId trackId, db::ArtistId artistId, db::TrackArtistLinkType linkType)
+    {
+        _trackArtists.emplace_back(TrackArtist{ trackId, artistId, linkType });
+    }
+
+    void CatalogSnapshot::Builder::addRelease(db::ReleaseId releaseId)
+    {
+        _releaseIds.push_back(releaseId);
+    }
+
+    void CatalogSnapshot::Builder::addReleaseLabel(db::ReleaseId releaseId, db::LabelId labelId)
+    {
+        _releaseLabels.emplace_back(releaseId, labelId);
+    }
+
+    void CatalogSnapshot::Builder::addReleaseType(db::ReleaseId releaseId, db::ReleaseTypeId releaseTypeId)
+    {
+        _releaseTypes.emplace_back(releaseId, releaseTypeId);
+    }
+
+    void CatalogSnapshot::Builder::addArtist(db::ArtistId artistId)
+    {
+        _artistIds.push_back(artistId);
+    }
+
+    void CatalogSnapshot::Builder::setTrackOrder(db::TrackSortMethod sortMethod, std::vector<db::TrackId> trackIds)
+    {
+        _trackOrders.emplace_back(sortMethod, std::move(trackIds));
+    }
+
+    void CatalogSnapshot::Builder::setReleaseOrder(db::ReleaseSortMethod sortMethod, std::vector<db::ReleaseId> releaseIds)
+    {
+        _releaseOrders.emplace_back(sortMethod, std::move(releaseIds));
+    }
+
+    void CatalogSnapshot::Builder::setArtistOrder(db::ArtistSortMethod sortMethod, std::vector<db::ArtistId> artistIds)
+    {
+        _artistOrders.emplace_back(sortMethod, std::move(artistIds));
+    }
+
+    CatalogSnapshot CatalogSnapshot::Builder::build()
+    {
+        CatalogSnapshot snapshot;
+
+        const auto buildObjects{ [](auto& objects, auto& ids, auto& orders) {
+            sortAndRemoveDuplicates(ids);
+            objects.ids = std::move(ids);
+
+            for (auto& [sortMethod, orderedIds] : orders)
+            {
+                std::vector<Ordinal> ordinals;
+                ordinals.reserve(orderedIds.size());
+                for (const auto id : orderedIds)
+                {
+                    if (const Ordinal ordinal{ objects.findOrdinal(id) }; ordinal != invalidOrdinal)
+                        ordinals.push_back(ordinal);
+                }
+                objects.orders.emplace_back(sortMethod, std::move(ordinals));
+            }
+            orders.clear();
+        } };
+
+        buildObjects(snapshot._tracks, _trackIds, _trackOrders);
+        buildObjects(snapshot._releases, _releaseIds, _releaseOrders);
+        buildObjects(snapshot._artists, _artistIds, _artistOrders);
+
+        snapshot._trackReleases.assign(snapshot._tracks.ids.size(), invalidOrdinal);
+        for (const auto& [trackId, releaseId] : _trackReleases)
+        {
+            const Ordinal track{ snapshot._tracks.findOrdinal(trackId) };
+            if (track != invalidOrdinal)
+                snapshot._trackReleases[track] = snapshot._releases.findOrdinal(releaseId);
+        }
+        _trackReleases.clear();
+
+        const auto buildTrackIndex{ [&](auto& index, auto& trackValues) {
+            std::unordered_map<typename std::decay_t<decltype(index)>::key_type, std::vector<Ordinal>> tracksByValue;
+            for (const auto& [trackId, value] : trackValues)
+            {
+                if (const Ordinal track{ snapshot._tracks.findOrdinal(trackId) }; track != invalidOrdinal)
+                    tracksByValue[value].push_back(track);
+            }
+            trackValues.clear();
+
+            index = toBitmaps(tracksByValue);
+        } };
+
+        buildTrackIndex(snapshot._tracksByMediaLibrary, _trackMediaLibraries);
+        buildTrackIndex(snapshot._tracksByCluster, _trackClusters);
+
+        // (release, track) pairs, to find the tracks of a release
+        std::vector<std::pair<Ordinal, Ordinal>> releaseTracks;
+        releaseTracks.reserve(snapshot._trackReleases.size());
+        for (Ordinal track{}; track < snapshot._trackReleases.size(); ++track)
+        {
+            if (const Ordinal release{ snapshot._trackReleases[track] }; release != invalidOrdinal)
+                releaseTracks.emplace_back(release, track);
+        }
+        std::sort(std::begin(releaseTracks), std::end(releaseTracks));
+
+        const auto buildTrackIndexFromReleases{ [&](auto& index, auto& releaseValues) {
+            std::unordered_map<typename std::decay_t<decltype(index)>::key_type, std::vector<Ordinal>> tracksByValue;
+            for (const auto& [releaseId, value] : releaseValues)
+            {
+                const Ordinal release{ snapshot._releases.findOrdinal(releaseId) };
+                if (release == invalidOrdinal)
+                    continue;
+
+                auto& tracks{ tracksByValue[value] };
+                for (auto it{ std::lower_bound(std::cbegin(releaseTracks), std::cend(releaseTracks), std::make_pair(release, Ordinal{})) }; it != std::cend(releaseTracks) && it->first == release; ++it)
+                    tracks.push_back(it->second);
+            }
+            releaseValues.clear();
+
+            index = toBitmaps(tracksByValue);
+        } };
+
+        buildTrackIndexFromReleases(snapshot._tracksByLabel, _releaseLabels);
+        buildTrackIndexFromReleases(snapshot._tracksByReleaseType, _releaseTypes);
+
+        std::vector<std::tuple<Ordinal, Ordinal, db::TrackArtistLinkType>> trackArtists;
+        trackArtists.reserve(_trackArtists.size());
+        for (const TrackArtist& trackArtist : _trackArtists)
+        {
+            const Ordinal track{ snapshot._tracks.findOrdinal(trackArtist.trackId) };
+            const Ordinal artist{ snapshot._artists.findOrdinal(trackArtist.artistId) };
+            if (track != invalidOrdinal && artist != invalidOrdinal)
+                trackArtists.emplace_back(track, artist, trackArtist.linkType);
+        }
+        _trackArtists.clear();
+        sortAndRemoveDuplicates(trackArtists);
+
+        snapshot._trackArtistOffsets.assign(snapshot._tracks.ids.size() + 1, 0);
+        snapshot._trackArtists.reserve(trackArtists.size());
+        for (const auto& [track, artist, linkType] : trackArtists)
+        {
+            snapshot._trackArtistOffsets[track + 1]++;
+            snapshot._trackArtists.push_back(ArtistLink{ artist, linkType });
+        }
+        for (std::size_t i{}; i < snapshot._tracks.ids.size(); ++i)
+            snapshot._trackArtistOffsets[i + 1] += snapshot._trackArtistOffsets[i];
+
+        return snapshot;
+    }
+
+    std::optional<db::RangeResults<db::TrackId>> CatalogSnapshot::findTracks(const db::Filters& filters, db::TrackSortMethod sortMethod, std::optional<db::Range> range) const
+    {
+        if (sortMethod == db::TrackSortMethod::None)
+            sortMethod = db::TrackSortMethod::Id;
+
+        std::optional<OrdinalBitmap> matchingTracks{ findMatchingTracks(filters) };
+        if (const std::optional<OrdinalBitmap> clusterTracks{ findTracksInAllClusters(filters.clusters) })
+            matchingTracks = matchingTracks ? (*matchingTracks & *clusterTracks) : *clusterTracks;
+
+        if (!matchingTracks)
+            return collect(_tracks, nullptr, sortMethod, range);
+
+        const Bitset matchingTrackSet{ _tracks.ids.size(), *matchingTracks };
+        return collect(_tracks, &matchingTrackSet, sortMethod, range);
+    }
+
+    std::optional<db::RangeResults<db::ReleaseId>> CatalogSnapshot::findReleases(const db::Filters& filters, db::ReleaseSortMethod sortMethod, std::optional<db::Range> range) const
+    {
+        const std::optional<OrdinalBitmap> matchingTracks{ findMatchingTracks(filters) };
+        const std::optional<OrdinalBitmap> clusterTracks{ findTracksInAllClusters(filters.clusters) };
+        if (!matchingTracks && !clusterTracks)
+            return collect(_releases, nullptr, sortMethod, range);
+
+        std::optional<Bitset> matchingReleases;
+        if (matchingTracks)
+            matchingReleases = getTrackReleases(*matchingTracks);
+        if (clusterTracks)
+        {
+            if (matchingReleases)
+                *matchingReleases &= getTrackReleases(*clusterTracks);
+            else
+                matchingReleases = getTrackReleases(*clusterTracks);
+        }
+
+        return collect(_releases, &*matchingReleases, sortMethod, range);
+    }
+
+    std::optional<db::RangeResults<db::ArtistId>> CatalogSnapshot::findArtists(const db::Filters& filters, std::optional<db::TrackArtistLinkType> linkType, db::ArtistSortMethod sortMethod, std::optional<db::Range> range) const
+    {
+        const std::optional<OrdinalBitmap> matchingTracks{ findMatchingTracks(filters) };
+        const std::optional<OrdinalBitmap> clusterTracks{ findTracksInAllClusters(filters.clusters) };
+        if (!matchingTracks && !clusterTracks && !linkType)
+            return collect(_artists, nullptr, sortMethod, range);
+
+        // the link type applies to the tracks matching the other filters, but not to the ones in all the clusters
+        Bitset matchingArtists{ getTrackArtists(matchingTracks ? &*matchingTracks : nullptr, linkType) };
+        if (clusterTracks)
+            matchingArtists &= getTrackArtists(&*clusterTracks, std::nullopt);
+
+        return collect(_artists, &matchingArtists, sortMethod, range);
+    }
+
+    std::size_t CatalogSnapshot::getMemoryUsage() const
+    {
+        return _tracks.getMemoryUsage()
+               + _releases.getMemoryUsage()
+               + _artists.getMemoryUsage()
+               + _trackReleases.capacity() * sizeof(Ordinal)
+               + _trackArtistOffsets.capacity() * sizeof(Ordinal)
+               + _trackArtists.capacity() * sizeof(ArtistLink)
+               + catalog::getMemoryUsage(_tracksByMediaLibrary)
+               + catalog::getMemoryUsage(_tracksByCluster)
+               + catalog::getMemoryUsage(_tracksByLabel)
+               + catalog::getMemoryUsage(_tracksByReleaseType);
+    }
+
+    std::optional<OrdinalBitmap> CatalogSnapshot::findMatchingTracks(const db::Filters& filters) const
+    {
+        std::vector<const OrdinalBitmap*> bitmaps;
+        const auto addBitmap{ [&](const auto& index, auto value) {
+            const auto it{ index.find(value) };
+            bitmaps.push_back(it != std::cend(index) ? &it->second : nullptr);
+        } };
+
+        if (filters.mediaLibrary.isValid())
+            addBitmap(_tracksByMediaLibrary, filters.mediaLibrary);
+        if (filters.clusters.size() == 1)
+            addBitmap(_tracksByCluster, filters.clusters.front());
+        if (filters.label.isValid())
+            addBitmap(_tracksByLabel, filters.label);
+        if (filters.releaseType.isValid())
+            addBitmap(_tracksByReleaseType, filters.releaseType);
+
+        return intersect(bitmaps);
+    }
+
+    std::optional<OrdinalBitmap> CatalogSnapshot::findTracksInAllClusters(std::span<const db::ClusterId> clusters) const
+    {
+        if (clusters.size() < 2)
+            return std::nullopt;
+
+        std::vector<const OrdinalBitmap*> bitmaps;
+        for (const db::ClusterId clusterId : clusters)
+        {
+            const auto it{ _tracksByCluster.find(clusterId) };
+            bitmaps.push_back(it != std::cend(_tracksByCluster) ? &it->second : nullptr);
+        }
+
+        return intersect(bitmaps);
+    }
+
+    CatalogSnapshot::Bitset CatalogSnapshot::getTrackReleases(const OrdinalBitmap& tracks) const
+    {
+        Bitset releases{ _releases.ids.size() };
+        tracks.visit([&](Ordinal track) {
+            if (const Ordinal release{ _trackReleases[track] }; release != invalidOrdinal)
+                releases.set(release);
+        });
+
+        return releases;
+    }
+
+    CatalogSnapshot::Bitset CatalogSnapshot::getTrackArtists(const OrdinalBitmap* tracks, std::optional<db::TrackArtistLinkType> linkType) const
+    {
+        Bitset artists{ _artists.ids.size() };
+        const auto addTrackArtists{ [&](Ordinal track) {
+            for (Ordinal i{ _trackArtistOffsets[track] }; i < _trackArtistOffsets[track + 1]; ++i)
+            {
+                if (!linkType || _trackArtists[i].linkType == *linkType)
+                    artists.set(_trackArtists[i].artist);
+            }
+        } };
+
+        if (tracks)
+            tracks->visit(addTrackArtists);
+        else
+        {
+            for (Ordinal track{}; track < _tracks.ids.size(); ++track)
+                addTrackArtists(track);
+        }
+
+        return artists;
+    }
+
+    template<typename IdType, typename SortMethodType>
+    std::optional<db::RangeResults<IdType>> CatalogSnapshot::collect(const Objects<IdType, SortMethodType>& objects, const Bitset* matchingObjects, SortMethodType sortMethod, std::optional<db::Range> range)
+    {
+        const auto isMatching{ [&](Ordinal ordinal) { return !matchingObjects || matchingObjects->test(ordinal); } };
+
+        db::RangeResults<IdType> res;
+        res.range.offset = range ? range->offset : 0;
+
+        if (sortMethod == SortMethodType::Random)
+        {
+            std::vector<Ordinal> ordinals;
+            for (Ordinal ordinal{}; ordinal < objects.ids.size(); ++ordinal)
+            {
+                if (isMatching(ordinal))
+                    ordinals.push_back(ordinal);
+            }
+            core::random::shuffleContainer(ordinals);
+
+            const std::size_t offset{ std::min(res.range.offset, ordinals.size()) };
+            const std::size_t size{ range ? std::min(range->size, ordinals.size() - offset) : ordinals.size() - offset };
+
+            res.results.reserve(size);
+            for (std::size_t i{}; i < size; ++i)
+                res.results.push_back(objects.ids[ordinals[offset + i]]);
+            res.moreResults = offset + size < ordinals.size();
+        }
+        else
+        {
+            const std::vector<Ordinal>* order{ objects.findOrder(sortMethod) };
+            if (!order && sortMethod != SortMethodType::Id)
+                return std::nullopt;
+
+            std::size_t skippedCount{};
+            // returns false once the requested range is complete
+            const auto visit{ [&](Ordinal ordinal) {
+                if (!isMatching(ordinal))
+                    return true;
+
+                if (skippedCount < res.range.offset)
+                {
+                    skippedCount++;
+                    return true;
+                }
+
+                if (range && res.results.size() == range->size)
+                {
+                    res.moreResults = true;
+                    return false;
+                }
+
+                res.results.push_back(objects.ids[ordinal]);
+                return true;
+            } };
+
+            if (order)
+            {
+                for (const Ordinal ordinal : *order)
+                {
+                    if (!visit(ordinal))
+                        break;
+                }
+            }
+            else
+            {
+                for (Ordinal ordinal{}; ordinal < objects.ids.size(); ++ordinal)
+                {
+                    if (!visit(ordinal))
+                        break;
+                }
+            }
+        }
+
+        res.range.size = res.results.size();
+        return res;
+    }
+} // namespace lms::catalog
@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "services/catalog/OrdinalBitmap.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace lms::catalog
+{
+    namespace
+    {
+        constexpr std::uint16_t getHigh(OrdinalBitmap::Value value)
+        {
+            return static_cast<std::uint16_t>(value >> 16);
+        }
+
+        constexpr std::uint16_t getLow(OrdinalBitmap::Value value)
+        {
+            return static_cast<std::uint16_t>(value & 0xFFFF);
+        }
+
+        template<typename Word>
+        bool testBit(const std::vector<Word>& words, std::uint16_t low)
+        {
+            constexpr std::size_t bitsPerWord{ sizeof(Word) * 8 };
+            return (words[low / bitsPerWord] >> (low % bitsPerWord)) & 1;
+        }
+
+        template<typename Word>
+        void setBit(std::vector<Word>& words, std::uint16_t low)
+        {
+            constexpr std::size_t bitsPerWord{ sizeof(Word) * 8 };
+            words[low / bitsPerWord] |= Word{ 1 } << (low % bitsPerWord);
+        }
+
+        template<typename Word>
+        std::uint32_t countBits(const std::vector<Word>& words)
+        {
+            std::uint32_t count{};
+            for (const Word word : words)
+                count += std::popcount(word);
+
+            return count;
+        }
+    } // namespace
+
+    OrdinalBitmap OrdinalBitmap::fromSortedValues(std::span<const Value> values)
+    {
+        OrdinalBitmap res;
+
+        auto it{ std::cbegin(values) };
+        while (it != std::cend(values))
+        {
+            const std::uint16_t key{ getHigh(*it) };
+            const auto chunkEnd{ std::partition_point(it, std::cend(values), [=](Value value) { return getHigh(value) == key; }) };
+
+            Chunk chunk;
+            chunk.key = key;
+            chunk.count = static_cast<std::uint32_t>(std::distance(it, chunkEnd));
+            chunk.values.reserve(chunk.count);
+            std::transform(it, chunkEnd, std::back_inserter(chunk.values), getLow);
+            optimize(chunk);
+
+            res._chunks.push_back(std::move(chunk));
+            it = chunkEnd;
+        }
+
+        res._chunks.shrink_to_fit();
+        return res;
+    }
+
+    bool OrdinalBitmap::contains(Value value) const
+    {
+        const std::uint16_t key{ getHigh(value) };
+        const auto it{ std::lower_bound(std::cbegin(_chunks), std::cend(_chunks), key, [](const Chunk& chunk, std::uint16_t key) { return chunk.key < key; }) };
+        if (it == std::cend(_chunks) || it->key != key)
+            return false;
+
+        if (it->isDense())
+            return testBit(it->words, getLow(value));
+
+        return std::binary_search(std::cbegin(it->values), std::cend(it->values), getLow(value));
+    }
+
+    std::size_t OrdinalBitmap::getCount() const
+    {
+        std::size_t count{};
+        for (const Chunk& chunk : _chunks)
+            count += chunk.count;
+
+        return count;
+    }
+
+    std::size_t OrdinalBitmap::getMemoryUsage() const
+    {
+        std::size_t res{ _chunks.capacity() * sizeof(Chunk) };
+        for (const Chunk& chunk : _chunks)
+            res += chunk.values.capacity() * sizeof(std::uint16_t) + chunk.words.capacity() * sizeof(Word);
+
+        return res;
+    }
+
+    OrdinalBitmap OrdinalBitmap::operator&(const OrdinalBitmap& other) const
+    {
+        OrdinalBitmap res;
+
+        auto it1{ std::cbegin(_chunks) };
+        auto it2{ std::cbegin(other._chunks) };
+        while (it1 != std::cend(_chunks) && it2 != std::cend(other._chunks))
+        {
+            if (it1->key < it2->key)
+                ++it1;
+            else if (it2->key < it1->key)
+                ++it2;
+            else
+            {
+                Chunk chunk{ intersect(*it1++, *it2++) };
+                if (chunk.count > 0)
+                    res._chunks.push_back(std::move(chunk));
+            }
+        }
+
+        return res;
+    }
+
+    OrdinalBitmap OrdinalBitmap::operator|(const OrdinalBitmap& other) const
+    {
+        OrdinalBitmap res;
+        res._chunks.reserve(std::max(_chunks.size(), other._chunks.size()));
+
+        auto it1{ std::cbegin(_chunks) };
+        auto it2{ std::cbegin(other._chunks) };
+        while (it1 != std::cend(_chunks) || it2 != std::cend(other._chunks))
+        {
+            if (it2 == std::cend(other._chunks) || (it1 != std::cend(_chunks) && it1->key < it2->key))
+                res._chunks.push_back(*it1++);
+            else if (it1 == std::cend(_chunks) || it2->key < it1->key)
+                res._chunks.push_back(*it2++);
+            else
+                res._chunks.push_back(unite(*it1++, *it2++));
+        }
+
+        return res;
+    }
+
+    OrdinalBitmap::Chunk OrdinalBitmap::intersect(const Chunk& chunk1, const Chunk& chunk2)
+    {
+        Chunk res;
+        res.key = chunk1.key;
+
+        if (chunk1.isDense() && chunk2.isDense())
+        {
+            res.words.resize(wordsPerChunk);
+            for (std::size_t i{}; i < wordsPerChunk; ++i)
+                res.words[i] = chunk1.words[i] & chunk2.words[i];
+            res.count = countBits(res.words);
+        }
+        else if (chunk1.isDense() || chunk2.isDense())
+        {
+            const Chunk& denseChunk{ chunk1.isDense() ? chunk1 : chunk2 };
+            const Chunk& sparseChunk{ chunk1.isDense() ? chunk2 : chunk1 };
+
+            std::copy_if(std::cbegin(sparseChunk.values), std::cend(sparseChunk.values), std::back_inserter(res.values), [&](std::uint16_t low) { return testBit(denseChunk.words, low); });
+            res.count = static_cast<std::uint32_t>(res.values.size());
+        }
+        else
+        {
+            std::set_intersection(std::cbegin(chunk1.values), std::cend(chunk1.values), std::cbegin(chunk2.values), std::cend(chunk2.values), std::back_inserter(res.values));
+            res.count = static_cast<std::uint32_t>(res.values.size());
+        }
+
+        optimize(res);
+        return res;
+    }
+
+    OrdinalBitmap::Chunk OrdinalBitmap::unite(const Chunk& chunk1, const Chunk& chunk2)
+    {
+        Chunk res;
+        res.key = chunk1.key;
+
+        if (chunk1.isDense() || chunk2.isDense())
+        {
+            res.words.assign(wordsPerChunk, 0);
+            for (const Chunk* chunk : { &chunk1, &chunk2 })
+            {
+                if (chunk->isDense())
+                {
+                    for (std::size_t i{}; i < wordsPerChunk; ++i)
+                        res.words[i] |= chunk->words[i];
+                }
+                else
+                {
+                    for (const std::uint16_t low : chunk->values)
+                        setBit(res.words, low);
+                }
+            }
+            res.count = countBits(res.words);
+        }
+        else
+        {
+            std::set_union(std::cbegin(chunk1.values), std::cend(chunk1.values), std::cbegin(chunk2.values), std::cend(chunk2.values), std::back_inserter(res.values));
+            res.count = static_cast<std::uint32_t>(res.values.size());
+        }
+
+        optimize(res);
+        return res;
+    }
+
+    void OrdinalBitmap::optimize(Chunk& chunk)
+    {
+        if (chunk.isDense() && chunk.count <= maxSparseCount)
+        {
+            chunk.values.reserve(chunk.count);
+            for (std::size_t i{}; i < wordsPerChunk; ++i)
+            {
+                Word word{ chunk.words[i] };
+                while (word)
+                {
+                    chunk.values.push_back(static_cast<std::uint16_t>(i * bitsPerWord + std::countr_zero(word)));
+                    word &= word - 1;
+                }
+            }
+            chunk.words.clear();
+            chunk.words.shrink_to_fit();
+        }
+        else if (!chunk.isDense() && chunk.count > maxSparseCount)
+        {
+            chunk.words.assign(wordsPerChunk, 0);
+            for (const std::uint16_t low : chunk.values)
+                setBit(chunk.words, low);
+            chunk.values.clear();
+            chunk.values.shrink_to_fit();
+        }
+        else if (!chunk.isDense())
+            chunk.values.shrink_to_fit();
+    }
+} // namespace lms::catalog
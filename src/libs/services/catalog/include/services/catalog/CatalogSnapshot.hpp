@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "database/Types.hpp"
+#include "database/objects/ArtistId.hpp"
+#include "database/objects/ClusterId.hpp"
+#include "database/objects/Filters.hpp"
+#include "database/objects/LabelId.hpp"
+#include "database/objects/MediaLibraryId.hpp"
+#include "database/objects/ReleaseId.hpp"
+#include "database/objects/ReleaseTypeId.hpp"
+#include "database/objects/TrackId.hpp"
+#include "services/catalog/OrdinalBitmap.hpp"
+
+namespace lms::catalog
+{
+    // Immutable, in memory copy of the catalog used to serve the most common listings without querying the database
+    // Objects are referred to by their ordinal, which is their rank in id order
+    class CatalogSnapshot
+    {
+    public:
+        class Builder
+        {
+        public:
+            void addTrack(db::TrackId trackId);
+            void setTrackRelease(db::TrackId trackId, db::ReleaseId releaseId);
+            void setTrackMediaLibrary(db::TrackId trackId, db::MediaLibraryId mediaLibraryId);
+            void addTrackCluster(db::TrackId trackId, db::ClusterId clusterId);
+            void addTrackArtist(db::TrackId trackId, db::ArtistId artistId, db::TrackArtistLinkType linkType);
+
+            void addRelease(db::ReleaseId releaseId);
+            void addReleaseLabel(db::ReleaseId releaseId, db::LabelId labelId);
+            void addReleaseType(db::ReleaseId releaseId, db::ReleaseTypeId releaseTypeId);
+
+            void addArtist(db::ArtistId artistId);
+
+            // Orders, as returned by the database for an unfiltered query
+            void setTrackOrder(db::TrackSortMethod sortMethod, std::vector<db::TrackId> trackIds);
+            void setReleaseOrder(db::ReleaseSortMethod sortMethod, std::vector<db::ReleaseId> releaseIds);
+            void setArtistOrder(db::ArtistSortMethod sortMethod, std::vector<db::ArtistId> artistIds);
+
+            CatalogSnapshot build();
+
+        private:
+            struct TrackArtist
+            {
+                db::TrackId trackId;
+                db::ArtistId artistId;
+                db::TrackArtistLinkType linkType;
+            };
+
+            std::vector<db::TrackId> _trackIds;
+            std::vector<std::pair<db::TrackId, db::ReleaseId>> _trackReleases;
+            std::vector<std::pair<db::TrackId, db::MediaLibraryId>> _trackMediaLibraries;
+            std::vector<std::pair<db::TrackId, db::ClusterId>> _trackClusters;
+            std::vector<TrackArtist> _trackArtists;
+            std::vector<db::ReleaseId> _releaseIds;
+            std::vector<std::pair<db::ReleaseId, db::LabelId>> _releaseLabels;
+            std::vector<std::pair<db::ReleaseId, db::ReleaseTypeId>> _releaseTypes;
+            std::vector<db::ArtistId> _artistIds;
+            std::vector<std::pair<db::TrackSortMethod, std::vector<db::TrackId>>> _trackOrders;
+            std::vector<std::pair<db::ReleaseSortMethod, std::vector<db::ReleaseId>>> _releaseOrders;
+            std::vector<std::pair<db::ArtistSortMethod, std::vector<db::ArtistId>>> _artistOrders;
+        };
+
+        // Same semantics as the database find queries, without keywords
+        // std::nullopt is returned if the sort method is not handled by the snapshot
+        std::optional<db::RangeResults<db::TrackId>> findTracks(const db::Filters& filters, db::TrackSortMethod sortMethod, std::optional<db::Range> range) const;
+        std::optional<db::RangeResults<db::ReleaseId>> findReleases(const db::Filters& filters, db::ReleaseSortMethod sortMethod, std::optional<db::Range> range) const;
+        std::optional<db::RangeResults<db::ArtistId>> findArtists(const db::Filters& filters, std::optional<db::TrackArtistLinkType> linkType, db::ArtistSortMethod sortMethod, std::optional<db::Range> range) const;
+
+        std::size_t getTrackCount() const { return _tracks.ids.size(); }
+        std::size_t getReleaseCount() const { return _releases.ids.size(); }
+        std::size_t getArtistCount() const { return _artists.ids.size(); }
+        std::size_t getMemoryUsage() const;
+
+    private:
+        using Ordinal = OrdinalBitmap::Value;
+        static constexpr Ordinal invalidOrdinal{ static_cast<Ordinal>(-1) };
+
+        class Bitset;
+
+        template<typename IdType, typename SortMethodType>
+        struct Objects
+        {
+            std::vector<IdType> ids; // sorted
+            std::vector<std::pair<SortMethodType, std::vector<Ordinal>>> orders;
+
+            Ordinal findOrdinal(IdType id) const;
+            const std::vector<Ordinal>* findOrder(SortMethodType sortMethod) const;
+            std::size_t getMemoryUsage() const;
+        };
+
+        struct ArtistLink
+        {
+            Ordinal artist;
+            db::TrackArtistLinkType linkType;
+        };
+
+        // Tracks matching the filters checked on each track: media library, label, release type and a single cluster
+        // std::nullopt means that all the tracks match
+        std::optional<OrdinalBitmap> findMatchingTracks(const db::Filters& filters) const;
+        // Like in the database, several clusters are matched on any track of the release/artist, not necessarily on the one matching the other filters
+        // std::nullopt if there are less than two clusters
+        std::optional<OrdinalBitmap> findTracksInAllClusters(std::span<const db::ClusterId> clusters) const;
+        Bitset getTrackReleases(const OrdinalBitmap& tracks) const;
+        Bitset getTrackArtists(const OrdinalBitmap* tracks, std::optional<db::TrackArtistLinkType> linkType) const; // all the tracks if null
+
+        template<typename IdType, typename SortMethodType>
+        static std::optional<db::RangeResults<IdType>> collect(const Objects<IdType, SortMethodType>& objects, const Bitset* matchingObjects, SortMethodType sortMethod, std::optional<db::Range> range);
+
+        Objects<db::TrackId, db::TrackSortMethod> _tracks;
+        Objects<db::ReleaseId, db::ReleaseSortMethod> _releases;
+        Objects<db::ArtistId, db::ArtistSortMethod> _artists;
+
+        std::vector<Ordinal> _trackReleases;
+        std::vector<Ordinal> _trackArtistOffsets;
+        std::vector<ArtistLink> _trackArtists;
+
+        // Tracks having each filter value, release values being given to all the tracks of the release
+        // Any combination of filters is then an intersection of these bitmaps
+        std::unordered_map<db::MediaLibraryId, OrdinalBitmap> _tracksByMediaLibrary;
+        std::unordered_map<db::ClusterId, OrdinalBitmap> _tracksByCluster;
+        std::unordered_map<db::LabelId, OrdinalBitmap> _tracksByLabel;
+        std::unordered_map<db::ReleaseTypeId, OrdinalBitmap> _tracksByReleaseType;
+    };
+} // namespace lms::catalog
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#include <Wt/WDateTime.h>
+
+#include <boost/asio/io_context.hpp>
+
+#include "services/catalog/CatalogSnapshot.hpp"
+
+namespace lms::db
+{
+    class IDb;
+}
+
+namespace lms::catalog
+{
+    class ICatalogService
+    {
+    public:
+        virtual ~ICatalogService() = default;
+
+        // Rebuilds the snapshot from the database in the background
+        // The current snapshot is dropped right away so that readers fall back on the database until the new one is ready
+        // A refresh requested while another one is in progress cancels it and starts over
+        virtual void refresh() = 0;
+        // Blocks until all the requested refreshes are done
+        virtual void waitForRefresh() = 0;
+
+        // May be null if no refresh has completed yet or if a refresh is in progress
+        virtual std::shared_ptr<const CatalogSnapshot> getSnapshot() const = 0;
+
+        struct RefreshStats
+        {
+            std::size_t refreshCount{};
+            Wt::WDateTime lastRefreshDateTime;
+            std::chrono::milliseconds lastRefreshDuration{};
+        };
+        virtual RefreshStats getRefreshStats() const = 0;
+    };
+
+    std::unique_ptr<ICatalogService> createCatalogService(boost::asio::io_context& ioContext, db::IDb& db);
+} // namespace lms::catalog
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace lms::catalog
+{
+    // Compressed set of 32 bits values, in the spirit of roaring bitmaps
+    // Values are split in chunks sharing the same 16 high bits, each chunk being
+    // either a sorted array of the low bits (sparse chunks) or a 65536 bits bitset (dense chunks)
+    class OrdinalBitmap
+    {
+    public:
+        using Value = std::uint32_t;
+
+        // values must be sorted and unique
+        static OrdinalBitmap fromSortedValues(std::span<const Value> values);
+
+        bool contains(Value value) const;
+        bool isEmpty() const { return _chunks.empty(); }
+        std::size_t getCount() const;
+        std::size_t getMemoryUsage() const;
+
+        OrdinalBitmap operator&(const OrdinalBitmap& other) const;
+        OrdinalBitmap operator|(const OrdinalBitmap& other) const;
+        bool operator==(const OrdinalBitmap& other) const = default;
+
+        // func(Value value), in ascending order
+        template<typename Func>
+        void visit(Func&& func) const;
+
+    private:
+        using Word = std::uint64_t;
+        static constexpr std::size_t bitsPerWord{ 64 };
+        static constexpr std::size_t wordsPerChunk{ 65536 / bitsPerWord };
+        static constexpr std::size_t maxSparseCount{ 4096 }; // above this, the bitset is smaller than the array
+
+        struct Chunk
+        {
+            std::uint16_t key{}; // high bits
+            std::uint32_t count{};
+            std::vector<std::uint16_t> values; // sparse chunks only
+            std::vector<Word> words;           // dense chunks only
+
+            bool isDense() const { return !words.empty(); }
+            bool operator==(const Chunk& other) const = default;
+        };
+
+        static Chunk intersect(const Chunk& chunk1, const Chunk& chunk2);
+        static Chunk unite(const Chunk& chunk1, const Chunk& chunk2);
+        static void optimize(Chunk& chunk); // use the smallest representation for the chunk count
+
+        std::vector<Chunk> _chunks; // sorted by key, no empty chunk
+    };
+
+    template<typename Func>
+    void OrdinalBitmap::visit(Func&& func) const
+    {
+        for (const Chunk& chunk : _chunks)
+        {
+            const Value high{ static_cast<Value>(chunk.key) << 16 };
+            if (chunk.isDense())
+            {
+                for (std::size_t i{}; i < chunk.words.size(); ++i)
+                {
+                    Word word{ chunk.words[i] };
+                    while (word)
+                    {
+                        func(static_cast<Value>(high | (i * bitsPerWord + std::countr_zero(word))));
+                        word &= word - 1;
+                    }
+                }
+            }
+            else
+            {
+                for (const std::uint16_t low : chunk.values)
+                    func(high | low);
+            }
+        }
+    }
+} // namespace lms::catalog
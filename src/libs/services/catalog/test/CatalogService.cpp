@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <gtest/gtest.h>
+
+#include "core/IOContextRunner.hpp"
+#include "database/IDb.hpp"
+#include "database/Session.hpp"
+#include "database/objects/Artist.hpp"
+#include "database/objects/Cluster.hpp"
+#include "database/objects/MediaLibrary.hpp"
+#include "database/objects/Release.hpp"
+#include "database/objects/Track.hpp"
+#include "database/objects/TrackArtistLink.hpp"
+#include "database/test/TmpDatabase.hpp"
+
+#include "services/catalog/ICatalogService.hpp"
+
+namespace lms::catalog::tests
+{
+    namespace
+    {
+        // Runs the same queries on the snapshot and on the database
+        // release1: track1 (library1, cluster1), track2 (library2, cluster1 + cluster2)
+        // release2 (label1, type1): track3 (library1, cluster2)
+        // no release: track4 (library2, cluster1 + cluster2)
+        // artist1: track1 (artist), track3 (composer)
+        // artist2: track2 (artist), track4 (composer)
+        class CatalogServiceTest : public ::testing::Test
+        {
+        protected:
+            void SetUp() override
+            {
+                {
+                    auto transaction{ _session.createWriteTransaction() };
+
+                    const auto library1{ _session.create<db::MediaLibrary>("Library1", "/music1") };
+                    const auto library2{ _session.create<db::MediaLibrary>("Library2", "/music2") };
+                    const auto clusterType{ _session.create<db::ClusterType>("Genre") };
+                    const auto cluster1{ _session.create<db::Cluster>(clusterType, "Rock") };
+                    const auto cluster2{ _session.create<db::Cluster>(clusterType, "Pop") };
+                    const auto label{ _session.create<db::Label>("Label1") };
+                    const auto releaseType{ _session.create<db::ReleaseType>("album") };
+                    const auto release1{ _session.create<db::Release>("Release1") };
+                    auto release2{ _session.create<db::Release>("Release2") };
+                    const auto artist1{ _session.create<db::Artist>("Artist1") };
+                    const auto artist2{ _session.create<db::Artist>("Artist2") };
+
+                    release2.modify()->addLabel(label);
+                    release2.modify()->addReleaseType(releaseType);
+
+                    const auto createTrack{ [&](const db::Release::pointer& release, const db::MediaLibrary::pointer& library, const std::vector<db::Cluster::pointer>& clusters, const db::Artist::pointer& artist, db::TrackArtistLinkType linkType) {
+                        db::Track::pointer track{ _session.create<db::Track>() };
+                        if (release)
+                            track.modify()->setRelease(release);
+                        track.modify()->setMediaLibrary(library);
+                        track.modify()->setClusters(clusters);
+                        db::TrackArtistLink::create(_session, track, artist, linkType);
+                    } };
+
+                    createTrack(release1, library1, { cluster1 }, artist1, db::TrackArtistLinkType::Artist);
+                    createTrack(release1, library2, { cluster1, cluster2 }, artist2, db::TrackArtistLinkType::Artist);
+                    createTrack(release2, library1, { cluster2 }, artist1, db::TrackArtistLinkType::Composer);
+                    createTrack(db::Release::pointer{}, library2, { cluster1, cluster2 }, artist2, db::TrackArtistLinkType::Composer);
+
+                    _libraries = { library1->getId(), library2->getId() };
+                    _clusters = { cluster1->getId(), cluster2->getId() };
+                    _label = label->getId();
+                    _releaseType = releaseType->getId();
+                }
+
+                _catalogService = createCatalogService(_ioContext, _tmpDb.getDb());
+                _catalogService->waitForRefresh();
+                _snapshot = _catalogService->getSnapshot();
+                ASSERT_NE(_snapshot, nullptr);
+            }
+
+            std::vector<db::Filters> getFilterCombinations() const
+            {
+                const db::ClusterId unknownCluster{ 42 };
+
+                std::vector<std::vector<db::ClusterId>> clusterCombinations{ {}, { _clusters[0] }, { _clusters[1] }, { _clusters[0], _clusters[1] }, { _clusters[0], unknownCluster } };
+                std::vector<db::MediaLibraryId> libraries{ db::MediaLibraryId{}, _libraries[0], _libraries[1] };
+
+                std::vector<db::Filters> res;
+                for (const auto& clusters : clusterCombinations)
+                {
+                    for (const db::MediaLibraryId library : libraries)
+                    {
+                        for (const db::LabelId label : { db::LabelId{}, _label })
+                        {
+                            for (const db::ReleaseTypeId releaseType : { db::ReleaseTypeId{}, _releaseType })
+                                res.push_back(db::Filters{}.setClusters(clusters).setMediaLibrary(library).setLabel(label).setReleaseType(releaseType));
+                        }
+                    }
+                }
+
+                return res;
+            }
+
+            db::tests::TmpDatabase _tmpDb;
+            db::Session _session{ _tmpDb.getDb() };
+            boost::asio::io_context _ioContext;
+            core::IOContextRunner _ioContextRunner{ _ioContext, 1, "Catalog" };
+            std::unique_ptr<ICatalogService> _catalogService;
+            std::shared_ptr<const CatalogSnapshot> _snapshot;
+
+            std::vector<db::MediaLibraryId> _libraries;
+            std::vector<db::ClusterId> _clusters;
+            db::LabelId _label;
+            db::ReleaseTypeId _releaseType;
+        };
+    } // namespace
+
+    TEST_F(CatalogServiceTest, tracksMatchDatabase)
+    {
+        for (const db::Filters& filters : getFilterCombinations())
+        {
+            const auto tracks{ _snapshot->findTracks(filters, db::TrackSortMethod::Id, std::nullopt) };
+            ASSERT_TRUE(tracks);
+
+            auto transaction{ _session.createReadTransaction() };
+            EXPECT_EQ(tracks->results, db::Track::findIds(_session, db::Track::FindParameters{}.setFilters(filters).setSortMethod(db::TrackSortMethod::Id)).results);
+        }
+    }
+
+    TEST_F(CatalogServiceTest, releasesMatchDatabase)
+    {
+        for (const db::Filters& filters : getFilterCombinations())
+        {
+            const auto releases{ _snapshot->findReleases(filters, db::ReleaseSortMethod::Id, std::nullopt) };
+            ASSERT_TRUE(releases);
+
+            auto transaction{ _session.createReadTransaction() };
+            EXPECT_EQ(releases->results, db::Release::findIds(_session, db::Release::FindParameters{}.setFilters(filters).setSortMethod(db::ReleaseSortMethod::Id)).results);
+        }
+    }
+
+    TEST_F(CatalogServiceTest, artistsMatchDatabase)
+    {
+        for (const db::Filters& filters : getFilterCombinations())
+        {
+            for (const std::optional<db::TrackArtistLinkType> linkType : { std::optional<db::TrackArtistLinkType>{}, std::optional{ db::TrackArtistLinkType::Artist }, std::optional{ db::TrackArtistLinkType::Composer } })
+            {
+                const auto artists{ _snapshot->findArtists(filters, linkType, db::ArtistSortMethod::Id, std::nullopt) };
+                ASSERT_TRUE(artists);
+
+                auto transaction{ _session.createReadTransaction() };
+                EXPECT_EQ(artists->results, db::Artist::findIds(_session, db::Artist::FindParameters{}.setFilters(filters).setLinkType(linkType).setSortMethod(db::ArtistSortMethod::Id)).results);
+            }
+        }
+    }
+} // namespace lms::catalog::tests
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "services/catalog/CatalogSnapshot.hpp"
+
+namespace lms::catalog::tests
+{
+    namespace
+    {
+        // release1: track1 (library1, cluster1), track2 (library2, cluster1 + cluster2)
+        // release2 (label1, type1): track3 (library1, cluster2)
+        // artist1: track1 (artist), track3 (composer)
+        // artist2: track2 (artist)
+        CatalogSnapshot createSnapshot()
+        {
+            CatalogSnapshot::Builder builder;
+
+            for (db::TrackId::ValueType i{ 1 }; i <= 3; ++i)
+                builder.addTrack(db::TrackId{ i });
+            builder.addRelease(db::ReleaseId{ 1 });
+            builder.addRelease(db::ReleaseId{ 2 });
+            builder.addArtist(db::ArtistId{ 1 });
+            builder.addArtist(db::ArtistId{ 2 });
+
+            builder.setTrackRelease(db::TrackId{ 1 }, db::ReleaseId{ 1 });
+            builder.setTrackRelease(db::TrackId{ 2 }, db::ReleaseId{ 1 });
+            builder.setTrackRelease(db::TrackId{ 3 }, db::ReleaseId{ 2 });
+            builder.setTrackMediaLibrary(db::TrackId{ 1 }, db::MediaLibraryId{ 1 });
+            builder.setTrackMediaLibrary(db::TrackId{ 2 }, db::MediaLibraryId{ 2 });
+            builder.setTrackMediaLibrary(db::TrackId{ 3 }, db::MediaLibraryId{ 1 });
+            builder.addTrackCluster(db::TrackId{ 1 }, db::ClusterId{ 1 });
+            builder.addTrackCluster(db::TrackId{ 2 }, db::ClusterId{ 1 });
+            builder.addTrackCluster(db::TrackId{ 2 }, db::ClusterId{ 2 });
+            builder.addTrackCluster(db::TrackId{ 3 }, db::ClusterId{ 2 });
+            builder.addTrackArtist(db::TrackId{ 1 }, db::ArtistId{ 1 }, db::TrackArtistLinkType::Artist);
+            builder.addTrackArtist(db::TrackId{ 2 }, db::ArtistId{ 2 }, db::TrackArtistLinkType::Artist);
+            builder.addTrackArtist(db::TrackId{ 3 }, db::ArtistId{ 1 }, db::TrackArtistLinkType::Composer);
+            builder.addReleaseLabel(db::ReleaseId{ 2 }, db::LabelId{ 1 });
+            builder.addReleaseType(db::ReleaseId{ 2 }, db::ReleaseTypeId{ 1 });
+
+            builder.setTrackOrder(db::TrackSortMethod::AddedDesc, { db::TrackId{ 3 }, db::TrackId{ 2 }, db::TrackId{ 1 } });
+            builder.setReleaseOrder(db::ReleaseSortMethod::SortName, { db::ReleaseId{ 2 }, db::ReleaseId{ 1 } });
+            builder.setArtistOrder(db::ArtistSortMethod::SortName, { db::ArtistId{ 2 }, db::ArtistId{ 1 } });
+
+            return builder.build();
+        }
+    } // namespace
+
+    TEST(CatalogSnapshot, empty)
+    {
+        const CatalogSnapshot snapshot{ CatalogSnapshot::Builder{}.build() };
+
+        EXPECT_EQ(snapshot.getTrackCount(), 0);
+        const auto tracks{ snapshot.findTracks(db::Filters{}, db::TrackSortMethod::None, std::nullopt) };
+        ASSERT_TRUE(tracks);
+        EXPECT_TRUE(tracks->results.empty());
+        EXPECT_FALSE(tracks->moreResults);
+
+        const auto releases{ snapshot.findReleases(db::Filters{}.setMediaLibrary(db::MediaLibraryId{ 1 }), db::ReleaseSortMethod::Random, std::nullopt) };
+        ASSERT_TRUE(releases);
+        EXPECT_TRUE(releases->results.empty());
+    }
+
+    TEST(CatalogSnapshot, sortMethods)
+    {
+        const CatalogSnapshot snapshot{ createSnapshot() };
+
+        const auto tracks{ snapshot.findTracks(db::Filters{}, db::TrackSortMethod::AddedDesc, std::nullopt) };
+        ASSERT_TRUE(tracks);
+        EXPECT_EQ(tracks->results, (std::vector<db::TrackId>{ db::TrackId{ 3 }, db::TrackId{ 2 }, db::TrackId{ 1 } }));
+
+        const auto releases{ snapshot.findReleases(db::Filters{}, db::ReleaseSortMethod::Id, std::nullopt) };
+        ASSERT_TRUE(releases);
+        EXPECT_EQ(releases->results, (std::vector<db::ReleaseId>{ db::ReleaseId{ 1 }, db::ReleaseId{ 2 } }));
+
+        const auto artists{ snapshot.findArtists(db::Filters{}, std::nullopt, db::ArtistSortMethod::Random, std::nullopt) };
+        ASSERT_TRUE(artists);
+        EXPECT_EQ(artists->results.size(), 2);
+
+        EXPECT_FALSE(snapshot.findTracks(db::Filters{}, db::TrackSortMethod::Name, std::nullopt));
+        EXPECT_FALSE(snapshot.findReleases(db::Filters{}, db::ReleaseSortMethod::AddedDesc, std::nullopt));
+    }
+
+    TEST(CatalogSnapshot, range)
+    {
+        const CatalogSnapshot snapshot{ createSnapshot() };
+
+        auto tracks{ snapshot.findTracks(db::Filters{}, db::TrackSortMethod::AddedDesc, db::Range{ 0, 2 }) };
+        ASSERT_TRUE(tracks);
+        EXPECT_EQ(tracks->results, (std::vector<db::TrackId>{ db::TrackId{ 3 }, db::TrackId{ 2 } }));
+        EXPECT_EQ(tracks->range, (db::Range{ 0, 2 }));
+        EXPECT_TRUE(tracks->moreResults);
+
+        tracks = snapshot.findTracks(db::Filters{}, db::TrackSortMethod::AddedDesc, db::Range{ 2, 2 });
+        ASSERT_TRUE(tracks);
+        EXPECT_EQ(tracks->results, (std::vector<db::TrackId>{ db::TrackId{ 1 } }));
+        EXPECT_EQ(tracks->range, (db::Range{ 2, 1 }));
+        EXPECT_FALSE(tracks->moreResults);
+
+        tracks = snapshot.findTracks(db::Filters{}, db::TrackSortMethod::Random, db::Range{ 1, 5 });
+        ASSERT_TRUE(tracks);
+        EXPECT_EQ(tracks->results.size(), 2);
+        EXPECT_FALSE(tracks->moreResults);
+    }
+
+    TEST(CatalogSnapshot, filters)
+    {
+        const CatalogSnapshot snapshot{ createSnapshot() };
+
+        auto releases{ snapshot.findReleases(db::Filters{}.setMediaLibrary(db::MediaLibraryId{ 2 }), db::ReleaseSortMethod::SortName, std::nullopt) };
+        ASSERT_TRUE(releases);
+        EXPECT_EQ(releases->results, (std::vector<db::ReleaseId>{ db::ReleaseId{ 1 } }));
+
+        // clusters must all be on the same track
+        const db::ClusterId clusters[]{ db::ClusterId{ 1 }, db::ClusterId{ 2 } };
+        releases = snapshot.findReleases(db::Filters{}.setClusters(clusters), db::ReleaseSortMethod::SortName, std::nullopt);
+        ASSERT_TRUE(releases);
+        EXPECT_EQ(releases->results, (std::vector<db::ReleaseId>{ db::ReleaseId{ 1 } }));
+
+        // but not necessarily on the track matching the other filters
+        releases = snapshot.findReleases(db::Filters{}.setClusters(clusters).setMediaLibrary(db::MediaLibraryId{ 1 }), db::ReleaseSortMethod::SortName, std::nullopt);
+        ASSERT_TRUE(releases);
+        EXPECT_EQ(releases->results, (std::vector<db::ReleaseId>{ db::ReleaseId{ 1 } }));
+
+        auto tracks{ snapshot.findTracks(db::Filters{}.setClusters(clusters).setMediaLibrary(db::MediaLibraryId{ 1 }), db::TrackSortMethod::None, std::nullopt) };
+        ASSERT_TRUE(tracks);
+        EXPECT_TRUE(tracks->results.empty());
+
+        releases = snapshot.findReleases(db::Filters{}.setClusters(std::initializer_list<db::ClusterId>{ db::ClusterId{ 42 } }), db::ReleaseSortMethod::SortName, std::nullopt);
+        ASSERT_TRUE(releases);
+        EXPECT_TRUE(releases->results.empty());
+
+        tracks = snapshot.findTracks(db::Filters{}.setLabel(db::LabelId{ 1 }), db::TrackSortMethod::None, std::nullopt);
+        ASSERT_TRUE(tracks);
+        EXPECT_EQ(tracks->results, (std::vector<db::TrackId>{ db::TrackId{ 3 } }));
+
+        releases = snapshot.findReleases(db::Filters{}.setReleaseType(db::ReleaseTypeId{ 1 }).setMediaLibrary(db::MediaLibraryId{ 1 }), db::ReleaseSortMethod::SortName, std::nullopt);
+        ASSERT_TRUE(releases);
+        EXPECT_EQ(releases->results, (std::vector<db::ReleaseId>{ db::ReleaseId{ 2 } }));
+
+        releases = snapshot.findReleases(db::Filters{}.setReleaseType(db::ReleaseTypeId{ 1 }).setClusters(std::initializer_list<db::ClusterId>{ db::ClusterId{ 1 } }), db::ReleaseSortMethod::SortName, std::nullopt);
+        ASSERT_TRUE(releases);
+        EXPECT_TRUE(releases->results.empty());
+
+        auto artists{ snapshot.findArtists(db::Filters{}.setLabel(db::LabelId{ 1 }), std::nullopt, db::ArtistSortMethod::SortName, std::nullopt) };
+        ASSERT_TRUE(artists);
+        EXPECT_EQ(artists->results, (std::vector<db::ArtistId>{ db::ArtistId{ 1 } }));
+
+        artists = snapshot.findArtists(db::Filters{}.setLabel(db::LabelId{ 1 }), db::TrackArtistLinkType::Artist, db::ArtistSortMethod::SortName, std::nullopt);
+        ASSERT_TRUE(artists);
+        EXPECT_TRUE(artists->results.empty());
+
+        artists = snapshot.findArtists(db::Filters{}, db::TrackArtistLinkType::Artist, db::ArtistSortMethod::SortName, std::nullopt);
+        ASSERT_TRUE(artists);
+        EXPECT_EQ(artists->results, (std::vector<db::ArtistId>{ db::ArtistId{ 2 }, db::ArtistId{ 1 } }));
+    }
+} // namespace lms::catalog::tests
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "services/catalog/OrdinalBitmap.hpp"
+
+namespace lms::catalog::tests
+{
+    namespace
+    {
+        std::vector<OrdinalBitmap::Value> getValues(const OrdinalBitmap& bitmap)
+        {
+            std::vector<OrdinalBitmap::Value> values;
+            bitmap.visit([&](OrdinalBitmap::Value value) { values.push_back(value); });
+            return values;
+        }
+
+        // first..last, every step values
+        std::vector<OrdinalBitmap::Value> createValues(OrdinalBitmap::Value first, OrdinalBitmap::Value last, OrdinalBitmap::Value step)
+        {
+            std::vector<OrdinalBitmap::Value> values;
+            for (OrdinalBitmap::Value value{ first }; value <= last; value += step)
+                values.push_back(value);
+            return values;
+        }
+    } // namespace
+
+    TEST(OrdinalBitmap, empty)
+    {
+        const OrdinalBitmap bitmap;
+
+        EXPECT_TRUE(bitmap.isEmpty());
+        EXPECT_EQ(bitmap.getCount(), 0);
+        EXPECT_FALSE(bitmap.contains(0));
+        EXPECT_TRUE(getValues(bitmap).empty());
+        EXPECT_TRUE((bitmap & bitmap).isEmpty());
+        EXPECT_TRUE((bitmap | bitmap).isEmpty());
+    }
+
+    TEST(OrdinalBitmap, sparse)
+    {
+        const std::vector<OrdinalBitmap::Value> values{ 0, 3, 65535, 65536, 1'000'000 };
+        const OrdinalBitmap bitmap{ OrdinalBitmap::fromSortedValues(values) };
+
+        EXPECT_FALSE(bitmap.isEmpty());
+        EXPECT_EQ(bitmap.getCount(), values.size());
+        for (const OrdinalBitmap::Value value : values)
+            EXPECT_TRUE(bitmap.contains(value)) << "value = " << value;
+        EXPECT_FALSE(bitmap.contains(1));
+        EXPECT_FALSE(bitmap.contains(65537));
+        EXPECT_FALSE(bitmap.contains(2'000'000));
+        EXPECT_EQ(getValues(bitmap), values);
+    }
+
+    TEST(OrdinalBitmap, dense)
+    {
+        const std::vector<OrdinalBitmap::Value> values{ createValues(10, 100'000, 2) };
+        const OrdinalBitmap bitmap{ OrdinalBitmap::fromSortedValues(values) };
+
+        EXPECT_EQ(bitmap.getCount(), values.size());
+        EXPECT_TRUE(bitmap.contains(10));
+        EXPECT_TRUE(bitmap.contains(65536));
+        EXPECT_FALSE(bitmap.contains(11));
+        EXPECT_FALSE(bitmap.contains(65537));
+        EXPECT_EQ(getValues(bitmap), values);
+
+        // dense chunks are smaller than the equivalent arrays
+        EXPECT_LT(bitmap.getMemoryUsage(), values.size() * sizeof(std::uint16_t));
+    }
+
+    TEST(OrdinalBitmap, intersection)
+    {
+        const OrdinalBitmap even{ OrdinalBitmap::fromSortedValues(createValues(0, 200'000, 2)) };
+        const OrdinalBitmap multiplesOf3{ OrdinalBitmap::fromSortedValues(createValues(0, 200'000, 3)) };
+        const OrdinalBitmap multiplesOf5000{ OrdinalBitmap::fromSortedValues(createValues(0, 200'000, 5'000)) };
+        const OrdinalBitmap multiplesOf7000{ OrdinalBitmap::fromSortedValues(createValues(0, 200'000, 7'000)) };
+
+        // dense & dense
+        EXPECT_EQ(even & multiplesOf3, OrdinalBitmap::fromSortedValues(createValues(0, 200'000, 6)));
+        // dense & sparse
+        EXPECT_EQ(multiplesOf3 & multiplesOf5000, OrdinalBitmap::fromSortedValues(createValues(0, 200'000, 15'000)));
+        EXPECT_EQ(multiplesOf5000 & multiplesOf3, multiplesOf3 & multiplesOf5000);
+        // sparse & sparse
+        EXPECT_EQ(multiplesOf5000 & multiplesOf7000, OrdinalBitmap::fromSortedValues(createValues(0, 200'000, 35'000)));
+
+        EXPECT_TRUE((multiplesOf5000 & OrdinalBitmap::fromSortedValues(std::vector<OrdinalBitmap::Value>{ 1, 300'000 })).isEmpty());
+    }
+
+    TEST(OrdinalBitmap, union)
+    {
+        const OrdinalBitmap even{ OrdinalBitmap::fromSortedValues(createValues(0, 100'000, 2)) };
+        const OrdinalBitmap odd{ OrdinalBitmap::fromSortedValues(createValues(1, 100'001, 2)) };
+        const OrdinalBitmap multiplesOf5000{ OrdinalBitmap::fromSortedValues(createValues(0, 200'000, 5'000)) };
+        const OrdinalBitmap multiplesOf7000{ OrdinalBitmap::fromSortedValues(createValues(0, 200'000, 7'000)) };
+
+        // dense | dense
+        EXPECT_EQ(even | odd, OrdinalBitmap::fromSortedValues(createValues(0, 100'001, 1)));
+        // dense | sparse
+        const OrdinalBitmap evenOrMultiplesOf5000{ even | multiplesOf5000 };
+        EXPECT_EQ(evenOrMultiplesOf5000.getCount(), even.getCount() + 20);
+        EXPECT_TRUE(evenOrMultiplesOf5000.contains(2));
+        EXPECT_TRUE(evenOrMultiplesOf5000.contains(105'000));
+        EXPECT_EQ(multiplesOf5000 | even, evenOrMultiplesOf5000);
+        // sparse | sparse
+        const OrdinalBitmap multiplesOf5000Or7000{ multiplesOf5000 | multiplesOf7000 };
+        EXPECT_EQ(multiplesOf5000Or7000.getCount(), multiplesOf5000.getCount() + multiplesOf7000.getCount() - (multiplesOf5000 & multiplesOf7000).getCount());
+        EXPECT_TRUE(multiplesOf5000Or7000.contains(7'000));
+        EXPECT_TRUE(multiplesOf5000Or7000.contains(200'000));
+    }
+
+    TEST(OrdinalBitmap, denseToSparse)
+    {
+        // both dense, but the intersection is small enough to be stored as an array
+        const OrdinalBitmap first{ OrdinalBitmap::fromSortedValues(createValues(0, 5'999, 1)) };
+        const OrdinalBitmap second{ OrdinalBitmap::fromSortedValues(createValues(5'000, 10'999, 1)) };
+
+        const OrdinalBitmap intersection{ first & second };
+        EXPECT_EQ(intersection, OrdinalBitmap::fromSortedValues(createValues(5'000, 5'999, 1)));
+        EXPECT_LT(intersection.getMemoryUsage(), first.getMemoryUsage());
+    }
+} // namespace lms::catalog::tests
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <variant>
+
+#include "core/PerUserLruCache.hpp"
+#include "database/Types.hpp"
+#include "database/objects/ArtistId.hpp"
+#include "database/objects/ReleaseId.hpp"
+#include "database/objects/TrackId.hpp"
+#include "database/objects/UserId.hpp"
+
+#include "services/feedback/IFeedbackService.hpp"
+
+namespace lms::feedback
+{
+    // Per user cache of the feedbacks given on artists, releases and tracks
+    using FeedbackCache = core::PerUserLruCache<db::UserId, db::FeedbackBackend, std::variant<db::ArtistId, db::ReleaseId, db::TrackId>, IFeedbackService::Feedback>;
+} // namespace lms::feedback
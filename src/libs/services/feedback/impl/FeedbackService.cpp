@@ -49,7 +49,7 @@ namespace lms::feedback
     {
         LMS_LOG(SCROBBLING, INFO, "Starting service...");
         _backends.emplace(db::FeedbackBackend::Internal, std::make_unique<InternalBackend>(_db));
-        _backends.emplace(db::FeedbackBackend::ListenBrainz, std::make_unique<listenBrainz::ListenBrainzBackend>(ioContext, _db));
+        _backends.emplace(db::FeedbackBackend::ListenBrainz, std::make_unique<listenBrainz::ListenBrainzBackend>(ioContext, _db, [this](db::UserId userId) { _feedbackCache.invalidate(userId); }));
         LMS_LOG(SCROBBLING, INFO, "Service started!");
     }
 
@@ -82,12 +82,12 @@ namespace lms::feedback
 
     bool FeedbackService::isStarred(UserId userId, ArtistId artistId)
     {
-        return isStarred<Artist, ArtistId, StarredArtist>(userId, artistId);
+        return getStarredDateTime(userId, artistId).isValid();
     }
 
     Wt::WDateTime FeedbackService::getStarredDateTime(UserId userId, ArtistId artistId)
     {
-        return getStarredDateTime<Artist, ArtistId, StarredArtist>(userId, artistId);
+        return getFeedbacks(userId, std::span{ &artistId, 1 }).front().starredDateTime;
     }
 
     FeedbackService::ArtistContainer FeedbackService::findStarredArtists(const ArtistFindParameters& params)
@@ -117,7 +117,12 @@ namespace lms::feedback
 
     std::optional<db::Rating> FeedbackService::getRating(db::UserId userId, db::ArtistId artistId)
     {
-        return getRating<Artist, ArtistId, RatedArtist>(userId, artistId);
+        return getFeedbacks(userId, std::span{ &artistId, 1 }).front().rating;
+    }
+
+    std::vector<FeedbackService::Feedback> FeedbackService::getFeedbacks(db::UserId userId, std::span<const db::ArtistId> artistIds)
+    {
+        return getFeedbacks<ArtistId, StarredArtist, RatedArtist>(userId, artistIds);
     }
 
     void FeedbackService::star(UserId userId, ReleaseId releaseId)
@@ -132,12 +137,12 @@ namespace lms::feedback
 
     bool FeedbackService::isStarred(UserId userId, ReleaseId releaseId)
     {
-        return isStarred<Release, ReleaseId, StarredRelease>(userId, releaseId);
+        return getStarredDateTime(userId, releaseId).isValid();
     }
 
     Wt::WDateTime FeedbackService::getStarredDateTime(UserId userId, ReleaseId releaseId)
     {
-        return getStarredDateTime<Release, ReleaseId, StarredRelease>(userId, releaseId);
+        return getFeedbacks(userId, std::span{ &releaseId, 1 }).front().starredDateTime;
     }
 
     FeedbackService::ReleaseContainer FeedbackService::findStarredReleases(const FindParameters& params)
@@ -166,7 +171,12 @@ namespace lms::feedback
 
     std::optional<db::Rating> FeedbackService::getRating(db::UserId userId, db::ReleaseId releaseId)
     {
-        return getRating<Release, ReleaseId, RatedRelease>(userId, releaseId);
+        return getFeedbacks(userId, std::span{ &releaseId, 1 }).front().rating;
+    }
+
+    std::vector<FeedbackService::Feedback> FeedbackService::getFeedbacks(db::UserId userId, std::span<const db::ReleaseId> releaseIds)
+    {
+        return getFeedbacks<ReleaseId, StarredRelease, RatedRelease>(userId, releaseIds);
     }
 
     void FeedbackService::star(UserId userId, TrackId trackId)
@@ -181,12 +191,12 @@ namespace lms::feedback
 
     bool FeedbackService::isStarred(UserId userId, TrackId trackId)
     {
-        return isStarred<Track, TrackId, StarredTrack>(userId, trackId);
+        return getStarredDateTime(userId, trackId).isValid();
     }
 
     Wt::WDateTime FeedbackService::getStarredDateTime(UserId userId, TrackId trackId)
     {
-        return getStarredDateTime<Track, TrackId, StarredTrack>(userId, trackId);
+        return getFeedbacks(userId, std::span{ &trackId, 1 }).front().starredDateTime;
     }
 
     FeedbackService::TrackContainer FeedbackService::findStarredTracks(const FindParameters& params)
@@ -215,6 +225,11 @@ namespace lms::feedback
 
     std::optional<db::Rating> FeedbackService::getRating(db::UserId userId, db::TrackId trackId)
     {
-        return getRating<db::Track, db::TrackId, db::RatedTrack>(userId, trackId);
+        return getFeedbacks(userId, std::span{ &trackId, 1 }).front().rating;
+    }
+
+    std::vector<FeedbackService::Feedback> FeedbackService::getFeedbacks(db::UserId userId, std::span<const db::TrackId> trackIds)
+    {
+        return getFeedbacks<TrackId, StarredTrack, RatedTrack>(userId, trackIds);
     }
 } // namespace lms::feedback
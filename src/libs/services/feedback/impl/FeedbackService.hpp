@@ -24,6 +24,7 @@
 
 #include "services/feedback/IFeedbackService.hpp"
 
+#include "FeedbackCache.hpp"
 #include "IFeedbackBackend.hpp"
 
 namespace lms::db
@@ -50,6 +51,7 @@ namespace lms::feedback
 
         void setRating(db::UserId userId, db::ArtistId artistId, std::optional<db::Rating> rating) override;
         std::optional<db::Rating> getRating(db::UserId userId, db::ArtistId artistId) override;
+        std::vector<Feedback> getFeedbacks(db::UserId userId, std::span<const db::ArtistId> artistIds) override;
 
         void star(db::UserId userId, db::ReleaseId releaseId) override;
         void unstar(db::UserId userId, db::ReleaseId releaseId) override;
@@ -59,6 +61,7 @@ namespace lms::feedback
 
         void setRating(db::UserId userId, db::ReleaseId releaseId, std::optional<db::Rating> rating) override;
         std::optional<db::Rating> getRating(db::UserId userId, db::ReleaseId releaseId) override;
+        std::vector<Feedback> getFeedbacks(db::UserId userId, std::span<const db::ReleaseId> releaseIds) override;
 
         void star(db::UserId userId, db::TrackId trackId) override;
         void unstar(db::UserId userId, db::TrackId trackId) override;
@@ -68,6 +71,7 @@ namespace lms::feedback
 
         void setRating(db::UserId userId, db::TrackId trackId, std::optional<db::Rating> rating) override;
         std::optional<db::Rating> getRating(db::UserId userId, db::TrackId trackId) override;
+        std::vector<Feedback> getFeedbacks(db::UserId userId, std::span<const db::TrackId> trackIds) override;
 
         std::optional<db::FeedbackBackend> getUserFeedbackBackend(db::UserId userId);
 
@@ -75,18 +79,15 @@ namespace lms::feedback
         void star(db::UserId userId, ObjIdType id);
         template<typename ObjType, typename ObjIdType, typename StarredObjType>
         void unstar(db::UserId userId, ObjIdType id);
-        template<typename ObjType, typename ObjIdType, typename StarredObjType>
-        bool isStarred(db::UserId userId, ObjIdType id);
-        template<typename ObjType, typename ObjIdType, typename StarredObjType>
-        Wt::WDateTime getStarredDateTime(db::UserId userId, ObjIdType id);
 
         template<typename ObjType, typename ObjIdType, typename RatedObjType>
         void setRating(db::UserId userId, ObjIdType objectId, std::optional<db::Rating> rating);
 
-        template<typename ObjType, typename ObjIdType, typename RatedObjType>
-        std::optional<db::Rating> getRating(db::UserId userId, ObjIdType objectId);
+        template<typename ObjIdType, typename StarredObjType, typename RatedObjType>
+        std::vector<Feedback> getFeedbacks(db::UserId userId, std::span<const ObjIdType> objectIds);
 
         db::IDb& _db;
+        FeedbackCache _feedbackCache{ 64 /* maxUserCount */, 3 * 4096 /* maxObjectCountPerUser, artists, releases and tracks altogether */ };
         std::unordered_map<db::FeedbackBackend, std::unique_ptr<IFeedbackBackend>> _backends;
     };
 
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "database/IDb.hpp"
 #include "database/Session.hpp"
 #include "database/objects/User.hpp"
@@ -56,6 +58,7 @@ namespace lms::feedback
             starredObjId = starredObj->getId();
         }
         _backends[*backend]->onStarred(starredObjId);
+        _feedbackCache.invalidate(userId);
     }
 
     template<typename ObjType, typename ObjIdType, typename StarredObjType>
@@ -77,72 +80,93 @@ namespace lms::feedback
             starredObjId = starredObj->getId();
         }
         _backends[*backend]->onUnstarred(starredObjId);
+        _feedbackCache.invalidate(userId);
     }
 
-    template<typename ObjType, typename ObjIdType, typename StarredObjType>
-    bool FeedbackService::isStarred(UserId userId, ObjIdType objId)
+    template<typename ObjType, typename ObjIdType, typename RatedObjType>
+    void FeedbackService::setRating(db::UserId userId, ObjIdType objectId, std::optional<db::Rating> rating)
     {
-        Session& session{ _db.getTLSSession() };
-        auto transaction{ session.createReadTransaction() };
+        {
+            Session& session{ _db.getTLSSession() };
+            auto transaction{ session.createWriteTransaction() };
 
-        typename StarredObjType::pointer starredObj{ StarredObjType::find(session, objId, userId) };
-        return starredObj && (starredObj->getSyncState() != SyncState::PendingRemove);
-    }
+            typename RatedObjType::pointer ratedObject{ RatedObjType::find(session, objectId, userId) };
+            if (rating)
+            {
+                if (!ratedObject)
+                {
+                    typename ObjType::pointer obj{ ObjType::find(session, objectId) };
+                    const User::pointer user{ User::find(session, userId) };
 
-    template<typename ObjType, typename ObjIdType, typename StarredObjType>
-    Wt::WDateTime FeedbackService::getStarredDateTime(UserId userId, ObjIdType objId)
-    {
-        Session& session{ _db.getTLSSession() };
-        auto transaction{ session.createReadTransaction() };
+                    if (!obj || !user)
+                        return;
+
+                    ratedObject = session.create<RatedObjType>(obj, user);
+                }
 
-        typename StarredObjType::pointer starredObj{ StarredObjType::find(session, objId, userId) };
-        if (starredObj && (starredObj->getSyncState() != SyncState::PendingRemove))
-            return starredObj->getDateTime();
+                ratedObject.modify()->setRating(*rating);
+                ratedObject.modify()->setLastUpdated(Wt::WDateTime::currentDateTime());
+            }
+            else
+            {
+                if (!ratedObject)
+                    return;
 
-        return {};
+                ratedObject.remove();
+            }
+        }
+        _feedbackCache.invalidate(userId);
     }
 
-    template<typename ObjType, typename ObjIdType, typename RatedObjType>
-    void FeedbackService::setRating(db::UserId userId, ObjIdType objectId, std::optional<db::Rating> rating)
+    template<typename ObjIdType, typename StarredObjType, typename RatedObjType>
+    std::vector<IFeedbackService::Feedback> FeedbackService::getFeedbacks(db::UserId userId, std::span<const ObjIdType> objectIds)
     {
-        Session& session{ _db.getTLSSession() };
-        auto transaction{ session.createWriteTransaction() };
+        std::vector<Feedback> res(objectIds.size());
 
-        typename RatedObjType::pointer ratedObject{ RatedObjType::find(session, objectId, userId) };
-        if (rating)
+        const auto backend{ getUserFeedbackBackend(userId) };
+        if (!backend)
+            return res;
+
+        std::vector<ObjIdType> missingIds;
+        for (std::size_t i{}; i < objectIds.size(); ++i)
         {
-            if (!ratedObject)
-            {
-                typename ObjType::pointer obj{ ObjType::find(session, objectId) };
-                const User::pointer user{ User::find(session, userId) };
+            if (const auto feedback{ _feedbackCache.get(userId, *backend, objectIds[i]) })
+                res[i] = *feedback;
+            else
+                missingIds.push_back(objectIds[i]);
+        }
 
-                if (!obj || !user)
-                    return;
+        if (missingIds.empty())
+            return res;
 
-                ratedObject = session.create<RatedObjType>(obj, user);
-            }
+        // objects without any feedback are cached too, as this is the most common case
+        std::unordered_map<ObjIdType, Feedback> feedbacks;
+        for (const ObjIdType id : missingIds)
+            feedbacks.emplace(id, Feedback{});
 
-            ratedObject.modify()->setRating(*rating);
-            ratedObject.modify()->setLastUpdated(Wt::WDateTime::currentDateTime());
-        }
-        else
+        const std::uint64_t generation{ _feedbackCache.getGeneration() };
         {
-            if (ratedObject)
-                ratedObject.remove();
+            Session& session{ _db.getTLSSession() };
+            auto transaction{ session.createReadTransaction() };
+
+            StarredObjType::getDateTimes(session, userId, *backend, missingIds, [&](ObjIdType id, const Wt::WDateTime& dateTime) {
+                feedbacks[id].starredDateTime = dateTime;
+            });
+            RatedObjType::getRatings(session, userId, missingIds, [&](ObjIdType id, db::Rating rating) {
+                feedbacks[id].rating = rating;
+            });
         }
-    }
 
-    template<typename ObjType, typename ObjIdType, typename RatedObjType>
-    std::optional<db::Rating> FeedbackService::getRating(db::UserId userId, ObjIdType objectId)
-    {
-        Session& session{ _db.getTLSSession() };
-        auto transaction{ session.createReadTransaction() };
+        for (const auto& [id, feedback] : feedbacks)
+            _feedbackCache.set(generation, userId, *backend, id, feedback);
 
-        const typename RatedObjType::pointer ratedObj{ RatedObjType::find(session, objectId, userId) };
-        if (!ratedObj)
-            return std::nullopt;
+        for (std::size_t i{}; i < objectIds.size(); ++i)
+        {
+            if (const auto it{ feedbacks.find(objectIds[i]) }; it != std::cend(feedbacks))
+                res[i] = it->second;
+        }
 
-        return ratedObj->getRating();
+        return res;
     }
 
 } // namespace lms::feedback
\ No newline at end of file
@@ -61,10 +61,11 @@ namespace lms::feedback::listenBrainz
         }
     } // namespace
 
-    FeedbacksSynchronizer::FeedbacksSynchronizer(boost::asio::io_context& ioContext, db::IDb& db, core::http::IClient& client)
+    FeedbacksSynchronizer::FeedbacksSynchronizer(boost::asio::io_context& ioContext, db::IDb& db, core::http::IClient& client, FeedbacksImportedCallback feedbacksImportedCallback)
         : _ioContext{ ioContext }
         , _db{ db }
         , _client{ client }
+        , _feedbacksImportedCallback{ std::move(feedbacksImportedCallback) }
         , _maxSyncFeedbackCount{ core::Service<core::IConfig>::get()->getULong("listenbrainz-max-sync-feedback-count", 1000) }
         , _syncFeedbacksPeriod{ core::Service<core::IConfig>::get()->getULong("listenbrainz-sync-feedbacks-period-hours", 1) }
     {
@@ -301,6 +302,9 @@ namespace lms::feedback::listenBrainz
             LOG(INFO, "Feedback sync done for user '" << context.listenBrainzUserName << "', fetched: " << context.fetchedFeedbackCount << ", matched: " << context.matchedFeedbackCount << ", imported: " << context.importedFeedbackCount);
             context.syncing = false;
 
+            if (context.importedFeedbackCount > 0 && _feedbacksImportedCallback)
+                _feedbacksImportedCallback(context.userId);
+
             if (!isSyncing())
                 scheduleSync(_syncFeedbacksPeriod);
         }));
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <functional>
 #include <optional>
 #include <unordered_map>
 
@@ -48,7 +49,10 @@ namespace lms::feedback::listenBrainz
     class FeedbacksSynchronizer
     {
     public:
-        FeedbacksSynchronizer(boost::asio::io_context& ioContext, db::IDb& db, core::http::IClient& client);
+        // Called once remote feedbacks have been imported for a user
+        using FeedbacksImportedCallback = std::function<void(db::UserId userId)>;
+
+        FeedbacksSynchronizer(boost::asio::io_context& ioContext, db::IDb& db, core::http::IClient& client, FeedbacksImportedCallback feedbacksImportedCallback = {});
         ~FeedbacksSynchronizer() = default;
         FeedbacksSynchronizer(const FeedbacksSynchronizer&) = delete;
         FeedbacksSynchronizer& operator=(const FeedbacksSynchronizer&) = delete;
@@ -98,6 +102,7 @@ namespace lms::feedback::listenBrainz
         db::IDb& _db;
         boost::asio::steady_timer _syncTimer{ _ioContext };
         core::http::IClient& _client;
+        const FeedbacksImportedCallback _feedbacksImportedCallback;
 
         std::unordered_map<db::UserId, UserContext> _userContexts;
 
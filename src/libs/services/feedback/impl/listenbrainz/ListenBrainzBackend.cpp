@@ -56,12 +56,12 @@ namespace lms::feedback::listenBrainz
         }
     } // namespace details
 
-    ListenBrainzBackend::ListenBrainzBackend(boost::asio::io_context& ioContext, db::IDb& db)
+    ListenBrainzBackend::ListenBrainzBackend(boost::asio::io_context& ioContext, db::IDb& db, FeedbacksSynchronizer::FeedbacksImportedCallback feedbacksImportedCallback)
         : _ioContext{ ioContext }
         , _db{ db }
         , _baseAPIUrl{ core::Service<core::IConfig>::get()->getString("listenbrainz-api-base-url", "https://api.listenbrainz.org") }
         , _client{ core::http::createClient(_ioContext, _baseAPIUrl) }
-        , _feedbacksSynchronizer{ _ioContext, db, *_client }
+        , _feedbacksSynchronizer{ _ioContext, db, *_client, std::move(feedbacksImportedCallback) }
     {
         LOG(INFO, "Starting ListenBrainz feedback backend... API endpoint = '" << _baseAPIUrl << "'");
     }
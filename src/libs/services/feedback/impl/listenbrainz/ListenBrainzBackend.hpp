@@ -36,7 +36,7 @@ namespace lms::feedback::listenBrainz
     class ListenBrainzBackend final : public IFeedbackBackend
     {
     public:
-        ListenBrainzBackend(boost::asio::io_context& ioContext, db::IDb& db);
+        ListenBrainzBackend(boost::asio::io_context& ioContext, db::IDb& db, FeedbacksSynchronizer::FeedbacksImportedCallback feedbacksImportedCallback = {});
         ~ListenBrainzBackend() override;
 
     private:
@@ -21,6 +21,8 @@
 
 #include <memory>
 #include <optional>
+#include <span>
+#include <vector>
 
 #include <Wt/WDateTime.h>
 #include <boost/asio/io_context.hpp>
@@ -95,6 +97,12 @@ namespace lms::feedback
             }
         };
 
+        struct Feedback
+        {
+            Wt::WDateTime starredDateTime; // invalid if not starred
+            std::optional<db::Rating> rating;
+        };
+
         virtual void star(db::UserId userId, db::ArtistId artistId) = 0;
         virtual void unstar(db::UserId userId, db::ArtistId artistId) = 0;
         virtual bool isStarred(db::UserId userId, db::ArtistId artistId) = 0;
@@ -104,6 +112,9 @@ namespace lms::feedback
         virtual void setRating(db::UserId userId, db::ArtistId artistId, std::optional<db::Rating> rating) = 0;
         virtual std::optional<db::Rating> getRating(db::UserId userId, db::ArtistId artistId) = 0;
 
+        // Same order as artistIds
+        virtual std::vector<Feedback> getFeedbacks(db::UserId userId, std::span<const db::ArtistId> artistIds) = 0;
+
         // Releases
         virtual void star(db::UserId userId, db::ReleaseId releaseId) = 0;
         virtual void unstar(db::UserId userId, db::ReleaseId releaseId) = 0;
@@ -114,6 +125,8 @@ namespace lms::feedback
         virtual void setRating(db::UserId userId, db::ReleaseId releaseId, std::optional<db::Rating> rating) = 0;
         virtual std::optional<db::Rating> getRating(db::UserId userId, db::ReleaseId releaseId) = 0;
 
+        virtual std::vector<Feedback> getFeedbacks(db::UserId userId, std::span<const db::ReleaseId> releaseIds) = 0;
+
         // Tracks
         virtual void star(db::UserId userId, db::TrackId trackId) = 0;
         virtual void unstar(db::UserId userId, db::TrackId trackId) = 0;
@@ -123,6 +136,8 @@ namespace lms::feedback
 
         virtual void setRating(db::UserId userId, db::TrackId trackId, std::optional<db::Rating> rating) = 0;
         virtual std::optional<db::Rating> getRating(db::UserId userId, db::TrackId trackId) = 0;
+
+        virtual std::vector<Feedback> getFeedbacks(db::UserId userId, std::span<const db::TrackId> trackIds) = 0;
     };
 
     std::unique_ptr<IFeedbackService> createFeedbackService(boost::asio::io_context& ioContext, db::IDb& db);
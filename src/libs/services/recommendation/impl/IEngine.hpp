@@ -24,6 +24,7 @@
 #include "core/EnumSet.hpp"
 #include "database/Types.hpp"
 #include "database/objects/TrackListId.hpp"
+#include "services/recommendation/TrackMetadataSnapshot.hpp"
 #include "services/recommendation/Types.hpp"
 
 namespace lms::db
@@ -38,7 +39,7 @@ namespace lms::recommendation
     public:
         virtual ~IEngine() = default;
 
-        virtual void load(bool forceReload, const ProgressCallback& progressCallback = {}) = 0;
+        virtual void load(bool forceReload, const TrackMetadataSnapshot& trackMetadata, const ProgressCallback& progressCallback = {}) = 0;
         virtual void requestCancelLoad() = 0;
 
         virtual TrackContainer findSimilarTracksFromTrackList(db::TrackListId tracklistId, std::size_t maxCount) const = 0;
@@ -35,6 +35,16 @@ namespace lms::recommendation
 {
     using namespace db;
 
+    namespace
+    {
+        // Used until the recommendation service has loaded its first snapshot: the constraints then only check for duplicate tracks
+        const TrackMetadataSnapshot& getEmptyTrackMetadataSnapshot()
+        {
+            static const TrackMetadataSnapshot emptySnapshot{ TrackMetadataSnapshot::Builder{}.build() };
+            return emptySnapshot;
+        }
+    } // namespace
+
     std::unique_ptr<IPlaylistGeneratorService> createPlaylistGeneratorService(db::IDb& db, IRecommendationService& recommendationService)
     {
         return std::make_unique<PlaylistGeneratorService>(db, recommendationService);
@@ -44,8 +54,8 @@ namespace lms::recommendation
         : _db{ db }
         , _recommendationService{ recommendationService }
     {
-        _constraints.push_back(std::make_unique<PlaylistGeneratorConstraint::ConsecutiveArtists>(_db));
-        _constraints.push_back(std::make_unique<PlaylistGeneratorConstraint::ConsecutiveReleases>(_db));
+        _constraints.push_back(std::make_unique<PlaylistGeneratorConstraint::ConsecutiveArtists>());
+        _constraints.push_back(std::make_unique<PlaylistGeneratorConstraint::ConsecutiveReleases>());
         _constraints.push_back(std::make_unique<PlaylistGeneratorConstraint::DuplicateTracks>());
     }
 
@@ -58,6 +68,9 @@ namespace lms::recommendation
 
         const std::vector<TrackId> startingTracks{ getTracksFromTrackList(tracklistId) };
 
+        const std::shared_ptr<const TrackMetadataSnapshot> trackMetadataSnapshot{ _recommendationService.getTrackMetadataSnapshot() };
+        const TrackMetadataSnapshot& trackMetadata{ trackMetadataSnapshot ? *trackMetadataSnapshot : getEmptyTrackMetadataSnapshot() };
+
         std::vector<TrackId> finalResult = startingTracks;
         finalResult.reserve(startingTracks.size() + maxCount);
 
@@ -78,7 +91,7 @@ namespace lms::recommendation
 
                 scores[trackIndex] = 0;
                 for (const auto& constraint : _constraints)
-                    scores[trackIndex] += constraint->computeScore(finalResult, finalResult.size() - 1);
+                    scores[trackIndex] += constraint->computeScore(trackMetadata, finalResult, finalResult.size() - 1);
 
                 finalResult.pop_back();
 
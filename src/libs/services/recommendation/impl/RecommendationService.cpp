@@ -19,11 +19,17 @@
 
 #include "RecommendationService.hpp"
 
+#include <mutex>
 #include <vector>
 
+#include <boost/asio/post.hpp>
+
 #include "database/IDb.hpp"
 #include "database/Session.hpp"
+#include "core/ILogger.hpp"
 #include "database/objects/ScanSettings.hpp"
+#include "database/objects/Track.hpp"
+#include "database/objects/TrackArtistLink.hpp"
 
 #include "ClustersEngineCreator.hpp"
 #include "FeaturesEngineCreator.hpp"
@@ -38,84 +44,236 @@ namespace lms::recommendation
 
             return db::ScanSettings::find(session)->getSimilarityEngineType();
         }
+
+        std::optional<TrackMetadataSnapshot> loadTrackMetadataSnapshot(db::Session& session, const std::atomic<bool>& loadCancelled)
+        {
+            using namespace db;
+
+            TrackMetadataSnapshot::Builder builder;
+
+            constexpr std::size_t batchSize{ 1'000 };
+            TrackId lastRetrievedTrackId;
+            while (true)
+            {
+                if (loadCancelled)
+                    return std::nullopt;
+
+                auto transaction{ session.createReadTransaction() };
+
+                const IdRange<TrackId> trackIdRange{ Track::findNextIdRange(session, lastRetrievedTrackId, batchSize) };
+                if (!trackIdRange.isValid())
+                    break;
+
+                Track::findDurations(session, trackIdRange, [&](TrackId trackId, std::chrono::milliseconds duration) {
+                    builder.addTrack(trackId, duration);
+                });
+                Track::findReleaseIds(session, trackIdRange, [&](TrackId trackId, ReleaseId releaseId) {
+                    builder.setTrackRelease(trackId, releaseId);
+                });
+                TrackArtistLink::find(session, trackIdRange, [&](TrackId trackId, ArtistId artistId, TrackArtistLinkType linkType) {
+                    builder.addTrackArtist(trackId, artistId, linkType);
+                });
+
+                lastRetrievedTrackId = trackIdRange.last;
+            }
+
+            return builder.build();
+        }
     } // namespace
 
-    std::unique_ptr<IRecommendationService> createRecommendationService(db::IDb& db)
+    std::unique_ptr<IRecommendationService> createRecommendationService(boost::asio::io_context& ioContext, db::IDb& db)
     {
-        return std::make_unique<RecommendationService>(db);
+        return std::make_unique<RecommendationService>(ioContext, db);
     }
 
-    RecommendationService::RecommendationService(db::IDb& db)
-        : _db{ db }
+    RecommendationService::RecommendationService(boost::asio::io_context& ioContext, db::IDb& db)
+        : _ioContext{ ioContext }
+        , _db{ db }
     {
         load();
     }
 
-    TrackContainer RecommendationService::findSimilarTracks(db::TrackListId trackListId, std::size_t maxCount) const
+    RecommendationService::~RecommendationService()
     {
-        TrackContainer res;
+        std::unique_lock lock{ _loadMutex };
+
+        _shuttingDown = true;
+        cancelCurrentLoad();
+        _loadCv.wait(lock, [this] { return !_loadInProgress; });
+    }
 
-        if (!_engine)
-            return res;
+    TrackContainer RecommendationService::findSimilarTracks(db::TrackListId trackListId, std::size_t maxCount) const
+    {
+        const std::shared_ptr<IEngine> engine{ getEngine() };
+        if (!engine)
+            return {};
 
-        return _engine->findSimilarTracksFromTrackList(trackListId, maxCount);
+        return engine->findSimilarTracksFromTrackList(trackListId, maxCount);
     }
 
     TrackContainer RecommendationService::findSimilarTracks(const std::vector<db::TrackId>& trackIds, std::size_t maxCount) const
     {
-        TrackContainer res;
+        const std::shared_ptr<IEngine> engine{ getEngine() };
+        if (!engine)
+            return {};
 
-        if (!_engine)
-            return res;
-
-        return _engine->findSimilarTracks(trackIds, maxCount);
+        return engine->findSimilarTracks(trackIds, maxCount);
     }
 
     ReleaseContainer RecommendationService::getSimilarReleases(db::ReleaseId releaseId, std::size_t maxCount) const
     {
-        ReleaseContainer res;
-
-        if (!_engine)
-            return res;
+        const std::shared_ptr<IEngine> engine{ getEngine() };
+        if (!engine)
+            return {};
 
-        return _engine->getSimilarReleases(releaseId, maxCount);
-        ;
+        return engine->getSimilarReleases(releaseId, maxCount);
     }
 
     ArtistContainer RecommendationService::getSimilarArtists(db::ArtistId artistId, core::EnumSet<db::TrackArtistLinkType> linkTypes, std::size_t maxCount) const
     {
-        ArtistContainer res;
+        const std::shared_ptr<IEngine> engine{ getEngine() };
+        if (!engine)
+            return {};
 
-        if (!_engine)
-            return res;
+        return engine->getSimilarArtists(artistId, linkTypes, maxCount);
+    }
 
-        return _engine->getSimilarArtists(artistId, linkTypes, maxCount);
+    std::shared_ptr<const TrackMetadataSnapshot> RecommendationService::getTrackMetadataSnapshot() const
+    {
+        const std::shared_lock lock{ _mutex };
+        return _trackMetadata;
+    }
 
-        return res;
+    std::shared_ptr<IEngine> RecommendationService::getEngine() const
+    {
+        const std::shared_lock lock{ _mutex };
+        return _engine;
     }
 
     void RecommendationService::load()
+    {
+        {
+            const std::scoped_lock lock{ _loadMutex };
+
+            if (_shuttingDown)
+                return;
+
+            _loadRequested = true;
+            if (_loadInProgress)
+            {
+                // the current load will start over once cancelled
+                cancelCurrentLoad();
+                return;
+            }
+
+            _loadInProgress = true;
+        }
+
+        boost::asio::post(_ioContext, [this] { processLoadRequests(); });
+    }
+
+    void RecommendationService::waitForLoad()
+    {
+        std::unique_lock lock{ _loadMutex };
+        _loadCv.wait(lock, [this] { return !_loadInProgress; });
+    }
+
+    // _loadMutex must be locked
+    void RecommendationService::cancelCurrentLoad()
+    {
+        _loadCancelled = true;
+        if (_loadingEngine)
+            _loadingEngine->requestCancelLoad();
+    }
+
+    void RecommendationService::processLoadRequests()
+    {
+        while (true)
+        {
+            {
+                const std::scoped_lock lock{ _loadMutex };
+
+                if (!_loadRequested || _shuttingDown)
+                {
+                    _loadInProgress = false;
+                    _loadCv.notify_all();
+                    return;
+                }
+
+                _loadRequested = false;
+                _loadCancelled = false;
+            }
+
+            try
+            {
+                doLoad();
+            }
+            catch (const std::exception& e)
+            {
+                LMS_LOG(RECOMMENDATION, ERROR, "Cannot load recommendation data: " << e.what());
+            }
+        }
+    }
+
+    void RecommendationService::doLoad()
     {
         using namespace db;
 
+        std::optional<TrackMetadataSnapshot> loadedTrackMetadata{ loadTrackMetadataSnapshot(_db.getTLSSession(), _loadCancelled) };
+        if (!loadedTrackMetadata)
+        {
+            LMS_LOG(RECOMMENDATION, DEBUG, "Recommendation load cancelled");
+            return;
+        }
+
+        auto trackMetadata{ std::make_shared<const TrackMetadataSnapshot>(std::move(*loadedTrackMetadata)) };
+        LMS_LOG(RECOMMENDATION, INFO, "Track metadata snapshot loaded: " << trackMetadata->getTrackCount() << " tracks, " << (trackMetadata->getMemoryUsage() / 1024) << " KiB");
+
+        std::optional<EngineType> engineType;
         switch (getSimilarityEngineType(_db.getTLSSession()))
         {
         case ScanSettings::SimilarityEngineType::Clusters:
-            if (_engineType != EngineType::Clusters)
-            {
-                _engineType = EngineType::Clusters;
-                _engine = createClustersEngine(_db);
-            }
+            engineType = EngineType::Clusters;
             break;
 
         case ScanSettings::SimilarityEngineType::Features:
         case ScanSettings::SimilarityEngineType::None:
-            _engineType.reset();
-            _engine.reset();
             break;
         }
 
-        if (_engine)
-            _engine->load(false);
+        // A new engine is built on each load, the current one keeps serving the queries until both the new engine and its snapshot are published
+        std::shared_ptr<IEngine> engine;
+        if (engineType)
+            engine = createClustersEngine(_db);
+
+        if (engine)
+        {
+            {
+                const std::scoped_lock lock{ _loadMutex };
+                if (_loadCancelled)
+                    return;
+
+                _loadingEngine = engine;
+            }
+
+            engine->load(false, *trackMetadata);
+
+            {
+                const std::scoped_lock lock{ _loadMutex };
+                _loadingEngine.reset();
+            }
+
+            if (_loadCancelled)
+            {
+                LMS_LOG(RECOMMENDATION, DEBUG, "Recommendation load cancelled");
+                return;
+            }
+        }
+
+        {
+            const std::unique_lock lock{ _mutex };
+            _engine = std::move(engine);
+            _trackMetadata = std::move(trackMetadata);
+        }
     }
 } // namespace lms::recommendation
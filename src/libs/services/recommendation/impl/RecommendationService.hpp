@@ -19,7 +19,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
+
+#include <boost/asio/io_context.hpp>
 
 #include "services/recommendation/IRecommendationService.hpp"
 
@@ -41,26 +48,40 @@ namespace lms::recommendation
     class RecommendationService : public IRecommendationService
     {
     public:
-        RecommendationService(db::IDb& db);
-        ~RecommendationService() override = default;
+        RecommendationService(boost::asio::io_context& ioContext, db::IDb& db);
+        ~RecommendationService() override;
         RecommendationService(const RecommendationService&) = delete;
         RecommendationService& operator=(const RecommendationService&) = delete;
 
     private:
         void load() override;
+        void waitForLoad() override;
 
         TrackContainer findSimilarTracks(db::TrackListId tracklistId, std::size_t maxCount) const override;
         TrackContainer findSimilarTracks(const std::vector<db::TrackId>& trackIds, std::size_t maxCount) const override;
         ReleaseContainer getSimilarReleases(db::ReleaseId releaseId, std::size_t maxCount) const override;
         ArtistContainer getSimilarArtists(db::ArtistId artistId, core::EnumSet<db::TrackArtistLinkType> linkTypes, std::size_t maxCount) const override;
+        std::shared_ptr<const TrackMetadataSnapshot> getTrackMetadataSnapshot() const override;
 
-        void setEnginePriorities(const std::vector<EngineType>& engineTypes);
-        void clearEngines();
-        void loadPendingEngine(EngineType engineType, std::unique_ptr<IEngine> engine, bool forceReload, const ProgressCallback& progressCallback);
+        void cancelCurrentLoad();
+        void processLoadRequests(); // on the io context
+        void doLoad();
+        std::shared_ptr<IEngine> getEngine() const;
 
+        boost::asio::io_context& _ioContext;
         db::IDb& _db;
-        std::optional<EngineType> _engineType;
-        std::unique_ptr<IEngine> _engine;
-    };
 
+        std::mutex _loadMutex;
+        std::condition_variable _loadCv;
+        bool _loadInProgress{};
+        bool _loadRequested{};  // another load is to be done once the current one is over
+        bool _shuttingDown{};
+        std::shared_ptr<IEngine> _loadingEngine; // engine being loaded, if any
+        std::atomic<bool> _loadCancelled{};
+
+        // Swapped once the new data are fully loaded
+        mutable std::shared_mutex _mutex;
+        std::shared_ptr<IEngine> _engine;
+        std::shared_ptr<const TrackMetadataSnapshot> _trackMetadata;
+    };
 } // namespace lms::recommendation
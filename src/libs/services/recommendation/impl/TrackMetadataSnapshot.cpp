@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "services/recommendation/TrackMetadataSnapshot.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace lms::recommendation
+{
+    void TrackMetadataSnapshot::Builder::addTrack(db::TrackId trackId, std::chrono::milliseconds duration)
+    {
+        _tracks.emplace_back(trackId, duration);
+    }
+
+    void TrackMetadataSnapshot::Builder::setTrackRelease(db::TrackId trackId, db::ReleaseId releaseId)
+    {
+        _trackReleases.emplace_back(trackId, releaseId);
+    }
+
+    void TrackMetadataSnapshot::Builder::addTrackArtist(db::TrackId trackId, db::ArtistId artistId, db::TrackArtistLinkType linkType)
+    {
+        _trackArtists.emplace_back(TrackArtist{ trackId, ArtistLink{ artistId, linkType } });
+    }
+
+    TrackMetadataSnapshot TrackMetadataSnapshot::Builder::build()
+    {
+        TrackMetadataSnapshot snapshot;
+
+        std::sort(std::begin(_tracks), std::end(_tracks), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+        _tracks.erase(std::unique(std::begin(_tracks), std::end(_tracks), [](const auto& lhs, const auto& rhs) { return lhs.first == rhs.first; }), std::end(_tracks));
+
+        snapshot._trackIds.reserve(_tracks.size());
+        snapshot._durations.reserve(_tracks.size());
+        for (const auto& [trackId, duration] : _tracks)
+        {
+            snapshot._trackIds.push_back(trackId);
+            snapshot._durations.push_back(static_cast<std::uint32_t>(std::max<std::chrono::milliseconds::rep>(duration.count(), 0)));
+        }
+        std::vector<std::pair<db::TrackId, std::chrono::milliseconds>>{}.swap(_tracks);
+
+        snapshot._releaseIds.resize(snapshot._trackIds.size());
+        for (const auto& [trackId, releaseId] : _trackReleases)
+        {
+            const Index index{ snapshot.findIndex(trackId) };
+            if (index != invalidIndex)
+                snapshot._releaseIds[index] = releaseId;
+        }
+        std::vector<std::pair<db::TrackId, db::ReleaseId>>{}.swap(_trackReleases);
+
+        const auto toTuple{ [](const TrackArtist& trackArtist) { return std::make_tuple(trackArtist.trackId, trackArtist.link.artistId, trackArtist.link.linkType); } };
+        std::sort(std::begin(_trackArtists), std::end(_trackArtists), [&](const TrackArtist& lhs, const TrackArtist& rhs) { return toTuple(lhs) < toTuple(rhs); });
+        _trackArtists.erase(std::unique(std::begin(_trackArtists), std::end(_trackArtists), [&](const TrackArtist& lhs, const TrackArtist& rhs) { return toTuple(lhs) == toTuple(rhs); }), std::end(_trackArtists));
+
+        snapshot._artistLinkOffsets.assign(snapshot._trackIds.size() + 1, 0);
+        snapshot._artistLinks.reserve(_trackArtists.size());
+        for (const TrackArtist& trackArtist : _trackArtists)
+        {
+            const Index index{ snapshot.findIndex(trackArtist.trackId) };
+            if (index == invalidIndex)
+                continue;
+
+            snapshot._artistLinkOffsets[index + 1]++;
+            snapshot._artistLinks.push_back(trackArtist.link);
+        }
+        for (std::size_t i{}; i < snapshot._trackIds.size(); ++i)
+            snapshot._artistLinkOffsets[i + 1] += snapshot._artistLinkOffsets[i];
+        std::vector<TrackArtist>{}.swap(_trackArtists);
+
+        return snapshot;
+    }
+
+    db::ReleaseId TrackMetadataSnapshot::getReleaseId(db::TrackId trackId) const
+    {
+        const Index index{ findIndex(trackId) };
+        return index != invalidIndex ? _releaseIds[index] : db::ReleaseId{};
+    }
+
+    std::chrono::milliseconds TrackMetadataSnapshot::getDuration(db::TrackId trackId) const
+    {
+        const Index index{ findIndex(trackId) };
+        return index != invalidIndex ? std::chrono::milliseconds{ _durations[index] } : std::chrono::milliseconds{};
+    }
+
+    std::span<const TrackMetadataSnapshot::ArtistLink> TrackMetadataSnapshot::getArtistLinks(db::TrackId trackId) const
+    {
+        const Index index{ findIndex(trackId) };
+        return index != invalidIndex ? getArtistLinks(index) : std::span<const ArtistLink>{};
+    }
+
+    std::size_t TrackMetadataSnapshot::getMemoryUsage() const
+    {
+        return _trackIds.capacity() * sizeof(db::TrackId)
+               + _releaseIds.capacity() * sizeof(db::ReleaseId)
+               + _durations.capacity() * sizeof(std::uint32_t)
+               + _artistLinkOffsets.capacity() * sizeof(Index)
+               + _artistLinks.capacity() * sizeof(ArtistLink);
+    }
+
+    TrackMetadataSnapshot::Index TrackMetadataSnapshot::findIndex(db::TrackId trackId) const
+    {
+        const auto it{ std::lower_bound(std::cbegin(_trackIds), std::cend(_trackIds), trackId) };
+        if (it == std::cend(_trackIds) || *it != trackId)
+            return invalidIndex;
+
+        return static_cast<Index>(std::distance(std::cbegin(_trackIds), it));
+    }
+
+    std::span<const TrackMetadataSnapshot::ArtistLink> TrackMetadataSnapshot::getArtistLinks(Index index) const
+    {
+        return std::span{ _artistLinks }.subspan(_artistLinkOffsets[index], _artistLinkOffsets[index + 1] - _artistLinkOffsets[index]);
+    }
+} // namespace lms::recommendation
@@ -0,0 +1,453 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ClusterSimilarityIndex.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+
+#include "core/ParallelFor.hpp"
+#include "core/Random.hpp"
+
+namespace lms::recommendation
+{
+    namespace
+    {
+        template<typename IdType>
+        std::vector<IdType> toIds(const std::vector<IdType>& ids, std::span<const std::uint32_t> indexes)
+        {
+            std::vector<IdType> res;
+            res.reserve(indexes.size());
+            std::transform(std::cbegin(indexes), std::cend(indexes), std::back_inserter(res), [&](std::uint32_t index) { return ids[index]; });
+
+            return res;
+        }
+
+        template<typename IdType, typename ScoredIndex>
+        std::vector<IdType> scoredIndexesToIds(const std::vector<IdType>& ids, const std::vector<ScoredIndex>& scoredIndexes)
+        {
+            std::vector<IdType> res;
+            res.reserve(scoredIndexes.size());
+            std::transform(std::cbegin(scoredIndexes), std::cend(scoredIndexes), std::back_inserter(res), [&](const ScoredIndex& scoredIndex) { return ids[scoredIndex.index]; });
+
+            return res;
+        }
+
+        template<typename IdType>
+        std::vector<IdType> getSortedUniqueIds(std::vector<IdType>&& ids)
+        {
+            std::sort(std::begin(ids), std::end(ids));
+            ids.erase(std::unique(std::begin(ids), std::end(ids)), std::end(ids));
+            ids.shrink_to_fit();
+
+            return std::move(ids);
+        }
+    } // namespace
+
+    void ClusterSimilarityIndex::Builder::addTrackCluster(db::TrackId trackId, db::ClusterId clusterId)
+    {
+        _trackClusters.emplace_back(trackId, clusterId);
+    }
+
+    void ClusterSimilarityIndex::Builder::setTrackRelease(db::TrackId trackId, db::ReleaseId releaseId)
+    {
+        _trackReleases.emplace_back(trackId, releaseId);
+    }
+
+    void ClusterSimilarityIndex::Builder::addTrackArtist(db::TrackId trackId, db::ArtistId artistId, db::TrackArtistLinkType linkType)
+    {
+        _trackArtists.emplace_back(TrackArtist{ trackId, artistId, linkType });
+    }
+
+    ClusterSimilarityIndex ClusterSimilarityIndex::Builder::build()
+    {
+        ClusterSimilarityIndex index;
+
+        // Only tracks that belong to at least one cluster are indexed: other tracks cannot contribute to any score
+        {
+            std::vector<db::TrackId> trackIds;
+            trackIds.reserve(_trackClusters.size());
+            std::transform(std::cbegin(_trackClusters), std::cend(_trackClusters), std::back_inserter(trackIds), [](const auto& trackCluster) { return trackCluster.first; });
+            index._trackIds = getSortedUniqueIds(std::move(trackIds));
+        }
+
+        {
+            std::vector<db::ClusterId> clusterIds;
+            clusterIds.reserve(_trackClusters.size());
+            std::transform(std::cbegin(_trackClusters), std::cend(_trackClusters), std::back_inserter(clusterIds), [](const auto& trackCluster) { return trackCluster.second; });
+            clusterIds = getSortedUniqueIds(std::move(clusterIds));
+
+            std::vector<std::pair<Index, Index>> trackClusterEdges;
+            std::vector<std::pair<Index, Index>> clusterTrackEdges;
+            trackClusterEdges.reserve(_trackClusters.size());
+            clusterTrackEdges.reserve(_trackClusters.size());
+            for (const auto& [trackId, clusterId] : _trackClusters)
+            {
+                const Index trackIndex{ findIndex(index._trackIds, trackId) };
+                const Index clusterIndex{ findIndex(clusterIds, clusterId) };
+
+                trackClusterEdges.emplace_back(trackIndex, clusterIndex);
+                clusterTrackEdges.emplace_back(clusterIndex, trackIndex);
+            }
+            std::vector<std::pair<db::TrackId, db::ClusterId>>{}.swap(_trackClusters);
+
+            index._trackClusters.build(index._trackIds.size(), trackClusterEdges);
+            index._clusterTracks.build(clusterIds.size(), clusterTrackEdges);
+        }
+
+        {
+            std::erase_if(_trackReleases, [&](const auto& trackRelease) { return findIndex(index._trackIds, trackRelease.first) == invalidIndex; });
+
+            std::vector<db::ReleaseId> releaseIds;
+            releaseIds.reserve(_trackReleases.size());
+            std::transform(std::cbegin(_trackReleases), std::cend(_trackReleases), std::back_inserter(releaseIds), [](const auto& trackRelease) { return trackRelease.second; });
+            index._releaseIds = getSortedUniqueIds(std::move(releaseIds));
+
+            index._trackRelease.resize(index._trackIds.size(), invalidIndex);
+            std::vector<std::pair<Index, Index>> releaseTrackEdges;
+            releaseTrackEdges.reserve(_trackReleases.size());
+            for (const auto& [trackId, releaseId] : _trackReleases)
+            {
+                const Index trackIndex{ findIndex(index._trackIds, trackId) };
+                const Index releaseIndex{ findIndex(index._releaseIds, releaseId) };
+
+                index._trackRelease[trackIndex] = releaseIndex;
+                releaseTrackEdges.emplace_back(releaseIndex, trackIndex);
+            }
+            std::vector<std::pair<db::TrackId, db::ReleaseId>>{}.swap(_trackReleases);
+
+            index._releaseTracks.build(index._releaseIds.size(), releaseTrackEdges);
+        }
+
+        {
+            std::erase_if(_trackArtists, [&](const TrackArtist& trackArtist) { return findIndex(index._trackIds, trackArtist.trackId) == invalidIndex; });
+
+            std::vector<db::ArtistId> artistIds;
+            artistIds.reserve(_trackArtists.size());
+            std::transform(std::cbegin(_trackArtists), std::cend(_trackArtists), std::back_inserter(artistIds), [](const TrackArtist& trackArtist) { return trackArtist.artistId; });
+            index._artistIds = getSortedUniqueIds(std::move(artistIds));
+
+            std::vector<std::pair<Index, ArtistLink>> trackArtistEdges;
+            std::vector<std::pair<Index, Index>> artistTrackEdges;
+            trackArtistEdges.reserve(_trackArtists.size());
+            artistTrackEdges.reserve(_trackArtists.size());
+            for (const TrackArtist& trackArtist : _trackArtists)
+            {
+                const Index trackIndex{ findIndex(index._trackIds, trackArtist.trackId) };
+                const Index artistIndex{ findIndex(index._artistIds, trackArtist.artistId) };
+
+                trackArtistEdges.emplace_back(trackIndex, ArtistLink{ artistIndex, trackArtist.linkType });
+                artistTrackEdges.emplace_back(artistIndex, trackIndex);
+            }
+            std::vector<TrackArtist>{}.swap(_trackArtists);
+
+            index._trackArtists.build(index._trackIds.size(), trackArtistEdges);
+
+            // an artist may appear several times on the same track, using different link types
+            std::sort(std::begin(artistTrackEdges), std::end(artistTrackEdges));
+            artistTrackEdges.erase(std::unique(std::begin(artistTrackEdges), std::end(artistTrackEdges)), std::end(artistTrackEdges));
+            index._artistTracks.build(index._artistIds.size(), artistTrackEdges);
+        }
+
+        return index;
+    }
+
+    // Per thread scoring buffers, reused across queries so that they do not allocate
+    struct ClusterSimilarityIndex::Scores
+    {
+        std::vector<std::uint32_t> counts;
+        std::vector<Index> touched;
+
+        void increment(Index index)
+        {
+            if (counts[index]++ == 0)
+                touched.push_back(index);
+        }
+
+        void reset()
+        {
+            for (const Index index : touched)
+                counts[index] = 0;
+            touched.clear();
+        }
+    };
+
+    ClusterSimilarityIndex::Scores& ClusterSimilarityIndex::getScores(std::size_t size)
+    {
+        thread_local Scores scores;
+        if (scores.counts.size() < size)
+            scores.counts.resize(size);
+
+        return scores;
+    }
+
+    template<typename ExcludeFunc>
+    std::vector<ClusterSimilarityIndex::ScoredIndex> ClusterSimilarityIndex::selectBest(Scores& scores, std::size_t maxCount, std::size_t maxTieCount, ExcludeFunc&& excludeFunc)
+    {
+        std::vector<ScoredIndex> candidates;
+        candidates.reserve(scores.touched.size());
+        for (const Index index : scores.touched)
+        {
+            if (!excludeFunc(index))
+                candidates.push_back(ScoredIndex{ index, scores.counts[index] });
+        }
+        scores.reset();
+
+        core::random::shuffleContainer(candidates);
+
+        const auto isBetter{ [](const ScoredIndex& lhs, const ScoredIndex& rhs) { return lhs.score > rhs.score; } };
+        std::size_t count{ std::min(maxCount, candidates.size()) };
+        std::partial_sort(std::begin(candidates), std::begin(candidates) + count, std::end(candidates), isBetter);
+
+        if (count > 0 && maxTieCount > 0)
+        {
+            const std::uint32_t cutOffScore{ candidates[count - 1].score };
+            const auto tiesEnd{ std::partition(std::begin(candidates) + count, std::end(candidates), [&](const ScoredIndex& candidate) { return candidate.score == cutOffScore; }) };
+            count += std::min(maxTieCount, static_cast<std::size_t>(std::distance(std::begin(candidates) + count, tiesEnd)));
+        }
+        candidates.resize(count);
+
+        return candidates;
+    }
+
+    std::vector<ClusterSimilarityIndex::Index> ClusterSimilarityIndex::selectPrecomputed(std::span<const ScoredIndex> similarIndexes, std::size_t maxCount)
+    {
+        // ties are shuffled again, as a query made on the fly would do
+        std::vector<ScoredIndex> candidates(std::cbegin(similarIndexes), std::cend(similarIndexes));
+        for (auto groupBegin{ std::begin(candidates) }; groupBegin != std::end(candidates);)
+        {
+            const auto groupEnd{ std::find_if(groupBegin, std::end(candidates), [&](const ScoredIndex& candidate) { return candidate.score != groupBegin->score; }) };
+            std::shuffle(groupBegin, groupEnd, core::random::getRandGenerator());
+            groupBegin = groupEnd;
+        }
+
+        std::vector<Index> res;
+        res.reserve(std::min(maxCount, candidates.size()));
+        for (std::size_t i{}; i < candidates.size() && i < maxCount; ++i)
+            res.push_back(candidates[i].index);
+
+        return res;
+    }
+
+    template<typename T>
+    void ClusterSimilarityIndex::AdjacencyList<T>::build(std::size_t nodeCount, std::vector<std::pair<Index, T>>& edges)
+    {
+        // counting sort, keeps the edge order for each node
+        _offsets.assign(nodeCount + 1, 0);
+        for (const auto& edge : edges)
+            _offsets[edge.first + 1]++;
+
+        for (std::size_t i{}; i < nodeCount; ++i)
+            _offsets[i + 1] += _offsets[i];
+
+        std::vector<Index> positions(std::cbegin(_offsets), std::cend(_offsets) - 1);
+        _values.resize(edges.size());
+        for (const auto& [node, value] : edges)
+            _values[positions[node]++] = value;
+
+        std::vector<std::pair<Index, T>>{}.swap(edges);
+    }
+
+    template<typename IdType>
+    ClusterSimilarityIndex::Index ClusterSimilarityIndex::findIndex(const std::vector<IdType>& ids, IdType id)
+    {
+        const auto it{ std::lower_bound(std::cbegin(ids), std::cend(ids), id) };
+        if (it == std::cend(ids) || *it != id)
+            return invalidIndex;
+
+        return static_cast<Index>(std::distance(std::cbegin(ids), it));
+    }
+
+    std::vector<ClusterSimilarityIndex::Index> ClusterSimilarityIndex::getClusters(std::span<const Index> trackIndexes) const
+    {
+        std::vector<Index> res;
+        for (const Index trackIndex : trackIndexes)
+        {
+            const std::span<const Index> clusters{ _trackClusters[trackIndex] };
+            res.insert(std::end(res), std::cbegin(clusters), std::cend(clusters));
+        }
+
+        std::sort(std::begin(res), std::end(res));
+        res.erase(std::unique(std::begin(res), std::end(res)), std::end(res));
+
+        return res;
+    }
+
+    template<typename Func>
+    void ClusterSimilarityIndex::visitClusterTracks(std::span<const Index> clusterIndexes, std::size_t maxClusterScanSize, Func&& func) const
+    {
+        for (const Index clusterIndex : clusterIndexes)
+        {
+            const std::span<const Index> tracks{ _clusterTracks[clusterIndex] };
+            if (maxClusterScanSize == 0 || tracks.size() <= maxClusterScanSize)
+            {
+                for (const Index trackIndex : tracks)
+                    func(trackIndex);
+            }
+            else
+            {
+                // window starting at a random offset, wrapping around the end
+                std::uniform_int_distribution<std::size_t> dist{ 0, tracks.size() - 1 };
+                const std::size_t offset{ dist(core::random::getRandGenerator()) };
+                const std::size_t firstPartSize{ std::min(maxClusterScanSize, tracks.size() - offset) };
+
+                for (const Index trackIndex : tracks.subspan(offset, firstPartSize))
+                    func(trackIndex);
+                for (const Index trackIndex : tracks.first(maxClusterScanSize - firstPartSize))
+                    func(trackIndex);
+            }
+        }
+    }
+
+    std::vector<db::TrackId> ClusterSimilarityIndex::findSimilarTracks(std::span<const db::TrackId> trackIds, const SearchParameters& params) const
+    {
+        if (params.maxCount == 0)
+            return {};
+
+        std::vector<Index> trackIndexes;
+        trackIndexes.reserve(trackIds.size());
+        for (const db::TrackId trackId : trackIds)
+        {
+            const Index trackIndex{ findIndex(_trackIds, trackId) };
+            if (trackIndex != invalidIndex)
+                trackIndexes.push_back(trackIndex);
+        }
+        std::sort(std::begin(trackIndexes), std::end(trackIndexes));
+
+        Scores& scores{ getScores(_trackIds.size()) };
+        visitClusterTracks(getClusters(trackIndexes), params.maxClusterScanSize, [&](Index trackIndex) {
+            scores.increment(trackIndex);
+        });
+
+        return scoredIndexesToIds(_trackIds, selectBest(scores, params.maxCount, 0, [&](Index trackIndex) { return std::binary_search(std::cbegin(trackIndexes), std::cend(trackIndexes), trackIndex); }));
+    }
+
+    std::vector<db::ReleaseId> ClusterSimilarityIndex::findSimilarReleases(db::ReleaseId releaseId, const SearchParameters& params) const
+    {
+        const Index releaseIndex{ findIndex(_releaseIds, releaseId) };
+        if (releaseIndex == invalidIndex || params.maxCount == 0)
+            return {};
+
+        if (isPrecomputed(params))
+            return toIds(_releaseIds, selectPrecomputed(_similarReleases[releaseIndex], params.maxCount));
+
+        return scoredIndexesToIds(_releaseIds, findSimilarReleaseIndexes(releaseIndex, params, 0));
+    }
+
+    std::vector<db::ArtistId> ClusterSimilarityIndex::findSimilarArtists(db::ArtistId artistId, core::EnumSet<db::TrackArtistLinkType> linkTypes, const SearchParameters& params) const
+    {
+        const Index artistIndex{ findIndex(_artistIds, artistId) };
+        if (artistIndex == invalidIndex || params.maxCount == 0)
+            return {};
+
+        if (isPrecomputed(params) && linkTypes == _precomputedArtistLinkTypes)
+            return toIds(_artistIds, selectPrecomputed(_similarArtists[artistIndex], params.maxCount));
+
+        return scoredIndexesToIds(_artistIds, findSimilarArtistIndexes(artistIndex, linkTypes, params, 0));
+    }
+
+    std::vector<ClusterSimilarityIndex::ScoredIndex> ClusterSimilarityIndex::findSimilarReleaseIndexes(Index releaseIndex, const SearchParameters& params, std::size_t maxTieCount) const
+    {
+        Scores& scores{ getScores(_releaseIds.size()) };
+        visitClusterTracks(getClusters(_releaseTracks[releaseIndex]), params.maxClusterScanSize, [&](Index trackIndex) {
+            const Index otherReleaseIndex{ _trackRelease[trackIndex] };
+            if (otherReleaseIndex != invalidIndex)
+                scores.increment(otherReleaseIndex);
+        });
+
+        return selectBest(scores, params.maxCount, maxTieCount, [&](Index otherReleaseIndex) { return otherReleaseIndex == releaseIndex; });
+    }
+
+    std::vector<ClusterSimilarityIndex::ScoredIndex> ClusterSimilarityIndex::findSimilarArtistIndexes(Index artistIndex, core::EnumSet<db::TrackArtistLinkType> linkTypes, const SearchParameters& params, std::size_t maxTieCount) const
+    {
+        Scores& scores{ getScores(_artistIds.size()) };
+        visitClusterTracks(getClusters(_artistTracks[artistIndex]), params.maxClusterScanSize, [&](Index trackIndex) {
+            for (const ArtistLink& artistLink : _trackArtists[trackIndex])
+            {
+                if (linkTypes.empty() || linkTypes.contains(artistLink.linkType))
+                    scores.increment(artistLink.artistIndex);
+            }
+        });
+
+        return selectBest(scores, params.maxCount, maxTieCount, [&](Index otherArtistIndex) { return otherArtistIndex == artistIndex; });
+    }
+
+    bool ClusterSimilarityIndex::precomputeSimilarObjects(core::EnumSet<db::TrackArtistLinkType> artistLinkTypes, const SearchParameters& params, core::IJobScheduler& jobScheduler, const AbortFunction& abortFunc)
+    {
+        // bounds the memory used by large groups of ties (typically objects sharing a single cluster)
+        const std::size_t maxTieCount{ params.maxCount };
+
+        std::atomic<bool> aborted{};
+        const auto computeEdges{ [&](std::size_t nodeCount, auto&& findSimilarIndexes) {
+            std::vector<std::vector<ScoredIndex>> similarIndexes(nodeCount);
+            core::parallelFor(jobScheduler, nodeCount, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t node{ begin }; node < end && !aborted; ++node)
+                {
+                    similarIndexes[node] = findSimilarIndexes(static_cast<Index>(node));
+                    if (abortFunc && abortFunc())
+                        aborted = true;
+                }
+            });
+
+            std::vector<std::pair<Index, ScoredIndex>> edges;
+            for (std::size_t node{}; node < nodeCount; ++node)
+            {
+                for (const ScoredIndex& similarIndex : similarIndexes[node])
+                    edges.emplace_back(static_cast<Index>(node), similarIndex);
+            }
+
+            return edges;
+        } };
+
+        auto releaseEdges{ computeEdges(_releaseIds.size(), [&](Index releaseIndex) { return findSimilarReleaseIndexes(releaseIndex, params, maxTieCount); }) };
+        auto artistEdges{ computeEdges(_artistIds.size(), [&](Index artistIndex) { return findSimilarArtistIndexes(artistIndex, artistLinkTypes, params, maxTieCount); }) };
+        if (aborted)
+            return false;
+
+        _similarReleases.build(_releaseIds.size(), releaseEdges);
+        _similarArtists.build(_artistIds.size(), artistEdges);
+        _precomputedParams = params;
+        _precomputedArtistLinkTypes = artistLinkTypes;
+
+        return true;
+    }
+
+    bool ClusterSimilarityIndex::isPrecomputed(const SearchParameters& params) const
+    {
+        return _precomputedParams.maxCount > 0
+               && params.maxCount <= _precomputedParams.maxCount
+               && params.maxClusterScanSize == _precomputedParams.maxClusterScanSize;
+    }
+
+    std::size_t ClusterSimilarityIndex::getMemoryUsage() const
+    {
+        return _trackIds.capacity() * sizeof(db::TrackId)
+               + _releaseIds.capacity() * sizeof(db::ReleaseId)
+               + _artistIds.capacity() * sizeof(db::ArtistId)
+               + _trackClusters.getMemoryUsage()
+               + _clusterTracks.getMemoryUsage()
+               + _trackRelease.capacity() * sizeof(Index)
+               + _releaseTracks.getMemoryUsage()
+               + _trackArtists.getMemoryUsage()
+               + _artistTracks.getMemoryUsage()
+               + _similarReleases.getMemoryUsage()
+               + _similarArtists.getMemoryUsage();
+    }
+} // namespace lms::recommendation
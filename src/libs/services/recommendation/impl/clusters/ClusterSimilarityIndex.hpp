@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "core/EnumSet.hpp"
+#include "database/Types.hpp"
+#include "database/objects/ArtistId.hpp"
+#include "database/objects/ClusterId.hpp"
+#include "database/objects/ReleaseId.hpp"
+#include "database/objects/TrackId.hpp"
+
+namespace lms::core
+{
+    class IJobScheduler;
+}
+
+namespace lms::recommendation
+{
+    // In-memory cluster co-membership graph (compressed adjacency lists)
+    // Objects are ranked using the number of (track, cluster) pairs they share with the query, the same way the database queries do,
+    // ties are randomly ordered
+    class ClusterSimilarityIndex
+    {
+    public:
+        class Builder
+        {
+        public:
+            void addTrackCluster(db::TrackId trackId, db::ClusterId clusterId);
+            void setTrackRelease(db::TrackId trackId, db::ReleaseId releaseId);
+            void addTrackArtist(db::TrackId trackId, db::ArtistId artistId, db::TrackArtistLinkType linkType);
+
+            ClusterSimilarityIndex build();
+
+        private:
+            struct TrackArtist
+            {
+                db::TrackId trackId;
+                db::ArtistId artistId;
+                db::TrackArtistLinkType linkType;
+            };
+
+            std::vector<std::pair<db::TrackId, db::ClusterId>> _trackClusters;
+            std::vector<std::pair<db::TrackId, db::ReleaseId>> _trackReleases;
+            std::vector<TrackArtist> _trackArtists;
+        };
+
+        // Only the first maxClusterScanSize tracks, from a random offset, are visited in each cluster (0 means no limit)
+        // This bounds the cost of queries involving very large clusters (main genres, etc.), at the expense of exactness
+        struct SearchParameters
+        {
+            std::size_t maxCount{};
+            std::size_t maxClusterScanSize{};
+        };
+
+        std::vector<db::TrackId> findSimilarTracks(std::span<const db::TrackId> trackIds, const SearchParameters& params) const;
+        std::vector<db::ReleaseId> findSimilarReleases(db::ReleaseId releaseId, const SearchParameters& params) const;
+        std::vector<db::ArtistId> findSimilarArtists(db::ArtistId artistId, core::EnumSet<db::TrackArtistLinkType> linkTypes, const SearchParameters& params) const;
+
+        // Computes once the similar releases and artists of every indexed object, using the threads of the job scheduler
+        // Later queries made with the same parameters (or a lower maxCount) are simple lookups
+        // Scores are kept along with the candidates tied at the cut-off score, so that ties are still randomly ordered by each query
+        // Only the cluster scan windows (see maxClusterScanSize) are drawn once
+        // Returns false if aborted, in that case nothing is precomputed
+        using AbortFunction = std::function<bool()>;
+        bool precomputeSimilarObjects(core::EnumSet<db::TrackArtistLinkType> artistLinkTypes, const SearchParameters& params, core::IJobScheduler& jobScheduler, const AbortFunction& abortFunc = {});
+
+        std::size_t getTrackCount() const { return _trackIds.size(); }
+        std::size_t getClusterCount() const { return _clusterTracks.size(); }
+        std::size_t getReleaseCount() const { return _releaseIds.size(); }
+        std::size_t getArtistCount() const { return _artistIds.size(); }
+        std::size_t getMemoryUsage() const;
+
+    private:
+        using Index = std::uint32_t;
+        static constexpr Index invalidIndex{ static_cast<Index>(-1) };
+
+        template<typename T>
+        class AdjacencyList
+        {
+        public:
+            void build(std::size_t nodeCount, std::vector<std::pair<Index, T>>& edges);
+
+            std::span<const T> operator[](Index node) const { return std::span{ _values }.subspan(_offsets[node], _offsets[node + 1] - _offsets[node]); }
+            std::size_t size() const { return _offsets.empty() ? 0 : _offsets.size() - 1; }
+            std::size_t getMemoryUsage() const { return _offsets.capacity() * sizeof(Index) + _values.capacity() * sizeof(T); }
+
+        private:
+            std::vector<Index> _offsets;
+            std::vector<T> _values;
+        };
+
+        struct ArtistLink
+        {
+            Index artistIndex;
+            db::TrackArtistLinkType linkType;
+        };
+
+        struct ScoredIndex
+        {
+            Index index;
+            std::uint32_t score;
+        };
+
+        struct Scores;
+        static Scores& getScores(std::size_t size);
+        // Best scores first, ties in random order
+        // Up to maxTieCount extra candidates sharing the lowest selected score are appended
+        template<typename ExcludeFunc>
+        static std::vector<ScoredIndex> selectBest(Scores& scores, std::size_t maxCount, std::size_t maxTieCount, ExcludeFunc&& excludeFunc);
+        static std::vector<Index> selectPrecomputed(std::span<const ScoredIndex> similarIndexes, std::size_t maxCount);
+
+        template<typename IdType>
+        static Index findIndex(const std::vector<IdType>& ids, IdType id);
+
+        std::vector<Index> getClusters(std::span<const Index> trackIndexes) const;
+        std::vector<ScoredIndex> findSimilarReleaseIndexes(Index releaseIndex, const SearchParameters& params, std::size_t maxTieCount) const;
+        std::vector<ScoredIndex> findSimilarArtistIndexes(Index artistIndex, core::EnumSet<db::TrackArtistLinkType> linkTypes, const SearchParameters& params, std::size_t maxTieCount) const;
+        bool isPrecomputed(const SearchParameters& params) const;
+        template<typename Func>
+        void visitClusterTracks(std::span<const Index> clusterIndexes, std::size_t maxClusterScanSize, Func&& func) const;
+
+        std::vector<db::TrackId> _trackIds;     // sorted
+        std::vector<db::ReleaseId> _releaseIds; // sorted
+        std::vector<db::ArtistId> _artistIds;   // sorted
+
+        AdjacencyList<Index> _trackClusters;
+        AdjacencyList<Index> _clusterTracks;
+        std::vector<Index> _trackRelease;
+        AdjacencyList<Index> _releaseTracks;
+        AdjacencyList<ArtistLink> _trackArtists;
+        AdjacencyList<Index> _artistTracks;
+
+        // precomputed results, best first
+        SearchParameters _precomputedParams;
+        core::EnumSet<db::TrackArtistLinkType> _precomputedArtistLinkTypes;
+        AdjacencyList<ScoredIndex> _similarReleases;
+        AdjacencyList<ScoredIndex> _similarArtists;
+    };
+} // namespace lms::recommendation
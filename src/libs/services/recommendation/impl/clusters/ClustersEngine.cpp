@@ -19,6 +19,11 @@
 
 #include "ClustersEngine.hpp"
 
+#include <algorithm>
+#include <thread>
+
+#include "core/IJobScheduler.hpp"
+#include "core/ILogger.hpp"
 #include "database/IDb.hpp"
 #include "database/Session.hpp"
 #include "database/objects/Artist.hpp"
@@ -31,16 +36,104 @@ namespace lms::recommendation
 {
     using namespace db;
 
+    namespace
+    {
+        // Bounds the work done in the very large clusters (main genres, etc.)
+        constexpr std::size_t maxClusterScanSize{ 10'000 };
+
+        // Similar releases and artists are precomputed for all objects, using the link types requested by the UI and the API
+        constexpr std::size_t maxPrecomputedCount{ 50 };
+        constexpr core::EnumSet<TrackArtistLinkType> precomputedArtistLinkTypes{ TrackArtistLinkType::Artist, TrackArtistLinkType::ReleaseArtist };
+    } // namespace
+
     std::unique_ptr<IEngine> createClustersEngine(db::IDb& db)
     {
         return std::make_unique<ClusterEngine>(db);
     }
 
+    void ClusterEngine::load(bool /*forceReload*/, const TrackMetadataSnapshot& trackMetadata, const ProgressCallback& progressCallback)
+    {
+        _index = buildIndex(trackMetadata, progressCallback);
+    }
+
+    std::shared_ptr<const ClusterSimilarityIndex> ClusterEngine::buildIndex(const TrackMetadataSnapshot& trackMetadata, const ProgressCallback& progressCallback) const
+    {
+        LMS_LOG(RECOMMENDATION, INFO, "Building cluster similarity index...");
+
+        Session& session{ _db.getTLSSession() };
+
+        Progress progress;
+        {
+            auto transaction{ session.createReadTransaction() };
+            progress.totalElems = Track::getCount(session);
+        }
+
+        ClusterSimilarityIndex::Builder builder;
+
+        constexpr std::size_t batchSize{ 1'000 };
+        TrackId lastRetrievedTrackId;
+        while (!_loadCancelled)
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            const IdRange<TrackId> trackIdRange{ Track::findNextIdRange(session, lastRetrievedTrackId, batchSize) };
+            if (!trackIdRange.isValid())
+                break;
+
+            Track::findClusterIds(session, trackIdRange, [&](TrackId trackId, ClusterId clusterId) {
+                builder.addTrackCluster(trackId, clusterId);
+            });
+
+            lastRetrievedTrackId = trackIdRange.last;
+
+            progress.processedElems = std::min(progress.processedElems + batchSize, progress.totalElems);
+            if (progressCallback)
+                progressCallback(progress);
+        }
+
+        if (_loadCancelled)
+        {
+            LMS_LOG(RECOMMENDATION, DEBUG, "Cluster similarity index build cancelled");
+            return {};
+        }
+
+        trackMetadata.visitTracks([&](TrackId trackId, ReleaseId releaseId, std::span<const TrackMetadataSnapshot::ArtistLink> artistLinks) {
+            if (releaseId.isValid())
+                builder.setTrackRelease(trackId, releaseId);
+            for (const TrackMetadataSnapshot::ArtistLink& artistLink : artistLinks)
+                builder.addTrackArtist(trackId, artistLink.artistId, artistLink.linkType);
+        });
+
+        ClusterSimilarityIndex builtIndex{ builder.build() };
+        LMS_LOG(RECOMMENDATION, INFO, "Cluster similarity index built: " << builtIndex.getTrackCount() << " tracks, " << builtIndex.getClusterCount() << " clusters");
+
+        const ClusterSimilarityIndex::SearchParameters precomputeParams{ .maxCount = maxPrecomputedCount, .maxClusterScanSize = maxClusterScanSize };
+        const std::unique_ptr<core::IJobScheduler> jobScheduler{ core::createJobScheduler("ClusterIndex", std::max<std::size_t>(std::thread::hardware_concurrency(), 1)) };
+        if (!builtIndex.precomputeSimilarObjects(precomputedArtistLinkTypes, precomputeParams, *jobScheduler, [this] { return _loadCancelled.load(); }))
+        {
+            LMS_LOG(RECOMMENDATION, DEBUG, "Cluster similarity index build cancelled");
+            return {};
+        }
+
+        auto index{ std::make_shared<const ClusterSimilarityIndex>(std::move(builtIndex)) };
+        LMS_LOG(RECOMMENDATION, INFO, "Similar objects precomputed for " << index->getReleaseCount() << " releases and " << index->getArtistCount() << " artists, index size = " << (index->getMemoryUsage() / 1024) << " KiB");
+
+        return index;
+    }
+
+    void ClusterEngine::requestCancelLoad()
+    {
+        _loadCancelled = true;
+    }
+
     TrackContainer ClusterEngine::findSimilarTracks(const std::vector<TrackId>& trackIds, std::size_t maxCount) const
     {
         if (maxCount == 0)
             return {};
 
+        if (_index)
+            return _index->findSimilarTracks(trackIds, ClusterSimilarityIndex::SearchParameters{ .maxCount = maxCount, .maxClusterScanSize = maxClusterScanSize });
+
         Session& dbSession{ _db.getTLSSession() };
         auto transaction{ dbSession.createReadTransaction() };
 
@@ -62,6 +155,9 @@ namespace lms::recommendation
             if (!trackList)
                 return res;
 
+            if (_index)
+                return _index->findSimilarTracks(trackList->getTrackIds(), ClusterSimilarityIndex::SearchParameters{ .maxCount = maxCount, .maxClusterScanSize = maxClusterScanSize });
+
             const auto tracks{ trackList->getSimilarTracks(0, maxCount) };
             res.reserve(tracks.size());
             std::transform(std::cbegin(tracks), std::cend(tracks), std::back_inserter(res), [](const auto& track) { return track->getId(); });
@@ -76,6 +172,9 @@ namespace lms::recommendation
         if (maxCount == 0)
             return res;
 
+        if (_index)
+            return _index->findSimilarReleases(releaseId, ClusterSimilarityIndex::SearchParameters{ .maxCount = maxCount, .maxClusterScanSize = maxClusterScanSize });
+
         {
             Session& dbSession{ _db.getTLSSession() };
             auto transaction{ dbSession.createReadTransaction() };
@@ -97,6 +196,9 @@ namespace lms::recommendation
         if (maxCount == 0)
             return {};
 
+        if (_index)
+            return _index->findSimilarArtists(artistId, artistLinkTypes, ClusterSimilarityIndex::SearchParameters{ .maxCount = maxCount, .maxClusterScanSize = maxClusterScanSize });
+
         Session& dbSession{ _db.getTLSSession() };
         auto transaction{ dbSession.createReadTransaction() };
 
@@ -19,6 +19,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+
+#include "ClusterSimilarityIndex.hpp"
 #include "IEngine.hpp"
 
 namespace lms::recommendation
@@ -37,15 +41,23 @@ namespace lms::recommendation
         ClusterEngine& operator=(ClusterEngine&&) = delete;
 
     private:
-        void load(bool /*forceReload*/, const ProgressCallback& /*progressCallback*/) override {}
-        void requestCancelLoad() override {}
+        void load(bool forceReload, const TrackMetadataSnapshot& trackMetadata, const ProgressCallback& progressCallback) override;
+        void requestCancelLoad() override;
 
         TrackContainer findSimilarTracksFromTrackList(db::TrackListId tracklistId, std::size_t maxCount) const override;
         TrackContainer findSimilarTracks(const std::vector<db::TrackId>& trackIds, std::size_t maxCount) const override;
         ReleaseContainer getSimilarReleases(db::ReleaseId releaseId, std::size_t maxCount) const override;
         ArtistContainer getSimilarArtists(db::ArtistId artistId, core::EnumSet<db::TrackArtistLinkType> linkTypes, std::size_t maxCount) const override;
 
+        // Returns nullptr if cancelled
+        std::shared_ptr<const ClusterSimilarityIndex> buildIndex(const TrackMetadataSnapshot& trackMetadata, const ProgressCallback& progressCallback) const;
+
         db::IDb& _db;
+        std::atomic<bool> _loadCancelled{};
+
+        // Set once by load, before the engine is published: a new engine is created on each reload
+        // Queries fallback on the database if the build was cancelled
+        std::shared_ptr<const ClusterSimilarityIndex> _index;
     };
 
 } // namespace lms::recommendation
@@ -110,44 +110,50 @@ namespace lms::recommendation
 
         Session& session{ _db.getTLSSession() };
 
-        RangeResults<TrackFeaturesId> trackFeaturesIds;
+        std::size_t trackFeaturesCount{};
         {
             auto transaction{ session.createReadTransaction() };
-
-            LMS_LOG(RECOMMENDATION, DEBUG, "Getting Track features...");
-            trackFeaturesIds = TrackFeatures::find(session);
-            LMS_LOG(RECOMMENDATION, DEBUG, "Getting Track features DONE (found " << trackFeaturesIds.results.size() << " track features)");
+            trackFeaturesCount = TrackFeatures::getCount(session);
         }
+        LMS_LOG(RECOMMENDATION, DEBUG, "Found " << trackFeaturesCount << " track features");
 
         std::vector<som::InputVector> samples;
         std::vector<TrackId> samplesTrackIds;
 
-        samples.reserve(trackFeaturesIds.results.size());
-        samplesTrackIds.reserve(trackFeaturesIds.results.size());
+        samples.reserve(trackFeaturesCount);
+        samplesTrackIds.reserve(trackFeaturesCount);
 
         LMS_LOG(RECOMMENDATION, DEBUG, "Extracting features...");
-        // TODO handle errors using exceptions
-        for (const TrackFeaturesId trackFeaturesId : trackFeaturesIds.results)
         {
-            if (_loadCancelled)
-                return;
+            // Sequential scan on pre extracted features, using small read transactions
+            constexpr std::size_t batchSize{ 1000 };
 
-            auto transaction{ session.createReadTransaction() };
+            TrackFeaturesId lastRetrievedId;
+            bool endReached{};
+            while (!endReached)
+            {
+                if (_loadCancelled)
+                    return;
+
+                auto transaction{ session.createReadTransaction() };
 
-            TrackFeatures::pointer trackFeatures{ TrackFeatures::find(session, trackFeaturesId) };
-            if (!trackFeatures)
-                continue;
+                std::size_t fetchedCount{};
+                TrackFeatures::find(session, lastRetrievedId, batchSize, featureNames, [&](TrackId trackId, const FeatureValuesMap& featureValuesMap) {
+                    fetchedCount++;
 
-            FeatureValuesMap featureValuesMap{ trackFeatures->getFeatureValuesMap(featureNames) };
-            if (featureValuesMap.empty())
-                continue;
+                    if (featureValuesMap.empty())
+                        return;
 
-            std::optional<som::InputVector> inputVector{ convertFeatureValuesMapToInputVector(featureValuesMap, nbDimensions) };
-            if (!inputVector)
-                continue;
+                    std::optional<som::InputVector> inputVector{ convertFeatureValuesMapToInputVector(featureValuesMap, nbDimensions) };
+                    if (!inputVector)
+                        return;
 
-            samples.emplace_back(std::move(*inputVector));
-            samplesTrackIds.emplace_back(trackFeatures->getTrack()->getId());
+                    samples.emplace_back(std::move(*inputVector));
+                    samplesTrackIds.emplace_back(trackId);
+                });
+
+                endReached = fetchedCount < batchSize;
+            }
         }
         LMS_LOG(RECOMMENDATION, DEBUG, "Extracting features DONE");
 
@@ -183,9 +189,9 @@ namespace lms::recommendation
         } };
 
         LMS_LOG(RECOMMENDATION, DEBUG, "Training network...");
-        network.train(samples, trainSettings.iterationCount,
-                      progressCallback ? somProgressCallback : som::Network::ProgressCallback{},
-                      [this] { return _loadCancelled; });
+        network.trainBatch(samples, trainSettings.iterationCount,
+                           progressCallback ? somProgressCallback : som::Network::ProgressCallback{},
+                           [this] { return _loadCancelled; });
         LMS_LOG(RECOMMENDATION, DEBUG, "Training network DONE");
 
         LMS_LOG(RECOMMENDATION, DEBUG, "Classifying tracks...");
@@ -202,14 +208,19 @@ namespace lms::recommendation
 
         LMS_LOG(RECOMMENDATION, DEBUG, "Classifying tracks DONE");
 
-        load(std::move(network), std::move(trackPositions));
+        load(network, [&](const FeaturesEngineCache::TrackPositionsVisitor& visitor) {
+            for (const auto& [trackId, positions] : trackPositions)
+                visitor(trackId, positions);
+        });
     }
 
     void FeaturesEngine::loadFromCache(FeaturesEngineCache&& cache)
     {
         LMS_LOG(RECOMMENDATION, INFO, "Constructing features classifier from cache...");
 
-        load(std::move(cache._network), cache._trackPositions);
+        load(cache.createNetwork(), [&](const FeaturesEngineCache::TrackPositionsVisitor& visitor) {
+            cache.visitTrackPositions(visitor);
+        });
     }
 
     TrackContainer FeaturesEngine::findSimilarTracksFromTrackList(TrackListId trackListId, std::size_t maxCount) const
@@ -314,12 +325,7 @@ namespace lms::recommendation
         return res;
     }
 
-    FeaturesEngineCache FeaturesEngine::toCache() const
-    {
-        return FeaturesEngineCache{ *_network, _trackPositions };
-    }
-
-    void FeaturesEngine::load(bool forceReload, const ProgressCallback& progressCallback)
+    void FeaturesEngine::load(bool forceReload, const TrackMetadataSnapshot& /*trackMetadata*/, const ProgressCallback& progressCallback)
     {
         if (forceReload)
         {
@@ -336,7 +342,7 @@ namespace lms::recommendation
 
         loadFromTraining(trainSettings, progressCallback);
         if (!_loadCancelled && _network)
-            toCache().write();
+            FeaturesEngineCache::write(*_network, _trackPositions);
     }
 
     void FeaturesEngine::requestCancelLoad()
@@ -345,7 +351,7 @@ namespace lms::recommendation
         _loadCancelled = true;
     }
 
-    void FeaturesEngine::load(const som::Network& network, const TrackPositions& trackPositions)
+    void FeaturesEngine::load(const som::Network& network, const TrackPositionsProvider& trackPositionsProvider)
     {
         using namespace db;
 
@@ -362,8 +368,7 @@ namespace lms::recommendation
 
         Session& session{ _db.getTLSSession() };
 
-        for (const auto& [trackId, positions] : trackPositions)
-        {
+        trackPositionsProvider([&](db::TrackId trackId, std::span<const som::Position> positions) {
             if (_loadCancelled)
                 return;
 
@@ -371,7 +376,7 @@ namespace lms::recommendation
 
             const Track::pointer track{ Track::find(session, trackId) };
             if (!track)
-                continue;
+                return;
 
             for (const som::Position& position : positions)
             {
@@ -399,7 +404,10 @@ namespace lms::recommendation
                     core::utils::push_back_if_not_present(itArtists->second[position], artistId);
                 }
             }
-        }
+        });
+
+        if (_loadCancelled)
+            return;
 
         _network = std::make_unique<som::Network>(network);
 
@@ -57,7 +57,7 @@ namespace lms::recommendation
         static const FeatureSettingsMap& getDefaultTrainFeatureSettings();
 
     private:
-        void load(bool forceReload, const ProgressCallback& progressCallback) override;
+        void load(bool forceReload, const TrackMetadataSnapshot& trackMetadata, const ProgressCallback& progressCallback) override;
         void requestCancelLoad() override;
 
         TrackContainer findSimilarTracksFromTrackList(db::TrackListId tracklistId, std::size_t maxCount) const override;
@@ -89,9 +89,9 @@ namespace lms::recommendation
         using ReleaseMatrix = ObjectMatrix<db::ReleaseId>;
         using TrackMatrix = ObjectMatrix<db::TrackId>;
 
-        void load(const som::Network& network, const TrackPositions& tracksPosition);
-
-        FeaturesEngineCache toCache() const;
+        // Calls the given visitor for each track
+        using TrackPositionsProvider = std::function<void(const FeaturesEngineCache::TrackPositionsVisitor&)>;
+        void load(const som::Network& network, const TrackPositionsProvider& trackPositionsProvider);
 
         template<typename IdType>
         static std::vector<som::Position> getMatchingRefVectorsPosition(const std::vector<IdType>& ids, const ObjectPositions<IdType>& objectPositions);
@@ -19,22 +19,97 @@
 
 #include "FeaturesEngineCache.hpp"
 
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/xml_parser.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <sstream>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "core/IConfig.hpp"
 #include "core/ILogger.hpp"
 #include "core/Service.hpp"
+#include "core/XxHash3.hpp"
 
 namespace lms::recommendation
 {
     namespace
     {
+        // File layout (native byte order, all sections are 8 bytes aligned):
+        // - header
+        // - weights: double[dimCount]
+        // - ref vectors: double[width * height * dimCount], position (x, y) at index x + width * y
+        // - track entries: TrackEntry[trackCount], sorted by track id
+        // - positions: som::Position[positionCount]
+        constexpr std::array<char, 8> magic{ 'L', 'M', 'S', 'F', 'E', 'A', 'T', 'S' };
+        constexpr std::uint32_t formatVersion{ 1 };
+
+        struct Header
+        {
+            std::array<char, 8> magic;
+            std::uint32_t version;
+            std::uint32_t width;
+            std::uint32_t height;
+            std::uint32_t dimCount;
+            std::uint64_t trackCount;
+            std::uint64_t positionCount;
+            std::uint64_t payloadChecksum; // of everything after the header
+        };
+        static_assert(sizeof(Header) % 8 == 0);
+
+        struct TrackEntry
+        {
+            db::TrackId::ValueType trackId;
+            std::uint32_t positionIndex;
+            std::uint32_t positionCount;
+        };
+        static_assert(sizeof(TrackEntry) % 8 == 0);
+
+        // positions are used directly from the mapping
+        static_assert(std::is_standard_layout_v<som::Position> && sizeof(som::Position) == 2 * sizeof(std::uint32_t));
+
+        using Value = som::InputVector::value_type;
+
+        struct Layout
+        {
+            std::size_t weightsOffset;
+            std::size_t refVectorsOffset;
+            std::size_t trackEntriesOffset;
+            std::size_t positionsOffset;
+            std::size_t totalSize;
+        };
+
+        Layout computeLayout(const Header& header)
+        {
+            Layout layout;
+            layout.weightsOffset = sizeof(Header);
+            layout.refVectorsOffset = layout.weightsOffset + header.dimCount * sizeof(Value);
+            layout.trackEntriesOffset = layout.refVectorsOffset + static_cast<std::size_t>(header.width) * header.height * header.dimCount * sizeof(Value);
+            layout.positionsOffset = layout.trackEntriesOffset + header.trackCount * sizeof(TrackEntry);
+            layout.totalSize = layout.positionsOffset + header.positionCount * sizeof(som::Position);
+
+            return layout;
+        }
+
         std::filesystem::path getCacheDirectory()
         {
             return core::Service<core::IConfig>::get()->getPath("working-dir", "/var/lms") / "cache" / "features";
         }
 
+        std::filesystem::path getCacheFilePath()
+        {
+            return getCacheDirectory() / "features.bin";
+        }
+
+        // Legacy xml cache files
         std::filesystem::path getCacheNetworkFilePath()
         {
             return getCacheDirectory() / "network";
@@ -45,204 +120,231 @@ namespace lms::recommendation
             return getCacheDirectory() / "track_positions";
         }
 
-        bool networkToCacheFile(const som::Network& network, std::filesystem::path path)
+        std::shared_ptr<const std::byte> mapFile(const std::filesystem::path& path, std::size_t& size)
         {
-            try
-            {
-                boost::property_tree::ptree root;
+            const int fd{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+            if (fd < 0)
+                return {};
 
-                root.put("width", network.getWidth());
-                root.put("height", network.getHeight());
-                root.put("dim_count", network.getInputDimCount());
+            std::shared_ptr<const std::byte> res;
 
-                for (som::InputVector::value_type weight : network.getDataWeights())
-                    root.add("weights.weight", weight);
-
-                for (som::Coordinate x = 0; x < network.getWidth(); ++x)
+            struct stat fileStat;
+            if (::fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+            {
+                size = static_cast<std::size_t>(fileStat.st_size);
+                void* const mapping{ ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) };
+                if (mapping != MAP_FAILED)
                 {
-                    for (som::Coordinate y = 0; y < network.getWidth(); ++y)
-                    {
-                        const auto& refVector = network.getRefVector({ x, y });
-
-                        boost::property_tree::ptree node;
-                        for (const auto& value : refVector)
-                            node.add("values.value", value);
-
-                        node.put("coord_x", x);
-                        node.put("coord_y", y);
-
-                        root.add_child("ref_vectors.ref_vector", node);
-                    }
+                    auto unmap{ [size](const std::byte* data) { ::munmap(const_cast<std::byte*>(data), size); } };
+                    res = std::shared_ptr<const std::byte>{ static_cast<const std::byte*>(mapping), unmap };
+                }
+                else
+                {
+                    const int err{ errno };
+                    LMS_LOG(RECOMMENDATION, ERROR, "Cannot map cache file: " << (std::error_code{ err, std::generic_category() }.message()));
                 }
+            }
 
-                boost::property_tree::write_xml(path.string(), root);
+            ::close(fd);
+            return res;
+        }
 
-                LMS_LOG(RECOMMENDATION, DEBUG, "Created network cache");
-                return true;
-            }
-            catch (boost::property_tree::ptree_error& error)
-            {
-                LMS_LOG(RECOMMENDATION, ERROR, "Cannot create network cache: " << error.what());
-                return false;
-            }
+        template<typename T>
+        void writeValue(std::ostream& os, const T& value)
+        {
+            os.write(reinterpret_cast<const char*>(&value), sizeof(T));
         }
     } // namespace
 
-    std::optional<som::Network> FeaturesEngineCache::createNetworkFromCacheFile(const std::filesystem::path& path)
+    FeaturesEngineCache::FeaturesEngineCache(std::shared_ptr<const std::byte> mapping, std::size_t size)
+        : _mapping{ std::move(mapping) }
+        , _size{ size }
     {
-        if (!std::filesystem::exists(path))
-            return std::nullopt;
+    }
 
-        try
+    void FeaturesEngineCache::invalidate()
+    {
+        for (const std::filesystem::path& path : { getCacheFilePath(), getCacheNetworkFilePath(), getCacheTrackPositionsFilePath() })
         {
-            LMS_LOG(RECOMMENDATION, INFO, "Reading network from cache...");
-
-            boost::property_tree::ptree root;
-
-            boost::property_tree::read_xml(path.string(), root);
-
-            som::Coordinate width{ root.get<som::Coordinate>("width") };
-            som::Coordinate height{ root.get<som::Coordinate>("height") };
-            std::size_t dimCount{ root.get<std::size_t>("dim_count") };
-
-            som::Network res{ width, height, dimCount };
-
-            {
-                som::InputVector weights{ dimCount };
-                std::size_t i{};
-                for (const auto& val : root.get_child("weights"))
-                    weights[i++] = val.second.get_value<double>();
-
-                res.setDataWeights(weights);
-            }
-
-            for (const auto& node : root.get_child("ref_vectors"))
-            {
-                som::Coordinate x{ node.second.get<som::Coordinate>("coord_x") };
-                som::Coordinate y{ node.second.get<som::Coordinate>("coord_y") };
-
-                som::InputVector refVector{ dimCount };
-                std::size_t i{};
-                for (const auto& val : node.second.get_child("values"))
-                    refVector[i++] = val.second.get_value<som::InputVector::value_type>();
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+            if (ec)
+                LMS_LOG(RECOMMENDATION, ERROR, "Cannot remove features cache file " << path << ": " << ec.message());
+        }
+    }
 
-                res.setRefVector({ x, y }, refVector);
-            }
+    std::optional<FeaturesEngineCache> FeaturesEngineCache::read()
+    {
+        // legacy xml files are never read again
+        std::error_code ec;
+        std::filesystem::remove(getCacheNetworkFilePath(), ec);
+        std::filesystem::remove(getCacheTrackPositionsFilePath(), ec);
+
+        std::size_t size{};
+        std::shared_ptr<const std::byte> mapping{ mapFile(getCacheFilePath(), size) };
+        if (!mapping)
+            return std::nullopt;
 
-            LMS_LOG(RECOMMENDATION, INFO, "Successfully read network from cache");
+        LMS_LOG(RECOMMENDATION, INFO, "Reading features cache...");
 
-            return res;
+        if (size < sizeof(Header))
+        {
+            LMS_LOG(RECOMMENDATION, ERROR, "Cannot read features cache: file too small");
+            return std::nullopt;
         }
-        catch (boost::property_tree::ptree_error& error)
+
+        Header header;
+        std::memcpy(&header, mapping.get(), sizeof(header));
+        if (header.magic != magic || header.version != formatVersion)
         {
-            LMS_LOG(RECOMMENDATION, ERROR, "Cannot read network cache: " << error.what());
+            LMS_LOG(RECOMMENDATION, INFO, "Features cache format mismatch, skipping");
             return std::nullopt;
         }
-    }
 
-    bool FeaturesEngineCache::objectPositionToCacheFile(const TrackPositions& trackPositions, const std::filesystem::path& path)
-    {
-        try
+        if (computeLayout(header).totalSize != size)
         {
-            boost::property_tree::ptree root;
+            LMS_LOG(RECOMMENDATION, ERROR, "Cannot read features cache: bad size");
+            return std::nullopt;
+        }
 
-            for (const auto& [id, positions] : trackPositions)
-            {
-                boost::property_tree::ptree node;
+        if (core::xxHash3_64(std::span{ mapping.get() + sizeof(Header), size - sizeof(Header) }) != header.payloadChecksum)
+        {
+            LMS_LOG(RECOMMENDATION, ERROR, "Cannot read features cache: checksum mismatch");
+            return std::nullopt;
+        }
 
-                node.put("id", id.getValue());
+        LMS_LOG(RECOMMENDATION, INFO, "Successfully read features cache");
 
-                for (const som::Position& position : positions)
-                {
-                    boost::property_tree::ptree positionNode;
-                    positionNode.put("x", position.x);
-                    positionNode.put("y", position.y);
+        return FeaturesEngineCache{ std::move(mapping), size };
+    }
 
-                    node.add_child("position.position", positionNode);
-                }
+    void FeaturesEngineCache::write(const som::Network& network, const TrackPositions& trackPositions)
+    {
+        std::filesystem::create_directories(getCacheDirectory());
+
+        Header header{};
+        header.magic = magic;
+        header.version = formatVersion;
+        header.width = network.getWidth();
+        header.height = network.getHeight();
+        header.dimCount = static_cast<std::uint32_t>(network.getInputDimCount());
+        header.trackCount = trackPositions.size();
+
+        std::vector<db::TrackId> trackIds;
+        trackIds.reserve(trackPositions.size());
+        for (const auto& [trackId, positions] : trackPositions)
+        {
+            trackIds.push_back(trackId);
+            header.positionCount += positions.size();
+        }
+        std::sort(std::begin(trackIds), std::end(trackIds));
 
-                root.add_child("objects.object", node);
-            }
+        // Serialize the payload first to compute its checksum
+        std::ostringstream payload;
+        for (const Value weight : network.getDataWeights())
+            writeValue(payload, weight);
 
-            boost::property_tree::write_xml(path.string(), root);
-            return true;
-        }
-        catch (boost::property_tree::ptree_error& error)
+        for (som::Coordinate y{}; y < network.getHeight(); ++y)
         {
-            LMS_LOG(RECOMMENDATION, ERROR, "Cannot cache object position: " << error.what());
-            return false;
+            for (som::Coordinate x{}; x < network.getWidth(); ++x)
+            {
+                for (const Value value : network.getRefVector({ x, y }))
+                    writeValue(payload, value);
+            }
         }
-    }
 
-    std::optional<FeaturesEngineCache::TrackPositions> FeaturesEngineCache::createObjectPositionsFromCacheFile(const std::filesystem::path& path)
-    {
-        try
+        std::uint32_t positionIndex{};
+        for (const db::TrackId trackId : trackIds)
         {
-            LMS_LOG(RECOMMENDATION, INFO, "Reading object position from cache...");
+            const std::vector<som::Position>& positions{ trackPositions.at(trackId) };
 
-            boost::property_tree::ptree root;
+            writeValue(payload, TrackEntry{ trackId.getValue(), positionIndex, static_cast<std::uint32_t>(positions.size()) });
+            positionIndex += static_cast<std::uint32_t>(positions.size());
+        }
 
-            boost::property_tree::read_xml(path.string(), root);
+        for (const db::TrackId trackId : trackIds)
+        {
+            for (const som::Position& position : trackPositions.at(trackId))
+                writeValue(payload, position);
+        }
 
-            TrackPositions res;
+        const std::string payloadStr{ std::move(payload).str() };
+        header.payloadChecksum = core::xxHash3_64(std::as_bytes(std::span{ payloadStr }));
 
-            for (const auto& object : root.get_child("objects"))
+        // write in a temporary file, then rename to make sure the cache is never partially written
+        const std::filesystem::path filePath{ getCacheFilePath() };
+        std::filesystem::path tmpFilePath{ filePath };
+        tmpFilePath += ".tmp";
+        {
+            std::ofstream ofs{ tmpFilePath, std::ios::binary | std::ios::trunc };
+            writeValue(ofs, header);
+            ofs.write(payloadStr.data(), static_cast<std::streamsize>(payloadStr.size()));
+            if (!ofs)
             {
-                const db::TrackId id{ object.second.get<db::IdType::ValueType>("id") };
-                for (const auto& position : object.second.get_child("position"))
-                {
-                    auto x = position.second.get<som::Coordinate>("x");
-                    auto y = position.second.get<som::Coordinate>("y");
-
-                    res[id].push_back({ x, y });
-                }
+                LMS_LOG(RECOMMENDATION, ERROR, "Cannot write features cache to " << tmpFilePath);
+                std::filesystem::remove(tmpFilePath);
+                return;
             }
-
-            LMS_LOG(RECOMMENDATION, INFO, "Successfully read object position from cache");
-
-            return res;
         }
-        catch (boost::property_tree::ptree_error& error)
+
+        std::error_code ec;
+        std::filesystem::rename(tmpFilePath, filePath, ec);
+        if (ec)
         {
-            LMS_LOG(RECOMMENDATION, ERROR, "Cannot create object position from cache file: " << error.what());
-            return std::nullopt;
+            LMS_LOG(RECOMMENDATION, ERROR, "Cannot rename features cache: " << ec.message());
+            std::filesystem::remove(tmpFilePath, ec);
+            return;
         }
-    }
 
-    void FeaturesEngineCache::invalidate()
-    {
-        std::filesystem::remove(getCacheNetworkFilePath());
-        std::filesystem::remove(getCacheTrackPositionsFilePath());
+        LMS_LOG(RECOMMENDATION, DEBUG, "Created features cache");
     }
 
-    std::optional<FeaturesEngineCache> FeaturesEngineCache::read()
+    som::Network FeaturesEngineCache::createNetwork() const
     {
-        auto network{ createNetworkFromCacheFile(getCacheNetworkFilePath()) };
-        if (!network)
-            return std::nullopt;
-
-        auto trackPositions{ createObjectPositionsFromCacheFile(getCacheTrackPositionsFilePath()) };
-        if (!trackPositions)
-            return std::nullopt;
+        Header header;
+        std::memcpy(&header, _mapping.get(), sizeof(header));
+        const Layout layout{ computeLayout(header) };
 
-        return FeaturesEngineCache{ std::move(*network), std::move(*trackPositions) };
-    }
+        som::Network network{ header.width, header.height, header.dimCount };
 
-    void FeaturesEngineCache::write() const
-    {
-        std::filesystem::create_directories(core::Service<core::IConfig>::get()->getPath("working-dir", "/var/lms") / "cache" / "features");
+        const Value* values{ reinterpret_cast<const Value*>(_mapping.get() + layout.weightsOffset) };
+        {
+            som::InputVector weights{ header.dimCount };
+            std::copy(values, values + header.dimCount, std::begin(weights));
+            network.setDataWeights(weights);
+        }
 
-        if (!networkToCacheFile(_network, getCacheNetworkFilePath())
-            || !objectPositionToCacheFile(_trackPositions, getCacheTrackPositionsFilePath()))
+        values = reinterpret_cast<const Value*>(_mapping.get() + layout.refVectorsOffset);
+        som::InputVector refVector{ header.dimCount };
+        for (som::Coordinate y{}; y < header.height; ++y)
         {
-            invalidate();
+            for (som::Coordinate x{}; x < header.width; ++x)
+            {
+                std::copy(values, values + header.dimCount, std::begin(refVector));
+                network.setRefVector({ x, y }, refVector);
+                values += header.dimCount;
+            }
         }
+
+        return network;
     }
 
-    FeaturesEngineCache::FeaturesEngineCache(som::Network network, TrackPositions trackPositions)
-        : _network{ std::move(network) }
-        , _trackPositions{ std::move(trackPositions) }
+    void FeaturesEngineCache::visitTrackPositions(const TrackPositionsVisitor& visitor) const
     {
-    }
+        Header header;
+        std::memcpy(&header, _mapping.get(), sizeof(header));
+        const Layout layout{ computeLayout(header) };
+
+        const std::span<const TrackEntry> trackEntries{ reinterpret_cast<const TrackEntry*>(_mapping.get() + layout.trackEntriesOffset), header.trackCount };
+        const std::span<const som::Position> positions{ reinterpret_cast<const som::Position*>(_mapping.get() + layout.positionsOffset), header.positionCount };
+
+        for (const TrackEntry& trackEntry : trackEntries)
+        {
+            // checksum does not protect against inconsistent data
+            if (static_cast<std::uint64_t>(trackEntry.positionIndex) + trackEntry.positionCount > positions.size())
+                continue;
 
+            visitor(db::TrackId{ trackEntry.trackId }, positions.subspan(trackEntry.positionIndex, trackEntry.positionCount));
+        }
+    }
 } // namespace lms::recommendation
@@ -19,36 +19,40 @@
 
 #pragma once
 
+#include <cstddef>
 #include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 #include "database/objects/TrackId.hpp"
 #include "som/Network.hpp"
 
 namespace lms::recommendation
 {
-
+    // Binary cache file, memory mapped when read: positions are directly used from the mapping
     class FeaturesEngineCache
     {
     public:
+        using TrackPositions = std::unordered_map<db::TrackId, std::vector<som::Position>>;
+
         static void invalidate();
 
         static std::optional<FeaturesEngineCache> read();
-        void write() const;
-
-    private:
-        using TrackPositions = std::unordered_map<db::TrackId, std::vector<som::Position>>;
+        static void write(const som::Network& network, const TrackPositions& trackPositions);
 
-        FeaturesEngineCache(som::Network network, TrackPositions trackPositions);
+        som::Network createNetwork() const;
 
-        static std::optional<som::Network> createNetworkFromCacheFile(const std::filesystem::path& path);
-        static std::optional<TrackPositions> createObjectPositionsFromCacheFile(const std::filesystem::path& path);
-        static bool objectPositionToCacheFile(const TrackPositions& trackPositions, const std::filesystem::path& path);
+        using TrackPositionsVisitor = std::function<void(db::TrackId trackId, std::span<const som::Position> positions)>;
+        void visitTrackPositions(const TrackPositionsVisitor& visitor) const;
 
-        friend class FeaturesEngine;
+    private:
+        FeaturesEngineCache(std::shared_ptr<const std::byte> mapping, std::size_t size);
 
-        som::Network _network;
-        TrackPositions _trackPositions;
+        std::shared_ptr<const std::byte> _mapping;
+        std::size_t _size;
     };
-
 } // namespace lms::recommendation
@@ -19,40 +19,52 @@
 
 #include "ConsecutiveArtists.hpp"
 
-#include <algorithm>
-
-#include "database/IDb.hpp"
-#include "database/Session.hpp"
-#include "database/objects/Release.hpp"
-#include "database/objects/Track.hpp"
+#include <cassert>
 
 namespace lms::recommendation::PlaylistGeneratorConstraint
 {
     namespace
     {
-        std::size_t countCommonArtists(const ArtistContainer& artists1, const ArtistContainer& artists2)
+        // links are sorted by artist id, an artist may be linked several times to the same track
+        std::size_t countCommonArtists(std::span<const TrackMetadataSnapshot::ArtistLink> links1, std::span<const TrackMetadataSnapshot::ArtistLink> links2)
         {
-            ArtistContainer intersection;
-
-            std::set_intersection(std::cbegin(artists1), std::cend(artists1),
-                                  std::cbegin(artists2), std::cend(artists2),
-                                  std::back_inserter(intersection));
-
-            return intersection.size();
+            std::size_t count{};
+
+            auto it1{ std::cbegin(links1) };
+            auto it2{ std::cbegin(links2) };
+            while (it1 != std::cend(links1) && it2 != std::cend(links2))
+            {
+                const db::ArtistId artistId1{ it1->artistId };
+                const db::ArtistId artistId2{ it2->artistId };
+
+                if (artistId1 < artistId2)
+                {
+                    ++it1;
+                }
+                else if (artistId2 < artistId1)
+                {
+                    ++it2;
+                }
+                else
+                {
+                    ++count;
+                    while (it1 != std::cend(links1) && it1->artistId == artistId1)
+                        ++it1;
+                    while (it2 != std::cend(links2) && it2->artistId == artistId2)
+                        ++it2;
+                }
+            }
+
+            return count;
         }
     } // namespace
 
-    ConsecutiveArtists::ConsecutiveArtists(db::IDb& db)
-        : _db{ db }
-    {
-    }
-
-    float ConsecutiveArtists::computeScore(const std::vector<db::TrackId>& trackIds, std::size_t trackIndex)
+    float ConsecutiveArtists::computeScore(const TrackMetadataSnapshot& trackMetadata, const std::vector<db::TrackId>& trackIds, std::size_t trackIndex)
     {
         assert(!trackIds.empty());
         assert(trackIndex <= trackIds.size() - 1);
 
-        const ArtistContainer artists{ getArtists(trackIds[trackIndex]) };
+        const std::span<const TrackMetadataSnapshot::ArtistLink> artistLinks{ trackMetadata.getArtistLinks(trackIds[trackIndex]) };
 
         constexpr std::size_t rangeSize{ 3 }; // check up to rangeSize tracks before/after the target track
         static_assert(rangeSize > 0);
@@ -61,32 +73,12 @@ namespace lms::recommendation::PlaylistGeneratorConstraint
         for (std::size_t i{ 1 }; i < rangeSize; ++i)
         {
             if (trackIndex >= i)
-                score += countCommonArtists(artists, getArtists(trackIds[trackIndex - i])) / static_cast<float>(i);
+                score += countCommonArtists(artistLinks, trackMetadata.getArtistLinks(trackIds[trackIndex - i])) / static_cast<float>(i);
 
             if (trackIndex + i < trackIds.size())
-                score += countCommonArtists(artists, getArtists(trackIds[trackIndex + i])) / static_cast<float>(i);
+                score += countCommonArtists(artistLinks, trackMetadata.getArtistLinks(trackIds[trackIndex + i])) / static_cast<float>(i);
         }
 
         return score;
     }
-
-    ArtistContainer ConsecutiveArtists::getArtists(db::TrackId trackId)
-    {
-        using namespace db;
-
-        ArtistContainer res;
-
-        Session& dbSession{ _db.getTLSSession() };
-        auto transaction{ dbSession.createReadTransaction() };
-
-        const Track::pointer track{ Track::find(dbSession, trackId) };
-        if (!track)
-            return res;
-
-        res = track->getArtistIds({});
-        std::sort(std::begin(res), std::end(res));
-
-        return res;
-    }
-
 } // namespace lms::recommendation::PlaylistGeneratorConstraint
@@ -21,28 +21,11 @@
 
 #include "IConstraint.hpp"
 
-#include "database/objects/ReleaseId.hpp"
-
-namespace lms::db
-{
-    class IDb;
-}
-
 namespace lms::recommendation::PlaylistGeneratorConstraint
 {
     class ConsecutiveReleases : public IConstraint
     {
-    public:
-        ConsecutiveReleases(db::IDb& db);
-        ~ConsecutiveReleases() override = default;
-        ConsecutiveReleases(const ConsecutiveReleases&) = delete;
-        ConsecutiveReleases& operator=(const ConsecutiveReleases&) = delete;
-
     private:
-        float computeScore(const std::vector<db::TrackId>& trackIds, std::size_t trackIndex) override;
-
-        db::ReleaseId getReleaseId(db::TrackId trackId);
-
-        db::IDb& _db;
+        float computeScore(const TrackMetadataSnapshot& trackMetadata, const std::vector<db::TrackId>& trackIds, std::size_t trackIndex) override;
     };
 } // namespace lms::recommendation::PlaylistGeneratorConstraint
@@ -26,6 +26,6 @@ namespace lms::recommendation::PlaylistGeneratorConstraint
     class DuplicateTracks : public IConstraint
     {
     private:
-        float computeScore(const std::vector<db::TrackId>& trackIds, std::size_t trackIndex) override;
+        float computeScore(const TrackMetadataSnapshot& trackMetadata, const std::vector<db::TrackId>& trackIds, std::size_t trackIndex) override;
     };
 } // namespace lms::recommendation::PlaylistGeneratorConstraint
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "services/recommendation/TrackMetadataSnapshot.hpp"
 #include "services/recommendation/Types.hpp"
 
 namespace lms::recommendation::PlaylistGeneratorConstraint
@@ -32,6 +33,6 @@ namespace lms::recommendation::PlaylistGeneratorConstraint
         // 0: best
         // 1: worst
         // > 1 : violation
-        virtual float computeScore(const TrackContainer& trackIds, std::size_t trackIndex) = 0;
+        virtual float computeScore(const TrackMetadataSnapshot& trackMetadata, const TrackContainer& trackIds, std::size_t trackIndex) = 0;
     };
 } // namespace lms::recommendation::PlaylistGeneratorConstraint
@@ -22,11 +22,14 @@
 #include <memory>
 #include <vector>
 
+#include <boost/asio/io_context.hpp>
+
 #include "core/EnumSet.hpp"
 #include "database/Types.hpp"
 #include "database/objects/ArtistId.hpp"
 #include "database/objects/ReleaseId.hpp"
 #include "database/objects/TrackListId.hpp"
+#include "services/recommendation/TrackMetadataSnapshot.hpp"
 #include "services/recommendation/Types.hpp"
 
 namespace lms::db
@@ -41,13 +44,20 @@ namespace lms::recommendation
     public:
         virtual ~IRecommendationService() = default;
 
+        // Loads run in the background, queries keep being served using the previous data until the new ones are ready
+        // A load requested while another one is in progress cancels it and starts over
         virtual void load() = 0;
+        // Blocks until all the requested loads are done
+        virtual void waitForLoad() = 0;
 
         virtual TrackContainer findSimilarTracks(db::TrackListId tracklistId, std::size_t maxCount) const = 0;
         virtual TrackContainer findSimilarTracks(const std::vector<db::TrackId>& tracksId, std::size_t maxCount) const = 0;
         virtual ReleaseContainer getSimilarReleases(db::ReleaseId releaseId, std::size_t maxCount) const = 0;
         virtual ArtistContainer getSimilarArtists(db::ArtistId artistId, core::EnumSet<db::TrackArtistLinkType> linkTypes, std::size_t maxCount) const = 0;
+
+        // Refreshed on each load
+        virtual std::shared_ptr<const TrackMetadataSnapshot> getTrackMetadataSnapshot() const = 0;
     };
 
-    std::unique_ptr<IRecommendationService> createRecommendationService(db::IDb& db);
+    std::unique_ptr<IRecommendationService> createRecommendationService(boost::asio::io_context& ioContext, db::IDb& db);
 } // namespace lms::recommendation
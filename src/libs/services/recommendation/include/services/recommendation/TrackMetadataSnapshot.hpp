@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "database/Types.hpp"
+#include "database/objects/ArtistId.hpp"
+#include "database/objects/ReleaseId.hpp"
+#include "database/objects/TrackId.hpp"
+
+namespace lms::recommendation
+{
+    // Compact, read-only copy of the track attributes used by the playlist constraints and the engines
+    // Rebuilt from scratch each time the recommendation service is loaded
+    class TrackMetadataSnapshot
+    {
+    public:
+        struct ArtistLink
+        {
+            db::ArtistId artistId;
+            db::TrackArtistLinkType linkType;
+        };
+
+        class Builder
+        {
+        public:
+            void addTrack(db::TrackId trackId, std::chrono::milliseconds duration);
+            void setTrackRelease(db::TrackId trackId, db::ReleaseId releaseId);
+            void addTrackArtist(db::TrackId trackId, db::ArtistId artistId, db::TrackArtistLinkType linkType);
+
+            TrackMetadataSnapshot build();
+
+        private:
+            struct TrackArtist
+            {
+                db::TrackId trackId;
+                ArtistLink link;
+            };
+
+            std::vector<std::pair<db::TrackId, std::chrono::milliseconds>> _tracks;
+            std::vector<std::pair<db::TrackId, db::ReleaseId>> _trackReleases;
+            std::vector<TrackArtist> _trackArtists;
+        };
+
+        bool contains(db::TrackId trackId) const { return findIndex(trackId) != invalidIndex; }
+
+        // Default values are returned for unknown tracks
+        db::ReleaseId getReleaseId(db::TrackId trackId) const;
+        std::chrono::milliseconds getDuration(db::TrackId trackId) const;
+        std::span<const ArtistLink> getArtistLinks(db::TrackId trackId) const; // sorted by artist id, then link type
+
+        // func(TrackId trackId, ReleaseId releaseId, std::span<const ArtistLink> artistLinks), in track id order
+        template<typename Func>
+        void visitTracks(Func&& func) const
+        {
+            for (Index index{}; index < _trackIds.size(); ++index)
+                func(_trackIds[index], _releaseIds[index], getArtistLinks(index));
+        }
+
+        std::size_t getTrackCount() const { return _trackIds.size(); }
+        std::size_t getMemoryUsage() const;
+
+    private:
+        using Index = std::uint32_t;
+        static constexpr Index invalidIndex{ static_cast<Index>(-1) };
+
+        Index findIndex(db::TrackId trackId) const;
+        std::span<const ArtistLink> getArtistLinks(Index index) const;
+
+        std::vector<db::TrackId> _trackIds; // sorted
+        std::vector<db::ReleaseId> _releaseIds;
+        std::vector<std::uint32_t> _durations; // in milliseconds
+        std::vector<Index> _artistLinkOffsets;
+        std::vector<ArtistLink> _artistLinks;
+    };
+} // namespace lms::recommendation
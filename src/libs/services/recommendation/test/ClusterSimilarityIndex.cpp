@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "core/IJobScheduler.hpp"
+
+#include "clusters/ClusterSimilarityIndex.hpp"
+
+namespace lms::recommendation::tests
+{
+    namespace
+    {
+        // release/artist N has track N, all tracks are in cluster 1
+        // release/artist 1 and 12 also share cluster 2
+        ClusterSimilarityIndex createIndex()
+        {
+            ClusterSimilarityIndex::Builder builder;
+            for (db::TrackId::ValueType i{ 1 }; i <= 12; ++i)
+            {
+                const db::TrackId trackId{ i };
+                builder.setTrackRelease(trackId, db::ReleaseId{ i });
+                builder.addTrackArtist(trackId, db::ArtistId{ i }, db::TrackArtistLinkType::Artist);
+                builder.addTrackCluster(trackId, db::ClusterId{ 1 });
+            }
+            builder.addTrackCluster(db::TrackId{ 1 }, db::ClusterId{ 2 });
+            builder.addTrackCluster(db::TrackId{ 12 }, db::ClusterId{ 2 });
+
+            return builder.build();
+        }
+    } // namespace
+
+    TEST(ClusterSimilarityIndex, similarReleases)
+    {
+        const ClusterSimilarityIndex index{ createIndex() };
+        const ClusterSimilarityIndex::SearchParameters params{ .maxCount = 3, .maxClusterScanSize = 0 };
+
+        const auto releaseIds{ index.findSimilarReleases(db::ReleaseId{ 1 }, params) };
+        ASSERT_EQ(releaseIds.size(), 3);
+        EXPECT_EQ(releaseIds[0], db::ReleaseId{ 12 });
+        EXPECT_TRUE(index.findSimilarReleases(db::ReleaseId{ 42 }, params).empty());
+    }
+
+    TEST(ClusterSimilarityIndex, precomputedTiesAreShuffled)
+    {
+        ClusterSimilarityIndex index{ createIndex() };
+        const ClusterSimilarityIndex::SearchParameters params{ .maxCount = 3, .maxClusterScanSize = 0 };
+        const std::unique_ptr<core::IJobScheduler> jobScheduler{ core::createJobScheduler("Test", 2) };
+        ASSERT_TRUE(index.precomputeSimilarObjects({ db::TrackArtistLinkType::Artist }, params, *jobScheduler));
+
+        std::set<db::ReleaseId> secondReleaseIds;
+        for (std::size_t i{}; i < 100; ++i)
+        {
+            const auto releaseIds{ index.findSimilarReleases(db::ReleaseId{ 1 }, params) };
+            ASSERT_EQ(releaseIds.size(), 3);
+            EXPECT_EQ(releaseIds[0], db::ReleaseId{ 12 });
+            secondReleaseIds.insert(releaseIds[1]);
+
+            const auto artistIds{ index.findSimilarArtists(db::ArtistId{ 1 }, { db::TrackArtistLinkType::Artist }, ClusterSimilarityIndex::SearchParameters{ .maxCount = 2, .maxClusterScanSize = 0 }) };
+            ASSERT_EQ(artistIds.size(), 2);
+            EXPECT_EQ(artistIds[0], db::ArtistId{ 12 });
+        }
+
+        // 10 releases are tied, not always the same one is picked
+        EXPECT_GT(secondReleaseIds.size(), 1);
+    }
+} // namespace lms::recommendation::tests
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "database/objects/TrackListId.hpp"
+#include "database/test/TmpDatabase.hpp"
+#include "services/recommendation/IPlaylistGeneratorService.hpp"
+#include "services/recommendation/IRecommendationService.hpp"
+#include "services/recommendation/TrackMetadataSnapshot.hpp"
+
+namespace lms::recommendation::tests
+{
+    namespace
+    {
+        // Always returns the same similar tracks, the snapshot is not set until loaded
+        class TestRecommendationService final : public IRecommendationService
+        {
+        public:
+            TestRecommendationService(TrackContainer similarTracks)
+                : _similarTracks{ std::move(similarTracks) }
+            {
+            }
+
+            void setTrackMetadataSnapshot(TrackMetadataSnapshot snapshot) { _trackMetadata = std::make_shared<const TrackMetadataSnapshot>(std::move(snapshot)); }
+
+        private:
+            void load() override {}
+            void waitForLoad() override {}
+
+            TrackContainer findSimilarTracks(db::TrackListId, std::size_t) const override { return _similarTracks; }
+            TrackContainer findSimilarTracks(const std::vector<db::TrackId>&, std::size_t) const override { return _similarTracks; }
+            ReleaseContainer getSimilarReleases(db::ReleaseId, std::size_t) const override { return {}; }
+            ArtistContainer getSimilarArtists(db::ArtistId, core::EnumSet<db::TrackArtistLinkType>, std::size_t) const override { return {}; }
+            std::shared_ptr<const TrackMetadataSnapshot> getTrackMetadataSnapshot() const override { return _trackMetadata; }
+
+            const TrackContainer _similarTracks;
+            std::shared_ptr<const TrackMetadataSnapshot> _trackMetadata;
+        };
+
+        class PlaylistGeneratorServiceTest : public ::testing::Test
+        {
+        protected:
+            TestRecommendationService _recommendationService{ TrackContainer{ db::TrackId{ 1 }, db::TrackId{ 2 }, db::TrackId{ 2 }, db::TrackId{ 3 } } };
+            db::tests::TmpDatabase _tmpDb;
+            const std::unique_ptr<IPlaylistGeneratorService> _playlistGenerator{ createPlaylistGeneratorService(_tmpDb.getDb(), _recommendationService) };
+
+            // tracks 1 and 2 share the same artist
+            static TrackMetadataSnapshot createTrackMetadataSnapshot()
+            {
+                using namespace std::chrono_literals;
+
+                TrackMetadataSnapshot::Builder builder;
+                for (const db::TrackId trackId : { db::TrackId{ 1 }, db::TrackId{ 2 }, db::TrackId{ 3 } })
+                    builder.addTrack(trackId, 180s);
+                builder.addTrackArtist(db::TrackId{ 1 }, db::ArtistId{ 1 }, db::TrackArtistLinkType::Artist);
+                builder.addTrackArtist(db::TrackId{ 2 }, db::ArtistId{ 1 }, db::TrackArtistLinkType::Artist);
+                builder.addTrackArtist(db::TrackId{ 3 }, db::ArtistId{ 2 }, db::TrackArtistLinkType::Artist);
+
+                return builder.build();
+            }
+        };
+    } // namespace
+
+    TEST_F(PlaylistGeneratorServiceTest, extendPlaylist_snapshotNotLoaded)
+    {
+        // only the duplicate tracks are skipped
+        EXPECT_EQ(_playlistGenerator->extendPlaylist(db::TrackListId{ 1 }, 3), (TrackContainer{ db::TrackId{ 1 }, db::TrackId{ 2 }, db::TrackId{ 3 } }));
+        EXPECT_EQ(_playlistGenerator->extendPlaylist(db::TrackListId{ 1 }, 2), (TrackContainer{ db::TrackId{ 1 }, db::TrackId{ 2 } }));
+    }
+
+    TEST_F(PlaylistGeneratorServiceTest, extendPlaylist_snapshotLoaded)
+    {
+        _recommendationService.setTrackMetadataSnapshot(createTrackMetadataSnapshot());
+
+        // track 2 is pushed back as it shares the artist of track 1
+        EXPECT_EQ(_playlistGenerator->extendPlaylist(db::TrackListId{ 1 }, 3), (TrackContainer{ db::TrackId{ 1 }, db::TrackId{ 3 }, db::TrackId{ 2 } }));
+        EXPECT_EQ(_playlistGenerator->extendPlaylist(db::TrackListId{ 1 }, 2), (TrackContainer{ db::TrackId{ 1 }, db::TrackId{ 3 } }));
+    }
+} // namespace lms::recommendation::tests
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "services/recommendation/TrackMetadataSnapshot.hpp"
+
+namespace lms::recommendation::tests
+{
+    using namespace std::chrono_literals;
+
+    namespace
+    {
+        std::vector<std::pair<db::ArtistId, db::TrackArtistLinkType>> toPairs(std::span<const TrackMetadataSnapshot::ArtistLink> links)
+        {
+            std::vector<std::pair<db::ArtistId, db::TrackArtistLinkType>> res;
+            for (const TrackMetadataSnapshot::ArtistLink& link : links)
+                res.emplace_back(link.artistId, link.linkType);
+
+            return res;
+        }
+    } // namespace
+
+    TEST(TrackMetadataSnapshot, empty)
+    {
+        const TrackMetadataSnapshot snapshot{ TrackMetadataSnapshot::Builder{}.build() };
+
+        EXPECT_EQ(snapshot.getTrackCount(), 0);
+        EXPECT_FALSE(snapshot.contains(db::TrackId{ 1 }));
+        EXPECT_FALSE(snapshot.getReleaseId(db::TrackId{ 1 }).isValid());
+        EXPECT_EQ(snapshot.getDuration(db::TrackId{ 1 }), 0ms);
+        EXPECT_TRUE(snapshot.getArtistLinks(db::TrackId{ 1 }).empty());
+    }
+
+    TEST(TrackMetadataSnapshot, build)
+    {
+        TrackMetadataSnapshot::Builder builder;
+
+        // out of order and duplicate tracks
+        builder.addTrack(db::TrackId{ 3 }, 3000ms);
+        builder.addTrack(db::TrackId{ 1 }, 1000ms);
+        builder.addTrack(db::TrackId{ 3 }, 3000ms);
+        builder.addTrack(db::TrackId{ 2 }, -5ms);
+        builder.setTrackRelease(db::TrackId{ 1 }, db::ReleaseId{ 10 });
+        builder.setTrackRelease(db::TrackId{ 3 }, db::ReleaseId{ 30 });
+        // unknown track
+        builder.setTrackRelease(db::TrackId{ 42 }, db::ReleaseId{ 42 });
+
+        const TrackMetadataSnapshot snapshot{ builder.build() };
+
+        EXPECT_EQ(snapshot.getTrackCount(), 3);
+        EXPECT_TRUE(snapshot.contains(db::TrackId{ 1 }));
+        EXPECT_TRUE(snapshot.contains(db::TrackId{ 2 }));
+        EXPECT_TRUE(snapshot.contains(db::TrackId{ 3 }));
+        EXPECT_FALSE(snapshot.contains(db::TrackId{ 42 }));
+
+        EXPECT_EQ(snapshot.getReleaseId(db::TrackId{ 1 }), db::ReleaseId{ 10 });
+        EXPECT_FALSE(snapshot.getReleaseId(db::TrackId{ 2 }).isValid());
+        EXPECT_EQ(snapshot.getReleaseId(db::TrackId{ 3 }), db::ReleaseId{ 30 });
+        EXPECT_FALSE(snapshot.getReleaseId(db::TrackId{ 42 }).isValid());
+
+        EXPECT_EQ(snapshot.getDuration(db::TrackId{ 1 }), 1000ms);
+        EXPECT_EQ(snapshot.getDuration(db::TrackId{ 2 }), 0ms);
+        EXPECT_EQ(snapshot.getDuration(db::TrackId{ 3 }), 3000ms);
+
+        std::vector<db::TrackId> visitedTrackIds;
+        snapshot.visitTracks([&](db::TrackId trackId, db::ReleaseId, std::span<const TrackMetadataSnapshot::ArtistLink>) { visitedTrackIds.push_back(trackId); });
+        EXPECT_EQ(visitedTrackIds, (std::vector<db::TrackId>{ db::TrackId{ 1 }, db::TrackId{ 2 }, db::TrackId{ 3 } }));
+    }
+
+    TEST(TrackMetadataSnapshot, artistLinks)
+    {
+        TrackMetadataSnapshot::Builder builder;
+
+        builder.addTrack(db::TrackId{ 1 }, 1000ms);
+        builder.addTrack(db::TrackId{ 2 }, 1000ms);
+        builder.addTrack(db::TrackId{ 3 }, 1000ms);
+
+        // several link types, out of order and duplicated
+        builder.addTrackArtist(db::TrackId{ 1 }, db::ArtistId{ 20 }, db::TrackArtistLinkType::Composer);
+        builder.addTrackArtist(db::TrackId{ 1 }, db::ArtistId{ 10 }, db::TrackArtistLinkType::Producer);
+        builder.addTrackArtist(db::TrackId{ 1 }, db::ArtistId{ 10 }, db::TrackArtistLinkType::Artist);
+        builder.addTrackArtist(db::TrackId{ 1 }, db::ArtistId{ 20 }, db::TrackArtistLinkType::Composer);
+        builder.addTrackArtist(db::TrackId{ 3 }, db::ArtistId{ 10 }, db::TrackArtistLinkType::ReleaseArtist);
+        // unknown track
+        builder.addTrackArtist(db::TrackId{ 42 }, db::ArtistId{ 10 }, db::TrackArtistLinkType::Artist);
+
+        const TrackMetadataSnapshot snapshot{ builder.build() };
+
+        using Links = std::vector<std::pair<db::ArtistId, db::TrackArtistLinkType>>;
+        EXPECT_EQ(toPairs(snapshot.getArtistLinks(db::TrackId{ 1 })), (Links{
+                                                                           { db::ArtistId{ 10 }, db::TrackArtistLinkType::Artist },
+                                                                           { db::ArtistId{ 10 }, db::TrackArtistLinkType::Producer },
+                                                                           { db::ArtistId{ 20 }, db::TrackArtistLinkType::Composer },
+                                                                       }));
+        EXPECT_TRUE(snapshot.getArtistLinks(db::TrackId{ 2 }).empty());
+        EXPECT_EQ(toPairs(snapshot.getArtistLinks(db::TrackId{ 3 })), (Links{ { db::ArtistId{ 10 }, db::TrackArtistLinkType::ReleaseArtist } }));
+        EXPECT_TRUE(snapshot.getArtistLinks(db::TrackId{ 42 }).empty());
+        EXPECT_TRUE(snapshot.getArtistLinks(db::TrackId{ 0 }).empty());
+
+        std::size_t linkCount{};
+        snapshot.visitTracks([&](db::TrackId, db::ReleaseId, std::span<const TrackMetadataSnapshot::ArtistLink> links) { linkCount += links.size(); });
+        EXPECT_EQ(linkCount, 4);
+    }
+} // namespace lms::recommendation::tests
@@ -0,0 +1,438 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/io_context.hpp>
+
+#include <taglib/attachedpictureframe.h>
+#include <taglib/fileref.h>
+#include <taglib/flacfile.h>
+#include <taglib/flacpicture.h>
+#include <taglib/id3v2tag.h>
+#include <taglib/mp4coverart.h>
+#include <taglib/mp4file.h>
+#include <taglib/mpegfile.h>
+#include <taglib/opusfile.h>
+#include <taglib/tpropertymap.h>
+
+#include "core/IChildProcessManager.hpp"
+#include "core/IConfig.hpp"
+#include "core/Service.hpp"
+#include "core/UUID.hpp"
+#include "database/IDb.hpp"
+#include "database/Session.hpp"
+#include "database/objects/MediaLibrary.hpp"
+#include "metadata/IAudioFileParser.hpp"
+#include "services/scanner/IScannerService.hpp"
+
+// Throughput of the metadata parsers and of the whole scanner, on a corpus generated locally using ffmpeg and TagLib
+// The corpus is generated once, in a temporary directory, at the first use
+// The ffmpeg binary is the configured 'ffmpeg-file', and can be overridden using the LMS_FFMPEG_FILE environment variable
+namespace lms::scanner::benchs
+{
+    namespace
+    {
+        std::filesystem::path getFFmpegPath()
+        {
+            if (const char* ffmpegPath{ std::getenv("LMS_FFMPEG_FILE") })
+                return ffmpegPath;
+
+            if (core::Service<core::IConfig>::exists())
+                return core::Service<core::IConfig>::get()->getPath("ffmpeg-file", "/usr/bin/ffmpeg");
+
+            return "/usr/bin/ffmpeg";
+        }
+
+        enum class Format
+        {
+            MP3,
+            FLAC,
+            Opus,
+            M4A,
+        };
+        constexpr std::array formats{ Format::MP3, Format::FLAC, Format::Opus, Format::M4A };
+
+        struct FormatInfo
+        {
+            std::string_view name;
+            std::string_view extension;
+            std::vector<std::string> encoderArgs;
+        };
+
+        FormatInfo getFormatInfo(Format format)
+        {
+            switch (format)
+            {
+            case Format::MP3:
+                return FormatInfo{ "mp3", ".mp3", { "-c:a", "libmp3lame", "-b:a", "320k" } };
+            case Format::FLAC:
+                return FormatInfo{ "flac", ".flac", { "-c:a", "flac", "-sample_fmt", "s16" } };
+            case Format::Opus:
+                return FormatInfo{ "opus", ".opus", { "-c:a", "libopus", "-b:a", "160k" } };
+            case Format::M4A:
+                return FormatInfo{ "m4a", ".m4a", { "-c:a", "aac", "-b:a", "256k" } };
+            }
+
+            return {};
+        }
+
+        void runFFmpeg(std::vector<std::string> args, const std::filesystem::path& outputFile)
+        {
+            boost::asio::io_context ioContext;
+            const auto childProcessManager{ core::createChildProcessManager(ioContext) };
+
+            const std::filesystem::path ffmpegPath{ getFFmpegPath() };
+            args.insert(std::begin(args), { ffmpegPath.string(), "-loglevel", "quiet", "-nostdin", "-y" });
+            args.push_back(outputFile.string());
+
+            const std::unique_ptr<core::IChildProcess> childProcess{ childProcessManager->spawnChildProcess(ffmpegPath, args) };
+            std::array<std::byte, 64> buffer;
+            while (childProcess->readSome(buffer.data(), buffer.size()) > 0)
+                ;
+
+            const std::optional<int> exitCode{ childProcess->getExitCode() };
+            if (exitCode != 0)
+                throw std::runtime_error{ "Cannot generate '" + outputFile.string() + "' using " + ffmpegPath.string() + (exitCode ? ": exit code " + std::to_string(*exitCode) : ": killed") };
+
+            if (!std::filesystem::exists(outputFile))
+                throw std::runtime_error{ "Cannot generate '" + outputFile.string() + "' using " + ffmpegPath.string() };
+        }
+
+        void addFrontCover(TagLib::File& file, const TagLib::ByteVector& cover)
+        {
+            if (auto* mpegFile{ dynamic_cast<TagLib::MPEG::File*>(&file) })
+            {
+                auto* frame{ new TagLib::ID3v2::AttachedPictureFrame };
+                frame->setMimeType("image/jpeg");
+                frame->setType(TagLib::ID3v2::AttachedPictureFrame::Type::FrontCover);
+                frame->setPicture(cover);
+                mpegFile->ID3v2Tag(true)->addFrame(frame);
+            }
+            else if (auto* flacFile{ dynamic_cast<TagLib::FLAC::File*>(&file) })
+            {
+                auto* picture{ new TagLib::FLAC::Picture };
+                picture->setMimeType("image/jpeg");
+                picture->setType(TagLib::FLAC::Picture::Type::FrontCover);
+                picture->setData(cover);
+                flacFile->addPicture(picture);
+            }
+            else if (auto* opusFile{ dynamic_cast<TagLib::Ogg::Opus::File*>(&file) })
+            {
+                auto* picture{ new TagLib::FLAC::Picture };
+                picture->setMimeType("image/jpeg");
+                picture->setType(TagLib::FLAC::Picture::Type::FrontCover);
+                picture->setData(cover);
+                opusFile->tag()->addPicture(picture);
+            }
+            else if (auto* mp4File{ dynamic_cast<TagLib::MP4::File*>(&file) })
+            {
+                TagLib::MP4::CoverArtList coverArts;
+                coverArts.append(TagLib::MP4::CoverArt{ TagLib::MP4::CoverArt::JPEG, cover });
+                mp4File->tag()->setItem("covr", coverArts);
+            }
+        }
+
+        // Tagged like a well maintained library: MusicBrainz ids, multi-valued genres, etc.
+        class Corpus
+        {
+        public:
+            static constexpr std::size_t releaseCountPerFormat{ 10 };
+            static constexpr std::size_t trackCountPerRelease{ 10 };
+            static constexpr std::size_t trackDurationSecs{ 60 };
+
+            Corpus()
+                : _rootPath{ std::filesystem::temp_directory_path() / ("lms-bench-scanner-" + std::string{ core::UUID::generate().getAsString() }) }
+            {
+                std::filesystem::create_directories(_rootPath);
+
+                const std::filesystem::path coverPath{ _rootPath / "cover.jpg" };
+                runFFmpeg({ "-f", "lavfi", "-i", "testsrc=size=1000x1000", "-frames:v", "1", "-q:v", "2" }, coverPath);
+                const TagLib::ByteVector cover{ readFile(coverPath) };
+                std::filesystem::remove(coverPath);
+
+                for (const Format format : formats)
+                    generate(format, cover);
+            }
+
+            ~Corpus()
+            {
+                std::error_code ec;
+                std::filesystem::remove_all(_rootPath, ec);
+            }
+
+            Corpus(const Corpus&) = delete;
+            Corpus& operator=(const Corpus&) = delete;
+
+            const std::filesystem::path& getRootPath() const { return _rootPath; }
+            std::span<const std::filesystem::path> getFiles(Format format) const { return _files[static_cast<std::size_t>(format)]; }
+            std::size_t getFileCount() const { return formats.size() * releaseCountPerFormat * trackCountPerRelease; }
+
+            static std::uintmax_t getTotalSize(std::span<const std::filesystem::path> files)
+            {
+                std::uintmax_t size{};
+                for (const std::filesystem::path& file : files)
+                    size += std::filesystem::file_size(file);
+                return size;
+            }
+
+            std::uintmax_t getTotalSize() const
+            {
+                std::uintmax_t size{};
+                for (const Format format : formats)
+                    size += getTotalSize(getFiles(format));
+                return size;
+            }
+
+        private:
+            static TagLib::ByteVector readFile(const std::filesystem::path& path)
+            {
+                std::ifstream ifs{ path, std::ios::binary };
+                const std::string content{ std::istreambuf_iterator<char>{ ifs }, std::istreambuf_iterator<char>{} };
+                return TagLib::ByteVector{ content.data(), static_cast<unsigned int>(content.size()) };
+            }
+
+            void generate(Format format, const TagLib::ByteVector& cover)
+            {
+                const FormatInfo formatInfo{ getFormatInfo(format) };
+                const std::filesystem::path formatPath{ _rootPath / formatInfo.name };
+                std::filesystem::create_directories(formatPath);
+
+                // Same audio stream for all the tracks, only tags differ
+                const std::filesystem::path templatePath{ formatPath / ("template" + std::string{ formatInfo.extension }) };
+                std::vector<std::string> args{ "-f", "lavfi", "-i", "sine=frequency=440:duration=" + std::to_string(trackDurationSecs), "-ac", "2", "-ar", "48000" };
+                args.insert(std::end(args), std::cbegin(formatInfo.encoderArgs), std::cend(formatInfo.encoderArgs));
+                runFFmpeg(args, templatePath);
+
+                static constexpr std::array genres{ "Rock", "Pop", "Jazz", "Electronic", "Classical", "Hip-Hop", "Folk", "Metal" };
+                static constexpr std::array moods{ "Calm", "Energetic", "Dark", "Happy" };
+
+                for (std::size_t releaseIndex{}; releaseIndex < releaseCountPerFormat; ++releaseIndex)
+                {
+                    const std::string artistName{ "Artist " + std::to_string(releaseIndex % 4) };
+                    const std::string releaseName{ std::string{ formatInfo.name } + " Release " + std::to_string(releaseIndex) };
+                    const std::string artistMBID{ core::UUID::generate().getAsString() };
+                    const std::string releaseMBID{ core::UUID::generate().getAsString() };
+                    const std::string releaseGroupMBID{ core::UUID::generate().getAsString() };
+
+                    const std::filesystem::path releasePath{ formatPath / artistName / releaseName };
+                    std::filesystem::create_directories(releasePath);
+
+                    for (std::size_t trackIndex{}; trackIndex < trackCountPerRelease; ++trackIndex)
+                    {
+                        const std::string title{ "Track " + std::to_string(trackIndex + 1) };
+                        const std::filesystem::path trackPath{ releasePath / (std::to_string(trackIndex + 1) + " - " + title + std::string{ formatInfo.extension }) };
+                        std::filesystem::copy_file(templatePath, trackPath);
+
+                        TagLib::PropertyMap properties;
+                        properties["TITLE"] = TagLib::String{ title, TagLib::String::UTF8 };
+                        properties["ARTIST"] = TagLib::String{ artistName, TagLib::String::UTF8 };
+                        properties["ALBUMARTIST"] = TagLib::String{ artistName, TagLib::String::UTF8 };
+                        properties["ALBUM"] = TagLib::String{ releaseName, TagLib::String::UTF8 };
+                        properties["TRACKNUMBER"] = TagLib::String{ std::to_string(trackIndex + 1) + "/" + std::to_string(trackCountPerRelease) };
+                        properties["DISCNUMBER"] = TagLib::String{ "1/1" };
+                        properties["DATE"] = TagLib::String{ std::to_string(1970 + releaseIndex) + "-01-01" };
+                        properties["GENRE"] = TagLib::StringList{ TagLib::String{ genres[(releaseIndex + trackIndex) % genres.size()] } };
+                        properties["GENRE"].append(TagLib::String{ genres[releaseIndex % genres.size()] });
+                        properties["MOOD"] = TagLib::String{ moods[trackIndex % moods.size()] };
+                        properties["LABEL"] = TagLib::String{ "Label " + std::to_string(releaseIndex % 3) };
+                        properties["RELEASETYPE"] = TagLib::String{ "album" };
+                        properties["COMPOSER"] = TagLib::String{ "Composer " + std::to_string(trackIndex % 5) };
+                        properties["MUSICBRAINZ_ARTISTID"] = TagLib::String{ artistMBID };
+                        properties["MUSICBRAINZ_ALBUMARTISTID"] = TagLib::String{ artistMBID };
+                        properties["MUSICBRAINZ_ALBUMID"] = TagLib::String{ releaseMBID };
+                        properties["MUSICBRAINZ_RELEASEGROUPID"] = TagLib::String{ releaseGroupMBID };
+                        properties["MUSICBRAINZ_TRACKID"] = TagLib::String{ std::string{ core::UUID::generate().getAsString() } };
+                        properties["MUSICBRAINZ_RELEASETRACKID"] = TagLib::String{ std::string{ core::UUID::generate().getAsString() } };
+                        properties["REPLAYGAIN_TRACK_GAIN"] = TagLib::String{ "-7.50 dB" };
+                        properties["REPLAYGAIN_ALBUM_GAIN"] = TagLib::String{ "-8.00 dB" };
+
+                        TagLib::FileRef fileRef{ trackPath.c_str() };
+                        if (fileRef.isNull())
+                            throw std::runtime_error{ "Cannot open '" + trackPath.string() + "' using TagLib" };
+
+                        fileRef.file()->setProperties(properties);
+                        addFrontCover(*fileRef.file(), cover);
+                        fileRef.save();
+
+                        _files[static_cast<std::size_t>(format)].push_back(trackPath);
+                    }
+                }
+
+                std::filesystem::remove(templatePath);
+            }
+
+            const std::filesystem::path _rootPath;
+            std::array<std::vector<std::filesystem::path>, formats.size()> _files;
+        };
+
+        const Corpus& getCorpus()
+        {
+            static const Corpus corpus;
+            return corpus;
+        }
+
+        void setThroughputCounters(benchmark::State& state, std::size_t fileCount, std::uintmax_t totalSize)
+        {
+            state.counters["files/s"] = benchmark::Counter{ static_cast<double>(fileCount), benchmark::Counter::kIsIterationInvariantRate };
+            state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * totalSize));
+        }
+
+        std::unique_ptr<metadata::IAudioFileParser> createParser(const benchmark::State& state)
+        {
+            metadata::AudioFileParserParameters params;
+            params.readStyle = static_cast<metadata::ParserReadStyle>(state.range(1));
+            return metadata::createAudioFileParser(params);
+        }
+    } // namespace
+
+    // Args are the format and the read style
+    static void BM_Scanner_parseMetaData(benchmark::State& state)
+    {
+        const std::span<const std::filesystem::path> files{ getCorpus().getFiles(static_cast<Format>(state.range(0))) };
+        const auto parser{ createParser(state) };
+
+        for (auto _ : state)
+        {
+            for (const std::filesystem::path& file : files)
+                benchmark::DoNotOptimize(parser->parseMetaData(file));
+        }
+
+        setThroughputCounters(state, files.size(), Corpus::getTotalSize(files));
+    }
+
+    static void BM_Scanner_parseImages(benchmark::State& state)
+    {
+        const std::span<const std::filesystem::path> files{ getCorpus().getFiles(static_cast<Format>(state.range(0))) };
+        const auto parser{ createParser(state) };
+
+        std::size_t imageCount{};
+        for (auto _ : state)
+        {
+            for (const std::filesystem::path& file : files)
+                parser->parseImages(file, [&](const metadata::Image& image) { benchmark::DoNotOptimize(image.data.data()); imageCount++; });
+        }
+
+        setThroughputCounters(state, files.size(), Corpus::getTotalSize(files));
+        state.counters["images"] = benchmark::Counter{ static_cast<double>(imageCount), benchmark::Counter::kAvgIterations };
+    }
+
+    // What the scanner actually does for each audio file
+    static void BM_Scanner_parseMetaDataAndImages(benchmark::State& state)
+    {
+        const std::span<const std::filesystem::path> files{ getCorpus().getFiles(static_cast<Format>(state.range(0))) };
+        const auto parser{ createParser(state) };
+
+        for (auto _ : state)
+        {
+            for (const std::filesystem::path& file : files)
+                benchmark::DoNotOptimize(parser->parseMetaDataAndImages(file, [&](const metadata::Image& image) { benchmark::DoNotOptimize(image.data.data()); }));
+        }
+
+        setThroughputCounters(state, files.size(), Corpus::getTotalSize(files));
+    }
+
+    // Full scan of the whole corpus in a fresh database, all steps included
+    static void BM_Scanner_fullScan(benchmark::State& state)
+    {
+        const Corpus& corpus{ getCorpus() };
+
+        const std::filesystem::path workingPath{ corpus.getRootPath().parent_path() / (corpus.getRootPath().filename().string() + "-db") };
+        std::filesystem::create_directories(workingPath);
+        {
+            std::ofstream configFile{ workingPath / "lms.conf" };
+            configFile << "scanner-parser-read-style = \"average\";" << std::endl;
+        }
+        core::Service<core::IConfig> config{ core::createConfig(workingPath / "lms.conf") };
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            std::filesystem::remove(workingPath / "lms.db");
+            const auto db{ db::createDb(workingPath / "lms.db") };
+            {
+                db::Session session{ *db };
+                session.prepareTablesIfNeeded();
+                session.createIndexesIfNeeded();
+
+                auto transaction{ session.createWriteTransaction() };
+                session.create<db::MediaLibrary>("Corpus", corpus.getRootPath());
+            }
+
+            const auto scannerService{ createScannerService(*db, workingPath / "cache") };
+
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::optional<ScanStats> stats;
+            scannerService->getEvents().scanComplete.connect([&](const ScanStats& scanStats) {
+                std::scoped_lock lock{ mutex };
+                stats = scanStats;
+                cv.notify_one();
+            });
+            state.ResumeTiming();
+
+            scannerService->requestImmediateScan();
+            {
+                std::unique_lock lock{ mutex };
+                cv.wait(lock, [&] { return stats.has_value(); });
+            }
+
+            state.PauseTiming();
+            if (stats->additions != corpus.getFileCount())
+                state.SkipWithError("Unexpected number of added files");
+            state.ResumeTiming();
+        }
+
+        setThroughputCounters(state, corpus.getFileCount(), corpus.getTotalSize());
+
+        std::error_code ec;
+        std::filesystem::remove_all(workingPath, ec);
+    }
+
+    static void applyFormatsAndReadStyles(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->ArgNames({ "format", "readStyle" });
+        for (const Format format : formats)
+        {
+            for (const metadata::ParserReadStyle readStyle : { metadata::ParserReadStyle::Fast, metadata::ParserReadStyle::Average, metadata::ParserReadStyle::Accurate })
+                benchmark->Args({ static_cast<std::int64_t>(format), static_cast<std::int64_t>(readStyle) });
+        }
+    }
+
+    BENCHMARK(BM_Scanner_parseMetaData)->Apply(applyFormatsAndReadStyles)->Unit(benchmark::kMillisecond);
+    BENCHMARK(BM_Scanner_parseImages)->Apply(applyFormatsAndReadStyles)->Unit(benchmark::kMillisecond);
+    BENCHMARK(BM_Scanner_parseMetaDataAndImages)->Apply(applyFormatsAndReadStyles)->Unit(benchmark::kMillisecond);
+    BENCHMARK(BM_Scanner_fullScan)->Unit(benchmark::kMillisecond)->UseRealTime()->Iterations(3);
+} // namespace lms::scanner::benchs
+
+BENCHMARK_MAIN();
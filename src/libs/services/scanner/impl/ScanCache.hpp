@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/UUID.hpp"
+#include "database/objects/ArtistId.hpp"
+#include "database/objects/ClusterId.hpp"
+#include "database/objects/CountryId.hpp"
+#include "database/objects/DirectoryId.hpp"
+#include "database/objects/LabelId.hpp"
+#include "database/objects/ReleaseTypeId.hpp"
+
+namespace lms::db
+{
+    class Session;
+} // namespace lms::db
+
+namespace lms::scanner
+{
+    // Scan-wide cache of the db objects resolved from the scanned metadata (names, MBIDs, paths), to avoid looking them up again for each file
+    // Entries added since the last commit() are dropped by rollback(), so that the cache never refers to objects created by a rolled back transaction
+    // Objects may still be removed behind the cache's back: users must check the cached object exists and invalidate the entry otherwise
+    class ScanCache
+    {
+    public:
+        template<typename Key, typename Id>
+        class Map
+        {
+        public:
+            template<typename K>
+            std::optional<Id> find(const K& key) const
+            {
+                const auto it{ _ids.find(key) };
+                if (it == std::cend(_ids))
+                    return std::nullopt;
+
+                return it->second;
+            }
+
+            // Returns a null pointer if not cached or if the cached object no longer exists
+            template<typename Object, typename K>
+            typename Object::pointer findObject(db::Session& session, const K& key)
+            {
+                typename Object::pointer object;
+                if (const std::optional<Id> id{ find(key) })
+                {
+                    object = Object::find(session, *id);
+                    if (!object)
+                        invalidate(key);
+                }
+
+                return object;
+            }
+
+            void add(const Key& key, Id id)
+            {
+                _ids.insert_or_assign(key, id);
+                _pendingKeys.push_back(key);
+            }
+
+            template<typename K>
+            void invalidate(const K& key)
+            {
+                const auto it{ _ids.find(key) };
+                if (it != std::end(_ids))
+                    _ids.erase(it);
+            }
+
+            void commit() { _pendingKeys.clear(); }
+
+            void rollback()
+            {
+                for (const Key& key : _pendingKeys)
+                    _ids.erase(key);
+                _pendingKeys.clear();
+            }
+
+            void clear()
+            {
+                _ids.clear();
+                _pendingKeys.clear();
+            }
+
+        private:
+            std::map<Key, Id, std::less<>> _ids;
+            std::vector<Key> _pendingKeys;
+        };
+
+        Map<core::UUID, db::ArtistId> artistsByMBID;
+        Map<std::string, db::ArtistId> artistsByName; // only artists resolved without MBID
+        Map<std::string, db::ClusterTypeId> clusterTypes;
+        Map<std::pair<db::ClusterTypeId, std::string>, db::ClusterId> clusters;
+        Map<std::string, db::CountryId> countries;
+        Map<std::string, db::LabelId> labels;
+        Map<std::string, db::ReleaseTypeId> releaseTypes;
+        Map<std::filesystem::path, db::DirectoryId> directories;
+
+        // To be called once the write transaction that used the cache has been committed
+        void commit() { visitMaps([](auto& map) { map.commit(); }); }
+        // To be called if the write transaction that used the cache has been rolled back
+        void rollback() { visitMaps([](auto& map) { map.rollback(); }); }
+        void clear() { visitMaps([](auto& map) { map.clear(); }); }
+
+    private:
+        template<typename Func>
+        void visitMaps(Func func)
+        {
+            func(artistsByMBID);
+            func(artistsByName);
+            func(clusterTypes);
+            func(clusters);
+            func(countries);
+            func(labels);
+            func(releaseTypes);
+            func(directories);
+        }
+    };
+} // namespace lms::scanner
@@ -22,6 +22,9 @@
 #include "services/scanner/ScannerOptions.hpp"
 #include "services/scanner/ScannerStats.hpp"
 
+#include "ScanCache.hpp"
+#include "ScanJournal.hpp"
+
 namespace lms::scanner
 {
     struct ScanContext
@@ -29,5 +32,7 @@ namespace lms::scanner
         ScanOptions scanOptions;
         ScanStats stats;
         ScanStepStats currentStepStats;
+        ScanJournal journal;
+        ScanCache cache;
     };
 } // namespace lms::scanner
\ No newline at end of file
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ScanJournal.hpp"
+
+#include "database/objects/Track.hpp"
+
+namespace lms::scanner
+{
+    void ScanJournal::addChangedTrack(const db::Track::pointer& track)
+    {
+        if (const db::ReleaseId releaseId{ track->getReleaseId() }; releaseId.isValid())
+            _changedReleases.insert(releaseId);
+
+        for (const db::ArtistId artistId : track->getArtistIds({}))
+            _changedArtists.insert(artistId);
+
+        for (const db::ClusterId clusterId : track->getClusterIds())
+            _changedClusters.insert(clusterId);
+    }
+
+    void ScanJournal::addChangedImage(const std::filesystem::path& imagePath)
+    {
+        if (const auto mbid{ core::UUID::fromString(imagePath.stem().string()) })
+            _changedImageMBIDs.insert(*mbid);
+    }
+} // namespace lms::scanner
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <set>
+
+#include "core/UUID.hpp"
+#include "database/Object.hpp"
+#include "database/objects/ArtistId.hpp"
+#include "database/objects/ClusterId.hpp"
+#include "database/objects/MediumId.hpp"
+#include "database/objects/ReleaseId.hpp"
+
+namespace lms::db
+{
+    class Track;
+}
+
+namespace lms::scanner
+{
+    // Records what has been changed during the current scan, so that the steps can only process the affected entities
+    // If the journal is not complete (first scan, previous scan aborted, settings changed, full scan requested), the steps must process everything
+    class ScanJournal
+    {
+    public:
+        void setIncomplete() { _complete = false; }
+        bool isComplete() const { return _complete; }
+
+        // A file has been added, updated, moved or removed in this directory
+        void addChangedDirectory(const std::filesystem::path& directory) { _changedDirectories.insert(directory); }
+        const std::set<std::filesystem::path>& getChangedDirectories() const { return _changedDirectories; }
+
+        // Records the release, artists and clusters of a track: to be called before a track is modified or removed, and after it is added or modified
+        void addChangedTrack(const db::ObjectPtr<db::Track>& track);
+        const std::set<db::ReleaseId>& getChangedReleases() const { return _changedReleases; }
+        const std::set<db::ClusterId>& getChangedClusters() const { return _changedClusters; }
+
+        // Artists whose tracks, artist info or links have changed
+        void addChangedArtist(db::ArtistId artistId) { _changedArtists.insert(artistId); }
+        const std::set<db::ArtistId>& getChangedArtists() const { return _changedArtists; }
+
+        // An image file has been added, updated or removed: only its file stem matters, as images named after a MBID are searched anywhere
+        void addChangedImage(const std::filesystem::path& imagePath);
+        const std::set<core::UUID>& getChangedImageMBIDs() const { return _changedImageMBIDs; }
+
+        void addReleaseWithChangedArtwork(db::ReleaseId releaseId) { _releasesWithChangedArtwork.insert(releaseId); }
+        const std::set<db::ReleaseId>& getReleasesWithChangedArtwork() const { return _releasesWithChangedArtwork; }
+
+        void addMediumWithChangedArtwork(db::MediumId mediumId) { _mediumsWithChangedArtwork.insert(mediumId); }
+        const std::set<db::MediumId>& getMediumsWithChangedArtwork() const { return _mediumsWithChangedArtwork; }
+
+    private:
+        bool _complete{ true };
+        std::set<std::filesystem::path> _changedDirectories;
+        std::set<db::ReleaseId> _changedReleases;
+        std::set<db::ClusterId> _changedClusters;
+        std::set<db::ArtistId> _changedArtists;
+        std::set<core::UUID> _changedImageMBIDs;
+        std::set<db::ReleaseId> _releasesWithChangedArtwork;
+        std::set<db::MediumId> _mediumsWithChangedArtwork;
+    };
+} // namespace lms::scanner
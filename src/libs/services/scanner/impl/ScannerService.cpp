@@ -375,6 +375,9 @@ namespace lms::scanner
 
         ScanContext scanContext;
         scanContext.scanOptions = scanOptions;
+        // Steps can only process what changed if the previous scan went through all the steps with the same settings
+        if (scanOptions.fullScan || !_previousScanComplete)
+            scanContext.journal.setIncomplete();
         ScanStats& stats{ scanContext.stats };
         stats.startTime = Wt::WDateTime::currentDateTime();
 
@@ -408,6 +411,7 @@ namespace lms::scanner
             // save current settings as last scan settings to compare during next scans if something changed
             writeScannerSettings(_db.getTLSSession(), lastScanSettingsName, _settings);
             _lastScanSettings = _settings;
+            _previousScanComplete = true;
 
             LMS_LOG(DBUPDATER, DEBUG, "Scan not aborted, scheduling next scan!");
             scheduleNextScan();
@@ -416,6 +420,7 @@ namespace lms::scanner
         }
         else
         {
+            _previousScanComplete = false;
             LMS_LOG(DBUPDATER, DEBUG, "Scan aborted, not scheduling next scan!");
         }
     }
@@ -467,6 +472,7 @@ namespace lms::scanner
         LMS_LOG(DBUPDATER, DEBUG, "Using artist info scan version " << newSettings->artistInfoScanVersion);
 
         _settings = std::move(*newSettings);
+        _previousScanComplete = false;
         if (!_lastScanSettings)
             _lastScanSettings = readScannerSettings(_db.getTLSSession(), lastScanSettingsName);
 
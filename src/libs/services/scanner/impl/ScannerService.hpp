@@ -110,5 +110,6 @@ namespace lms::scanner
 
         ScannerSettings _settings;
         std::optional<ScannerSettings> _lastScanSettings;
+        bool _previousScanComplete{}; // previous scan was not aborted and used the current settings
     };
 } // namespace lms::scanner
@@ -23,12 +23,23 @@
 #include "database/Session.hpp"
 #include "metadata/Types.hpp"
 
+#include "ScanCache.hpp"
+
 namespace lms::scanner::helpers
 {
     namespace
     {
-        db::Artist::pointer createArtist(db::Session& session, const metadata::Artist& artistInfo)
+        // Same truncation as the one applied when looking up artists by name
+        std::string_view getNameKey(std::string_view name)
+        {
+            return name.substr(0, db::Artist::maxNameLength);
+        }
+
+        db::Artist::pointer createArtist(db::Session& session, ScanCache& cache, const metadata::Artist& artistInfo)
         {
+            // the artists having this name are about to change
+            cache.artistsByName.invalidate(getNameKey(artistInfo.name));
+
             db::Artist::pointer artist{ session.create<db::Artist>(artistInfo.name) };
 
             if (artistInfo.mbid)
@@ -44,15 +55,24 @@ namespace lms::scanner::helpers
             return uuid ? std::string{ uuid->getAsString() } : "<no MBID>";
         }
 
-        void updateArtistIfNeeded(db::Artist::pointer artist, const metadata::Artist& artistInfo)
+        void updateArtistIfNeeded(ScanCache& cache, db::Artist::pointer artist, const metadata::Artist& artistInfo)
         {
             // MBID may be set
             if (artist->getMBID() != artistInfo.mbid)
+            {
+                if (const auto previousMBID{ artist->getMBID() })
+                    cache.artistsByMBID.invalidate(*previousMBID);
+                cache.artistsByName.invalidate(getNameKey(artist->getName())); // name resolution depends on MBIDs
+
                 artist.modify()->setMBID(artistInfo.mbid);
+            }
 
             // Name may have been updated
             if (artist->getName() != artistInfo.name)
             {
+                cache.artistsByName.invalidate(getNameKey(artist->getName()));
+                cache.artistsByName.invalidate(getNameKey(artistInfo.name));
+
                 LMS_LOG(DBUPDATER, DEBUG, "Artist [" << optionalMBIDAsString(artist->getMBID()) << "], updated name from '" << artist->getName() << "' to '" << artistInfo.name << "'");
                 artist.modify()->setName(artistInfo.name);
             }
@@ -68,13 +88,16 @@ namespace lms::scanner::helpers
 
     } // namespace
 
-    db::Artist::pointer getOrCreateArtistByMBID(db::Session& session, const metadata::Artist& artistInfo, AllowFallbackOnMBIDEntry allowFallbackOnMBIDEntries)
+    db::Artist::pointer getOrCreateArtistByMBID(db::Session& session, ScanCache& cache, const metadata::Artist& artistInfo, AllowFallbackOnMBIDEntry allowFallbackOnMBIDEntries)
     {
         assert(artistInfo.mbid.has_value());
-        db::Artist::pointer artist{ db::Artist::find(session, *artistInfo.mbid) };
+        db::Artist::pointer artist{ cache.artistsByMBID.findObject<db::Artist>(session, *artistInfo.mbid) };
+        if (!artist)
+            artist = db::Artist::find(session, *artistInfo.mbid);
+
         if (artist)
         {
-            updateArtistIfNeeded(artist, artistInfo);
+            updateArtistIfNeeded(cache, artist, artistInfo);
         }
         else
         {
@@ -86,22 +109,34 @@ namespace lms::scanner::helpers
                     if (!artistWithSameName->hasMBID())
                     {
                         artist = artistWithSameName;
-                        updateArtistIfNeeded(artist, artistInfo);
+                        updateArtistIfNeeded(cache, artist, artistInfo);
                         break;
                     }
                 }
             }
 
             if (!artist)
-                artist = createArtist(session, artistInfo);
+                artist = createArtist(session, cache, artistInfo);
         }
 
+        cache.artistsByMBID.add(*artistInfo.mbid, artist->getId());
         return artist;
     }
 
-    db::Artist::pointer getOrCreateArtistByName(db::Session& session, const metadata::Artist& artistInfo, AllowFallbackOnMBIDEntry allowFallbackOnMBIDEntries)
+    db::Artist::pointer getOrCreateArtistByName(db::Session& session, ScanCache& cache, const metadata::Artist& artistInfo, AllowFallbackOnMBIDEntry allowFallbackOnMBIDEntries)
     {
-        db::Artist::pointer artist;
+        const std::string_view nameKey{ getNameKey(artistInfo.name) };
+
+        // The cached entry is invalidated as soon as the artists having this name change, so the same artist would be selected below
+        db::Artist::pointer artist{ cache.artistsByName.findObject<db::Artist>(session, nameKey) };
+        if (artist)
+        {
+            // artists with MBID are only selected as a fallback, and are not updated in that case
+            if (!artist->hasMBID())
+                updateArtistIfNeeded(cache, artist, artistInfo);
+
+            return artist;
+        }
 
         // Here we can have only one artist with no MBID, others all have mbids
         const std::vector<db::Artist::pointer> artistsWithSameName{ db::Artist::find(session, artistInfo.name) };
@@ -113,10 +148,10 @@ namespace lms::scanner::helpers
             if (itArtistWithoutMBID != std::end(artistsWithSameName))
             {
                 artist = *itArtistWithoutMBID;
-                updateArtistIfNeeded(artist, artistInfo);
+                updateArtistIfNeeded(cache, artist, artistInfo);
             }
             else
-                artist = createArtist(session, artistInfo);
+                artist = createArtist(session, cache, artistInfo);
         }
         else
         {
@@ -130,22 +165,23 @@ namespace lms::scanner::helpers
             else if (itArtistWithoutMBID != std::end(artistsWithSameName))
             {
                 artist = *itArtistWithoutMBID;
-                updateArtistIfNeeded(artist, artistInfo);
+                updateArtistIfNeeded(cache, artist, artistInfo);
             }
             else
-                artist = createArtist(session, artistInfo);
+                artist = createArtist(session, cache, artistInfo);
         }
 
+        cache.artistsByName.add(std::string{ nameKey }, artist->getId());
         return artist;
     }
 
-    db::Artist::pointer getOrCreateArtist(db::Session& session, const metadata::Artist& artistInfo, AllowFallbackOnMBIDEntry allowFallbackOnMBIDEntries)
+    db::Artist::pointer getOrCreateArtist(db::Session& session, ScanCache& cache, const metadata::Artist& artistInfo, AllowFallbackOnMBIDEntry allowFallbackOnMBIDEntries)
     {
         // First try to get by MBID
         if (artistInfo.mbid)
-            return getOrCreateArtistByMBID(session, artistInfo, allowFallbackOnMBIDEntries);
+            return getOrCreateArtistByMBID(session, cache, artistInfo, allowFallbackOnMBIDEntries);
 
         // Fall back on artist name (collisions may occur)
-        return getOrCreateArtistByName(session, artistInfo, allowFallbackOnMBIDEntries);
+        return getOrCreateArtistByName(session, cache, artistInfo, allowFallbackOnMBIDEntries);
     }
 } // namespace lms::scanner::helpers
\ No newline at end of file
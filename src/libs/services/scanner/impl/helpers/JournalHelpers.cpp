@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "JournalHelpers.hpp"
+
+#include <set>
+
+#include "database/Session.hpp"
+#include "database/objects/Directory.hpp"
+#include "database/objects/Release.hpp"
+
+#include "ScanJournal.hpp"
+
+namespace lms::scanner::helpers
+{
+    std::vector<db::ReleaseId> getReleaseIdsInChangedDirectories(db::Session& session, const ScanJournal& journal)
+    {
+        std::vector<db::DirectoryId> directoryIds;
+        std::set<db::DirectoryId> visitedDirectoryIds;
+
+        auto addDirectory{ [&](db::DirectoryId directoryId) {
+            if (visitedDirectoryIds.insert(directoryId).second)
+                directoryIds.push_back(directoryId);
+        } };
+
+        for (const std::filesystem::path& directoryPath : journal.getChangedDirectories())
+        {
+            if (const db::Directory::pointer directory{ db::Directory::find(session, directoryPath) })
+                addDirectory(directory->getId());
+        }
+
+        // directoryIds grows while iterating: this visits all the subdirectories
+        for (std::size_t i{}; i < directoryIds.size(); ++i)
+        {
+            db::Directory::find(session, db::Directory::FindParameters{}.setParentDirectory(directoryIds[i]), [&](const db::Directory::pointer& directory) {
+                addDirectory(directory->getId());
+            });
+        }
+
+        std::set<db::ReleaseId> releaseIds;
+        for (const db::DirectoryId directoryId : directoryIds)
+        {
+            const auto results{ db::Release::findIds(session, db::Release::FindParameters{}.setDirectory(directoryId)) };
+            releaseIds.insert(std::cbegin(results.results), std::cend(results.results));
+        }
+
+        return std::vector<db::ReleaseId>(std::cbegin(releaseIds), std::cend(releaseIds));
+    }
+} // namespace lms::scanner::helpers
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "database/objects/ReleaseId.hpp"
+
+namespace lms::db
+{
+    class Session;
+}
+
+namespace lms::scanner
+{
+    class ScanJournal;
+} // namespace lms::scanner
+
+namespace lms::scanner::helpers
+{
+    // Releases having tracks in the changed directories or in any of their subdirectories, as files there may be used as release/artist artworks
+    // Must be called within a read transaction
+    std::vector<db::ReleaseId> getReleaseIdsInChangedDirectories(db::Session& session, const ScanJournal& journal);
+} // namespace lms::scanner::helpers
@@ -34,6 +34,7 @@
 #include "services/scanner/ScanErrors.hpp"
 
 #include "FileScanOperationBase.hpp"
+#include "ScanJournal.hpp"
 #include "ScannerSettings.hpp"
 #include "Utils.hpp"
 #include "helpers/ArtistHelpers.hpp"
@@ -53,7 +54,7 @@ namespace lms::scanner
         private:
             core::LiteralString getName() const override { return "ScanArtistInfoFile"; }
             void scan() override;
-            OperationResult processResult() override;
+            OperationResult processResult(ScanJournal& journal, ScanCache& cache) override;
 
             std::string getArtistNameFromArtistInfoFilePath();
 
@@ -85,10 +86,12 @@ namespace lms::scanner
             }
         }
 
-        ArtistInfoFileScanOperation::OperationResult ArtistInfoFileScanOperation::processResult()
+        ArtistInfoFileScanOperation::OperationResult ArtistInfoFileScanOperation::processResult(ScanJournal& journal, ScanCache& cache)
         {
             db::Session& dbSession{ getDb().getTLSSession() };
             db::ArtistInfo::pointer artistInfo{ db::ArtistInfo::find(dbSession, getFilePath()) };
+            if (artistInfo && artistInfo->getArtist())
+                journal.addChangedArtist(artistInfo->getArtist()->getId());
             if (!_parsedArtistInfo)
             {
                 if (artistInfo)
@@ -119,11 +122,12 @@ namespace lms::scanner
             artistInfo.modify()->setBiography(_parsedArtistInfo->biography);
 
             db::MediaLibrary::pointer mediaLibrary{ db::MediaLibrary::find(dbSession, getMediaLibrary().id) }; // may be null if settings are updated in // => next scan will correct this
-            artistInfo.modify()->setDirectory(utils::getOrCreateDirectory(dbSession, getFilePath().parent_path(), mediaLibrary));
+            artistInfo.modify()->setDirectory(utils::getOrCreateDirectory(dbSession, cache, getFilePath().parent_path(), mediaLibrary));
 
             const metadata::Artist artistMetadata{ _parsedArtistInfo->mbid, _parsedArtistInfo->name, _parsedArtistInfo->sortName.empty() ? std::nullopt : std::make_optional<std::string>(_parsedArtistInfo->sortName) };
-            db::Artist::pointer artist{ helpers::getOrCreateArtist(dbSession, artistMetadata, helpers::AllowFallbackOnMBIDEntry{ getScannerSettings().allowArtistMBIDFallback }) };
+            db::Artist::pointer artist{ helpers::getOrCreateArtist(dbSession, cache, artistMetadata, helpers::AllowFallbackOnMBIDEntry{ getScannerSettings().allowArtistMBIDFallback }) };
             artistInfo.modify()->setArtist(artist);
+            journal.addChangedArtist(artist->getId());
             artistInfo.modify()->setMBIDMatched(_parsedArtistInfo->mbid.has_value() && _parsedArtistInfo->mbid == artist->getMBID());
 
             if (added)
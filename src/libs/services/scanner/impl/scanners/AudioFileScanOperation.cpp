@@ -47,6 +47,8 @@
 #include "services/scanner/ScanErrors.hpp"
 
 #include "IFileScanOperation.hpp"
+#include "ScanCache.hpp"
+#include "ScanJournal.hpp"
 #include "ScannerSettings.hpp"
 #include "Utils.hpp"
 #include "helpers/ArtistHelpers.hpp"
@@ -55,11 +57,11 @@ namespace lms::scanner
 {
     namespace
     {
-        void createTrackArtistLinks(db::Session& session, const db::Track::pointer& track, db::TrackArtistLinkType linkType, std::string_view role, std::span<const metadata::Artist> artists, helpers::AllowFallbackOnMBIDEntry allowArtistMBIDFallback)
+        void createTrackArtistLinks(db::Session& session, ScanCache& cache, const db::Track::pointer& track, db::TrackArtistLinkType linkType, std::string_view role, std::span<const metadata::Artist> artists, helpers::AllowFallbackOnMBIDEntry allowArtistMBIDFallback)
         {
             for (const metadata::Artist& artistInfo : artists)
             {
-                db::Artist::pointer artist{ helpers::getOrCreateArtist(session, artistInfo, allowArtistMBIDFallback) };
+                db::Artist::pointer artist{ helpers::getOrCreateArtist(session, cache, artistInfo, allowArtistMBIDFallback) };
 
                 const bool matchedUsingMbid{ artistInfo.mbid.has_value() && artist->getMBID() == artistInfo.mbid };
                 db::TrackArtistLink::pointer link{ session.create<db::TrackArtistLink>(track, artist, linkType, role, matchedUsingMbid) };
@@ -69,40 +71,29 @@ namespace lms::scanner
             }
         }
 
-        void createTrackArtistLinks(db::Session& session, const db::Track::pointer& track, db::TrackArtistLinkType linkType, std::span<const metadata::Artist> artists, helpers::AllowFallbackOnMBIDEntry allowArtistMBIDFallback)
+        void createTrackArtistLinks(db::Session& session, ScanCache& cache, const db::Track::pointer& track, db::TrackArtistLinkType linkType, std::span<const metadata::Artist> artists, helpers::AllowFallbackOnMBIDEntry allowArtistMBIDFallback)
         {
             constexpr std::string_view noRole{};
-            createTrackArtistLinks(session, track, linkType, noRole, artists, allowArtistMBIDFallback);
+            createTrackArtistLinks(session, cache, track, linkType, noRole, artists, allowArtistMBIDFallback);
         }
 
-        db::ReleaseType::pointer getOrCreateReleaseType(db::Session& session, std::string_view name)
+        // For objects only identified by their name (cluster types, countries, labels, release types)
+        template<typename Object, typename IdType>
+        typename Object::pointer getOrCreateByName(db::Session& session, ScanCache::Map<std::string, IdType>& cachedIds, std::string_view name)
         {
-            db::ReleaseType::pointer releaseType{ db::ReleaseType::find(session, name) };
-            if (!releaseType)
-                releaseType = session.create<db::ReleaseType>(name);
+            typename Object::pointer object{ cachedIds.template findObject<Object>(session, name) };
+            if (object)
+                return object;
 
-            return releaseType;
-        }
-
-        db::Country::pointer getOrCreateCountry(db::Session& session, std::string_view name)
-        {
-            db::Country::pointer country{ db::Country::find(session, name) };
-            if (!country)
-                country = session.create<db::Country>(name);
+            object = Object::find(session, name);
+            if (!object)
+                object = session.create<Object>(name);
 
-            return country;
+            cachedIds.add(std::string{ name }, object->getId());
+            return object;
         }
 
-        db::Label::pointer getOrCreateLabel(db::Session& session, std::string_view name)
-        {
-            db::Label::pointer label{ db::Label::find(session, name) };
-            if (!label)
-                label = session.create<db::Label>(name);
-
-            return label;
-        }
-
-        void updateReleaseIfNeeded(db::Session& session, db::Release::pointer release, const metadata::Release& releaseInfo)
+        void updateReleaseIfNeeded(db::Session& session, ScanCache& cache, db::Release::pointer release, const metadata::Release& releaseInfo)
         {
             if (release->getName() != releaseInfo.name)
                 release.modify()->setName(releaseInfo.name);
@@ -124,19 +115,19 @@ namespace lms::scanner
             {
                 release.modify()->clearReleaseTypes();
                 for (std::string_view releaseType : releaseInfo.releaseTypes)
-                    release.modify()->addReleaseType(getOrCreateReleaseType(session, releaseType));
+                    release.modify()->addReleaseType(getOrCreateByName<db::ReleaseType>(session, cache.releaseTypes, releaseType));
             }
             if (release->getCountryNames() != releaseInfo.countries)
             {
                 release.modify()->clearCountries();
                 for (std::string_view country : releaseInfo.countries)
-                    release.modify()->addCountry(getOrCreateCountry(session, country));
+                    release.modify()->addCountry(getOrCreateByName<db::Country>(session, cache.countries, country));
             }
             if (release->getLabelNames() != releaseInfo.labels)
             {
                 release.modify()->clearLabels();
                 for (std::string_view label : releaseInfo.labels)
-                    release.modify()->addLabel(getOrCreateLabel(session, label));
+                    release.modify()->addLabel(getOrCreateByName<db::Label>(session, cache.labels, label));
             }
         }
 
@@ -152,7 +143,7 @@ namespace lms::scanner
                 && candidateRelease->getBarcode() == releaseInfo.barcode;
         }
 
-        db::Release::pointer getOrCreateRelease(db::Session& session, const metadata::Release& releaseInfo, const db::Directory::pointer& currentDirectory)
+        db::Release::pointer getOrCreateRelease(db::Session& session, ScanCache& cache, const metadata::Release& releaseInfo, const db::Directory::pointer& currentDirectory)
         {
             db::Release::pointer release;
 
@@ -219,7 +210,7 @@ namespace lms::scanner
             if (!release)
                 release = session.create<db::Release>(releaseInfo.name);
 
-            updateReleaseIfNeeded(session, release, releaseInfo);
+            updateReleaseIfNeeded(session, cache, release, releaseInfo);
             return release;
         }
 
@@ -243,20 +234,25 @@ namespace lms::scanner
             return dbMedium;
         }
 
-        std::vector<db::Cluster::pointer> getOrCreateClusters(db::Session& session, const metadata::Track& track)
+        std::vector<db::Cluster::pointer> getOrCreateClusters(db::Session& session, ScanCache& cache, const metadata::Track& track)
         {
             std::vector<db::Cluster::pointer> clusters;
 
             auto getOrCreateClusters{ [&](std::string_view tag, std::span<const std::string> values) {
-                auto clusterType = db::ClusterType::find(session, tag);
-                if (!clusterType)
-                    clusterType = session.create<db::ClusterType>(tag);
+                const db::ClusterType::pointer clusterType{ getOrCreateByName<db::ClusterType>(session, cache.clusterTypes, tag) };
 
                 for (const auto& value : values)
                 {
-                    auto cluster{ clusterType->getCluster(value) };
+                    std::pair<db::ClusterTypeId, std::string> cacheKey{ clusterType->getId(), value };
+                    db::Cluster::pointer cluster{ cache.clusters.findObject<db::Cluster>(session, cacheKey) };
                     if (!cluster)
-                        cluster = session.create<db::Cluster>(clusterType, value);
+                    {
+                        cluster = clusterType->getCluster(value);
+                        if (!cluster)
+                            cluster = session.create<db::Cluster>(clusterType, value);
+
+                        cache.clusters.add(cacheKey, cluster->getId());
+                    }
 
                     clusters.push_back(cluster);
                 }
@@ -499,13 +495,8 @@ namespace lms::scanner
 
         try
         {
-            _parsedTrack = _parser.parseMetaData(getFilePath());
-
-            // We fill missing artist mbids with mbids found on other artist roles
-            fillMissingMbids(*_parsedTrack);
-
             std::size_t index{};
-            _parser.parseImages(getFilePath(), [&](const metadata::Image& image) {
+            _parsedTrack = _parser.parseMetaDataAndImages(getFilePath(), [&](const metadata::Image& image) {
                 try
                 {
                     image::ImageProperties properties{ image::probeImage(image.data) };
@@ -531,6 +522,9 @@ namespace lms::scanner
 
                 index++;
             });
+
+            // We fill missing artist mbids with mbids found on other artist roles
+            fillMissingMbids(*_parsedTrack);
         }
         catch (const metadata::AudioFileNoAudioPropertiesException&)
         {
@@ -546,12 +540,15 @@ namespace lms::scanner
         }
     }
 
-    AudioFileScanOperation::OperationResult AudioFileScanOperation::processResult()
+    AudioFileScanOperation::OperationResult AudioFileScanOperation::processResult(ScanJournal& journal, ScanCache& cache)
     {
         LMS_SCOPED_TRACE_DETAILED("Scanner", "ProcessAudioScanData");
 
         db::Session& dbSession{ getDb().getTLSSession() };
         db::Track::pointer track{ db::Track::findByPath(dbSession, getFilePath()) };
+        if (track)
+            journal.addChangedTrack(track);
+
         if (!_parsedTrack)
         {
             if (track)
@@ -575,6 +572,8 @@ namespace lms::scanner
                 {
                     LMS_LOG(DBUPDATER, DEBUG, "Considering track " << getFilePath() << " moved from " << otherTrack->getAbsoluteFilePath());
                     track = otherTrack;
+                    journal.addChangedDirectory(track->getAbsoluteFilePath().parent_path());
+                    journal.addChangedTrack(track);
                     track.modify()->setAbsoluteFilePath(getFilePath());
                 }
             }
@@ -620,6 +619,8 @@ namespace lms::scanner
             if (track)
             {
                 LMS_LOG(DBUPDATER, DEBUG, "Considering track " << getFilePath() << " moved from " << track->getAbsoluteFilePath());
+                journal.addChangedDirectory(track->getAbsoluteFilePath().parent_path());
+                journal.addChangedTrack(track);
                 track.modify()->setAbsoluteFilePath(getFilePath());
             }
         }
@@ -690,30 +691,30 @@ namespace lms::scanner
 
         db::MediaLibrary::pointer mediaLibrary{ db::MediaLibrary::find(dbSession, getMediaLibrary().id) }; // may be null if settings are updated in // => next scan will correct this
         track.modify()->setMediaLibrary(mediaLibrary);
-        db::Directory::pointer directory{ utils::getOrCreateDirectory(dbSession, getFilePath().parent_path(), mediaLibrary) };
+        db::Directory::pointer directory{ utils::getOrCreateDirectory(dbSession, cache, getFilePath().parent_path(), mediaLibrary) };
         track.modify()->setDirectory(directory);
 
         track.modify()->clearArtistLinks();
 
         const helpers::AllowFallbackOnMBIDEntry allowFallback{ getScannerSettings().allowArtistMBIDFallback };
-        createTrackArtistLinks(dbSession, track, db::TrackArtistLinkType::Artist, _parsedTrack->artists, allowFallback);
+        createTrackArtistLinks(dbSession, cache, track, db::TrackArtistLinkType::Artist, _parsedTrack->artists, allowFallback);
         if (_parsedTrack->medium && _parsedTrack->medium->release)
-            createTrackArtistLinks(dbSession, track, db::TrackArtistLinkType::ReleaseArtist, _parsedTrack->medium->release->artists, allowFallback);
+            createTrackArtistLinks(dbSession, cache, track, db::TrackArtistLinkType::ReleaseArtist, _parsedTrack->medium->release->artists, allowFallback);
 
-        createTrackArtistLinks(dbSession, track, db::TrackArtistLinkType::Conductor, _parsedTrack->conductorArtists, allowFallback);
-        createTrackArtistLinks(dbSession, track, db::TrackArtistLinkType::Composer, _parsedTrack->composerArtists, allowFallback);
-        createTrackArtistLinks(dbSession, track, db::TrackArtistLinkType::Lyricist, _parsedTrack->lyricistArtists, allowFallback);
-        createTrackArtistLinks(dbSession, track, db::TrackArtistLinkType::Mixer, _parsedTrack->mixerArtists, allowFallback);
-        createTrackArtistLinks(dbSession, track, db::TrackArtistLinkType::Producer, _parsedTrack->producerArtists, allowFallback);
-        createTrackArtistLinks(dbSession, track, db::TrackArtistLinkType::Remixer, _parsedTrack->remixerArtists, allowFallback);
+        createTrackArtistLinks(dbSession, cache, track, db::TrackArtistLinkType::Conductor, _parsedTrack->conductorArtists, allowFallback);
+        createTrackArtistLinks(dbSession, cache, track, db::TrackArtistLinkType::Composer, _parsedTrack->composerArtists, allowFallback);
+        createTrackArtistLinks(dbSession, cache, track, db::TrackArtistLinkType::Lyricist, _parsedTrack->lyricistArtists, allowFallback);
+        createTrackArtistLinks(dbSession, cache, track, db::TrackArtistLinkType::Mixer, _parsedTrack->mixerArtists, allowFallback);
+        createTrackArtistLinks(dbSession, cache, track, db::TrackArtistLinkType::Producer, _parsedTrack->producerArtists, allowFallback);
+        createTrackArtistLinks(dbSession, cache, track, db::TrackArtistLinkType::Remixer, _parsedTrack->remixerArtists, allowFallback);
 
         for (const auto& [role, performers] : _parsedTrack->performerArtists)
-            createTrackArtistLinks(dbSession, track, db::TrackArtistLinkType::Performer, role, performers, allowFallback);
+            createTrackArtistLinks(dbSession, cache, track, db::TrackArtistLinkType::Performer, role, performers, allowFallback);
 
         // For now, alway tie a medium to a release, and a release mst have at least one medium, even if no disc number is set
         if (_parsedTrack->medium && _parsedTrack->medium->release)
         {
-            db::Release::pointer release{ getOrCreateRelease(dbSession, *_parsedTrack->medium->release, directory) };
+            db::Release::pointer release{ getOrCreateRelease(dbSession, cache, *_parsedTrack->medium->release, directory) };
             assert(release);
             track.modify()->setRelease(release);
             track.modify()->setMedium(getOrCreateMedium(dbSession, *_parsedTrack->medium, release));
@@ -723,7 +724,7 @@ namespace lms::scanner
             track.modify()->setRelease({});
             track.modify()->setMedium({});
         }
-        track.modify()->setClusters(getOrCreateClusters(dbSession, *_parsedTrack));
+        track.modify()->setClusters(getOrCreateClusters(dbSession, cache, *_parsedTrack));
         track.modify()->setName(title);
         track.modify()->setTrackNumber(_parsedTrack->position);
         track.modify()->setDate(_parsedTrack->date);
@@ -751,6 +752,7 @@ namespace lms::scanner
             track.modify()->addLyrics(createLyrics(dbSession, lyricsInfo));
 
         updateEmbeddedImages(dbSession, track, _parsedImages);
+        journal.addChangedTrack(track);
 
         if (added)
         {
@@ -64,7 +64,7 @@ namespace lms::scanner
     private:
         core::LiteralString getName() const override { return "ScanAudioFile"; }
         void scan() override;
-        OperationResult processResult() override;
+        OperationResult processResult(ScanJournal& journal, ScanCache& cache) override;
 
         metadata::IAudioFileParser& _parser;
         std::unique_ptr<metadata::Track> _parsedTrack;
@@ -27,7 +27,9 @@
 
 namespace lms::scanner
 {
+    class ScanCache;
     struct ScanError;
+    class ScanJournal;
 
     class IFileScanOperation
     {
@@ -49,7 +51,9 @@ namespace lms::scanner
             Updated,
             Skipped,
         };
-        virtual OperationResult processResult() = 0;
+        // Changes that cannot be deduced from the file path and the result (moved files, etc.) are recorded in the journal
+        // The cache is used to resolve the db objects shared by the scanned files (artists, clusters, directories, etc.)
+        virtual OperationResult processResult(ScanJournal& journal, ScanCache& cache) = 0;
 
         using ScanErrorVector = std::vector<std::shared_ptr<ScanError>>;
         // list of errors collected during scan/result processing (there might be errors without skipping the file)
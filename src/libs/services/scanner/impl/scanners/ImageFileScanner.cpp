@@ -34,6 +34,7 @@
 
 #include "FileScanOperationBase.hpp"
 #include "IFileScanOperation.hpp"
+#include "ScanJournal.hpp"
 #include "Utils.hpp"
 
 namespace lms::scanner
@@ -48,7 +49,7 @@ namespace lms::scanner
         private:
             core::LiteralString getName() const override { return "ScanImageFile"; }
             void scan() override;
-            OperationResult processResult() override;
+            OperationResult processResult(ScanJournal& journal, ScanCache& cache) override;
 
             std::optional<image::ImageProperties> _parsedImageProperties;
         };
@@ -66,10 +67,11 @@ namespace lms::scanner
             }
         }
 
-        ImageFileScanOperation::OperationResult ImageFileScanOperation::processResult()
+        ImageFileScanOperation::OperationResult ImageFileScanOperation::processResult(ScanJournal& journal, ScanCache& cache)
         {
             db::Session& dbSession{ getDb().getTLSSession() };
             db::Image::pointer image{ db::Image::find(dbSession, getFilePath()) };
+            journal.addChangedImage(getFilePath());
 
             if (!_parsedImageProperties)
             {
@@ -96,7 +98,7 @@ namespace lms::scanner
             image.modify()->setHeight(_parsedImageProperties->height);
             image.modify()->setWidth(_parsedImageProperties->width);
             db::MediaLibrary::pointer mediaLibrary{ db::MediaLibrary::find(dbSession, getMediaLibrary().id) }; // may be null if settings are updated in // => next scan will correct this
-            image.modify()->setDirectory(utils::getOrCreateDirectory(dbSession, getFilePath().parent_path(), mediaLibrary));
+            image.modify()->setDirectory(utils::getOrCreateDirectory(dbSession, cache, getFilePath().parent_path(), mediaLibrary));
 
             if (added)
             {
@@ -46,7 +46,7 @@ namespace lms::scanner
         private:
             core::LiteralString getName() const override { return "ScanLyricsFile"; }
             void scan() override;
-            OperationResult processResult() override;
+            OperationResult processResult(ScanJournal& journal, ScanCache& cache) override;
 
             std::optional<metadata::Lyrics> _parsedLyrics;
         };
@@ -72,7 +72,7 @@ namespace lms::scanner
             }
         }
 
-        LyricsFileScanOperation::OperationResult LyricsFileScanOperation::processResult()
+        LyricsFileScanOperation::OperationResult LyricsFileScanOperation::processResult([[maybe_unused]] ScanJournal& journal, ScanCache& cache)
         {
             db::Session& dbSession{ getDb().getTLSSession() };
             db::TrackLyrics::pointer trackLyrics{ db::TrackLyrics::find(dbSession, getFilePath()) };
@@ -109,7 +109,7 @@ namespace lms::scanner
                 trackLyrics.modify()->setUnsynchronizedLines(_parsedLyrics->unsynchronizedLines);
 
             db::MediaLibrary::pointer mediaLibrary{ db::MediaLibrary::find(dbSession, getMediaLibrary().id) }; // may be null if settings are updated in // => next scan will correct this
-            trackLyrics.modify()->setDirectory(utils::getOrCreateDirectory(dbSession, getFilePath().parent_path(), mediaLibrary));
+            trackLyrics.modify()->setDirectory(utils::getOrCreateDirectory(dbSession, cache, getFilePath().parent_path(), mediaLibrary));
 
             if (added)
             {
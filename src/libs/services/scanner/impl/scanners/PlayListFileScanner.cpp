@@ -49,7 +49,7 @@ namespace lms::scanner
         private:
             core::LiteralString getName() const override { return "ScanPlayListFile"; }
             void scan() override;
-            OperationResult processResult() override;
+            OperationResult processResult(ScanJournal& journal, ScanCache& cache) override;
 
             std::optional<metadata::PlayList> _parsedPlayList;
         };
@@ -75,7 +75,7 @@ namespace lms::scanner
             }
         }
 
-        PlayListFileScanOperation::OperationResult PlayListFileScanOperation::processResult()
+        PlayListFileScanOperation::OperationResult PlayListFileScanOperation::processResult([[maybe_unused]] ScanJournal& journal, ScanCache& cache)
         {
             db::Session& dbSession{ getDb().getTLSSession() };
             db::PlayListFile::pointer playList{ db::PlayListFile::find(dbSession, getFilePath()) };
@@ -106,7 +106,7 @@ namespace lms::scanner
             playList.modify()->setFiles(_parsedPlayList->files);
 
             db::MediaLibrary::pointer mediaLibrary{ db::MediaLibrary::find(dbSession, getMediaLibrary().id) }; // may be null if settings are updated in // => next scan will correct this
-            playList.modify()->setDirectory(utils::getOrCreateDirectory(dbSession, getFilePath().parent_path(), mediaLibrary));
+            playList.modify()->setDirectory(utils::getOrCreateDirectory(dbSession, cache, getFilePath().parent_path(), mediaLibrary));
 
             if (added)
             {
@@ -26,16 +26,22 @@
 #include "database/objects/Directory.hpp"
 #include "database/objects/MediaLibrary.hpp"
 
+#include "ScanCache.hpp"
+
 namespace lms::scanner::utils
 {
-    db::Directory::pointer getOrCreateDirectory(db::Session& session, const std::filesystem::path& path, const db::MediaLibrary::pointer& mediaLibrary)
+    db::Directory::pointer getOrCreateDirectory(db::Session& session, ScanCache& cache, const std::filesystem::path& path, const db::MediaLibrary::pointer& mediaLibrary)
     {
-        db::Directory::pointer directory{ db::Directory::find(session, path) };
+        db::Directory::pointer directory{ cache.directories.findObject<db::Directory>(session, path) };
+        if (directory)
+            return directory;
+
+        directory = db::Directory::find(session, path);
         if (!directory)
         {
             db::Directory::pointer parentDirectory;
             if (path != mediaLibrary->getPath())
-                parentDirectory = getOrCreateDirectory(session, path.parent_path(), mediaLibrary);
+                parentDirectory = getOrCreateDirectory(session, cache, path.parent_path(), mediaLibrary);
 
             directory = session.create<db::Directory>(path);
             directory.modify()->setParent(parentDirectory);
@@ -43,6 +49,7 @@ namespace lms::scanner::utils
         }
         // Don't update library if it does not match, will be updated elsewhere
 
+        cache.directories.add(path, directory->getId());
         return directory;
     }
 } // namespace lms::scanner::utils
\ No newline at end of file
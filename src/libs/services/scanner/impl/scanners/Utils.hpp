@@ -30,7 +30,12 @@ namespace lms::db
     class Session;
 } // namespace lms::db
 
+namespace lms::scanner
+{
+    class ScanCache;
+} // namespace lms::scanner
+
 namespace lms::scanner::utils
 {
-    db::ObjectPtr<db::Directory> getOrCreateDirectory(db::Session& session, const std::filesystem::path& path, const db::ObjectPtr<db::MediaLibrary>& mediaLibrary);
+    db::ObjectPtr<db::Directory> getOrCreateDirectory(db::Session& session, ScanCache& cache, const std::filesystem::path& path, const db::ObjectPtr<db::MediaLibrary>& mediaLibrary);
 } // namespace lms::scanner::utils
\ No newline at end of file
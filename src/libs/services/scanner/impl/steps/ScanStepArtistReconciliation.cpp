@@ -33,6 +33,7 @@
 #include "metadata/Types.hpp"
 
 #include "ScanContext.hpp"
+#include "ScanJournal.hpp"
 #include "ScannerSettings.hpp"
 #include "helpers/ArtistHelpers.hpp"
 
@@ -49,28 +50,33 @@ namespace lms::scanner
             return os;
         }
 
-        void recomputeArtist(db::Session& session, db::TrackArtistLink::pointer link, bool allowArtistMBIDFallback)
+        void recomputeArtist(db::Session& session, ScanCache& cache, ScanJournal& journal, db::TrackArtistLink::pointer link, bool allowArtistMBIDFallback)
         {
             assert(!link->isArtistMBIDMatched());
 
             metadata::Artist artistInfo{ std::nullopt, link->getArtistName(), link->getArtistSortName().empty() ? std::nullopt : std::make_optional<std::string>(link->getArtistSortName()) };
 
-            db::Artist::pointer newArtist{ helpers::getOrCreateArtistByName(session, artistInfo, helpers::AllowFallbackOnMBIDEntry{ allowArtistMBIDFallback }) };
+            db::Artist::pointer newArtist{ helpers::getOrCreateArtistByName(session, cache, artistInfo, helpers::AllowFallbackOnMBIDEntry{ allowArtistMBIDFallback }) };
             LMS_LOG(DB, DEBUG, "Reconcile artist link for track " << link->getTrack()->getAbsoluteFilePath() << ", type " << static_cast<int>(link->getType()) << " from " << link->getArtist() << " to " << newArtist);
 
             assert(newArtist != link->getArtist());
+            journal.addChangedArtist(link->getArtist()->getId());
+            journal.addChangedArtist(newArtist->getId());
             link.modify()->setArtist(newArtist);
         }
 
-        void recomputeArtist(db::Session& session, db::ArtistInfo::pointer artistInfo, bool allowArtistMBIDFallback)
+        void recomputeArtist(db::Session& session, ScanCache& cache, ScanJournal& journal, db::ArtistInfo::pointer artistInfo, bool allowArtistMBIDFallback)
         {
             assert(!artistInfo->isMBIDMatched());
 
             const metadata::Artist artistMetadata{ std::nullopt, artistInfo->getName(), artistInfo->getSortName().empty() ? std::nullopt : std::make_optional<std::string>(artistInfo->getSortName()) };
-            db::Artist::pointer newArtist{ helpers::getOrCreateArtistByName(session, artistMetadata, helpers::AllowFallbackOnMBIDEntry{ allowArtistMBIDFallback }) };
+            db::Artist::pointer newArtist{ helpers::getOrCreateArtistByName(session, cache, artistMetadata, helpers::AllowFallbackOnMBIDEntry{ allowArtistMBIDFallback }) };
             LMS_LOG(DB, DEBUG, "Reconcile artist link for artist info " << artistInfo->getAbsoluteFilePath() << " from " << artistInfo->getArtist() << " to " << newArtist);
 
             assert(newArtist != artistInfo->getArtist());
+            if (artistInfo->getArtist())
+                journal.addChangedArtist(artistInfo->getArtist()->getId());
+            journal.addChangedArtist(newArtist->getId());
             artistInfo.modify()->setArtist(newArtist);
         }
     } // namespace
@@ -123,12 +129,13 @@ namespace lms::scanner
                 auto transaction{ session.createWriteTransaction() };
                 for (db::ArtistInfo::pointer& info : artistInfo)
                 {
-                    recomputeArtist(session, info, allowArtistMBIDFallback);
+                    recomputeArtist(session, context.cache, context.journal, info, allowArtistMBIDFallback);
                     context.currentStepStats.processedElems++;
                 }
 
                 _progressCallback(context.currentStepStats);
             }
+            context.cache.commit();
         }
     }
 
@@ -157,12 +164,13 @@ namespace lms::scanner
                 auto transaction{ session.createWriteTransaction() };
                 for (db::ArtistInfo::pointer& info : artistInfo)
                 {
-                    recomputeArtist(session, info, allowArtistMBIDFallback);
+                    recomputeArtist(session, context.cache, context.journal, info, allowArtistMBIDFallback);
                     context.currentStepStats.processedElems++;
                 }
 
                 _progressCallback(context.currentStepStats);
             }
+            context.cache.commit();
         }
     }
     void ScanStepArtistReconciliation::updateLinksForArtistNameNoLongerMatch(ScanContext& context)
@@ -190,12 +198,13 @@ namespace lms::scanner
                 auto transaction{ session.createWriteTransaction() };
                 for (db::TrackArtistLink::pointer& link : links)
                 {
-                    recomputeArtist(session, link, allowArtistMBIDFallback);
+                    recomputeArtist(session, context.cache, context.journal, link, allowArtistMBIDFallback);
                     context.currentStepStats.processedElems++;
                 }
 
                 _progressCallback(context.currentStepStats);
             }
+            context.cache.commit();
         }
     }
 
@@ -224,12 +233,13 @@ namespace lms::scanner
                 auto transaction{ session.createWriteTransaction() };
                 for (db::TrackArtistLink::pointer& link : links)
                 {
-                    recomputeArtist(session, link, allowArtistMBIDFallback);
+                    recomputeArtist(session, context.cache, context.journal, link, allowArtistMBIDFallback);
                     context.currentStepStats.processedElems++;
                 }
 
                 _progressCallback(context.currentStepStats);
             }
+            context.cache.commit();
         }
     }
 } // namespace lms::scanner
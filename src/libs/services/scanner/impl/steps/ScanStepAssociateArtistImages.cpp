@@ -19,11 +19,13 @@
 
 #include "ScanStepAssociateArtistImages.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <deque>
 #include <set>
 #include <span>
+#include <vector>
 
 #include "core/IConfig.hpp"
 #include "core/IJob.hpp"
@@ -43,7 +45,9 @@
 
 #include "JobQueue.hpp"
 #include "ScanContext.hpp"
+#include "ScanJournal.hpp"
 #include "ScannerSettings.hpp"
+#include "helpers/JournalHelpers.hpp"
 
 namespace lms::scanner
 {
@@ -227,9 +231,9 @@ namespace lms::scanner
 
         void updateArtistPreferredArtworks(db::Session& session, ArtistArtworkAssociationContainer& imageAssociations, bool forceFullBatch)
         {
-            constexpr std::size_t writeBatchSize{ 50 };
+            constexpr std::size_t writeBatchSize{ 500 };
 
-            while ((forceFullBatch && imageAssociations.size() >= writeBatchSize) || !imageAssociations.empty())
+            while (forceFullBatch ? imageAssociations.size() >= writeBatchSize : !imageAssociations.empty())
             {
                 auto transaction{ session.createWriteTransaction() };
 
@@ -267,6 +271,48 @@ namespace lms::scanner
             return res;
         }
 
+        // Artists whose artwork may have changed: artists whose tracks, links or artist info have changed, release artists of releases having files in changed directories
+        // or whose artwork has changed, artists having artist info files in changed directories, and artists named after changed image files
+        std::vector<db::ArtistId> getArtistIdsToCheck(db::Session& session, const ScanJournal& journal)
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            std::vector<db::ArtistId> artistIds(std::cbegin(journal.getChangedArtists()), std::cend(journal.getChangedArtists()));
+
+            auto addReleaseArtistIds{ [&](db::ReleaseId releaseId) {
+                const auto results{ db::Artist::findIds(session, db::Artist::FindParameters{}.setRelease(releaseId).setLinkType(db::TrackArtistLinkType::ReleaseArtist)) };
+                artistIds.insert(std::end(artistIds), std::cbegin(results.results), std::cend(results.results));
+            } };
+
+            for (const db::ReleaseId releaseId : helpers::getReleaseIdsInChangedDirectories(session, journal))
+                addReleaseArtistIds(releaseId);
+
+            for (const db::ReleaseId releaseId : journal.getReleasesWithChangedArtwork())
+                addReleaseArtistIds(releaseId);
+
+            for (const std::filesystem::path& directoryPath : journal.getChangedDirectories())
+            {
+                if (const db::Directory::pointer directory{ db::Directory::find(session, directoryPath) })
+                {
+                    db::ArtistInfo::find(session, directory->getId(), [&](const db::ArtistInfo::pointer& artistInfo) {
+                        if (artistInfo->getArtist())
+                            artistIds.push_back(artistInfo->getArtist()->getId());
+                    });
+                }
+            }
+
+            for (const core::UUID& mbid : journal.getChangedImageMBIDs())
+            {
+                if (const db::Artist::pointer artist{ db::Artist::find(session, mbid) })
+                    artistIds.push_back(artist->getId());
+            }
+
+            std::sort(std::begin(artistIds), std::end(artistIds));
+            artistIds.erase(std::unique(std::begin(artistIds), std::end(artistIds)), std::end(artistIds));
+
+            return artistIds;
+        }
+
         bool fetchNextArtistIdRange(db::Session& session, db::ArtistId& lastRetrievedId, db::IdRange<db::ArtistId>& idRange)
         {
             constexpr std::size_t readBatchSize{ 100 };
@@ -288,6 +334,13 @@ namespace lms::scanner
                 , _artistIdRange{ artistIdRange }
             {
             }
+
+            ComputeArtistArtworkAssociationsJob(db::IDb& db, const SearchArtistArtworkParams& searchParams, std::span<const db::ArtistId> artistIds)
+                : _db{ db }
+                , _searchParams{ searchParams }
+                , _artistIds{ std::cbegin(artistIds), std::cend(artistIds) }
+            {
+            }
             ~ComputeArtistArtworkAssociationsJob() override = default;
             ComputeArtistArtworkAssociationsJob(const ComputeArtistArtworkAssociationsJob&) = delete;
             ComputeArtistArtworkAssociationsJob& operator=(const ComputeArtistArtworkAssociationsJob&) = delete;
@@ -302,7 +355,7 @@ namespace lms::scanner
                 auto& session{ _db.getTLSSession() };
                 auto transaction{ session.createReadTransaction() };
 
-                db::Artist::find(session, _artistIdRange, [this, &session](const db::Artist::pointer& artist) {
+                auto processArtist{ [this, &session](const db::Artist::pointer& artist) {
                     const db::Artwork::pointer preferredArtwork{ computePreferredArtistArtwork(session, _searchParams, artist) };
 
                     if (artist->getPreferredArtwork() != preferredArtwork)
@@ -316,12 +369,26 @@ namespace lms::scanner
                     }
 
                     _processedArtistCount++;
-                });
+                } };
+
+                if (_artistIdRange.isValid())
+                {
+                    db::Artist::find(session, _artistIdRange, processArtist);
+                }
+                else
+                {
+                    for (const db::ArtistId artistId : _artistIds)
+                    {
+                        if (const db::Artist::pointer artist{ db::Artist::find(session, artistId) })
+                            processArtist(artist);
+                    }
+                }
             }
 
             db::IDb& _db;
             const SearchArtistArtworkParams& _searchParams;
             db::IdRange<db::ArtistId> _artistIdRange;
+            std::vector<db::ArtistId> _artistIds;
             std::vector<ArtistArtworkAssociation> _associations;
             std::size_t _processedArtistCount{};
         };
@@ -350,6 +417,16 @@ namespace lms::scanner
     {
         auto& session{ _db.getTLSSession() };
 
+        // The release fallback setting affects all the artists
+        const bool processAllArtists{ !context.journal.isComplete() || (getLastScanSettings() && getLastScanSettings()->artistImageFallbackToRelease != _settings.artistImageFallbackToRelease) };
+
+        std::vector<db::ArtistId> artistIdsToCheck;
+        if (!processAllArtists)
+        {
+            artistIdsToCheck = getArtistIdsToCheck(session, context.journal);
+            context.currentStepStats.totalElems = artistIdsToCheck.size();
+        }
+        else
         {
             auto transaction{ session.createReadTransaction() };
             context.currentStepStats.totalElems = db::Artist::getCount(session);
@@ -383,10 +460,20 @@ namespace lms::scanner
         {
             JobQueue queue{ getJobScheduler(), 20, processJobsDone, 1, 0.85F };
 
-            db::ArtistId lastRetrievedArtistId{};
-            db::IdRange<db::ArtistId> artistIdRange;
-            while (fetchNextArtistIdRange(session, lastRetrievedArtistId, artistIdRange))
-                queue.push(std::make_unique<ComputeArtistArtworkAssociationsJob>(_db, searchParams, artistIdRange));
+            if (!processAllArtists)
+            {
+                constexpr std::size_t artistsPerJob{ 100 };
+
+                for (std::size_t offset{}; offset < artistIdsToCheck.size(); offset += artistsPerJob)
+                    queue.push(std::make_unique<ComputeArtistArtworkAssociationsJob>(_db, searchParams, std::span{ artistIdsToCheck }.subspan(offset, std::min(artistsPerJob, artistIdsToCheck.size() - offset))));
+            }
+            else
+            {
+                db::ArtistId lastRetrievedArtistId{};
+                db::IdRange<db::ArtistId> artistIdRange;
+                while (fetchNextArtistIdRange(session, lastRetrievedArtistId, artistIdRange))
+                    queue.push(std::make_unique<ComputeArtistArtworkAssociationsJob>(_db, searchParams, artistIdRange));
+            }
         }
 
         // process all remaining associations
@@ -20,6 +20,7 @@
 #include "ScanStepAssociateExternalLyrics.hpp"
 
 #include <deque>
+#include <filesystem>
 
 #include "core/ILogger.hpp"
 #include "database/IDb.hpp"
@@ -82,6 +83,38 @@ namespace lms::scanner
             return matchingTrack;
         }
 
+        void checkTrackLyricsAssociation(db::Session& session, const db::TrackLyrics::pointer& trackLyrics, TrackLyricsAssociationContainer& trackLyricsAssociations)
+        {
+            db::Track::pointer track{ getMatchingTrack(session, trackLyrics) };
+            if (track != trackLyrics->getTrack())
+            {
+                LMS_LOG(DBUPDATER, DEBUG, "Updating track for external lyrics " << trackLyrics->getAbsoluteFilePath() << ", using " << (track ? track->getAbsoluteFilePath() : "<none>"));
+                trackLyricsAssociations.push_back(TrackLyricsAssociation{ .trackLyricsId = trackLyrics->getId(), .trackId = (track ? track->getId() : db::TrackId{}) });
+            }
+            else if (!track)
+            {
+                LMS_LOG(DBUPDATER, DEBUG, "No track found for external lyrics " << trackLyrics->getAbsoluteFilePath() << "'");
+            }
+        }
+
+        // Only the lyrics located in a directory that has changed can have their association changed
+        void fetchTrackLyricsToUpdate(db::Session& session, const std::filesystem::path& directoryPath, TrackLyricsAssociationContainer& trackLyricsAssociations)
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            const db::Directory::pointer directory{ db::Directory::find(session, directoryPath) };
+            if (!directory)
+                return;
+
+            db::TrackLyrics::FindParameters params;
+            params.setDirectory(directory->getId());
+            params.setExternal(true);
+
+            db::TrackLyrics::find(session, params, [&](const db::TrackLyrics::pointer& trackLyrics) {
+                checkTrackLyricsAssociation(session, trackLyrics, trackLyricsAssociations);
+            });
+        }
+
         bool fetchNextTrackLyricsToUpdate(SearchTrackLyricsContext& searchContext, TrackLyricsAssociationContainer& trackLyricsAssociations)
         {
             constexpr std::size_t readBatchSize{ 100 };
@@ -96,17 +129,7 @@ namespace lms::scanner
                     if (trackLyrics->getAbsoluteFilePath().empty())
                         return;
 
-                    db::Track::pointer track{ getMatchingTrack(searchContext.session, trackLyrics) };
-                    if (track != trackLyrics->getTrack())
-                    {
-                        LMS_LOG(DBUPDATER, DEBUG, "Updating track for external lyrics " << trackLyrics->getAbsoluteFilePath() << ", using " << (track ? track->getAbsoluteFilePath() : "<none>"));
-                        trackLyricsAssociations.push_back(TrackLyricsAssociation{ .trackLyricsId = trackLyrics->getId(), .trackId = (track ? track->getId() : db::TrackId{}) });
-                    }
-                    else if (!track)
-                    {
-                        LMS_LOG(DBUPDATER, DEBUG, "No track found for external lyrics " << trackLyrics->getAbsoluteFilePath() << "'");
-                    }
-
+                    checkTrackLyricsAssociation(searchContext.session, trackLyrics, trackLyricsAssociations);
                     searchContext.processedLyricsCount++;
                 });
             }
@@ -152,6 +175,35 @@ namespace lms::scanner
     }
 
     void ScanStepAssociateExternalLyrics::process(ScanContext& context)
+    {
+        if (context.journal.isComplete())
+            processChangedDirectories(context);
+        else
+            processAll(context);
+    }
+
+    void ScanStepAssociateExternalLyrics::processChangedDirectories(ScanContext& context)
+    {
+        auto& session{ _db.getTLSSession() };
+
+        const auto& changedDirectories{ context.journal.getChangedDirectories() };
+        context.currentStepStats.totalElems = changedDirectories.size();
+
+        TrackLyricsAssociationContainer trackLyricsAssociations;
+        for (const std::filesystem::path& directory : changedDirectories)
+        {
+            if (_abortScan)
+                return;
+
+            fetchTrackLyricsToUpdate(session, directory, trackLyricsAssociations);
+            updateTrackLyrics(session, trackLyricsAssociations);
+
+            context.currentStepStats.processedElems++;
+            _progressCallback(context.currentStepStats);
+        }
+    }
+
+    void ScanStepAssociateExternalLyrics::processAll(ScanContext& context)
     {
         auto& session{ _db.getTLSSession() };
 
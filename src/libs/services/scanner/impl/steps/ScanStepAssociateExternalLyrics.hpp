@@ -33,5 +33,7 @@ namespace lms::scanner
         core::LiteralString getStepName() const override { return "Associate external lyrics"; }
         bool needProcess(const ScanContext& context) const override;
         void process(ScanContext& context) override;
+        void processChangedDirectories(ScanContext& context);
+        void processAll(ScanContext& context);
     };
 } // namespace lms::scanner
@@ -19,11 +19,13 @@
 
 #include "ScanStepAssociateMediumImages.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <deque>
 #include <set>
 #include <span>
+#include <vector>
 
 #include "core/IConfig.hpp"
 #include "core/IJob.hpp"
@@ -44,6 +46,8 @@
 
 #include "JobQueue.hpp"
 #include "ScanContext.hpp"
+#include "ScanJournal.hpp"
+#include "helpers/JournalHelpers.hpp"
 #include "database/objects/TrackEmbeddedImage.hpp"
 
 namespace lms::scanner
@@ -156,9 +160,9 @@ namespace lms::scanner
 
         void updateMediumPreferredArtworks(db::Session& session, MediumArtworkAssociationContainer& imageAssociations, bool forceFullBatch)
         {
-            constexpr std::size_t writeBatchSize{ 50 };
+            constexpr std::size_t writeBatchSize{ 500 };
 
-            while ((forceFullBatch && imageAssociations.size() >= writeBatchSize) || !imageAssociations.empty())
+            while (forceFullBatch ? imageAssociations.size() >= writeBatchSize : !imageAssociations.empty())
             {
                 auto transaction{ session.createWriteTransaction() };
 
@@ -183,6 +187,30 @@ namespace lms::scanner
             return res;
         }
 
+        // Mediums whose artwork may have changed: mediums of the releases of the added/updated/removed tracks, and of the releases having files in changed directories
+        std::vector<db::MediumId> getMediumIdsToCheck(db::Session& session, const ScanJournal& journal)
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            std::vector<db::ReleaseId> releaseIds{ helpers::getReleaseIdsInChangedDirectories(session, journal) };
+            releaseIds.insert(std::end(releaseIds), std::cbegin(journal.getChangedReleases()), std::cend(journal.getChangedReleases()));
+
+            std::vector<db::MediumId> mediumIds;
+            for (const db::ReleaseId releaseId : releaseIds)
+            {
+                if (const db::Release::pointer release{ db::Release::find(session, releaseId) })
+                {
+                    for (const db::Medium::pointer& medium : release->getMediums())
+                        mediumIds.push_back(medium->getId());
+                }
+            }
+
+            std::sort(std::begin(mediumIds), std::end(mediumIds));
+            mediumIds.erase(std::unique(std::begin(mediumIds), std::end(mediumIds)), std::end(mediumIds));
+
+            return mediumIds;
+        }
+
         bool fetchNextMediumIdRange(db::Session& session, db::MediumId& lastRetrievedId, db::IdRange<db::MediumId>& idRange)
         {
             constexpr std::size_t readBatchSize{ 100 };
@@ -204,6 +232,13 @@ namespace lms::scanner
                 , _mediumIdRange{ mediumIdRange }
             {
             }
+
+            ComputeMediumArtworkAssociationsJob(db::IDb& db, const SearchMediumArtworkParams& searchParams, std::span<const db::MediumId> mediumIds)
+                : _db{ db }
+                , _searchParams{ searchParams }
+                , _mediumIds{ std::cbegin(mediumIds), std::cend(mediumIds) }
+            {
+            }
             ~ComputeMediumArtworkAssociationsJob() override = default;
 
             ComputeMediumArtworkAssociationsJob(const ComputeMediumArtworkAssociationsJob&) = delete;
@@ -219,7 +254,7 @@ namespace lms::scanner
                 auto& session{ _db.getTLSSession() };
                 auto transaction{ session.createReadTransaction() };
 
-                db::Medium::find(session, _mediumIdRange, [this, &session](const db::Medium::pointer& medium) {
+                auto processMedium{ [this, &session](const db::Medium::pointer& medium) {
                     const db::Artwork::pointer preferredArtwork{ computePreferredMediumArtwork(session, _searchParams, medium) };
 
                     if (medium->getPreferredArtwork() != preferredArtwork)
@@ -233,12 +268,26 @@ namespace lms::scanner
                     }
 
                     _processedMediumCount++;
-                });
+                } };
+
+                if (_mediumIdRange.isValid())
+                {
+                    db::Medium::find(session, _mediumIdRange, processMedium);
+                }
+                else
+                {
+                    for (const db::MediumId mediumId : _mediumIds)
+                    {
+                        if (const db::Medium::pointer medium{ db::Medium::find(session, mediumId) })
+                            processMedium(medium);
+                    }
+                }
             }
 
             db::IDb& _db;
             const SearchMediumArtworkParams& _searchParams;
             db::IdRange<db::MediumId> _mediumIdRange;
+            std::vector<db::MediumId> _mediumIds;
             std::vector<MediumArtworkAssociation> _associations;
             std::size_t _processedMediumCount{};
         };
@@ -260,9 +309,16 @@ namespace lms::scanner
     {
         auto& session{ _db.getTLSSession() };
 
+        std::vector<db::MediumId> mediumIdsToCheck;
+        if (context.journal.isComplete())
+        {
+            mediumIdsToCheck = getMediumIdsToCheck(session, context.journal);
+            context.currentStepStats.totalElems = mediumIdsToCheck.size();
+        }
+        else
         {
             auto transaction{ session.createReadTransaction() };
-            context.currentStepStats.totalElems = db::Artist::getCount(session);
+            context.currentStepStats.totalElems = db::Medium::getCount(session);
         }
 
         std::vector<std::string_view> mediumFileNames;
@@ -285,6 +341,8 @@ namespace lms::scanner
                 const auto& artistAssociations{ associationJob.getAssociations() };
 
                 mediumArtworkAssociations.insert(std::end(mediumArtworkAssociations), std::cbegin(artistAssociations), std::cend(artistAssociations));
+                for (const auto& association : artistAssociations)
+                    context.journal.addMediumWithChangedArtwork(association.mediumId);
 
                 context.currentStepStats.processedElems += associationJob.getProcessedMediumCount();
             }
@@ -296,10 +354,20 @@ namespace lms::scanner
         {
             JobQueue queue{ getJobScheduler(), 20, processJobsDone, 1, 0.85F };
 
-            db::MediumId lastRetrievedMediumId{};
-            db::IdRange<db::MediumId> mediumIdRange;
-            while (fetchNextMediumIdRange(session, lastRetrievedMediumId, mediumIdRange))
-                queue.push(std::make_unique<ComputeMediumArtworkAssociationsJob>(_db, searchParams, mediumIdRange));
+            if (context.journal.isComplete())
+            {
+                constexpr std::size_t mediumsPerJob{ 100 };
+
+                for (std::size_t offset{}; offset < mediumIdsToCheck.size(); offset += mediumsPerJob)
+                    queue.push(std::make_unique<ComputeMediumArtworkAssociationsJob>(_db, searchParams, std::span{ mediumIdsToCheck }.subspan(offset, std::min(mediumsPerJob, mediumIdsToCheck.size() - offset))));
+            }
+            else
+            {
+                db::MediumId lastRetrievedMediumId{};
+                db::IdRange<db::MediumId> mediumIdRange;
+                while (fetchNextMediumIdRange(session, lastRetrievedMediumId, mediumIdRange))
+                    queue.push(std::make_unique<ComputeMediumArtworkAssociationsJob>(_db, searchParams, mediumIdRange));
+            }
         }
 
         // process all remaining associations
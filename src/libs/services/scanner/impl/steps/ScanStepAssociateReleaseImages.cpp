@@ -19,10 +19,13 @@
 
 #include "ScanStepAssociateReleaseImages.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <deque>
 #include <set>
+#include <span>
+#include <vector>
 
 #include "core/IConfig.hpp"
 #include "core/IJob.hpp"
@@ -39,6 +42,8 @@
 
 #include "JobQueue.hpp"
 #include "ScanContext.hpp"
+#include "ScanJournal.hpp"
+#include "helpers/JournalHelpers.hpp"
 
 namespace lms::scanner
 {
@@ -185,9 +190,9 @@ namespace lms::scanner
 
         void updateReleasePreferredArtworks(db::Session& session, ReleaseArtworkAssociationContainer& imageAssociations, bool forceFullBatch)
         {
-            constexpr std::size_t writeBatchSize{ 50 };
+            constexpr std::size_t writeBatchSize{ 500 };
 
-            while ((forceFullBatch && imageAssociations.size() >= writeBatchSize) || !imageAssociations.empty())
+            while (forceFullBatch ? imageAssociations.size() >= writeBatchSize : !imageAssociations.empty())
             {
                 auto transaction{ session.createWriteTransaction() };
 
@@ -212,6 +217,26 @@ namespace lms::scanner
             return res;
         }
 
+        // Releases whose artwork may have changed: releases of the added/updated/removed tracks, releases having files in changed directories, and releases named after changed image files
+        std::vector<db::ReleaseId> getReleaseIdsToCheck(db::Session& session, const ScanJournal& journal)
+        {
+            auto transaction{ session.createReadTransaction() };
+
+            std::vector<db::ReleaseId> releaseIds{ helpers::getReleaseIdsInChangedDirectories(session, journal) };
+            releaseIds.insert(std::end(releaseIds), std::cbegin(journal.getChangedReleases()), std::cend(journal.getChangedReleases()));
+
+            for (const core::UUID& mbid : journal.getChangedImageMBIDs())
+            {
+                if (const db::Release::pointer release{ db::Release::find(session, mbid) })
+                    releaseIds.push_back(release->getId());
+            }
+
+            std::sort(std::begin(releaseIds), std::end(releaseIds));
+            releaseIds.erase(std::unique(std::begin(releaseIds), std::end(releaseIds)), std::end(releaseIds));
+
+            return releaseIds;
+        }
+
         bool fetchNextReleaseIdRange(db::Session& session, db::ReleaseId& lastRetrievedId, db::IdRange<db::ReleaseId>& idRange)
         {
             constexpr std::size_t readBatchSize{ 100 };
@@ -234,6 +259,13 @@ namespace lms::scanner
             {
             }
 
+            ComputeReleaseArtworkAssociationsJob(db::IDb& db, const SearchReleaseArtworkParams& searchParams, std::span<const db::ReleaseId> releaseIds)
+                : _db{ db }
+                , _searchParams{ searchParams }
+                , _releaseIds{ std::cbegin(releaseIds), std::cend(releaseIds) }
+            {
+            }
+
             std::span<const ReleaseArtworkAssociation> getAssociations() const { return _associations; }
             std::size_t getProcessedReleaseCount() const { return _processedReleaseCount; }
 
@@ -244,7 +276,7 @@ namespace lms::scanner
                 auto& session{ _db.getTLSSession() };
                 auto transaction{ session.createReadTransaction() };
 
-                db::Release::find(session, _artistIdRange, [this, &session](const db::Release::pointer& release) {
+                auto processRelease{ [this, &session](const db::Release::pointer& release) {
                     const db::Artwork::pointer preferredArtwork{ computePreferredReleaseArtwork(session, _searchParams, release) };
 
                     if (release->getPreferredArtwork() != preferredArtwork)
@@ -258,12 +290,26 @@ namespace lms::scanner
                     }
 
                     _processedReleaseCount++;
-                });
+                } };
+
+                if (_artistIdRange.isValid())
+                {
+                    db::Release::find(session, _artistIdRange, processRelease);
+                }
+                else
+                {
+                    for (const db::ReleaseId releaseId : _releaseIds)
+                    {
+                        if (const db::Release::pointer release{ db::Release::find(session, releaseId) })
+                            processRelease(release);
+                    }
+                }
             }
 
             db::IDb& _db;
             const SearchReleaseArtworkParams& _searchParams;
             db::IdRange<db::ReleaseId> _artistIdRange;
+            std::vector<db::ReleaseId> _releaseIds;
             std::vector<ReleaseArtworkAssociation> _associations;
             std::size_t _processedReleaseCount{};
         };
@@ -285,6 +331,13 @@ namespace lms::scanner
     {
         auto& session{ _db.getTLSSession() };
 
+        std::vector<db::ReleaseId> releaseIdsToCheck;
+        if (context.journal.isComplete())
+        {
+            releaseIdsToCheck = getReleaseIdsToCheck(session, context.journal);
+            context.currentStepStats.totalElems = releaseIdsToCheck.size();
+        }
+        else
         {
             auto transaction{ session.createReadTransaction() };
             context.currentStepStats.totalElems = db::Release::getCount(session);
@@ -305,6 +358,8 @@ namespace lms::scanner
                 const auto& artistAssociations{ associationJob.getAssociations() };
 
                 releaseArtworkAssociations.insert(std::end(releaseArtworkAssociations), std::cbegin(artistAssociations), std::cend(artistAssociations));
+                for (const auto& association : artistAssociations)
+                    context.journal.addReleaseWithChangedArtwork(association.releaseId);
 
                 context.currentStepStats.processedElems += associationJob.getProcessedReleaseCount();
             }
@@ -315,10 +370,20 @@ namespace lms::scanner
 
         JobQueue queue{ getJobScheduler(), 20, processJobsDone, 1, 0.85F };
 
-        db::ReleaseId lastRetrievedReleaseId{};
-        db::IdRange<db::ReleaseId> artistIdRange;
-        while (fetchNextReleaseIdRange(session, lastRetrievedReleaseId, artistIdRange))
-            queue.push(std::make_unique<ComputeReleaseArtworkAssociationsJob>(_db, searchParams, artistIdRange));
+        if (context.journal.isComplete())
+        {
+            constexpr std::size_t releasesPerJob{ 100 };
+
+            for (std::size_t offset{}; offset < releaseIdsToCheck.size(); offset += releasesPerJob)
+                queue.push(std::make_unique<ComputeReleaseArtworkAssociationsJob>(_db, searchParams, std::span{ releaseIdsToCheck }.subspan(offset, std::min(releasesPerJob, releaseIdsToCheck.size() - offset))));
+        }
+        else
+        {
+            db::ReleaseId lastRetrievedReleaseId{};
+            db::IdRange<db::ReleaseId> artistIdRange;
+            while (fetchNextReleaseIdRange(session, lastRetrievedReleaseId, artistIdRange))
+                queue.push(std::make_unique<ComputeReleaseArtworkAssociationsJob>(_db, searchParams, artistIdRange));
+        }
 
         queue.finish();
 
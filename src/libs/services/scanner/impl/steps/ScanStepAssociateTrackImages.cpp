@@ -19,9 +19,13 @@
 
 #include "ScanStepAssociateTrackImages.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <deque>
+#include <filesystem>
 #include <optional>
+#include <span>
+#include <vector>
 
 #include "core/IJob.hpp"
 #include "core/IJobScheduler.hpp"
@@ -126,9 +130,9 @@ namespace lms::scanner
 
         void updateTrackPreferredArtworks(db::Session& session, TrackArtworksAssociationContainer& imageAssociations, bool forceFullBatch)
         {
-            constexpr std::size_t writeBatchSize{ 50 };
+            constexpr std::size_t writeBatchSize{ 500 };
 
-            while ((forceFullBatch && imageAssociations.size() >= writeBatchSize) || !imageAssociations.empty())
+            while (forceFullBatch ? imageAssociations.size() >= writeBatchSize : !imageAssociations.empty())
             {
                 auto transaction{ session.createWriteTransaction() };
 
@@ -140,6 +144,36 @@ namespace lms::scanner
             }
         }
 
+        // Tracks whose artwork may have changed: tracks located in changed directories, or belonging to a release/medium whose artwork has changed
+        std::vector<db::TrackId> getTrackIdsToCheck(db::Session& session, const ScanJournal& journal)
+        {
+            std::vector<db::TrackId> trackIds;
+
+            auto addTrackIds{ [&](const db::Track::FindParameters& params) {
+                const auto results{ db::Track::findIds(session, params) };
+                trackIds.insert(std::end(trackIds), std::cbegin(results.results), std::cend(results.results));
+            } };
+
+            auto transaction{ session.createReadTransaction() };
+
+            for (const std::filesystem::path& directoryPath : journal.getChangedDirectories())
+            {
+                if (const db::Directory::pointer directory{ db::Directory::find(session, directoryPath) })
+                    addTrackIds(db::Track::FindParameters{}.setDirectory(directory->getId()));
+            }
+
+            for (const db::ReleaseId releaseId : journal.getReleasesWithChangedArtwork())
+                addTrackIds(db::Track::FindParameters{}.setRelease(releaseId));
+
+            for (const db::MediumId mediumId : journal.getMediumsWithChangedArtwork())
+                addTrackIds(db::Track::FindParameters{}.setMedium(mediumId));
+
+            std::sort(std::begin(trackIds), std::end(trackIds));
+            trackIds.erase(std::unique(std::begin(trackIds), std::end(trackIds)), std::end(trackIds));
+
+            return trackIds;
+        }
+
         bool fetchNextTrackIdRange(db::Session& session, db::TrackId& lastRetrievedTrackId, db::IdRange<db::TrackId>& trackIdRange)
         {
             constexpr std::size_t readBatchSize{ 100 };
@@ -161,6 +195,12 @@ namespace lms::scanner
             {
             }
 
+            ComputeTrackArtworkAssociationsJob(db::IDb& db, std::span<const db::TrackId> trackIds)
+                : _db{ db }
+                , _trackIds{ std::cbegin(trackIds), std::cend(trackIds) }
+            {
+            }
+
             std::span<const TrackArtworksAssociation> getTrackAssociations() const { return _trackAssociations; }
             std::size_t getProcessedTrackCount() const { return _processedTrackCount; }
 
@@ -171,7 +211,7 @@ namespace lms::scanner
                 auto& session{ _db.getTLSSession() };
                 auto transaction{ session.createReadTransaction() };
 
-                db::Track::find(session, _trackIdRange, [&](const db::Track::pointer& track) {
+                auto processTrack{ [&](const db::Track::pointer& track) {
                     const db::Artwork::pointer preferredMediaArtwork{ computePreferredTrackMediaArtwork(session, track) };
                     const db::Artwork::pointer preferredArtwork{ computePreferredTrackArtwork(session, track, preferredMediaArtwork) };
 
@@ -201,11 +241,25 @@ namespace lms::scanner
                         _trackAssociations.push_back(artworksAssociation);
 
                     _processedTrackCount++;
-                });
+                } };
+
+                if (_trackIdRange.isValid())
+                {
+                    db::Track::find(session, _trackIdRange, processTrack);
+                }
+                else
+                {
+                    for (const db::TrackId trackId : _trackIds)
+                    {
+                        if (const db::Track::pointer track{ db::Track::find(session, trackId) })
+                            processTrack(track);
+                    }
+                }
             }
 
             db::IDb& _db;
             db::IdRange<db::TrackId> _trackIdRange;
+            std::vector<db::TrackId> _trackIds;
             std::vector<TrackArtworksAssociation> _trackAssociations;
             std::size_t _processedTrackCount{};
         };
@@ -225,6 +279,13 @@ namespace lms::scanner
     {
         auto& session{ _db.getTLSSession() };
 
+        std::vector<db::TrackId> trackIdsToCheck;
+        if (context.journal.isComplete())
+        {
+            trackIdsToCheck = getTrackIdsToCheck(session, context.journal);
+            context.currentStepStats.totalElems = trackIdsToCheck.size();
+        }
+        else
         {
             auto transaction{ session.createReadTransaction() };
             context.currentStepStats.totalElems = db::Track::getCount(session);
@@ -252,10 +313,20 @@ namespace lms::scanner
         {
             JobQueue queue{ getJobScheduler(), 20, processTracks, 1, 0.85F };
 
-            db::TrackId lastRetrievedTrackId;
-            db::IdRange<db::TrackId> trackIdRange;
-            while (fetchNextTrackIdRange(session, lastRetrievedTrackId, trackIdRange))
-                queue.push(std::make_unique<ComputeTrackArtworkAssociationsJob>(_db, trackIdRange));
+            if (context.journal.isComplete())
+            {
+                constexpr std::size_t tracksPerJob{ 100 };
+
+                for (std::size_t offset{}; offset < trackIdsToCheck.size(); offset += tracksPerJob)
+                    queue.push(std::make_unique<ComputeTrackArtworkAssociationsJob>(_db, std::span{ trackIdsToCheck }.subspan(offset, std::min(tracksPerJob, trackIdsToCheck.size() - offset))));
+            }
+            else
+            {
+                db::TrackId lastRetrievedTrackId;
+                db::IdRange<db::TrackId> trackIdRange;
+                while (fetchNextTrackIdRange(session, lastRetrievedTrackId, trackIdRange))
+                    queue.push(std::make_unique<ComputeTrackArtworkAssociationsJob>(_db, trackIdRange));
+            }
         }
 
         // process all remaining associations
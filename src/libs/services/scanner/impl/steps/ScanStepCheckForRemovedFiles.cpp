@@ -22,6 +22,7 @@
 #include <deque>
 #include <filesystem>
 #include <span>
+#include <type_traits>
 #include <vector>
 
 #include "core/IJob.hpp"
@@ -29,6 +30,7 @@
 #include "core/Path.hpp"
 #include "database/IDb.hpp"
 #include "database/Session.hpp"
+#include "database/objects/Artist.hpp"
 #include "database/objects/ArtistInfo.hpp"
 #include "database/objects/Image.hpp"
 #include "database/objects/PlayListFile.hpp"
@@ -38,6 +40,7 @@
 #include "FileScanners.hpp"
 #include "JobQueue.hpp"
 #include "ScanContext.hpp"
+#include "ScanJournal.hpp"
 #include "ScannerSettings.hpp"
 #include "services/scanner/ScannerStats.hpp"
 
@@ -68,6 +71,7 @@ namespace lms::scanner
 
             std::size_t getProcessedCount() const { return _processedCount; }
             std::span<const IdType> getObjectsToRemove() const { return _objectsToRemove; }
+            std::span<const std::filesystem::path> getRemovedFiles() const { return _removedFiles; }
 
         private:
             core::LiteralString getName() const override { return "Check For Removed Files"; }
@@ -76,7 +80,10 @@ namespace lms::scanner
                 for (const FileToCheck<IdType>& fileToCheck : _filesToCheck)
                 {
                     if (!checkFile(fileToCheck.file))
+                    {
                         _objectsToRemove.push_back(fileToCheck.objectId);
+                        _removedFiles.push_back(fileToCheck.file);
+                    }
                 }
 
                 _processedCount += _filesToCheck.size();
@@ -122,11 +129,31 @@ namespace lms::scanner
             const FileScanners& _scanners;
             std::vector<FileToCheck<IdType>> _filesToCheck;
             std::vector<IdType> _objectsToRemove;
+            std::vector<std::filesystem::path> _removedFiles;
             std::size_t _processedCount{};
         };
 
+        // Must be called before the objects are destroyed, as their links are lost afterwards
+        template<typename Object>
+        void addRemovedObjectsToJournal(db::Session& session, ScanJournal& journal, std::span<const typename Object::IdType> objectIds)
+        {
+            for (const typename Object::IdType objectId : objectIds)
+            {
+                if constexpr (std::is_same_v<Object, db::Track>)
+                {
+                    if (const db::Track::pointer track{ db::Track::find(session, objectId) })
+                        journal.addChangedTrack(track);
+                }
+                else if constexpr (std::is_same_v<Object, db::ArtistInfo>)
+                {
+                    if (const db::ArtistInfo::pointer artistInfo{ db::ArtistInfo::find(session, objectId) }; artistInfo && artistInfo->getArtist())
+                        journal.addChangedArtist(artistInfo->getArtist()->getId());
+                }
+            }
+        }
+
         template<typename Object>
-        std::size_t removeObjects(db::Session& session, std::deque<typename Object::IdType>& objectIdsToRemove, bool forceFullBatch)
+        std::size_t removeObjects(db::Session& session, ScanJournal& journal, std::deque<typename Object::IdType>& objectIdsToRemove, bool forceFullBatch)
         {
             std::size_t removedObjectCount{};
             constexpr std::size_t writeBatchSize{ 50 };
@@ -142,6 +169,7 @@ namespace lms::scanner
 
                 {
                     auto transaction{ session.createWriteTransaction() };
+                    addRemovedObjectsToJournal<Object>(session, journal, ids);
                     session.destroy<Object>(ids);
                 }
 
@@ -233,12 +261,18 @@ namespace lms::scanner
                 std::span<const ObjectIdType> objectsToRemove{ checkJob.getObjectsToRemove() };
 
                 objectIdsToRemove.insert(std::end(objectIdsToRemove), std::cbegin(objectsToRemove), std::cend(objectsToRemove));
+                for (const std::filesystem::path& file : checkJob.getRemovedFiles())
+                {
+                    context.journal.addChangedDirectory(file.parent_path());
+                    if constexpr (std::is_same_v<Object, db::Image>)
+                        context.journal.addChangedImage(file);
+                }
 
                 context.currentStepStats.processedElems += checkJob.getProcessedCount();
             }
 
             if (!objectIdsToRemove.empty())
-                context.stats.deletions += removeObjects<Object>(session, objectIdsToRemove, true);
+                context.stats.deletions += removeObjects<Object>(session, context.journal, objectIdsToRemove, true);
 
             _progressCallback(context.currentStepStats);
         };
@@ -253,6 +287,6 @@ namespace lms::scanner
         }
 
         // process all remaining objects
-        context.stats.deletions += removeObjects<Object>(session, objectIdsToRemove, false);
+        context.stats.deletions += removeObjects<Object>(session, context.journal, objectIdsToRemove, false);
     }
 } // namespace lms::scanner
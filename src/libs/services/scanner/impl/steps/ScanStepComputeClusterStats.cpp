@@ -18,12 +18,16 @@
  */
 
 #include "ScanStepComputeClusterStats.hpp"
+
+#include <vector>
+
 #include "core/ILogger.hpp"
 #include "database/IDb.hpp"
 #include "database/Session.hpp"
 #include "database/objects/Cluster.hpp"
 
 #include "ScanContext.hpp"
+#include "ScanJournal.hpp"
 
 namespace lms::scanner
 {
@@ -38,54 +42,27 @@ namespace lms::scanner
 
         Session& dbSession{ _db.getTLSSession() };
 
-        const std::size_t clusterCount{ [&] {
-            auto transaction{ dbSession.createReadTransaction() };
-            return Cluster::getCount(dbSession);
-        }() };
-
-        context.currentStepStats.totalElems = clusterCount;
+        context.currentStepStats.totalElems = 1;
+        _progressCallback(context.currentStepStats);
 
-        foreachSubRange(Range{ 0, clusterCount }, 100, [&](Range range) {
-            const std::vector<ClusterId> clusterIds{ [&] {
-                Cluster::FindParameters params;
-                params.setRange(range);
+        {
+            auto transaction{ dbSession.createWriteTransaction() };
 
-                {
-                    auto transaction{ dbSession.createReadTransaction() };
-                    return std::move(Cluster::findIds(dbSession, params).results);
-                }
-            }() };
-
-            for (const ClusterId clusterId : clusterIds)
+            // Only the clusters of the added/updated/removed tracks can have their stats changed
+            if (context.journal.isComplete())
             {
-                if (_abortScan)
-                    break;
-
-                std::size_t trackCount;
-                std::size_t releaseCount;
-
-                {
-                    auto transaction{ dbSession.createReadTransaction() };
-
-                    trackCount = Cluster::computeTrackCount(dbSession, clusterId);
-                    releaseCount = Cluster::computeReleaseCount(dbSession, clusterId);
-                }
-
-                {
-                    auto transaction{ dbSession.createWriteTransaction() };
-
-                    auto cluster{ Cluster::find(dbSession, clusterId) };
-                    cluster.modify()->setTrackCount(trackCount);
-                    cluster.modify()->setReleaseCount(releaseCount);
-                }
-
-                context.currentStepStats.processedElems++;
-                _progressCallback(context.currentStepStats);
+                const std::vector<ClusterId> clusterIds(std::cbegin(context.journal.getChangedClusters()), std::cend(context.journal.getChangedClusters()));
+                Cluster::updateStats(dbSession, clusterIds);
+            }
+            else
+            {
+                Cluster::updateStats(dbSession);
             }
+        }
 
-            return true;
-        });
+        context.currentStepStats.processedElems = 1;
+        _progressCallback(context.currentStepStats);
 
-        LMS_LOG(DBUPDATER, DEBUG, "Recomputed stats for " << context.currentStepStats.processedElems << " clusters!");
+        LMS_LOG(DBUPDATER, DEBUG, "Recomputed cluster stats");
     }
 } // namespace lms::scanner
@@ -52,6 +52,9 @@ namespace lms::scanner
         removeOrphanedCountries(context);
         removeOrphanedDirectories(context);
         removeOrphanedTrackEmbeddedImages(context);
+
+        // Some of the cached objects are likely gone now
+        context.cache.clear();
     }
 
     void ScanStepRemoveOrphanedDbEntries::removeOrphanedClusters(ScanContext& context)
@@ -117,31 +120,24 @@ namespace lms::scanner
     template<typename T>
     void ScanStepRemoveOrphanedDbEntries::removeOrphanedEntries(ScanContext& context)
     {
-        constexpr std::size_t batchSize = 200;
-
-        using IdType = typename T::IdType;
+        // Orphans are detected and deleted by the same statement, bounded to keep write transactions short
+        constexpr std::size_t batchSize = 1000;
 
         db::Session& session{ _db.getTLSSession() };
 
-        db::RangeResults<IdType> entries;
         while (!_abortScan)
         {
-            {
-                auto transaction{ session.createReadTransaction() };
-
-                entries = T::findOrphanIds(session, db::Range{ 0, batchSize });
-            };
-
-            if (entries.results.empty())
-                break;
-
+            std::size_t removedCount{};
             {
                 auto transaction{ session.createWriteTransaction() };
 
-                session.destroy<T>(entries.results);
+                removedCount = T::removeOrphans(session, batchSize);
             }
 
-            context.currentStepStats.processedElems += entries.results.size();
+            if (removedCount == 0)
+                break;
+
+            context.currentStepStats.processedElems += removedCount;
             _progressCallback(context.currentStepStats);
         }
     }
@@ -255,15 +255,25 @@ namespace lms::scanner
 
         while ((forceBatch && scanOperations.size() >= writeBatchSize) || !scanOperations.empty())
         {
-            db::Session& dbSession{ _db.getTLSSession() };
-            auto transaction{ dbSession.createWriteTransaction() };
+            try
+            {
+                db::Session& dbSession{ _db.getTLSSession() };
+                auto transaction{ dbSession.createWriteTransaction() };
 
-            for (std::size_t i{}; !scanOperations.empty() && i < writeBatchSize; ++i)
+                for (std::size_t i{}; !scanOperations.empty() && i < writeBatchSize; ++i)
+                {
+                    processFileScanOperation(context, *scanOperations.front());
+                    scanOperations.pop_front();
+                    count++;
+                }
+            }
+            catch (...)
             {
-                processFileScanOperation(context, *scanOperations.front());
-                scanOperations.pop_front();
-                count++;
+                // the transaction has been rolled back
+                context.cache.rollback();
+                throw;
             }
+            context.cache.commit();
         }
 
         return count;
@@ -272,20 +282,23 @@ namespace lms::scanner
     void ScanStepScanFiles::processFileScanOperation(ScanContext& context, IFileScanOperation& scanOperation)
     {
         LMS_LOG(DBUPDATER, DEBUG, scanOperation.getName() << ": processing result for " << scanOperation.getFilePath());
-        const IFileScanOperation::OperationResult res{ scanOperation.processResult() };
+        const IFileScanOperation::OperationResult res{ scanOperation.processResult(context.journal, context.cache) };
         switch (res)
         {
         case IFileScanOperation::OperationResult::Added:
             context.stats.additions++;
+            context.journal.addChangedDirectory(scanOperation.getFilePath().parent_path());
             break;
         case IFileScanOperation::OperationResult::Removed:
             context.stats.deletions++;
+            context.journal.addChangedDirectory(scanOperation.getFilePath().parent_path());
             break;
         case IFileScanOperation::OperationResult::Skipped:
             context.stats.failures++;
             break;
         case IFileScanOperation::OperationResult::Updated:
             context.stats.updates++;
+            context.journal.addChangedDirectory(scanOperation.getFilePath().parent_path());
             break;
         }
         context.stats.scans++;
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/IJobScheduler.hpp"
+#include "database/IDb.hpp"
+#include "database/Session.hpp"
+#include "database/objects/Artwork.hpp"
+#include "database/objects/Cluster.hpp"
+#include "database/objects/Directory.hpp"
+#include "database/objects/Image.hpp"
+#include "database/objects/Release.hpp"
+#include "database/objects/Track.hpp"
+#include "database/test/TmpDatabase.hpp"
+
+#include "FileScanners.hpp"
+#include "ScanContext.hpp"
+#include "ScannerSettings.hpp"
+#include "steps/ScanStepAssociateTrackImages.hpp"
+#include "steps/ScanStepComputeClusterStats.hpp"
+
+namespace lms::scanner::tests
+{
+    namespace
+    {
+        // Two directories, each containing one release of two tracks
+        class ScanJournalTest : public ::testing::Test
+        {
+        protected:
+            void SetUp() override
+            {
+                auto transaction{ _session.createWriteTransaction() };
+
+                for (std::size_t i{}; i < 2; ++i)
+                {
+                    const std::filesystem::path directoryPath{ "/music/release" + std::to_string(i) };
+                    const db::Directory::pointer directory{ _session.create<db::Directory>(directoryPath) };
+                    const db::Release::pointer release{ _session.create<db::Release>("Release" + std::to_string(i)) };
+
+                    for (std::size_t j{}; j < 2; ++j)
+                    {
+                        db::Track::pointer track{ _session.create<db::Track>() };
+                        track.modify()->setAbsoluteFilePath(directoryPath / ("track" + std::to_string(j) + ".mp3"));
+                        track.modify()->setDirectory(directory);
+                        track.modify()->setRelease(release);
+                        _trackIds[i].push_back(track->getId());
+                    }
+
+                    _directoryPaths.push_back(directoryPath);
+                    _releaseIds.push_back(release->getId());
+                }
+            }
+
+            // Simulates an updated cover in all the directories
+            std::vector<db::ArtworkId> setNewReleaseArtworks()
+            {
+                auto transaction{ _session.createWriteTransaction() };
+
+                std::vector<db::ArtworkId> artworkIds;
+                for (std::size_t i{}; i < _releaseIds.size(); ++i)
+                {
+                    const db::Image::pointer image{ _session.create<db::Image>(_directoryPaths[i] / ("cover" + std::to_string(_coverIndex++) + ".jpg")) };
+                    const db::Artwork::pointer artwork{ _session.create<db::Artwork>(image) };
+
+                    db::Release::updatePreferredArtwork(_session, _releaseIds[i], artwork->getId());
+                    artworkIds.push_back(artwork->getId());
+                }
+
+                return artworkIds;
+            }
+
+            template<typename Step>
+            void runStep(ScanContext& context)
+            {
+                bool abortScan{};
+                const std::filesystem::path cachePath;
+                ScanStepBase::InitParams params{
+                    .jobScheduler = *_jobScheduler,
+                    .settings = _settings,
+                    .lastScanSettings = &_settings,
+                    .progressCallback = [](const ScanStepStats&) {},
+                    .abortScan = abortScan,
+                    .db = _tmpDb.getDb(),
+                    .fileScanners = _fileScanners,
+                    .cachePath = cachePath,
+                };
+
+                Step step{ params };
+                static_cast<IScanStep&>(step).process(context);
+            }
+
+            db::ArtworkId getTrackArtworkId(db::TrackId trackId)
+            {
+                auto transaction{ _session.createReadTransaction() };
+                return db::Track::find(_session, trackId)->getPreferredArtworkId();
+            }
+
+            db::tests::TmpDatabase _tmpDb;
+            db::Session _session{ _tmpDb.getDb() };
+            const std::unique_ptr<core::IJobScheduler> _jobScheduler{ core::createJobScheduler("Scanner", 2) };
+            const ScannerSettings _settings{};
+            const FileScanners _fileScanners{};
+
+            std::vector<std::filesystem::path> _directoryPaths;
+            std::vector<db::ReleaseId> _releaseIds;
+            std::vector<db::TrackId> _trackIds[2];
+            std::size_t _coverIndex{};
+        };
+    } // namespace
+
+    TEST_F(ScanJournalTest, incompleteJournalProcessesAllTracks)
+    {
+        const std::vector<db::ArtworkId> artworkIds{ setNewReleaseArtworks() };
+
+        ScanContext context;
+        context.journal.setIncomplete();
+        runStep<ScanStepAssociateTrackImages>(context);
+
+        EXPECT_EQ(context.currentStepStats.processedElems, 4);
+        for (std::size_t i{}; i < 2; ++i)
+        {
+            for (const db::TrackId trackId : _trackIds[i])
+                EXPECT_EQ(getTrackArtworkId(trackId), artworkIds[i]);
+        }
+    }
+
+    TEST_F(ScanJournalTest, rescanOnlyReassociatesChangedDirectory)
+    {
+        // initial full pass
+        const std::vector<db::ArtworkId> initialArtworkIds{ setNewReleaseArtworks() };
+        {
+            ScanContext context;
+            context.journal.setIncomplete();
+            runStep<ScanStepAssociateTrackImages>(context);
+        }
+
+        // both covers are updated, but only the first directory is reported as changed
+        const std::vector<db::ArtworkId> newArtworkIds{ setNewReleaseArtworks() };
+
+        ScanContext context;
+        context.journal.addChangedDirectory(_directoryPaths[0]);
+        runStep<ScanStepAssociateTrackImages>(context);
+
+        EXPECT_EQ(context.currentStepStats.totalElems, 2);
+        EXPECT_EQ(context.currentStepStats.processedElems, 2);
+        for (const db::TrackId trackId : _trackIds[0])
+            EXPECT_EQ(getTrackArtworkId(trackId), newArtworkIds[0]);
+        for (const db::TrackId trackId : _trackIds[1])
+            EXPECT_EQ(getTrackArtworkId(trackId), initialArtworkIds[1]);
+    }
+
+    TEST_F(ScanJournalTest, releaseWithChangedArtwork)
+    {
+        const std::vector<db::ArtworkId> artworkIds{ setNewReleaseArtworks() };
+
+        ScanContext context;
+        context.journal.addReleaseWithChangedArtwork(_releaseIds[1]);
+        runStep<ScanStepAssociateTrackImages>(context);
+
+        EXPECT_EQ(context.currentStepStats.processedElems, 2);
+        for (const db::TrackId trackId : _trackIds[0])
+            EXPECT_FALSE(getTrackArtworkId(trackId).isValid());
+        for (const db::TrackId trackId : _trackIds[1])
+            EXPECT_EQ(getTrackArtworkId(trackId), artworkIds[1]);
+    }
+
+    TEST_F(ScanJournalTest, clusterStatsOnlyUpdatesChangedClusters)
+    {
+        std::vector<db::ClusterId> clusterIds;
+        {
+            auto transaction{ _session.createWriteTransaction() };
+
+            const db::ClusterType::pointer clusterType{ _session.create<db::ClusterType>("Genre") };
+            for (std::size_t i{}; i < 2; ++i)
+            {
+                db::Cluster::pointer cluster{ _session.create<db::Cluster>(clusterType, "Cluster" + std::to_string(i)) };
+                for (const db::TrackId trackId : _trackIds[i])
+                    cluster.modify()->addTrack(db::Track::find(_session, trackId));
+
+                clusterIds.push_back(cluster->getId());
+            }
+        }
+
+        ScanContext context;
+        {
+            auto transaction{ _session.createReadTransaction() };
+            context.journal.addChangedTrack(db::Track::find(_session, _trackIds[0].front()));
+        }
+        EXPECT_EQ(context.journal.getChangedReleases(), std::set<db::ReleaseId>{ _releaseIds[0] });
+        EXPECT_EQ(context.journal.getChangedClusters(), std::set<db::ClusterId>{ clusterIds[0] });
+
+        runStep<ScanStepComputeClusterStats>(context);
+
+        auto transaction{ _session.createReadTransaction() };
+        EXPECT_EQ(db::Cluster::find(_session, clusterIds[0])->getTrackCount(), 2);
+        EXPECT_EQ(db::Cluster::find(_session, clusterIds[1])->getTrackCount(), 0);
+    }
+} // namespace lms::scanner::tests
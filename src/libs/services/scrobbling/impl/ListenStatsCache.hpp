@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "core/PerUserLruCache.hpp"
+#include "database/Types.hpp"
+#include "database/objects/TrackId.hpp"
+#include "database/objects/UserId.hpp"
+
+#include "services/scrobbling/IScrobblingService.hpp"
+
+namespace lms::scrobbling
+{
+    // Per user cache of track listen stats
+    using ListenStatsCache = core::PerUserLruCache<db::UserId, db::ScrobblingBackend, db::TrackId, IScrobblingService::TrackListenStats>;
+} // namespace lms::scrobbling
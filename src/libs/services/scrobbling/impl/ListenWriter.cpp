@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ListenWriter.hpp"
+
+#include <algorithm>
+#include <map>
+
+#include <boost/asio/post.hpp>
+
+#include "core/ILogger.hpp"
+#include "database/IDb.hpp"
+#include "database/Session.hpp"
+#include "database/objects/Listen.hpp"
+#include "database/objects/Track.hpp"
+#include "database/objects/User.hpp"
+
+namespace lms::scrobbling
+{
+    ListenWriter::ListenWriter(db::IDb& db, ListensWrittenCallback listensWrittenCallback, std::size_t maxPendingCount, std::size_t maxBatchSize)
+        : _db{ db }
+        , _listensWrittenCallback{ std::move(listensWrittenCallback) }
+        , _maxPendingCount{ maxPendingCount }
+        , _maxBatchSize{ maxBatchSize }
+    {
+    }
+
+    ListenWriter::~ListenWriter()
+    {
+        flush();
+    }
+
+    void ListenWriter::enqueue(const Entry& entry, CompletionCallback callback)
+    {
+        enqueue(std::vector<Entry>{ entry }, std::move(callback), false);
+    }
+
+    void ListenWriter::enqueue(std::vector<Entry> entries, CompletionCallback callback)
+    {
+        enqueue(std::move(entries), std::move(callback), false);
+    }
+
+    bool ListenWriter::tryEnqueue(const Entry& entry, CompletionCallback callback)
+    {
+        return enqueue(std::vector<Entry>{ entry }, std::move(callback), true);
+    }
+
+    bool ListenWriter::enqueue(std::vector<Entry> entries, CompletionCallback callback, bool bounded)
+    {
+        {
+            const std::scoped_lock lock{ _mutex };
+
+            if (bounded && _pendingCount + entries.size() > _maxPendingCount)
+            {
+                LMS_LOG(SCROBBLING, ERROR, "Too many pending listen writes, dropping " << entries.size() << " listen(s)");
+                return false;
+            }
+
+            _pendingCount += entries.size();
+            _pendingBatches.push_back(Batch{ std::move(entries), std::move(callback) });
+            _enqueuedBatchCount++;
+
+            if (_processing)
+                return true;
+
+            _processing = true;
+        }
+
+        boost::asio::post(_ioContext, [this] { processPendingBatches(); });
+        return true;
+    }
+
+    void ListenWriter::flush()
+    {
+        std::unique_lock lock{ _mutex };
+
+        const std::size_t targetBatchCount{ _enqueuedBatchCount };
+        _cv.wait(lock, [&] { return _processedBatchCount >= targetBatchCount; });
+    }
+
+    void ListenWriter::processPendingBatches()
+    {
+        while (true)
+        {
+            std::deque<Batch> batches;
+            std::size_t entryCount{};
+
+            {
+                const std::scoped_lock lock{ _mutex };
+
+                if (_pendingBatches.empty())
+                {
+                    _processing = false;
+                    return;
+                }
+
+                // Coalesce as many requests as possible, but never split them
+                while (!_pendingBatches.empty() && (batches.empty() || entryCount + _pendingBatches.front().entries.size() <= _maxBatchSize))
+                {
+                    entryCount += _pendingBatches.front().entries.size();
+                    batches.push_back(std::move(_pendingBatches.front()));
+                    _pendingBatches.pop_front();
+                }
+            }
+
+            const std::vector<std::size_t> writtenCounts{ write(batches) };
+
+            {
+                const std::scoped_lock lock{ _mutex };
+                _pendingCount -= entryCount;
+            }
+
+            if (_listensWrittenCallback)
+            {
+                std::vector<db::UserId> userIds;
+                for (std::size_t i{}; i < batches.size(); ++i)
+                {
+                    if (writtenCounts[i] == 0)
+                        continue;
+
+                    for (const Entry& entry : batches[i].entries)
+                        userIds.push_back(entry.listen.userId);
+                }
+                std::sort(std::begin(userIds), std::end(userIds));
+                userIds.erase(std::unique(std::begin(userIds), std::end(userIds)), std::end(userIds));
+
+                if (!userIds.empty())
+                    _listensWrittenCallback(userIds);
+            }
+
+            for (std::size_t i{}; i < batches.size(); ++i)
+            {
+                if (batches[i].callback)
+                    batches[i].callback(writtenCounts[i]);
+            }
+
+            {
+                const std::scoped_lock lock{ _mutex };
+                _processedBatchCount += batches.size();
+            }
+            _cv.notify_all();
+        }
+    }
+
+    std::vector<std::size_t> ListenWriter::write(const std::deque<Batch>& batches)
+    {
+        std::vector<std::span<const Entry>> entryGroups;
+        entryGroups.reserve(batches.size());
+        for (const Batch& batch : batches)
+            entryGroups.emplace_back(batch.entries);
+
+        if (std::optional<std::vector<std::size_t>> writtenCounts{ tryWrite(entryGroups) })
+            return std::move(*writtenCounts);
+
+        // Isolate the failure, so that a single bad entry does not discard the listens of the other requests/users
+        std::vector<std::size_t> writtenCounts(batches.size(), 0);
+        for (std::size_t i{}; i < entryGroups.size(); ++i)
+        {
+            const std::span<const Entry> entries{ entryGroups[i] };
+            if (entryGroups.size() > 1)
+            {
+                if (const std::optional<std::vector<std::size_t>> batchWrittenCounts{ tryWrite(std::span{ &entries, 1 }) })
+                {
+                    writtenCounts[i] = batchWrittenCounts->front();
+                    continue;
+                }
+            }
+
+            // already failed on its own
+            if (entries.size() == 1)
+                continue;
+
+            for (std::size_t entryIndex{}; entryIndex < entries.size(); ++entryIndex)
+            {
+                const std::span<const Entry> entry{ entries.subspan(entryIndex, 1) };
+                if (const std::optional<std::vector<std::size_t>> entryWrittenCounts{ tryWrite(std::span{ &entry, 1 }) })
+                    writtenCounts[i] += entryWrittenCounts->front();
+            }
+        }
+
+        return writtenCounts;
+    }
+
+    std::optional<std::vector<std::size_t>> ListenWriter::tryWrite(std::span<const std::span<const Entry>> entryGroups)
+    {
+        std::vector<std::size_t> writtenCounts(entryGroups.size(), 0);
+
+        try
+        {
+            db::Session& session{ _db.getTLSSession() };
+            auto transaction{ session.createWriteTransaction() };
+
+            ExistingListens existingListens{ findExistingListens(session, entryGroups) };
+
+            for (std::size_t i{}; i < entryGroups.size(); ++i)
+            {
+                for (const Entry& entry : entryGroups[i])
+                {
+                    if (write(session, existingListens, entry))
+                        writtenCounts[i]++;
+                }
+            }
+
+            // make sure any failure is reported here rather than on commit
+            session.getDboSession()->flush();
+        }
+        catch (const std::exception& e)
+        {
+            std::size_t entryCount{};
+            for (const std::span<const Entry> entries : entryGroups)
+                entryCount += entries.size();
+
+            LMS_LOG(SCROBBLING, ERROR, "Cannot write " << entryCount << " listen(s): " << e.what());
+            return std::nullopt;
+        }
+
+        return writtenCounts;
+    }
+
+    ListenWriter::ExistingListens ListenWriter::findExistingListens(db::Session& session, std::span<const std::span<const Entry>> entryGroups)
+    {
+        // One query per user/backend, instead of one per entry
+        std::map<std::pair<db::UserId, db::ScrobblingBackend>, std::vector<Wt::WDateTime>> dateTimesByUser;
+        for (const std::span<const Entry> entries : entryGroups)
+        {
+            for (const Entry& entry : entries)
+                dateTimesByUser[{ entry.listen.userId, entry.backend }].push_back(entry.listen.listenedAt);
+        }
+
+        ExistingListens existingListens;
+        for (auto& [userAndBackend, dateTimes] : dateTimesByUser)
+        {
+            std::sort(std::begin(dateTimes), std::end(dateTimes));
+            dateTimes.erase(std::unique(std::begin(dateTimes), std::end(dateTimes)), std::end(dateTimes));
+
+            const auto [userId, backend]{ userAndBackend };
+            db::Listen::find(session, userId, backend, dateTimes, [&](const db::Listen::pointer& listen) {
+                existingListens.emplace(ExistingListenKey{ userId, backend, listen->getTrackId(), listen->getDateTime().toTime_t() }, listen);
+            });
+        }
+
+        return existingListens;
+    }
+
+    bool ListenWriter::write(db::Session& session, ExistingListens& existingListens, const Entry& entry)
+    {
+        const TimedListen& listen{ entry.listen };
+        const ExistingListenKey key{ listen.userId, entry.backend, listen.trackId, listen.listenedAt.toTime_t() };
+
+        auto itListen{ existingListens.find(key) };
+        if (itListen == std::end(existingListens))
+        {
+            const db::User::pointer user{ db::User::find(session, listen.userId) };
+            if (!user)
+                return false;
+
+            const db::Track::pointer track{ db::Track::find(session, listen.trackId) };
+            if (!track)
+                return false;
+
+            db::Listen::pointer dbListen{ session.create<db::Listen>(user, track, entry.backend, listen.listenedAt) };
+            dbListen.modify()->setSyncState(entry.syncState);
+            existingListens.emplace(key, dbListen);
+
+            LMS_LOG(SCROBBLING, DEBUG, "Listen created for user " << user->getLoginName() << ", track '" << track->getName() << "' at " << listen.listenedAt.toString());
+            return true;
+        }
+
+        db::Listen::pointer& dbListen{ itListen->second };
+        if (dbListen->getSyncState() == entry.syncState)
+            return false;
+
+        dbListen.modify()->setSyncState(entry.syncState);
+        return true;
+    }
+} // namespace lms::scrobbling
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+
+#include "core/IOContextRunner.hpp"
+#include "database/Types.hpp"
+#include "database/objects/Listen.hpp"
+#include "database/objects/TrackId.hpp"
+#include "database/objects/UserId.hpp"
+
+#include "services/scrobbling/Listen.hpp"
+
+namespace lms::db
+{
+    class IDb;
+    class Session;
+} // namespace lms::db
+
+namespace lms::scrobbling
+{
+    // Coalesces listen writes from all users/backends into batched write transactions
+    // Writes are processed in submission order, on a dedicated thread
+    // If a coalesced transaction fails, each request, then each entry of the failing requests, is retried in its own transaction
+    class ListenWriter
+    {
+    public:
+        struct Entry
+        {
+            TimedListen listen;
+            db::ScrobblingBackend backend;
+            db::SyncState syncState;
+        };
+
+        // Called on the writer thread once the entries are committed, with the number of listens that were created or updated
+        // Must not wait on the writer itself
+        using CompletionCallback = std::function<void(std::size_t writtenCount)>;
+        // Called on the writer thread once some listens are committed, with the users they belong to (before the completion callbacks)
+        using ListensWrittenCallback = std::function<void(const std::vector<db::UserId>& userIds)>;
+
+        ListenWriter(db::IDb& db, ListensWrittenCallback listensWrittenCallback = {}, std::size_t maxPendingCount = 10'000, std::size_t maxBatchSize = 500);
+        ~ListenWriter(); // flushes pending writes
+        ListenWriter(const ListenWriter&) = delete;
+        ListenWriter& operator=(const ListenWriter&) = delete;
+
+        // Never block and always accepted: callers must bound their own pending entries (by waiting for the completion callback before enqueuing more)
+        void enqueue(const Entry& entry, CompletionCallback callback = {});
+        void enqueue(std::vector<Entry> entries, CompletionCallback callback = {});
+        // Never blocks: the entry is dropped (and the callback not called) if too many entries are already pending
+        bool tryEnqueue(const Entry& entry, CompletionCallback callback = {});
+
+        // Wait for all the entries enqueued so far to be written
+        void flush();
+
+    private:
+        struct Batch
+        {
+            std::vector<Entry> entries;
+            CompletionCallback callback;
+        };
+
+        // listens already in the database, or created by the current write
+        using ExistingListenKey = std::tuple<db::UserId, db::ScrobblingBackend, db::TrackId, std::time_t>;
+        using ExistingListens = std::map<ExistingListenKey, db::Listen::pointer>;
+
+        bool enqueue(std::vector<Entry> entries, CompletionCallback callback, bool bounded);
+        void processPendingBatches();
+        std::vector<std::size_t> write(const std::deque<Batch>& batches);
+        // Written count for each group of entries, std::nullopt if the transaction failed (nothing written)
+        std::optional<std::vector<std::size_t>> tryWrite(std::span<const std::span<const Entry>> entryGroups);
+        static ExistingListens findExistingListens(db::Session& session, std::span<const std::span<const Entry>> entryGroups);
+        static bool write(db::Session& session, ExistingListens& existingListens, const Entry& entry);
+
+        db::IDb& _db;
+        const ListensWrittenCallback _listensWrittenCallback;
+        const std::size_t _maxPendingCount;
+        const std::size_t _maxBatchSize;
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::deque<Batch> _pendingBatches;
+        std::size_t _pendingCount{}; // entries in _pendingBatches
+        bool _processing{};          // processing is scheduled or in progress
+        std::size_t _enqueuedBatchCount{};
+        std::size_t _processedBatchCount{};
+
+        boost::asio::io_context _ioContext;
+        core::IOContextRunner _ioContextRunner{ _ioContext, 1, "ListenWriter" };
+    };
+} // namespace lms::scrobbling
@@ -62,15 +62,18 @@ namespace lms::scrobbling
 
     ScrobblingService::ScrobblingService(boost::asio::io_context& ioContext, db::IDb& db)
         : _db{ db }
+        , _listenWriter{ db, [this](const std::vector<db::UserId>& userIds) { _listenStatsCache.invalidate(userIds); } }
     {
         LMS_LOG(SCROBBLING, INFO, "Starting service...");
-        _scrobblingBackends.emplace(ScrobblingBackend::Internal, std::make_unique<InternalBackend>(_db));
-        _scrobblingBackends.emplace(ScrobblingBackend::ListenBrainz, std::make_unique<listenBrainz::ListenBrainzBackend>(ioContext, _db));
+        _scrobblingBackends.emplace(ScrobblingBackend::Internal, std::make_unique<InternalBackend>(_listenWriter));
+        _scrobblingBackends.emplace(ScrobblingBackend::ListenBrainz, std::make_unique<listenBrainz::ListenBrainzBackend>(ioContext, _db, _listenWriter));
         LMS_LOG(SCROBBLING, INFO, "Service started!");
     }
 
     ScrobblingService::~ScrobblingService()
     {
+        // write pending listens while backends are still alive, as they may be notified
+        _listenWriter.flush();
         LMS_LOG(SCROBBLING, INFO, "Service stopped!");
     }
 
@@ -167,9 +170,7 @@ namespace lms::scrobbling
 
     std::size_t ScrobblingService::getCount(db::UserId userId, db::TrackId trackId)
     {
-        Session& session{ _db.getTLSSession() };
-        auto transaction{ session.createReadTransaction() };
-        return db::Listen::getCount(session, userId, trackId);
+        return getListenStats(userId, std::span{ &trackId, 1 }).front().listenCount;
     }
 
     Wt::WDateTime ScrobblingService::getLastListenDateTime(db::UserId userId, db::ReleaseId releaseId)
@@ -186,16 +187,62 @@ namespace lms::scrobbling
     }
 
     Wt::WDateTime ScrobblingService::getLastListenDateTime(db::UserId userId, db::TrackId trackId)
+    {
+        return getListenStats(userId, std::span{ &trackId, 1 }).front().lastListenDateTime;
+    }
+
+    std::vector<ScrobblingService::TrackListenStats> ScrobblingService::getListenStats(db::UserId userId, std::span<const db::TrackId> trackIds)
     {
         const auto backend{ getUserBackend(userId) };
         if (!backend)
-            return {};
+            return std::vector<TrackListenStats>(trackIds.size());
 
-        Session& session{ _db.getTLSSession() };
-        auto transaction{ session.createReadTransaction() };
+        return getListenStats(userId, *backend, trackIds);
+    }
 
-        const db::Listen::pointer listen{ db::Listen::getMostRecentListen(session, userId, *backend, trackId) };
-        return listen ? listen->getDateTime() : Wt::WDateTime{};
+    std::vector<ScrobblingService::TrackListenStats> ScrobblingService::getListenStats(db::UserId userId, db::ScrobblingBackend backend, std::span<const db::TrackId> trackIds)
+    {
+        std::vector<TrackListenStats> res(trackIds.size());
+
+        std::vector<std::size_t> missingIndexes;
+        for (std::size_t i{}; i < trackIds.size(); ++i)
+        {
+            if (const std::optional<TrackListenStats> stats{ _listenStatsCache.get(userId, backend, trackIds[i]) })
+                res[i] = *stats;
+            else
+                missingIndexes.push_back(i);
+        }
+
+        if (missingIndexes.empty())
+            return res;
+
+        std::vector<db::TrackId> missingTrackIds;
+        missingTrackIds.reserve(missingIndexes.size());
+        for (const std::size_t index : missingIndexes)
+            missingTrackIds.push_back(trackIds[index]);
+
+        const std::uint64_t cacheGeneration{ _listenStatsCache.getGeneration() };
+
+        std::unordered_map<db::TrackId, TrackListenStats> listenedTrackStats;
+        {
+            Session& session{ _db.getTLSSession() };
+            auto transaction{ session.createReadTransaction() };
+
+            db::Listen::getTrackStats(session, userId, backend, missingTrackIds, [&](db::TrackId trackId, std::size_t listenCount, const Wt::WDateTime& lastListenDateTime) {
+                listenedTrackStats[trackId] = TrackListenStats{ listenCount, lastListenDateTime };
+            });
+        }
+
+        // tracks that have never been listened to are cached too
+        for (const std::size_t index : missingIndexes)
+        {
+            if (auto it{ listenedTrackStats.find(trackIds[index]) }; it != std::cend(listenedTrackStats))
+                res[index] = it->second;
+
+            _listenStatsCache.set(cacheGeneration, userId, backend, trackIds[index], res[index]);
+        }
+
+        return res;
     }
 
     // Top
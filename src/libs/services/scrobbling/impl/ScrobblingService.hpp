@@ -26,6 +26,8 @@
 #include "services/scrobbling/IScrobblingService.hpp"
 
 #include "IScrobblingBackend.hpp"
+#include "ListenStatsCache.hpp"
+#include "ListenWriter.hpp"
 
 namespace lms::scrobbling
 {
@@ -49,6 +51,8 @@ namespace lms::scrobbling
 
         Wt::WDateTime getLastListenDateTime(db::UserId userId, db::ReleaseId releaseId) override;
         Wt::WDateTime getLastListenDateTime(db::UserId userId, db::TrackId trackId) override;
+        std::vector<TrackListenStats> getListenStats(db::UserId userId, std::span<const db::TrackId> trackIds) override;
+        std::vector<TrackListenStats> getListenStats(db::UserId userId, db::ScrobblingBackend backend, std::span<const db::TrackId> trackIds) override;
 
         ArtistContainer getTopArtists(const ArtistFindParameters& params) override;
         ReleaseContainer getTopReleases(const FindParameters& params) override;
@@ -57,6 +61,8 @@ namespace lms::scrobbling
         std::optional<db::ScrobblingBackend> getUserBackend(db::UserId userId);
 
         db::IDb& _db;
+        ListenStatsCache _listenStatsCache{ 64 /* maxUserCount */, 4096 /* maxTrackCountPerUser */ }; // invalidated by the listen writer
+        ListenWriter _listenWriter;         // must outlive backends
         std::unordered_map<db::ScrobblingBackend, std::unique_ptr<IScrobblingBackend>> _scrobblingBackends;
     };
 
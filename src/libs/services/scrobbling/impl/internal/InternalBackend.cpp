@@ -19,16 +19,12 @@
 
 #include "InternalBackend.hpp"
 
-#include "database/IDb.hpp"
-#include "database/Session.hpp"
-#include "database/objects/Listen.hpp"
-#include "database/objects/Track.hpp"
-#include "database/objects/User.hpp"
+#include "ListenWriter.hpp"
 
 namespace lms::scrobbling
 {
-    InternalBackend::InternalBackend(db::IDb& db)
-        : _db{ db }
+    InternalBackend::InternalBackend(ListenWriter& listenWriter)
+        : _listenWriter{ listenWriter }
     {
     }
 
@@ -48,21 +44,6 @@ namespace lms::scrobbling
 
     void InternalBackend::addTimedListen(const TimedListen& listen)
     {
-        db::Session& session{ _db.getTLSSession() };
-        auto transaction{ session.createWriteTransaction() };
-
-        if (db::Listen::find(session, listen.userId, listen.trackId, db::ScrobblingBackend::Internal, listen.listenedAt))
-            return;
-
-        const db::User::pointer user{ db::User::find(session, listen.userId) };
-        if (!user)
-            return;
-
-        const db::Track::pointer track{ db::Track::find(session, listen.trackId) };
-        if (!track)
-            return;
-
-        auto dbListen{ session.create<db::Listen>(user, track, db::ScrobblingBackend::Internal, listen.listenedAt) };
-        dbListen.modify()->setSyncState(db::SyncState::Synchronized);
+        _listenWriter.tryEnqueue(ListenWriter::Entry{ listen, db::ScrobblingBackend::Internal, db::SyncState::Synchronized });
     }
 } // namespace lms::scrobbling
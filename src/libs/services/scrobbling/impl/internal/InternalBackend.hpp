@@ -21,9 +21,9 @@
 
 #include "IScrobblingBackend.hpp"
 
-namespace lms::db
+namespace lms::scrobbling
 {
-    class IDb;
+    class ListenWriter;
 }
 
 namespace lms::scrobbling
@@ -31,13 +31,13 @@ namespace lms::scrobbling
     class InternalBackend final : public IScrobblingBackend
     {
     public:
-        InternalBackend(db::IDb& db);
+        InternalBackend(ListenWriter& listenWriter);
 
     private:
         void listenStarted(const Listen& listen) override;
         void listenFinished(const Listen& listen, std::optional<std::chrono::seconds> duration) override;
         void addTimedListen(const TimedListen& listen) override;
 
-        db::IDb& _db;
+        ListenWriter& _listenWriter;
     };
 } // namespace lms::scrobbling
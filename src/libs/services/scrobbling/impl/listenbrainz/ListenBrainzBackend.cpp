@@ -51,12 +51,12 @@ namespace lms::scrobbling::listenBrainz
         }
     } // namespace
 
-    ListenBrainzBackend::ListenBrainzBackend(boost::asio::io_context& ioContext, db::IDb& db)
+    ListenBrainzBackend::ListenBrainzBackend(boost::asio::io_context& ioContext, db::IDb& db, ListenWriter& listenWriter)
         : _ioContext{ ioContext }
         , _db{ db }
         , _baseAPIUrl{ core::Service<core::IConfig>::get()->getString("listenbrainz-api-base-url", "https://api.listenbrainz.org") }
         , _client{ core::http::createClient(_ioContext, _baseAPIUrl) }
-        , _listensSynchronizer{ _ioContext, db, *_client }
+        , _listensSynchronizer{ _ioContext, db, *_client, listenWriter }
     {
         LOG(INFO, "Starting ListenBrainz backend... API endpoint = '" << _baseAPIUrl << "'");
     }
@@ -27,17 +27,24 @@
 #include "IScrobblingBackend.hpp"
 #include "ListensSynchronizer.hpp"
 
-namespace lms::db
+namespace lms
 {
-    class IDb;
-}
+    namespace db
+    {
+        class IDb;
+    }
+    namespace scrobbling
+    {
+        class ListenWriter;
+    }
+} // namespace lms
 
 namespace lms::scrobbling::listenBrainz
 {
     class ListenBrainzBackend final : public IScrobblingBackend
     {
     public:
-        ListenBrainzBackend(boost::asio::io_context& ioContext, db::IDb& db);
+        ListenBrainzBackend(boost::asio::io_context& ioContext, db::IDb& db, ListenWriter& listenWriter);
         ~ListenBrainzBackend() override;
 
     private:
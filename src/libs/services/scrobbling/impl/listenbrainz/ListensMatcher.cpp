@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ListensMatcher.hpp"
+
+#include <cassert>
+
+#include "database/Session.hpp"
+#include "database/objects/Track.hpp"
+
+#include "Utils.hpp"
+
+namespace lms::scrobbling::listenBrainz
+{
+    namespace
+    {
+        enum class MBIDMatchResult
+        {
+            NotFound,
+            Ambiguous,
+            Found,
+        };
+
+        template<typename MBIDMatches>
+        MBIDMatchResult getMBIDMatchResult(const MBIDMatches& matches, const std::optional<core::UUID>& MBID, db::TrackId& trackId)
+        {
+            if (!MBID)
+                return MBIDMatchResult::NotFound;
+
+            const auto it{ matches.find(*MBID) };
+            assert(it != std::cend(matches));
+
+            if (it->second.trackCount == 0)
+                return MBIDMatchResult::NotFound;
+            if (it->second.trackCount > 1)
+                return MBIDMatchResult::Ambiguous;
+
+            trackId = it->second.trackId;
+            return MBIDMatchResult::Found;
+        }
+    } // namespace
+
+    std::vector<db::TrackId> ListensMatcher::match(db::Session& session, std::span<const Listen> listens)
+    {
+        std::vector<db::TrackId> res(listens.size());
+        std::vector<bool> resolved(listens.size());
+
+        auto transaction{ session.createReadTransaction() };
+
+        // first try to match using track MBID, and then fallback on possibly ambiguous info
+        {
+            std::vector<core::UUID> MBIDs;
+            for (const Listen& listen : listens)
+            {
+                if (listen.trackMBID)
+                    MBIDs.push_back(*listen.trackMBID);
+            }
+            resolveMBIDs(session, MBIDs, _trackMBIDMatches, &db::Track::findIdsByMBID);
+
+            for (std::size_t i{}; i < listens.size(); ++i)
+            {
+                switch (getMBIDMatchResult(_trackMBIDMatches, listens[i].trackMBID, res[i]))
+                {
+                case MBIDMatchResult::Found:
+                    LOG(DEBUG, "Matched listen '" << listens[i] << "' using track MBID");
+                    resolved[i] = true;
+                    break;
+                case MBIDMatchResult::Ambiguous:
+                    // if duplicated files, do not record it (let the user correct its database)
+                    LOG(DEBUG, "Too many matches for listen '" << listens[i] << "' using track MBID!");
+                    resolved[i] = true;
+                    break;
+                case MBIDMatchResult::NotFound:
+                    break;
+                }
+            }
+        }
+
+        {
+            std::vector<core::UUID> MBIDs;
+            for (std::size_t i{}; i < listens.size(); ++i)
+            {
+                if (!resolved[i] && listens[i].recordingMBID)
+                    MBIDs.push_back(*listens[i].recordingMBID);
+            }
+            resolveMBIDs(session, MBIDs, _recordingMBIDMatches, &db::Track::findIdsByRecordingMBID);
+
+            for (std::size_t i{}; i < listens.size(); ++i)
+            {
+                if (resolved[i])
+                    continue;
+
+                switch (getMBIDMatchResult(_recordingMBIDMatches, listens[i].recordingMBID, res[i]))
+                {
+                case MBIDMatchResult::Found:
+                    LOG(DEBUG, "Matched listen '" << listens[i] << "' using recording MBID");
+                    resolved[i] = true;
+                    break;
+                case MBIDMatchResult::Ambiguous:
+                    // if duplicated files, do not record it (let the user correct its database)
+                    LOG(DEBUG, "Too many matches for listen '" << listens[i] << "' using recording MBID!");
+                    resolved[i] = true;
+                    break;
+                case MBIDMatchResult::NotFound:
+                    break;
+                }
+            }
+        }
+
+        for (std::size_t i{}; i < listens.size(); ++i)
+        {
+            if (!resolved[i])
+                res[i] = matchUsingMetadata(session, listens[i]);
+        }
+
+        return res;
+    }
+
+    void ListensMatcher::clear()
+    {
+        _trackMBIDMatches.clear();
+        _recordingMBIDMatches.clear();
+        _metadataMatches.clear();
+    }
+
+    void ListensMatcher::resolveMBIDs(db::Session& session, std::span<const core::UUID> MBIDs, MBIDMatches& matches, FindTrackIdsFunc findTrackIds)
+    {
+        // only look up the MBIDs never seen before, once
+        std::vector<core::UUID> newMBIDs;
+        for (const core::UUID& MBID : MBIDs)
+        {
+            if (matches.try_emplace(MBID).second)
+                newMBIDs.push_back(MBID);
+        }
+
+        if (newMBIDs.empty())
+            return;
+
+        findTrackIds(session, newMBIDs, [&](const core::UUID& MBID, db::TrackId trackId) {
+            MBIDMatch& match{ matches[MBID] };
+            match.trackCount++;
+            match.trackId = trackId;
+        });
+    }
+
+    db::TrackId ListensMatcher::matchUsingMetadata(db::Session& session, const Listen& listen)
+    {
+        assert(!listen.trackName.empty() && !listen.artistName.empty());
+
+        MetadataKey key{ listen.trackName, listen.releaseName, listen.artistName, listen.trackNumber };
+        if (const auto it{ _metadataMatches.find(key) }; it != std::cend(_metadataMatches))
+        {
+            LOG(DEBUG, (it->second.isValid() ? "Matched" : "No match for") << " listen '" << listen << "' using cached metadata");
+            return it->second;
+        }
+
+        // TODO check release MBID?
+        db::Track::FindParameters params;
+        params.setName(listen.trackName);
+        params.setReleaseName(listen.releaseName);
+        params.setArtistName(listen.artistName);
+        if (listen.trackNumber)
+            params.setTrackNumber(*listen.trackNumber);
+
+        db::TrackId trackId;
+        const auto tracks{ db::Track::findIds(session, params) };
+        // conservative behavior: in case of multiple matches: reject
+        if (tracks.results.size() == 1)
+        {
+            LOG(DEBUG, "Matched listen '" << listen << "' using metadata");
+            trackId = tracks.results.front();
+        }
+        else if (tracks.results.size() > 1)
+            LOG(DEBUG, "Too many matches for listen '" << listen << "' using metadata");
+        else
+            LOG(DEBUG, "No match for listen '" << listen << "'");
+
+        _metadataMatches.emplace(std::move(key), trackId);
+        return trackId;
+    }
+} // namespace lms::scrobbling::listenBrainz
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "core/UUID.hpp"
+#include "database/objects/TrackId.hpp"
+
+#include "ListenTypes.hpp"
+
+namespace lms::db
+{
+    class Session;
+}
+
+namespace lms::scrobbling::listenBrainz
+{
+    // Matches fetched listens against the tracks of the database, a whole page at once:
+    // MBIDs are resolved using set-based queries, and the metadata lookups are deduplicated
+    // Lookup results (including failures) are kept so that the next pages of the same sync are cheaper
+    class ListensMatcher
+    {
+    public:
+        // Returns the matching track of each listen, or an invalid id if no unique match is found
+        std::vector<db::TrackId> match(db::Session& session, std::span<const Listen> listens);
+
+        void clear();
+
+    private:
+        struct MBIDMatch
+        {
+            std::size_t trackCount{};
+            db::TrackId trackId; // if trackCount == 1
+        };
+        using MBIDMatches = std::map<core::UUID, MBIDMatch>;
+
+        // same fields as used by the metadata search
+        using MetadataKey = std::tuple<std::string, std::string, std::string, std::optional<unsigned>>;
+
+        using FindTrackIdsFunc = void (*)(db::Session& session, std::span<const core::UUID> MBIDs, const std::function<void(const core::UUID& MBID, db::TrackId trackId)>& func);
+        static void resolveMBIDs(db::Session& session, std::span<const core::UUID> MBIDs, MBIDMatches& matches, FindTrackIdsFunc findTrackIds);
+        db::TrackId matchUsingMetadata(db::Session& session, const Listen& listen);
+
+        MBIDMatches _trackMBIDMatches;
+        MBIDMatches _recordingMBIDMatches;
+        std::map<MetadataKey, db::TrackId> _metadataMatches;
+    };
+} // namespace lms::scrobbling::listenBrainz
@@ -143,78 +143,13 @@ namespace lms::scrobbling::listenBrainz
                 return std::nullopt;
             }
         }
-
-        db::TrackId tryGetMatchingTrack(db::Session& session, const Listen& listen)
-        {
-            using namespace db;
-
-            auto transaction{ session.createReadTransaction() };
-
-            // first try to match using track MBID, and then fallback on possibly ambiguous info
-            if (listen.trackMBID)
-            {
-                const auto tracks{ Track::findByMBID(session, *listen.trackMBID) };
-                // if duplicated files, do not record it (let the user correct its database)
-                if (tracks.size() == 1)
-                {
-                    LOG(DEBUG, "Matched listen '" << listen << "' using track MBID");
-                    return tracks.front()->getId();
-                }
-                else if (tracks.size() > 1)
-                {
-                    LOG(DEBUG, "Too many matches for listen '" << listen << "' using track MBID!");
-                    return {};
-                }
-            }
-
-            if (listen.recordingMBID)
-            {
-                const auto tracks{ Track::findByRecordingMBID(session, *listen.recordingMBID) };
-                // if duplicated files, do not record it (let the user correct its database)
-                if (tracks.size() == 1)
-                {
-                    LOG(DEBUG, "Matched listen '" << listen << "' using recording MBID");
-                    return tracks.front()->getId();
-                }
-                else if (tracks.size() > 1)
-                {
-                    LOG(DEBUG, "Too many matches for listen '" << listen << "' using recording MBID!");
-                    return {};
-                }
-            }
-
-            assert(!listen.trackName.empty() && !listen.artistName.empty());
-
-            // TODO check release MBID?
-            Track::FindParameters params;
-            params.setName(listen.trackName);
-            params.setReleaseName(listen.releaseName);
-            params.setArtistName(listen.artistName);
-            if (listen.trackNumber)
-                params.setTrackNumber(*listen.trackNumber);
-
-            const auto tracks{ Track::findIds(session, params) };
-            // conservative behavior: in case of multiple matches: reject
-            if (tracks.results.size() == 1)
-            {
-                LOG(DEBUG, "Matched listen '" << listen << "' using metadata");
-                return tracks.results.front();
-            }
-            else if (tracks.results.size() > 1)
-            {
-                LOG(DEBUG, "Too many matches for listen '" << listen << "' using metadata");
-                return {};
-            }
-
-            LOG(DEBUG, "No match for listen '" << listen << "'");
-            return {};
-        }
     } // namespace
 
-    ListensSynchronizer::ListensSynchronizer(boost::asio::io_context& ioContext, db::IDb& db, core::http::IClient& client)
+    ListensSynchronizer::ListensSynchronizer(boost::asio::io_context& ioContext, db::IDb& db, core::http::IClient& client, ListenWriter& listenWriter)
         : _ioContext{ ioContext }
         , _db{ db }
         , _client{ client }
+        , _listenWriter{ listenWriter }
         , _maxSyncListenCount{ core::Service<core::IConfig>::get()->getULong("listenbrainz-max-sync-listen-count", 1000) }
         , _syncListensPeriod{ core::Service<core::IConfig>::get()->getULong("listenbrainz-sync-listens-period-hours", 1) }
     {
@@ -247,14 +182,16 @@ namespace lms::scrobbling::listenBrainz
 
             request.priority = core::http::ClientRequestParameters::Priority::Normal;
             request.onSuccessFunc = [this, timedListen](const Wt::Http::Message&) {
-                boost::asio::post(boost::asio::bind_executor(_strand, [this, timedListen] {
-                    if (saveListen(timedListen, db::SyncState::Synchronized))
-                    {
-                        UserContext& context{ getUserContext(timedListen.userId) };
+                saveListen(timedListen, db::SyncState::Synchronized, [this, userId = timedListen.userId](std::size_t writtenCount) {
+                    if (writtenCount == 0)
+                        return;
+
+                    boost::asio::post(boost::asio::bind_executor(_strand, [this, userId] {
+                        UserContext& context{ getUserContext(userId) };
                         if (context.listenCount)
                             (*context.listenCount)++;
-                    }
-                }));
+                    }));
+                });
             };
             // on failure, this listen will be sent during the next sync
         }
@@ -285,37 +222,11 @@ namespace lms::scrobbling::listenBrainz
         _client.sendPOSTRequest(std::move(request));
     }
 
-    bool ListensSynchronizer::saveListen(const TimedListen& listen, db::SyncState scrobblingState)
+    void ListensSynchronizer::saveListen(const TimedListen& listen, db::SyncState syncState, ListenWriter::CompletionCallback callback)
     {
-        using namespace db;
-
-        Session& session{ _db.getTLSSession() };
-        auto transaction{ session.createWriteTransaction() }; // TODO: unique only if needed
-
-        db::Listen::pointer dbListen{ db::Listen::find(session, listen.userId, listen.trackId, db::ScrobblingBackend::ListenBrainz, listen.listenedAt) };
-        if (!dbListen)
-        {
-            const User::pointer user{ User::find(session, listen.userId) };
-            if (!user)
-                return false;
-
-            const Track::pointer track{ Track::find(session, listen.trackId) };
-            if (!track)
-                return false;
-
-            dbListen = session.create<db::Listen>(user, track, db::ScrobblingBackend::ListenBrainz, listen.listenedAt);
-            dbListen.modify()->setSyncState(scrobblingState);
-
-            LOG(DEBUG, "LISTEN CREATED for user " << user->getLoginName() << ", track '" << track->getName() << "' AT " << listen.listenedAt.toString());
-
-            return true;
-        }
-
-        if (dbListen->getSyncState() == scrobblingState)
-            return false;
-
-        dbListen.modify()->setSyncState(scrobblingState);
-        return true;
+        // Written asynchronously, but in order: the final sync state always wins
+        // Dropped if the writer is overloaded: listens left pending are sent again on the next sync
+        _listenWriter.tryEnqueue(ListenWriter::Entry{ listen, db::ScrobblingBackend::ListenBrainz, syncState }, std::move(callback));
     }
 
     void ListensSynchronizer::enquePendingListens()
@@ -426,6 +337,7 @@ namespace lms::scrobbling::listenBrainz
         context.fetchedListenCount = 0;
         context.matchedListenCount = 0;
         context.importedListenCount = 0;
+        context.listensMatcher.clear();
 
         enqueValidateToken(context);
     }
@@ -513,14 +425,18 @@ namespace lms::scrobbling::listenBrainz
         request.relativeUrl = "/1/user/" + context.listenBrainzUserName + "/listens?max_ts=" + std::to_string(context.maxDateTime.toTime_t());
         request.priority = core::http::ClientRequestParameters::Priority::Low;
         request.onSuccessFunc = [this, &context](const Wt::Http::Message& msg) {
-            processGetListensResponse(msg.body(), context);
-            if (context.fetchedListenCount >= _maxSyncListenCount || !context.maxDateTime.isValid())
-            {
-                onSyncEnded(context);
-                return;
-            }
+            // Save the whole page at once, and only fetch the next one when done: at most one page per user is pending in the writer
+            _listenWriter.enqueue(processGetListensResponse(msg.body(), context), [this, &context](std::size_t importedCount) {
+                context.importedListenCount += importedCount;
 
-            enqueGetListens(context);
+                if (context.fetchedListenCount >= _maxSyncListenCount || !context.maxDateTime.isValid())
+                {
+                    onSyncEnded(context);
+                    return;
+                }
+
+                enqueGetListens(context);
+            });
         };
         request.onFailureFunc = [this, &context] {
             onSyncEnded(context);
@@ -529,15 +445,15 @@ namespace lms::scrobbling::listenBrainz
         _client.sendGETRequest(std::move(request));
     }
 
-    void ListensSynchronizer::processGetListensResponse(std::string_view msgBody, UserContext& context)
+    std::vector<ListenWriter::Entry> ListensSynchronizer::processGetListensResponse(std::string_view msgBody, UserContext& context)
     {
-        db::Session& session{ _db.getTLSSession() };
-
         context.maxDateTime = {}; // invalidate to break in case no more listens are fetched
         ListensParser::Result result{ ListensParser::parse(msgBody) };
         context.fetchedListenCount += result.listenCount;
 
-        for (const Listen& parsedListen : result.listens)
+        std::vector<Listen> parsedListens;
+        parsedListens.reserve(result.listens.size());
+        for (Listen& parsedListen : result.listens)
         {
             // update oldest listen for the next query
             if (!parsedListen.listenedAt.isValid())
@@ -549,14 +465,23 @@ namespace lms::scrobbling::listenBrainz
             if (!context.maxDateTime.isValid() || context.maxDateTime > parsedListen.listenedAt)
                 context.maxDateTime = parsedListen.listenedAt;
 
-            if (const db::TrackId trackId{ tryGetMatchingTrack(session, parsedListen) }; trackId.isValid())
-            {
-                context.matchedListenCount++;
+            parsedListens.push_back(std::move(parsedListen));
+        }
 
-                const scrobbling::TimedListen listen{ { context.userId, trackId }, parsedListen.listenedAt };
-                if (saveListen(listen, db::SyncState::Synchronized))
-                    context.importedListenCount++;
-            }
+        const std::vector<db::TrackId> trackIds{ context.listensMatcher.match(_db.getTLSSession(), parsedListens) };
+
+        std::vector<ListenWriter::Entry> matchedListens;
+        for (std::size_t i{}; i < parsedListens.size(); ++i)
+        {
+            if (!trackIds[i].isValid())
+                continue;
+
+            context.matchedListenCount++;
+
+            const scrobbling::TimedListen listen{ { context.userId, trackIds[i] }, parsedListens[i].listenedAt };
+            matchedListens.push_back(ListenWriter::Entry{ listen, db::ScrobblingBackend::ListenBrainz, db::SyncState::Synchronized });
         }
+
+        return matchedListens;
     }
 } // namespace lms::scrobbling::listenBrainz
@@ -21,6 +21,7 @@
 
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/io_context_strand.hpp>
@@ -31,6 +32,9 @@
 
 #include "services/scrobbling/Listen.hpp"
 
+#include "ListenWriter.hpp"
+#include "ListensMatcher.hpp"
+
 namespace lms
 {
     namespace core::http
@@ -48,14 +52,14 @@ namespace lms::scrobbling::listenBrainz
     class ListensSynchronizer
     {
     public:
-        ListensSynchronizer(boost::asio::io_context& ioContext, db::IDb& db, core::http::IClient& client);
+        ListensSynchronizer(boost::asio::io_context& ioContext, db::IDb& db, core::http::IClient& client, ListenWriter& listenWriter);
 
         void enqueListen(const TimedListen& listen);
         void enqueListenNow(const Listen& listen);
 
     private:
         void enqueListen(const Listen& listen, const Wt::WDateTime& timePoint);
-        bool saveListen(const TimedListen& listen, db::SyncState scrobblinState);
+        void saveListen(const TimedListen& listen, db::SyncState syncState, ListenWriter::CompletionCallback callback = {});
 
         void enquePendingListens();
 
@@ -79,6 +83,7 @@ namespace lms::scrobbling::listenBrainz
             std::size_t fetchedListenCount{};
             std::size_t matchedListenCount{};
             std::size_t importedListenCount{};
+            ListensMatcher listensMatcher;
         };
 
         UserContext& getUserContext(db::UserId userId);
@@ -90,13 +95,14 @@ namespace lms::scrobbling::listenBrainz
         void enqueValidateToken(UserContext& context);
         void enqueGetListenCount(UserContext& context);
         void enqueGetListens(UserContext& context);
-        void processGetListensResponse(std::string_view body, UserContext& context);
+        std::vector<ListenWriter::Entry> processGetListensResponse(std::string_view body, UserContext& context);
 
         boost::asio::io_context& _ioContext;
         boost::asio::io_context::strand _strand{ _ioContext };
         db::IDb& _db;
         boost::asio::steady_timer _syncTimer{ _ioContext };
         core::http::IClient& _client;
+        ListenWriter& _listenWriter;
 
         std::unordered_map<db::UserId, UserContext> _userContexts;
 
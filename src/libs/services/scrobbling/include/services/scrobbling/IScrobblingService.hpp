@@ -22,6 +22,8 @@
 #include <chrono>
 #include <memory>
 #include <optional>
+#include <span>
+#include <vector>
 
 #include <Wt/WDateTime.h>
 #include <boost/asio/io_context.hpp>
@@ -120,6 +122,16 @@ namespace lms::scrobbling
         virtual Wt::WDateTime getLastListenDateTime(db::UserId userId, db::ReleaseId releaseId) = 0;
         virtual Wt::WDateTime getLastListenDateTime(db::UserId userId, db::TrackId trackId) = 0;
 
+        struct TrackListenStats
+        {
+            std::size_t listenCount{};
+            Wt::WDateTime lastListenDateTime; // invalid if never listened
+        };
+        // Same order as trackIds, for the current backend of the user
+        virtual std::vector<TrackListenStats> getListenStats(db::UserId userId, std::span<const db::TrackId> trackIds) = 0;
+        // Same, when the backend of the user is already known
+        virtual std::vector<TrackListenStats> getListenStats(db::UserId userId, db::ScrobblingBackend backend, std::span<const db::TrackId> trackIds) = 0;
+
         // Top
         virtual ArtistContainer getTopArtists(const ArtistFindParameters& params) = 0;
         virtual ReleaseContainer getTopReleases(const FindParameters& params) = 0;
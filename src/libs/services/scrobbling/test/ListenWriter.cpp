@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "database/Session.hpp"
+#include "database/test/TmpDatabase.hpp"
+#include "database/objects/Listen.hpp"
+#include "database/objects/Track.hpp"
+#include "database/objects/User.hpp"
+
+#include "ListenWriter.hpp"
+
+namespace lms::scrobbling::tests
+{
+    namespace
+    {
+        class ListenWriterTest : public ::testing::Test
+        {
+        protected:
+            void SetUp() override
+            {
+                auto transaction{ _session.createWriteTransaction() };
+
+                for (std::size_t i{}; i < 2; ++i)
+                    _userIds.push_back(_session.create<db::User>("MyUser" + std::to_string(i))->getId());
+                for (std::size_t i{}; i < 3; ++i)
+                    _trackIds.push_back(_session.create<db::Track>()->getId());
+            }
+
+            static ListenWriter::Entry createEntry(db::UserId userId, db::TrackId trackId, long long listenedAt)
+            {
+                return ListenWriter::Entry{ TimedListen{ { userId, trackId }, Wt::WDateTime::fromTime_t(listenedAt) }, db::ScrobblingBackend::Internal, db::SyncState::Synchronized };
+            }
+
+            std::size_t getListenCount()
+            {
+                auto transaction{ _session.createReadTransaction() };
+                return db::Listen::getCount(_session);
+            }
+
+            db::tests::TmpDatabase _tmpDb;
+            db::Session _session{ _tmpDb.getDb() };
+            std::vector<db::UserId> _userIds;
+            std::vector<db::TrackId> _trackIds;
+        };
+
+        // Blocks the writer thread from a completion callback, until released
+        class WriterGate
+        {
+        public:
+            ListenWriter::CompletionCallback getCallback()
+            {
+                return [this](std::size_t) {
+                    _entered.set_value();
+                    _released.get_future().wait();
+                };
+            }
+
+            void waitEntered() { _entered.get_future().wait(); }
+            void release() { _released.set_value(); }
+
+        private:
+            std::promise<void> _entered;
+            std::promise<void> _released;
+        };
+    } // namespace
+
+    TEST_F(ListenWriterTest, coalescing)
+    {
+        std::mutex mutex;
+        std::vector<std::vector<db::UserId>> writtenUserIds;
+        std::vector<std::size_t> writtenCounts;
+
+        WriterGate gate;
+        {
+            ListenWriter writer{ _tmpDb.getDb(), [&](const std::vector<db::UserId>& userIds) {
+                                    const std::scoped_lock lock{ mutex };
+                                    writtenUserIds.push_back(userIds);
+                                } };
+
+            writer.enqueue(createEntry(_userIds[0], _trackIds[0], 1000), gate.getCallback());
+            gate.waitEntered();
+
+            // pending while the writer is busy: written in a single transaction
+            for (std::size_t i{}; i < 3; ++i)
+            {
+                writer.enqueue({ createEntry(_userIds[i % 2], _trackIds[i], 2000), createEntry(_userIds[i % 2], _trackIds[i], 2001) }, [&](std::size_t writtenCount) {
+                    const std::scoped_lock lock{ mutex };
+                    writtenCounts.push_back(writtenCount);
+                });
+            }
+
+            gate.release();
+            writer.flush();
+        }
+
+        EXPECT_EQ(writtenCounts, (std::vector<std::size_t>{ 2, 2, 2 }));
+        ASSERT_EQ(writtenUserIds.size(), 2);
+        EXPECT_EQ(writtenUserIds[0], (std::vector<db::UserId>{ _userIds[0] }));
+        EXPECT_EQ(writtenUserIds[1], (std::vector<db::UserId>{ _userIds[0], _userIds[1] }));
+        EXPECT_EQ(getListenCount(), 7);
+    }
+
+    TEST_F(ListenWriterTest, dropWhenFull)
+    {
+        WriterGate gate;
+        ListenWriter writer{ _tmpDb.getDb(), {}, 2 /* maxPendingCount */ };
+
+        writer.enqueue(createEntry(_userIds[0], _trackIds[0], 1000), gate.getCallback());
+        gate.waitEntered();
+
+        EXPECT_TRUE(writer.tryEnqueue(createEntry(_userIds[0], _trackIds[0], 2000)));
+        EXPECT_TRUE(writer.tryEnqueue(createEntry(_userIds[0], _trackIds[0], 2001)));
+
+        // never blocks while the writer is stuck
+        bool callbackCalled{};
+        EXPECT_FALSE(writer.tryEnqueue(createEntry(_userIds[0], _trackIds[0], 3000), [&](std::size_t) { callbackCalled = true; }));
+        writer.enqueue(createEntry(_userIds[0], _trackIds[0], 4000));
+
+        gate.release();
+        writer.flush();
+
+        EXPECT_FALSE(callbackCalled);
+        EXPECT_EQ(getListenCount(), 4);
+    }
+
+    TEST_F(ListenWriterTest, flushOnDestruction)
+    {
+        std::size_t writtenCount{};
+        {
+            ListenWriter writer{ _tmpDb.getDb() };
+            writer.enqueue({ createEntry(_userIds[0], _trackIds[0], 1000), createEntry(_userIds[1], _trackIds[1], 1000) }, [&](std::size_t count) { writtenCount = count; });
+        }
+
+        EXPECT_EQ(writtenCount, 2);
+        EXPECT_EQ(getListenCount(), 2);
+    }
+
+    TEST_F(ListenWriterTest, failureIsolation)
+    {
+        {
+            auto transaction{ _session.createWriteTransaction() };
+            _session.execute("CREATE TRIGGER reject_listen BEFORE INSERT ON listen WHEN NEW.track_id = " + _trackIds[2].toString() + " BEGIN SELECT RAISE(ABORT, 'rejected'); END");
+        }
+
+        std::mutex mutex;
+        std::vector<std::size_t> writtenCounts(3);
+
+        WriterGate gate;
+        {
+            ListenWriter writer{ _tmpDb.getDb() };
+
+            writer.enqueue(createEntry(_userIds[0], _trackIds[0], 1000), gate.getCallback());
+            gate.waitEntered();
+
+            // coalesced with the bad entry
+            const auto onWritten{ [&](std::size_t index) {
+                return [&, index](std::size_t writtenCount) {
+                    const std::scoped_lock lock{ mutex };
+                    writtenCounts[index] = writtenCount;
+                };
+            } };
+            writer.enqueue(createEntry(_userIds[0], _trackIds[0], 2000), onWritten(0));
+            writer.enqueue({ createEntry(_userIds[1], _trackIds[1], 2000), createEntry(_userIds[1], _trackIds[2], 2001) }, onWritten(1));
+            writer.enqueue(createEntry(_userIds[1], _trackIds[2], 2002), onWritten(2));
+
+            gate.release();
+        }
+
+        EXPECT_EQ(writtenCounts, (std::vector<std::size_t>{ 1, 1, 0 }));
+        EXPECT_EQ(getListenCount(), 3);
+    }
+} // namespace lms::scrobbling::tests
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <future>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+#include <gtest/gtest.h>
+
+#include "core/IOContextRunner.hpp"
+#include "core/http/IClient.hpp"
+#include "database/IDb.hpp"
+#include "database/Session.hpp"
+#include "database/objects/Listen.hpp"
+#include "database/objects/Track.hpp"
+#include "database/objects/User.hpp"
+#include "database/test/TmpDatabase.hpp"
+
+#include "ListenWriter.hpp"
+#include "listenbrainz/ListensMatcher.hpp"
+#include "listenbrainz/ListensParser.hpp"
+
+namespace lms::scrobbling::listenBrainz::tests
+{
+    namespace
+    {
+        // Minimal HTTP/1.1 server, answering canned responses depending on the request path (query excluded)
+        class MockListenBrainzServer
+        {
+        public:
+            MockListenBrainzServer(std::map<std::string, std::string> responses)
+                : _responses{ std::move(responses) }
+            {
+                _acceptor.open(boost::asio::ip::tcp::v4());
+                _acceptor.bind(boost::asio::ip::tcp::endpoint{ boost::asio::ip::address_v4::loopback(), 0 });
+                _acceptor.listen();
+                asyncAccept();
+
+                _thread = std::thread{ [this] { _ioContext.run(); } };
+            }
+
+            ~MockListenBrainzServer()
+            {
+                _ioContext.stop();
+                _thread.join();
+            }
+            MockListenBrainzServer(const MockListenBrainzServer&) = delete;
+            MockListenBrainzServer& operator=(const MockListenBrainzServer&) = delete;
+
+            std::string getBaseUrl() const { return "http://127.0.0.1:" + std::to_string(_acceptor.local_endpoint().port()); }
+
+        private:
+            void asyncAccept()
+            {
+                _acceptor.async_accept([this](const boost::system::error_code& ec, boost::asio::ip::tcp::socket socket) {
+                    if (ec)
+                        return;
+
+                    serve(socket);
+                    asyncAccept();
+                });
+            }
+
+            void serve(boost::asio::ip::tcp::socket& socket)
+            {
+                boost::system::error_code ec;
+
+                boost::asio::streambuf requestBuffer;
+                boost::asio::read_until(socket, requestBuffer, "\r\n\r\n", ec);
+                if (ec)
+                    return;
+
+                std::istream requestStream{ &requestBuffer };
+                std::string method;
+                std::string target;
+                requestStream >> method >> target;
+
+                const std::string path{ target.substr(0, target.find('?')) };
+                const auto itResponse{ _responses.find(path) };
+
+                std::ostringstream response;
+                if (itResponse != std::cend(_responses))
+                    response << "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " << itResponse->second.size() << "\r\nConnection: close\r\n\r\n" << itResponse->second;
+                else
+                    response << "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+
+                boost::asio::write(socket, boost::asio::buffer(response.str()), ec);
+                socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+            }
+
+            const std::map<std::string, std::string> _responses;
+            boost::asio::io_context _ioContext;
+            boost::asio::ip::tcp::acceptor _acceptor{ _ioContext };
+            std::thread _thread;
+        };
+
+        std::string listenToJson(std::string_view trackName, long long listenedAt, std::string_view recordingMBID, std::string_view trackMBID = "")
+        {
+            std::ostringstream oss;
+            oss << R"({"listened_at":)" << listenedAt << R"(,"track_metadata":{"artist_name":"MyArtist","release_name":"MyRelease","track_name":")" << trackName << R"(","additional_info":{)";
+            oss << R"("recording_mbid":")" << recordingMBID << R"(")";
+            if (!trackMBID.empty())
+                oss << R"(,"track_mbid":")" << trackMBID << R"(")";
+            oss << "}}}";
+            return oss.str();
+        }
+
+        std::string fetchListens(std::string_view baseUrl, std::string_view relativeUrl)
+        {
+            boost::asio::io_context ioContext;
+            core::IOContextRunner ioContextRunner{ ioContext, 1, "TestHttpClient" };
+            auto client{ core::http::createClient(ioContext, baseUrl) };
+
+            std::promise<std::string> body;
+            core::http::ClientGETRequestParameters request;
+            request.relativeUrl = relativeUrl;
+            request.onSuccessFunc = [&](const Wt::Http::Message& msg) { body.set_value(msg.body()); };
+            request.onFailureFunc = [&] { body.set_value(""); };
+            client->sendGETRequest(std::move(request));
+
+            return body.get_future().get();
+        }
+    } // namespace
+
+    TEST(Listenbrainz, matchAndWriteListensPage)
+    {
+        constexpr std::string_view recordingMBID1{ "46ae879f-2dbe-46d3-99ad-05c116f97a30" };
+        constexpr std::string_view trackMBID2{ "5427a943-a096-4d0b-8b9a-53aca9ed61ac" };
+        constexpr std::string_view ambiguousRecordingMBID{ "d89d042c-8cc1-4526-9080-5bab728ee15f" };
+        constexpr std::string_view unknownRecordingMBID{ "9f33a17f-e33e-492f-85a4-7b2e9e09613e" };
+
+        db::tests::TmpDatabase tmpDb;
+        db::Session session{ tmpDb.getDb() };
+
+        db::UserId userId;
+        db::TrackId trackId1;
+        db::TrackId trackId2;
+        {
+            auto transaction{ session.createWriteTransaction() };
+
+            db::User::pointer user{ session.create<db::User>("MyUser") };
+            userId = user->getId();
+
+            db::Track::pointer track1{ session.create<db::Track>() };
+            track1.modify()->setName("Track1");
+            track1.modify()->setRecordingMBID(core::UUID::fromString(recordingMBID1));
+            trackId1 = track1->getId();
+
+            db::Track::pointer track2{ session.create<db::Track>() };
+            track2.modify()->setName("Track2");
+            track2.modify()->setTrackMBID(core::UUID::fromString(trackMBID2));
+            trackId2 = track2->getId();
+
+            // duplicated files: must not be matched
+            for (std::size_t i{}; i < 2; ++i)
+                session.create<db::Track>().modify()->setRecordingMBID(core::UUID::fromString(ambiguousRecordingMBID));
+
+            // already imported
+            session.create<db::Listen>(user, track1, db::ScrobblingBackend::ListenBrainz, Wt::WDateTime::fromTime_t(1700000000)).modify()->setSyncState(db::SyncState::Synchronized);
+        }
+
+        const std::string listens{ "[" + listenToJson("Track1", 1700000300, recordingMBID1)
+                                   + "," + listenToJson("Track1", 1700000300, recordingMBID1) // duplicate
+                                   + "," + listenToJson("Track1", 1700000200, recordingMBID1)
+                                   + "," + listenToJson("Track2", 1700000100, unknownRecordingMBID, trackMBID2)
+                                   + "," + listenToJson("Track3", 1700000050, ambiguousRecordingMBID)
+                                   + "," + listenToJson("Track4", 1700000040, unknownRecordingMBID)
+                                   + "," + listenToJson("Track1", 1700000000, recordingMBID1) // already imported
+                                   + "]" };
+
+        MockListenBrainzServer server{ { { "/1/user/MyListenBrainzUser/listens", R"({"payload":{"count":7,"listens":)" + listens + R"(,"user_id":"MyListenBrainzUser"}})" } } };
+
+        const std::string body{ fetchListens(server.getBaseUrl(), "/1/user/MyListenBrainzUser/listens?max_ts=1700001000") };
+        const ListensParser::Result result{ ListensParser::parse(body) };
+        ASSERT_EQ(result.listens.size(), 7);
+
+        ListensMatcher matcher;
+        const std::vector<db::TrackId> trackIds{ matcher.match(session, result.listens) };
+        ASSERT_EQ(trackIds.size(), 7);
+        EXPECT_EQ(trackIds[0], trackId1);
+        EXPECT_EQ(trackIds[1], trackId1);
+        EXPECT_EQ(trackIds[2], trackId1);
+        EXPECT_EQ(trackIds[3], trackId2);
+        EXPECT_FALSE(trackIds[4].isValid());
+        EXPECT_FALSE(trackIds[5].isValid());
+        EXPECT_EQ(trackIds[6], trackId1);
+
+        // same results when served from the matcher's cache
+        EXPECT_EQ(matcher.match(session, result.listens), trackIds);
+
+        std::vector<ListenWriter::Entry> entries;
+        for (std::size_t i{}; i < trackIds.size(); ++i)
+        {
+            if (trackIds[i].isValid())
+                entries.push_back(ListenWriter::Entry{ TimedListen{ { userId, trackIds[i] }, result.listens[i].listenedAt }, db::ScrobblingBackend::ListenBrainz, db::SyncState::Synchronized });
+        }
+
+        std::size_t writtenCount{};
+        {
+            ListenWriter listenWriter{ tmpDb.getDb() };
+            listenWriter.enqueue(std::move(entries), [&](std::size_t count) { writtenCount = count; });
+            listenWriter.flush();
+        }
+        EXPECT_EQ(writtenCount, 3);
+
+        {
+            auto transaction{ session.createReadTransaction() };
+            EXPECT_EQ(db::Listen::getCount(session), 4);
+            EXPECT_TRUE(db::Listen::find(session, userId, trackId1, db::ScrobblingBackend::ListenBrainz, Wt::WDateTime::fromTime_t(1700000300)));
+            EXPECT_TRUE(db::Listen::find(session, userId, trackId1, db::ScrobblingBackend::ListenBrainz, Wt::WDateTime::fromTime_t(1700000200)));
+            EXPECT_TRUE(db::Listen::find(session, userId, trackId2, db::ScrobblingBackend::ListenBrainz, Wt::WDateTime::fromTime_t(1700000100)));
+        }
+    }
+} // namespace lms::scrobbling::listenBrainz::tests
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SegmentCache.hpp"
+
+#include <mutex>
+
+#include "core/ILogger.hpp"
+#include "core/Random.hpp"
+
+namespace lms::transcoding
+{
+    SegmentCache::SegmentCache(std::size_t maxCacheSize)
+        : _maxCacheSize{ maxCacheSize }
+    {
+    }
+
+    void SegmentCache::addSegment(const EntryDesc& entryDesc, std::shared_ptr<const Segment> segment)
+    {
+        if (segment->data.size() > _maxCacheSize)
+            return;
+
+        const std::unique_lock lock{ _mutex };
+
+        if (auto it{ _cache.find(entryDesc) }; it != std::cend(_cache))
+        {
+            _cacheSize -= it->second->data.size();
+            _cache.erase(it);
+        }
+
+        while (_cacheSize + segment->data.size() > _maxCacheSize && !_cache.empty())
+        {
+            auto itRandom{ core::random::pickRandom(_cache) };
+            _cacheSize -= itRandom->second->data.size();
+            _cache.erase(itRandom);
+        }
+
+        _cacheSize += segment->data.size();
+        _cache[entryDesc] = std::move(segment);
+    }
+
+    std::shared_ptr<const SegmentCache::Segment> SegmentCache::getSegment(const EntryDesc& entryDesc) const
+    {
+        const std::shared_lock lock{ _mutex };
+
+        const auto it{ _cache.find(entryDesc) };
+        if (it == std::cend(_cache))
+        {
+            ++_cacheMisses;
+            return nullptr;
+        }
+
+        ++_cacheHits;
+        LMS_LOG(TRANSCODING, DEBUG, "Segment cache stats: hits = " << _cacheHits.load() << ", misses = " << _cacheMisses.load() << ", nb entries = " << _cache.size() << ", size = " << _cacheSize);
+        return it->second;
+    }
+} // namespace lms::transcoding
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "av/ITranscoder.hpp"
+
+namespace lms::transcoding
+{
+    class SegmentCache
+    {
+    public:
+        SegmentCache(std::size_t maxCacheSize);
+
+        struct EntryDesc
+        {
+            std::filesystem::path filePath;
+            std::filesystem::file_time_type lastWriteTime; // so that modified files are transcoded again
+            std::optional<std::size_t> streamIndex;
+            av::OutputFormat format;
+            std::size_t bitrate;
+            bool stripMetadata;
+            std::size_t segmentIndex;
+
+            bool operator==(const EntryDesc& other) const = default;
+        };
+
+        struct Segment
+        {
+            std::string mimeType;
+            std::vector<std::byte> data;
+        };
+
+        std::size_t getMaxCacheSize() const { return _maxCacheSize; }
+
+        void addSegment(const EntryDesc& entryDesc, std::shared_ptr<const Segment> segment);
+        std::shared_ptr<const Segment> getSegment(const EntryDesc& entryDesc) const;
+
+    private:
+        const std::size_t _maxCacheSize;
+
+        mutable std::shared_mutex _mutex;
+
+        struct EntryHasher
+        {
+            std::size_t operator()(const EntryDesc& entry) const
+            {
+                return std::filesystem::hash_value(entry.filePath) ^ std::hash<std::size_t>{}(entry.segmentIndex) ^ std::hash<std::size_t>{}(entry.bitrate);
+            }
+        };
+
+        std::unordered_map<EntryDesc, std::shared_ptr<const Segment>, EntryHasher> _cache;
+        std::size_t _cacheSize{};
+        mutable std::atomic<std::size_t> _cacheMisses;
+        mutable std::atomic<std::size_t> _cacheHits;
+    };
+} // namespace lms::transcoding
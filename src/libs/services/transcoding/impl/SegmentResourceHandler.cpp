@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SegmentResourceHandler.hpp"
+
+#include <cassert>
+#include <span>
+
+#include "av/Exception.hpp"
+#include "core/ILogger.hpp"
+
+namespace lms::transcoding
+{
+    SegmentResourceHandler::SegmentResourceHandler(SegmentCache& cache, const SegmentCache::EntryDesc& entryDesc, const av::InputParameters& inputParameters, const av::OutputParameters& outputParameters)
+        : _cache{ cache }
+        , _entryDesc{ entryDesc }
+        , _cachedSegment{ _cache.getSegment(_entryDesc) }
+    {
+        if (_cachedSegment)
+        {
+            LMS_LOG(TRANSCODING, DEBUG, "Segment " << _entryDesc.segmentIndex << " of " << _entryDesc.filePath << " found in cache");
+            return;
+        }
+
+        try
+        {
+            _transcoder = av::createTranscoder(inputParameters, outputParameters);
+            _segmentWriter.emplace(_cache, _entryDesc, _transcoder->getOutputMimeType());
+        }
+        catch (av::Exception& e)
+        {
+            LMS_LOG(TRANSCODING, ERROR, "Failed to create transcoder: " << e.what());
+        }
+    }
+
+    SegmentResourceHandler::~SegmentResourceHandler() = default;
+
+    Wt::Http::ResponseContinuation* SegmentResourceHandler::processRequest(const Wt::Http::Request& /*request*/, Wt::Http::Response& response)
+    {
+        if (_cachedSegment)
+        {
+            response.setMimeType(_cachedSegment->mimeType);
+            response.setContentLength(_cachedSegment->data.size());
+            response.out().write(reinterpret_cast<const char*>(_cachedSegment->data.data()), _cachedSegment->data.size());
+            return {};
+        }
+
+        if (!_transcoder)
+        {
+            response.setStatus(404);
+            return {};
+        }
+
+        response.setMimeType(std::string{ _transcoder->getOutputMimeType() });
+
+        if (_bytesReadyCount > 0)
+        {
+            response.out().write(reinterpret_cast<const char*>(_buffer.data()), _bytesReadyCount);
+            _segmentWriter->write(std::span{ _buffer }.first(_bytesReadyCount));
+            _bytesReadyCount = 0;
+        }
+
+        if (!_transcoder->finished())
+        {
+            Wt::Http::ResponseContinuation* continuation{ response.createContinuation() };
+            continuation->waitForMoreData();
+            _transcoder->asyncRead(_buffer.data(), _buffer.size(), [this, continuation](std::size_t nbBytesRead) {
+                assert(_bytesReadyCount == 0);
+                _bytesReadyCount = nbBytesRead;
+                continuation->haveMoreData();
+            });
+
+            return continuation;
+        }
+
+        _segmentWriter->complete(_transcoder->succeeded());
+
+        return {};
+    }
+} // namespace lms::transcoding
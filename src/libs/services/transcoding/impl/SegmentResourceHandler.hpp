@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+
+#include "av/ITranscoder.hpp"
+#include "core/IResourceHandler.hpp"
+
+#include "SegmentCache.hpp"
+#include "SegmentWriter.hpp"
+
+namespace lms::transcoding
+{
+    // Serves a segment from the cache, or transcodes it and adds it in the cache once fully and successfully transcoded
+    class SegmentResourceHandler final : public core::IResourceHandler
+    {
+    public:
+        SegmentResourceHandler(SegmentCache& cache, const SegmentCache::EntryDesc& entryDesc, const av::InputParameters& inputParameters, const av::OutputParameters& outputParameters);
+        ~SegmentResourceHandler() override;
+
+        SegmentResourceHandler(const SegmentResourceHandler&) = delete;
+        SegmentResourceHandler& operator=(const SegmentResourceHandler&) = delete;
+
+    private:
+        Wt::Http::ResponseContinuation* processRequest(const Wt::Http::Request& request, Wt::Http::Response& response) override;
+        void abort() override {};
+
+        SegmentCache& _cache;
+        const SegmentCache::EntryDesc _entryDesc;
+        std::shared_ptr<const SegmentCache::Segment> _cachedSegment;
+
+        static constexpr std::size_t _chunkSize{ 65'536 };
+        std::array<std::byte, _chunkSize> _buffer;
+        std::size_t _bytesReadyCount{};
+        std::unique_ptr<av::ITranscoder> _transcoder;
+        std::optional<SegmentWriter> _segmentWriter;
+    };
+} // namespace lms::transcoding
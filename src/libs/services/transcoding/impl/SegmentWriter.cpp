@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SegmentWriter.hpp"
+
+#include <memory>
+
+#include "core/ILogger.hpp"
+
+namespace lms::transcoding
+{
+    SegmentWriter::SegmentWriter(SegmentCache& cache, const SegmentCache::EntryDesc& entryDesc, std::string_view mimeType)
+        : _cache{ cache }
+        , _entryDesc{ entryDesc }
+        , _mimeType{ mimeType }
+    {
+    }
+
+    void SegmentWriter::write(std::span<const std::byte> data)
+    {
+        _data.insert(std::end(_data), std::cbegin(data), std::cend(data));
+    }
+
+    void SegmentWriter::complete(bool transcodeSucceeded)
+    {
+        if (!transcodeSucceeded)
+        {
+            LMS_LOG(TRANSCODING, ERROR, "Segment " << _entryDesc.segmentIndex << " of " << _entryDesc.filePath << " failed to transcode, not caching it");
+            return;
+        }
+
+        LMS_LOG(TRANSCODING, DEBUG, "Segment " << _entryDesc.segmentIndex << " of " << _entryDesc.filePath << " transcoded, size = " << _data.size());
+        if (_data.empty())
+            return;
+
+        auto segment{ std::make_shared<SegmentCache::Segment>() };
+        segment->mimeType = _mimeType;
+        segment->data = std::move(_data);
+        _cache.addSegment(_entryDesc, std::move(segment));
+    }
+} // namespace lms::transcoding
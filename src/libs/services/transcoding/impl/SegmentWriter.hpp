@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SegmentCache.hpp"
+
+namespace lms::transcoding
+{
+    // Accumulates the output of a segment transcode, and adds the segment in the cache once complete
+    class SegmentWriter
+    {
+    public:
+        SegmentWriter(SegmentCache& cache, const SegmentCache::EntryDesc& entryDesc, std::string_view mimeType);
+        SegmentWriter(const SegmentWriter&) = delete;
+        SegmentWriter& operator=(const SegmentWriter&) = delete;
+
+        void write(std::span<const std::byte> data);
+
+        // Failed transcodes are not cached: a truncated segment would be served to all the clients until evicted
+        void complete(bool transcodeSucceeded);
+
+    private:
+        SegmentCache& _cache;
+        const SegmentCache::EntryDesc _entryDesc;
+        const std::string _mimeType;
+        std::vector<std::byte> _data;
+    };
+} // namespace lms::transcoding
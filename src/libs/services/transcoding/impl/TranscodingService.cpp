@@ -20,10 +20,13 @@
 #include "TranscodingService.hpp"
 
 #include "av/ITranscoder.hpp"
+#include "core/IConfig.hpp"
 #include "core/ILogger.hpp"
+#include "core/Service.hpp"
 #include "database/IDb.hpp"
 #include "database/Session.hpp"
 
+#include "SegmentResourceHandler.hpp"
 #include "TranscodingResourceHandler.hpp"
 
 namespace lms::transcoding
@@ -50,6 +53,7 @@ namespace lms::transcoding
     TranscodingService::TranscodingService(db::IDb& db, core::IChildProcessManager& childProcessManager)
         : _db{ db }
         , _childProcessManager(childProcessManager)
+        , _segmentCache{ core::Service<core::IConfig>::get()->getULong("hls-max-cache-size", 64) * 1000 * 1000 }
     {
         LMS_LOG(TRANSCODING, INFO, "Service started!");
     }
@@ -78,4 +82,28 @@ namespace lms::transcoding
 
         return std::make_unique<TranscodingResourceHandler>(avInputParams, toAv(outputParameters), estimatedContentLength);
     }
+
+    std::unique_ptr<core::IResourceHandler> TranscodingService::createSegmentResourceHandler(const InputParameters& inputParameters, const OutputParameters& outputParameters, std::size_t segmentIndex)
+    {
+        av::InputParameters avInputParams;
+        avInputParams.file = inputParameters.filePath;
+        avInputParams.offset = std::chrono::milliseconds{ segmentDuration } * static_cast<std::chrono::milliseconds::rep>(segmentIndex);
+        avInputParams.duration = segmentDuration;
+        avInputParams.streamIndex = inputParameters.streamIndex;
+
+        const av::OutputParameters avOutputParams{ toAv(outputParameters) };
+
+        std::error_code ec;
+        const SegmentCache::EntryDesc entryDesc{
+            .filePath = inputParameters.filePath,
+            .lastWriteTime = std::filesystem::last_write_time(inputParameters.filePath, ec),
+            .streamIndex = inputParameters.streamIndex,
+            .format = avOutputParams.format,
+            .bitrate = avOutputParams.bitrate,
+            .stripMetadata = avOutputParams.stripMetadata,
+            .segmentIndex = segmentIndex,
+        };
+
+        return std::make_unique<SegmentResourceHandler>(_segmentCache, entryDesc, avInputParams, avOutputParams);
+    }
 } // namespace lms::transcoding
@@ -21,6 +21,8 @@
 
 #include "services/transcoding/ITranscodingService.hpp"
 
+#include "SegmentCache.hpp"
+
 namespace lms::transcoding
 {
     class TranscodingService : public ITranscodingService
@@ -34,8 +36,10 @@ namespace lms::transcoding
 
     private:
         std::unique_ptr<core::IResourceHandler> createResourceHandler(const InputParameters& inputParameters, const OutputParameters& outputParameters, bool estimateContentLength) override;
+        std::unique_ptr<core::IResourceHandler> createSegmentResourceHandler(const InputParameters& inputParameters, const OutputParameters& outputParameters, std::size_t segmentIndex) override;
 
         db::IDb& _db;
         core::IChildProcessManager& _childProcessManager;
+        SegmentCache _segmentCache;
     };
 } // namespace lms::transcoding
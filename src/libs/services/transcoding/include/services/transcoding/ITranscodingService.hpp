@@ -55,6 +55,7 @@ namespace lms::transcoding
         MATROSKA_OPUS,
         OGG_VORBIS,
         WEBM_VORBIS,
+        MPEGTS_AAC, // for segmented streaming
     };
 
     struct OutputParameters
@@ -70,6 +71,11 @@ namespace lms::transcoding
         virtual ~ITranscodingService() = default;
 
         virtual std::unique_ptr<core::IResourceHandler> createResourceHandler(const InputParameters& inputParameters, const OutputParameters& outputParameters, bool estimateContentLength) = 0;
+
+        // Segmented streaming: the input is split in segments of fixed duration (offset in input parameters is ignored)
+        // Transcoded segments are cached, and shared between clients
+        static constexpr std::chrono::seconds segmentDuration{ 10 };
+        virtual std::unique_ptr<core::IResourceHandler> createSegmentResourceHandler(const InputParameters& inputParameters, const OutputParameters& outputParameters, std::size_t segmentIndex) = 0;
     };
 
     std::unique_ptr<ITranscodingService> createTranscodingService(db::IDb& db, core::IChildProcessManager& childProcessManager);
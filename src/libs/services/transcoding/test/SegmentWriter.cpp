@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "SegmentCache.hpp"
+#include "SegmentWriter.hpp"
+
+namespace lms::transcoding::tests
+{
+    namespace
+    {
+        SegmentCache::EntryDesc createEntryDesc(std::size_t segmentIndex)
+        {
+            return SegmentCache::EntryDesc{
+                .filePath = "/test/file.flac",
+                .lastWriteTime = {},
+                .streamIndex = std::nullopt,
+                .format = av::OutputFormat::MPEGTS_AAC,
+                .bitrate = 128'000,
+                .stripMetadata = true,
+                .segmentIndex = segmentIndex,
+            };
+        }
+
+        const std::byte data[]{ std::byte{ 1 }, std::byte{ 2 }, std::byte{ 3 } };
+    } // namespace
+
+    TEST(SegmentWriter, succeeded)
+    {
+        SegmentCache cache{ 1'000 };
+
+        SegmentWriter writer{ cache, createEntryDesc(0), "video/mp2t" };
+        writer.write(data);
+        writer.write(data);
+        writer.complete(true);
+
+        const auto segment{ cache.getSegment(createEntryDesc(0)) };
+        ASSERT_TRUE(segment);
+        EXPECT_EQ(segment->mimeType, "video/mp2t");
+        EXPECT_EQ(segment->data.size(), 6);
+        EXPECT_FALSE(cache.getSegment(createEntryDesc(1)));
+    }
+
+    TEST(SegmentWriter, failedTranscode)
+    {
+        SegmentCache cache{ 1'000 };
+
+        // some data may have been produced before the transcoder failed
+        SegmentWriter writer{ cache, createEntryDesc(0), "video/mp2t" };
+        writer.write(data);
+        writer.complete(false);
+
+        EXPECT_FALSE(cache.getSegment(createEntryDesc(0)));
+    }
+
+    TEST(SegmentWriter, emptyOutput)
+    {
+        SegmentCache cache{ 1'000 };
+
+        SegmentWriter writer{ cache, createEntryDesc(0), "video/mp2t" };
+        writer.complete(true);
+
+        EXPECT_FALSE(cache.getSegment(createEntryDesc(0)));
+    }
+} // namespace lms::transcoding::tests
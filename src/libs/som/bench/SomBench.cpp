@@ -18,6 +18,7 @@
  */
 
 #include <random>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -51,6 +52,83 @@ namespace lms::som
 
     // Register the benchmark with custom range
     BENCHMARK(BM_Matrix)->Arg(3)->Arg(6)->Arg(12)->Arg(24);
+
+    namespace
+    {
+        constexpr std::size_t sampleCount{ 100'000 };
+        constexpr std::size_t dimCount{ 50 };
+
+        const std::vector<InputVector>& getSamples()
+        {
+            static const std::vector<InputVector> samples{ [] {
+                std::minstd_rand randomEngine{ 42 };
+                std::uniform_real_distribution<InputVector::value_type> distrib{ 0, 1 };
+
+                std::vector<InputVector> res(sampleCount, InputVector{ dimCount });
+                for (InputVector& sample : res)
+                {
+                    for (InputVector::value_type& value : sample)
+                        value = distrib(randomEngine);
+                }
+                return res;
+            }() };
+
+            return samples;
+        }
+
+        enum class TrainMode
+        {
+            Generic, // custom distance function: legacy code path
+            Online,
+            Batch,
+        };
+
+        void trainNetwork(benchmark::State& state, TrainMode mode)
+        {
+            const std::vector<InputVector>& samples{ getSamples() };
+            const Coordinate size{ static_cast<Coordinate>(state.range(0)) };
+
+            for (auto _ : state)
+            {
+                Network network{ size, size, dimCount };
+                if (mode == TrainMode::Generic)
+                {
+                    network.setDistanceFunc([](const InputVector& a, const InputVector& b, const InputVector& weights) {
+                        return a.computeEuclidianSquareDistance(b, weights);
+                    });
+                }
+
+                if (mode == TrainMode::Batch)
+                    network.trainBatch(samples, 1);
+                else
+                    network.train(samples, 1);
+
+                benchmark::DoNotOptimize(network.getRefVector({ 0, 0 }));
+            }
+
+            state.SetItemsProcessed(state.iterations() * samples.size());
+        }
+    } // namespace
+
+    // One training iteration over 100k samples of 50 dimensions
+    static void BM_Network_trainGeneric(benchmark::State& state)
+    {
+        trainNetwork(state, TrainMode::Generic);
+    }
+
+    static void BM_Network_trainOnline(benchmark::State& state)
+    {
+        trainNetwork(state, TrainMode::Online);
+    }
+
+    static void BM_Network_trainBatch(benchmark::State& state)
+    {
+        trainNetwork(state, TrainMode::Batch);
+    }
+
+    BENCHMARK(BM_Network_trainGeneric)->ArgName("size")->Arg(10)->Arg(20)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_Network_trainOnline)->ArgName("size")->Arg(10)->Arg(20)->Arg(40)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_Network_trainBatch)->ArgName("size")->Arg(10)->Arg(20)->Arg(40)->Arg(160)->Unit(benchmark::kMillisecond)->UseRealTime();
 } // namespace lms::som
 
 BENCHMARK_MAIN();
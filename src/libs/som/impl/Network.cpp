@@ -20,13 +20,21 @@
 #include "som/Network.hpp"
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
 #include <random>
+#include <span>
 #include <sstream>
+#include <thread>
 #include <unordered_set>
 
+#include "core/IJobScheduler.hpp"
 #include "core/ILogger.hpp"
+#include "core/ParallelFor.hpp"
 #include "core/Random.hpp"
 
 namespace lms::som
@@ -69,10 +77,119 @@ namespace lms::som
         return exp(-norm / (2 * sigma * sigma));
     }
 
+    namespace
+    {
+        // Training is done on packed float copies of the vectors, in order to make the most of the SIMD units and caches
+        using Real = float;
+
+        // Vectors are padded (using zero values and zero weights) so that kernels never have to handle remainders
+        constexpr std::size_t laneCount{ 8 };
+
+        class PackedVectors
+        {
+        public:
+            PackedVectors(std::size_t vectorCount, std::size_t dimCount)
+                : _stride{ (dimCount + laneCount - 1) / laneCount * laneCount }
+                , _values(vectorCount * _stride, Real{})
+            {
+            }
+
+            std::size_t getVectorCount() const { return _stride ? _values.size() / _stride : 0; }
+            std::size_t getStride() const { return _stride; }
+
+            Real* operator[](std::size_t index) { return _values.data() + index * _stride; }
+            const Real* operator[](std::size_t index) const { return _values.data() + index * _stride; }
+
+            void set(std::size_t index, const InputVector& vector)
+            {
+                std::transform(std::cbegin(vector), std::cend(vector), (*this)[index], [](InputVector::value_type value) { return static_cast<Real>(value); });
+            }
+
+            void get(std::size_t index, InputVector& vector) const
+            {
+                std::transform(std::begin(vector), std::end(vector), (*this)[index], std::begin(vector), [](InputVector::value_type, Real value) { return static_cast<InputVector::value_type>(value); });
+            }
+
+        private:
+            std::size_t _stride;
+            std::vector<Real> _values;
+        };
+
+        // Independent partial sums let the compiler vectorize the reduction (no need for fast-math)
+        Real computeWeightedSquareDistance(const Real* a, const Real* b, const Real* weights, std::size_t stride)
+        {
+            std::array<Real, laneCount> sums{};
+
+            for (std::size_t i{}; i < stride; i += laneCount)
+            {
+                for (std::size_t lane{}; lane < laneCount; ++lane)
+                {
+                    const Real diff{ a[i + lane] - b[i + lane] };
+                    sums[lane] += diff * diff * weights[i + lane];
+                }
+            }
+
+            return std::accumulate(std::cbegin(sums), std::cend(sums), Real{});
+        }
+
+        std::size_t findClosestVectorIndex(const PackedVectors& refVectors, const Real* input, const Real* weights)
+        {
+            std::size_t closestIndex{};
+            Real closestDistance{ std::numeric_limits<Real>::max() };
+
+            for (std::size_t i{}; i < refVectors.getVectorCount(); ++i)
+            {
+                const Real distance{ computeWeightedSquareDistance(refVectors[i], input, weights, refVectors.getStride()) };
+                if (distance < closestDistance)
+                {
+                    closestDistance = distance;
+                    closestIndex = i;
+                }
+            }
+
+            return closestIndex;
+        }
+
+        // refVector += factor * (input - refVector)
+        void moveTowards(Real* refVector, const Real* input, Real factor, std::size_t stride)
+        {
+            for (std::size_t i{}; i < stride; ++i)
+                refVector[i] += factor * (input[i] - refVector[i]);
+        }
+
+        // Neighbourhood factors are only a function of the position offset from the best matching unit
+        // Negligible factors are skipped, which makes the update cost depend on the neighbourhood radius rather than on the network size
+        struct NeighbourhoodOffset
+        {
+            int dx;
+            int dy;
+            Real factor;
+        };
+
+        std::vector<NeighbourhoodOffset> computeNeighbourhoodOffsets(Coordinate width, Coordinate height, const Network::NeighbourhoodFunc& neighbourhoodFunc, const Network::CurrentIteration& iteration)
+        {
+            constexpr Real minFactor{ 1e-6 };
+
+            std::vector<NeighbourhoodOffset> offsets;
+            for (int dy{ -static_cast<int>(height) + 1 }; dy < static_cast<int>(height); ++dy)
+            {
+                for (int dx{ -static_cast<int>(width) + 1 }; dx < static_cast<int>(width); ++dx)
+                {
+                    const Real factor{ static_cast<Real>(neighbourhoodFunc(std::sqrt(static_cast<Norm>(dx * dx + dy * dy)), iteration)) };
+                    if (factor >= minFactor)
+                        offsets.push_back(NeighbourhoodOffset{ dx, dy, factor });
+                }
+            }
+
+            return offsets;
+        }
+    } // namespace
+
     Network::Network(Coordinate width, Coordinate height, std::size_t inputDimCount)
         : _inputDimCount{ inputDimCount }
         , _weights{ inputDimCount, static_cast<InputVector::value_type>(1) }
         , _refVectors{ width, height, _inputDimCount }
+        , _threadCount{ std::max<std::size_t>(std::thread::hardware_concurrency(), 1) }
         , _distanceFunc{ euclidianSquareDistance }
         , _learningFactorFunc{ defaultLearningFactor }
         , _neighbourhoodFunc{ defaultNeighbourhoodFunc }
@@ -102,6 +219,34 @@ namespace lms::som
         _refVectors[position] = data;
     }
 
+    void Network::setThreadCount(std::size_t threadCount)
+    {
+        _threadCount = std::max<std::size_t>(threadCount, 1);
+    }
+
+    void Network::setDistanceFunc(DistanceFunc distanceFunc)
+    {
+        _distanceFunc = std::move(distanceFunc);
+    }
+
+    void Network::setLearningFactorFunc(LearningFactorFunc learningFactorFunc)
+    {
+        _learningFactorFunc = std::move(learningFactorFunc);
+    }
+
+    void Network::setNeighbourhoodFunc(NeighbourhoodFunc neighbourhoodFunc)
+    {
+        _neighbourhoodFunc = std::move(neighbourhoodFunc);
+    }
+
+    bool Network::hasDefaultDistanceFunc() const
+    {
+        using DistanceFuncPtr = InputVector::Distance (*)(const InputVector&, const InputVector&, const InputVector&);
+
+        const DistanceFuncPtr* func{ _distanceFunc.target<DistanceFuncPtr>() };
+        return func && *func == euclidianSquareDistance;
+    }
+
     InputVector::Distance Network::getRefVectorsDistance(const Position& position1, const Position& position2) const
     {
         return _distanceFunc(_refVectors.get(position1), _refVectors.get(position2), _weights);
@@ -164,9 +309,24 @@ namespace lms::som
 
     Position Network::getClosestRefVectorPosition(const InputVector& data) const
     {
-        return _refVectors.getPositionMinElement([&](const auto& a, const auto& b) {
-            return (_distanceFunc(a, data, _weights) < _distanceFunc(b, data, _weights));
-        });
+        Position closestPosition{};
+        InputVector::Distance closestDistance{ std::numeric_limits<InputVector::Distance>::max() };
+
+        // compute each distance only once
+        for (Coordinate y{}; y < _refVectors.getHeight(); ++y)
+        {
+            for (Coordinate x{}; x < _refVectors.getWidth(); ++x)
+            {
+                const InputVector::Distance distance{ _distanceFunc(_refVectors.get({ x, y }), data, _weights) };
+                if (distance < closestDistance)
+                {
+                    closestDistance = distance;
+                    closestPosition = { x, y };
+                }
+            }
+        }
+
+        return closestPosition;
     }
 
     std::optional<Position> Network::getClosestRefVectorPosition(const InputVector& data, InputVector::Distance maxDistance) const
@@ -258,6 +418,212 @@ namespace lms::som
     }
 
     void Network::train(const std::vector<InputVector>& inputData, std::size_t nbIterations, ProgressCallback progressCallback, RequestStopCallback requestStopCallback)
+    {
+        if (!hasDefaultDistanceFunc())
+        {
+            trainGeneric(inputData, nbIterations, std::move(progressCallback), std::move(requestStopCallback));
+            return;
+        }
+
+        const Coordinate width{ _refVectors.getWidth() };
+        const Coordinate height{ _refVectors.getHeight() };
+
+        PackedVectors refVectors{ static_cast<std::size_t>(width) * height, _inputDimCount };
+        PackedVectors weights{ 1, _inputDimCount };
+        PackedVectors samples{ inputData.size(), _inputDimCount };
+        for (std::size_t i{}; i < refVectors.getVectorCount(); ++i)
+            refVectors.set(i, _refVectors.get({ static_cast<Coordinate>(i % width), static_cast<Coordinate>(i / width) }));
+        weights.set(0, _weights);
+        for (std::size_t i{}; i < inputData.size(); ++i)
+        {
+            checkSameDimensions(inputData[i], _inputDimCount);
+            samples.set(i, inputData[i]);
+        }
+
+        std::vector<std::size_t> sampleIndexes(inputData.size());
+        std::iota(std::begin(sampleIndexes), std::end(sampleIndexes), 0);
+
+        bool stopRequested{ false };
+        for (std::size_t i{}; i < nbIterations && !stopRequested; ++i)
+        {
+            CurrentIteration curIter{ i, nbIterations };
+
+            if (progressCallback)
+                progressCallback(curIter);
+
+            core::random::shuffleContainer(sampleIndexes);
+
+            const LearningFactor learningFactor{ _learningFactorFunc(curIter) };
+            const std::vector<NeighbourhoodOffset> neighbourhoodOffsets{ computeNeighbourhoodOffsets(width, height, _neighbourhoodFunc, curIter) };
+
+            for (const std::size_t sampleIndex : sampleIndexes)
+            {
+                if (requestStopCallback)
+                    stopRequested = requestStopCallback();
+
+                if (stopRequested)
+                    break;
+
+                const Real* sample{ samples[sampleIndex] };
+                const std::size_t closestIndex{ findClosestVectorIndex(refVectors, sample, weights[0]) };
+                const int closestX{ static_cast<int>(closestIndex % width) };
+                const int closestY{ static_cast<int>(closestIndex / width) };
+
+                for (const NeighbourhoodOffset& offset : neighbourhoodOffsets)
+                {
+                    const int x{ closestX + offset.dx };
+                    const int y{ closestY + offset.dy };
+                    if (x < 0 || y < 0 || x >= static_cast<int>(width) || y >= static_cast<int>(height))
+                        continue;
+
+                    moveTowards(refVectors[x + static_cast<std::size_t>(width) * y], sample, static_cast<Real>(learningFactor) * offset.factor, refVectors.getStride());
+                }
+            }
+        }
+
+        for (std::size_t i{}; i < refVectors.getVectorCount(); ++i)
+            refVectors.get(i, _refVectors.get({ static_cast<Coordinate>(i % width), static_cast<Coordinate>(i / width) }));
+    }
+
+    void Network::trainBatch(const std::vector<InputVector>& inputData, std::size_t nbIterations, ProgressCallback progressCallback, RequestStopCallback requestStopCallback)
+    {
+        const Coordinate width{ _refVectors.getWidth() };
+        const Coordinate height{ _refVectors.getHeight() };
+        const std::size_t nodeCount{ static_cast<std::size_t>(width) * height };
+        const bool useDefaultDistance{ hasDefaultDistanceFunc() };
+
+        PackedVectors refVectors{ nodeCount, _inputDimCount };
+        PackedVectors newRefVectors{ nodeCount, _inputDimCount };
+        PackedVectors weights{ 1, _inputDimCount };
+        PackedVectors samples{ inputData.size(), _inputDimCount };
+        for (std::size_t i{}; i < nodeCount; ++i)
+            refVectors.set(i, _refVectors.get({ static_cast<Coordinate>(i % width), static_cast<Coordinate>(i / width) }));
+        weights.set(0, _weights);
+        for (std::size_t i{}; i < inputData.size(); ++i)
+        {
+            checkSameDimensions(inputData[i], _inputDimCount);
+            samples.set(i, inputData[i]);
+        }
+
+        const std::size_t stride{ refVectors.getStride() };
+        std::vector<std::size_t> closestNodes(inputData.size());
+        std::vector<std::size_t> nodeSampleOffsets(nodeCount + 1);
+        std::vector<std::size_t> sampleIndexesByNode(inputData.size());
+        PackedVectors nodeSampleSums{ nodeCount, _inputDimCount };
+
+        // threads are created once for the whole training
+        const std::unique_ptr<core::IJobScheduler> jobScheduler{ core::createJobScheduler("SomTrain", _threadCount) };
+
+        for (std::size_t i{}; i < nbIterations; ++i)
+        {
+            CurrentIteration curIter{ i, nbIterations };
+
+            if (requestStopCallback && requestStopCallback())
+                break;
+
+            if (progressCallback)
+                progressCallback(curIter);
+
+            // Best matching unit for each sample, in parallel across samples
+            core::parallelFor(*jobScheduler, inputData.size(), [&](std::size_t begin, std::size_t end) {
+                for (std::size_t sampleIndex{ begin }; sampleIndex < end; ++sampleIndex)
+                {
+                    if (useDefaultDistance)
+                    {
+                        closestNodes[sampleIndex] = findClosestVectorIndex(refVectors, samples[sampleIndex], weights[0]);
+                    }
+                    else
+                    {
+                        const Position position{ getClosestRefVectorPosition(inputData[sampleIndex]) };
+                        closestNodes[sampleIndex] = position.x + static_cast<std::size_t>(width) * position.y;
+                    }
+                }
+            });
+
+            if (requestStopCallback && requestStopCallback())
+                break;
+
+            // Group samples by best matching unit
+            std::fill(std::begin(nodeSampleOffsets), std::end(nodeSampleOffsets), 0);
+            for (const std::size_t node : closestNodes)
+                nodeSampleOffsets[node + 1]++;
+            std::partial_sum(std::cbegin(nodeSampleOffsets), std::cend(nodeSampleOffsets), std::begin(nodeSampleOffsets));
+            {
+                std::vector<std::size_t> nodeCursors{ nodeSampleOffsets };
+                for (std::size_t sampleIndex{}; sampleIndex < closestNodes.size(); ++sampleIndex)
+                    sampleIndexesByNode[nodeCursors[closestNodes[sampleIndex]]++] = sampleIndex;
+            }
+
+            // Sum of the samples matched by each node, in parallel across nodes
+            core::parallelFor(*jobScheduler, nodeCount, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t node{ begin }; node < end; ++node)
+                {
+                    Real* sum{ nodeSampleSums[node] };
+                    std::fill(sum, sum + stride, Real{});
+
+                    for (std::size_t j{ nodeSampleOffsets[node] }; j < nodeSampleOffsets[node + 1]; ++j)
+                    {
+                        const Real* sample{ samples[sampleIndexesByNode[j]] };
+                        for (std::size_t k{}; k < stride; ++k)
+                            sum[k] += sample[k];
+                    }
+                }
+            });
+
+            // Each ref vector becomes the neighbourhood weighted mean of the matched samples, in parallel across nodes
+            const std::vector<NeighbourhoodOffset> neighbourhoodOffsets{ computeNeighbourhoodOffsets(width, height, _neighbourhoodFunc, curIter) };
+            core::parallelFor(*jobScheduler, nodeCount, [&](std::size_t begin, std::size_t end) {
+                std::vector<Real> numerator(stride);
+
+                for (std::size_t node{ begin }; node < end; ++node)
+                {
+                    const int nodeX{ static_cast<int>(node % width) };
+                    const int nodeY{ static_cast<int>(node / width) };
+
+                    std::fill(std::begin(numerator), std::end(numerator), Real{});
+                    Real denominator{};
+
+                    for (const NeighbourhoodOffset& offset : neighbourhoodOffsets)
+                    {
+                        const int x{ nodeX + offset.dx };
+                        const int y{ nodeY + offset.dy };
+                        if (x < 0 || y < 0 || x >= static_cast<int>(width) || y >= static_cast<int>(height))
+                            continue;
+
+                        const std::size_t neighbourNode{ x + static_cast<std::size_t>(width) * y };
+                        const std::size_t sampleCount{ nodeSampleOffsets[neighbourNode + 1] - nodeSampleOffsets[neighbourNode] };
+                        if (sampleCount == 0)
+                            continue;
+
+                        denominator += offset.factor * static_cast<Real>(sampleCount);
+
+                        const Real* sum{ nodeSampleSums[neighbourNode] };
+                        for (std::size_t k{}; k < stride; ++k)
+                            numerator[k] += offset.factor * sum[k];
+                    }
+
+                    Real* newRefVector{ newRefVectors[node] };
+                    if (denominator > 0)
+                    {
+                        for (std::size_t k{}; k < stride; ++k)
+                            newRefVector[k] = numerator[k] / denominator;
+                    }
+                    else
+                    {
+                        // no sample in the neighbourhood: keep the current value
+                        std::copy(refVectors[node], refVectors[node] + stride, newRefVector);
+                    }
+                }
+            });
+
+            std::swap(refVectors, newRefVectors);
+
+            for (std::size_t node{}; node < nodeCount; ++node)
+                refVectors.get(node, _refVectors.get({ static_cast<Coordinate>(node % width), static_cast<Coordinate>(node / width) }));
+        }
+    }
+
+    void Network::trainGeneric(const std::vector<InputVector>& inputData, std::size_t nbIterations, ProgressCallback progressCallback, RequestStopCallback requestStopCallback)
     {
         bool stopRequested{ false };
         std::vector<const InputVector*> inputDataShuffled;
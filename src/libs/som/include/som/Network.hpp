@@ -61,7 +61,14 @@ namespace lms::som
         };
         using ProgressCallback = std::function<void(const CurrentIteration&)>;
         using RequestStopCallback = std::function<bool()>;
+        // Online training: ref vectors are updated after each sample
         void train(const std::vector<InputVector>& dataSamples, std::size_t nbIterations, ProgressCallback = ProgressCallback{}, RequestStopCallback = RequestStopCallback{});
+        // Batch training: ref vectors are updated once per iteration, using all the samples (processed in parallel)
+        // Learning factor func is not used
+        void trainBatch(const std::vector<InputVector>& dataSamples, std::size_t nbIterations, ProgressCallback = ProgressCallback{}, RequestStopCallback = RequestStopCallback{});
+
+        // Thread count used by batch training (defaults to hardware concurrency)
+        void setThreadCount(std::size_t threadCount);
 
         const InputVector& getRefVector(const Position& position) const;
         Position getClosestRefVectorPosition(const InputVector& data) const;
@@ -91,12 +98,15 @@ namespace lms::som
         void setNeighbourhoodFunc(NeighbourhoodFunc neighbourhoodFunc);
 
     private:
+        bool hasDefaultDistanceFunc() const;
+        void trainGeneric(const std::vector<InputVector>& dataSamples, std::size_t nbIterations, ProgressCallback progressCallback, RequestStopCallback requestStopCallback);
         void updateRefVectors(const Position& closestRefVectorPosition, const InputVector& input, LearningFactor learningFactor, const CurrentIteration& iteration);
 
         std::size_t _inputDimCount{};
         InputVector _weights; // weight for each dimension
         Matrix<InputVector> _refVectors;
 
+        std::size_t _threadCount;
         DistanceFunc _distanceFunc;
         LearningFactorFunc _learningFactorFunc;
         NeighbourhoodFunc _neighbourhoodFunc;
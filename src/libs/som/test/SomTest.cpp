@@ -126,6 +126,102 @@ namespace lms::som
             }
         }
     }
+
+    namespace
+    {
+        // 4 well separated clusters
+        std::vector<InputVector> createClusteredTrainData()
+        {
+            std::vector<InputVector> trainData;
+            for (std::size_t i{}; i < 100; ++i)
+            {
+                const InputVector::value_type offset{ static_cast<InputVector::value_type>(i % 10) / 100 };
+
+                InputVector data{ 2 };
+                data[0] = (i % 2 ? 0 : 1) + offset;
+                data[1] = ((i / 2) % 2 ? 0 : 1) - offset;
+                trainData.push_back(data);
+            }
+
+            return trainData;
+        }
+
+        Network createOrderedNetwork()
+        {
+            // deterministic, already ordered, init
+            Network network{ 2, 2, 2 };
+            for (Coordinate x{}; x < network.getWidth(); ++x)
+            {
+                for (Coordinate y{}; y < network.getHeight(); ++y)
+                {
+                    InputVector refVector{ 2 };
+                    refVector[0] = 0.4 + 0.2 * x;
+                    refVector[1] = 0.4 + 0.2 * y;
+                    network.setRefVector({ x, y }, refVector);
+                }
+            }
+            network.setThreadCount(3);
+            return network;
+        }
+    } // namespace
+
+    TEST(som, NetworkTrainBatch)
+    {
+        const std::vector<InputVector> trainData{ createClusteredTrainData() };
+
+        Network network{ createOrderedNetwork() };
+        network.trainBatch(trainData, 10);
+
+        {
+            std::unordered_set<Position> positions;
+            for (const InputVector& data : trainData)
+                positions.insert(network.getClosestRefVectorPosition(data));
+
+            EXPECT_EQ(positions.size(), 4);
+        }
+
+        // custom distance functions use another code path, results must be the same
+        Network genericNetwork{ createOrderedNetwork() };
+        genericNetwork.setDistanceFunc([](const InputVector& a, const InputVector& b, const InputVector& weights) {
+            return a.computeEuclidianSquareDistance(b, weights);
+        });
+        genericNetwork.trainBatch(trainData, 10);
+
+        for (Coordinate x{}; x < network.getWidth(); ++x)
+        {
+            for (Coordinate y{}; y < network.getHeight(); ++y)
+            {
+                EXPECT_LT(network.getRefVector({ x, y }).computeEuclidianSquareDistance(genericNetwork.getRefVector({ x, y }), network.getDataWeights()), EPSILON);
+            }
+        }
+    }
+
+    TEST(som, NetworkTrainBatchMatchesTrain)
+    {
+        const std::vector<InputVector> trainData{ createClusteredTrainData() };
+
+        Network onlineNetwork{ createOrderedNetwork() };
+        onlineNetwork.train(trainData, 10);
+
+        Network batchNetwork{ createOrderedNetwork() };
+        batchNetwork.trainBatch(trainData, 10);
+
+        // the ref vectors differ, but both modes must group the samples the same way
+        std::vector<Position> onlinePositions;
+        std::vector<Position> batchPositions;
+        for (const InputVector& data : trainData)
+        {
+            onlinePositions.push_back(onlineNetwork.getClosestRefVectorPosition(data));
+            batchPositions.push_back(batchNetwork.getClosestRefVectorPosition(data));
+        }
+
+        EXPECT_EQ(std::unordered_set<Position>(std::cbegin(onlinePositions), std::cend(onlinePositions)).size(), 4);
+        for (std::size_t i{}; i < trainData.size(); ++i)
+        {
+            for (std::size_t j{ i + 1 }; j < trainData.size(); ++j)
+                EXPECT_EQ(onlinePositions[i] == onlinePositions[j], batchPositions[i] == batchPositions[j]) << "samples " << i << " and " << j;
+        }
+    }
 } // namespace lms::som
 
 int main(int argc, char** argv)
@@ -201,7 +201,6 @@ namespace lms::api::subsonic
             { "/deletePlaylist", { handleDeletePlaylistRequest } },
 
             // Media retrieval
-            { "/hls", { handleNotImplemented } },
             { "/getCaptions", { handleNotImplemented } },
             { "/getLyrics", { handleGetLyrics } },
             { "/getLyricsBySongId", { handleGetLyricsBySongId } },
@@ -267,6 +266,7 @@ namespace lms::api::subsonic
             // Media retrieval
             { "/download", handleDownload },
             { "/stream", handleStream },
+            { "/hls", handleHls },
             { "/getCoverArt", handleGetCoverArt },
         };
 
@@ -326,6 +326,8 @@ namespace lms::api::subsonic
         std::string requestPath{ request.pathInfo() };
         if (core::stringUtils::stringEndsWith(requestPath, ".view"))
             requestPath.resize(requestPath.length() - 5);
+        else if (core::stringUtils::stringEndsWith(requestPath, ".m3u8")) // hls.m3u8
+            requestPath.resize(requestPath.length() - 5);
 
         // Optional parameters
         const ResponseFormat format{ getParameterAs<std::string>(request.getParameterMap(), "f").value_or("xml") == "json" ? ResponseFormat::json : ResponseFormat::xml };
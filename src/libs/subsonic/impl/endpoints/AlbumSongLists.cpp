@@ -169,6 +169,7 @@ namespace lms::api::subsonic
             Response response{ Response::createOkResponse(context.serverProtocolVersion) };
             Response::Node& albumListNode{ response.createNode(id3 ? Response::Node::Key{ "albumList2" } : Response::Node::Key{ "albumList" }) };
 
+            core::Service<feedback::IFeedbackService>::get()->getFeedbacks(context.user->getId(), releases.results);
             for (const ReleaseId releaseId : releases.results)
             {
                 const Release::pointer release{ Release::find(context.dbSession, releaseId) };
@@ -196,7 +197,9 @@ namespace lms::api::subsonic
                 feedback::IFeedbackService::ArtistFindParameters artistFindParams;
                 artistFindParams.setUser(context.user->getId());
                 artistFindParams.setSortMethod(ArtistSortMethod::SortName);
-                for (const ArtistId artistId : feedbackService.findStarredArtists(artistFindParams).results)
+                const auto artists{ feedbackService.findStarredArtists(artistFindParams) };
+                feedbackService.getFeedbacks(context.user->getId(), artists.results);
+                for (const ArtistId artistId : artists.results)
                 {
                     if (auto artist{ Artist::find(context.dbSession, artistId) })
                         starredNode.addArrayChild("artist", createArtistNode(context, artist));
@@ -207,18 +210,25 @@ namespace lms::api::subsonic
             findParameters.setUser(context.user->getId());
             findParameters.filters.setMediaLibrary(mediaLibrary);
 
-            for (const ReleaseId releaseId : feedbackService.findStarredReleases(findParameters).results)
+            const auto releases{ feedbackService.findStarredReleases(findParameters) };
+            feedbackService.getFeedbacks(context.user->getId(), releases.results);
+            for (const ReleaseId releaseId : releases.results)
             {
                 if (auto release{ Release::find(context.dbSession, releaseId) })
                     starredNode.addArrayChild("album", createAlbumNode(context, release, id3));
             }
 
+            std::vector<Track::pointer> tracks;
             for (const TrackId trackId : feedbackService.findStarredTracks(findParameters).results)
             {
                 if (auto track{ Track::find(context.dbSession, trackId) })
-                    starredNode.addArrayChild("song", createSongNode(context, track, context.user));
+                    tracks.push_back(track);
             }
 
+            const std::vector<SongUserData> songUserData{ getSongUserData(context, tracks) };
+            for (std::size_t i{}; i < tracks.size(); ++i)
+                starredNode.addArrayChild("song", createSongNode(context, tracks[i], songUserData[i], context.user));
+
             return response;
         }
     } // namespace
@@ -489,8 +489,9 @@ namespace lms::api::subsonic
         Response::Node albumNode{ createAlbumNode(context, release, true /* id3 */) };
 
         const auto tracks{ Track::find(context.dbSession, Track::FindParameters{}.setRelease(id).setSortMethod(TrackSortMethod::Release)) };
-        for (const Track::pointer& track : tracks.results)
-            albumNode.addArrayChild("song", createSongNode(context, track, true /* id3 */));
+        const std::vector<SongUserData> songUserData{ getSongUserData(context, tracks.results) };
+        for (std::size_t i{}; i < tracks.results.size(); ++i)
+            albumNode.addArrayChild("song", createSongNode(context, tracks.results[i], songUserData[i], true /* id3 */));
 
         response.addNode("album", std::move(albumNode));
 
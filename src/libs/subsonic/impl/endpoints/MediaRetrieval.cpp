@@ -21,6 +21,8 @@
 
 #include <algorithm>
 #include <chrono>
+#include <iomanip>
+#include <ostream>
 
 #include "core/FileResourceHandlerCreator.hpp"
 #include "core/ILogger.hpp"
@@ -98,6 +100,9 @@ namespace lms::api::subsonic
             case transcoding::OutputFormat::OGG_VORBIS:
             case transcoding::OutputFormat::WEBM_VORBIS:
                 return codec == av::DecodingCodec::VORBIS;
+
+            case transcoding::OutputFormat::MPEGTS_AAC:
+                return codec == av::DecodingCodec::AAC;
             }
 
             return true;
@@ -244,6 +249,71 @@ namespace lms::api::subsonic
 
             return parameters;
         }
+
+        struct HlsParameters
+        {
+            transcoding::InputParameters inputParameters;
+            transcoding::OutputParameters outputParameters;
+        };
+
+        HlsParameters getHlsParameters(RequestContext& context)
+        {
+            // Mandatory params
+            const auto trackId{ getParameterAs<db::TrackId>(context.parameters, "id") };
+            const auto podcastEpisodeId{ getParameterAs<db::PodcastEpisodeId>(context.parameters, "id") };
+            if (!trackId && !podcastEpisodeId)
+                throw RequiredParameterMissingError{ "id" };
+
+            const AudioFileId audioId{ trackId ? AudioFileId{ *trackId } : AudioFileId{ *podcastEpisodeId } };
+
+            // Optional params
+            // Choice: no variant playlist, only the first requested bitrate is used
+            const std::size_t bitrate{ getParameterAs<std::size_t>(context.parameters, "bitRate").value_or(0) * 1000 }; // given in kbps
+
+            const AudioFileInfo audioFileInfo{ getAudioFileInfo(context.dbSession, audioId) };
+
+            HlsParameters parameters;
+            parameters.inputParameters.filePath = audioFileInfo.path;
+            parameters.inputParameters.duration = audioFileInfo.duration;
+
+            parameters.outputParameters.format = transcoding::OutputFormat::MPEGTS_AAC;
+            parameters.outputParameters.bitrate = bitrate ? bitrate : context.user->getSubsonicDefaultTranscodingOutputBitrate();
+            parameters.outputParameters.stripMetadata = true;
+
+            return parameters;
+        }
+
+        std::size_t getHlsSegmentCount(std::chrono::milliseconds duration)
+        {
+            const std::chrono::milliseconds segmentDuration{ transcoding::ITranscodingService::segmentDuration };
+            return static_cast<std::size_t>((duration + segmentDuration - std::chrono::milliseconds{ 1 }) / segmentDuration);
+        }
+
+        void writeHlsPlaylist(const Wt::Http::Request& request, std::chrono::milliseconds duration, std::ostream& os)
+        {
+            const std::chrono::milliseconds segmentDuration{ transcoding::ITranscodingService::segmentDuration };
+
+            // Segments are requested using the very same parameters (including the authentication ones), plus the segment index
+            // Relative to the playlist URL, which is located in the same directory
+            const std::string segmentBaseUrl{ "hls.view?" + request.queryString() + (request.queryString().empty() ? "" : "&") + "segment=" };
+
+            os << "#EXTM3U\n";
+            os << "#EXT-X-VERSION:3\n";
+            os << "#EXT-X-PLAYLIST-TYPE:VOD\n";
+            os << "#EXT-X-TARGETDURATION:" << std::chrono::duration_cast<std::chrono::seconds>(segmentDuration).count() << "\n";
+            os << "#EXT-X-MEDIA-SEQUENCE:0\n";
+
+            const std::size_t segmentCount{ getHlsSegmentCount(duration) };
+            for (std::size_t segmentIndex{}; segmentIndex < segmentCount; ++segmentIndex)
+            {
+                const std::chrono::milliseconds thisSegmentDuration{ std::min(segmentDuration, duration - segmentDuration * static_cast<std::chrono::milliseconds::rep>(segmentIndex)) };
+
+                os << "#EXTINF:" << std::fixed << std::setprecision(3) << (thisSegmentDuration.count() / 1000.f) << ",\n";
+                os << segmentBaseUrl << segmentIndex << "\n";
+            }
+
+            os << "#EXT-X-ENDLIST\n";
+        }
     } // namespace
 
     Response handleGetLyrics(RequestContext& context)
@@ -378,6 +448,46 @@ namespace lms::api::subsonic
         }
     }
 
+    void handleHls(RequestContext& context, const Wt::Http::Request& request, Wt::Http::Response& response)
+    {
+        std::shared_ptr<core::IResourceHandler> resourceHandler;
+
+        try
+        {
+            Wt::Http::ResponseContinuation* continuation = request.continuation();
+            if (!continuation)
+            {
+                const HlsParameters hlsParameters{ getHlsParameters(context) };
+
+                const std::optional<std::size_t> segmentIndex{ getParameterAs<std::size_t>(context.parameters, "segment") };
+                if (!segmentIndex)
+                {
+                    writeHlsPlaylist(request, hlsParameters.inputParameters.duration, response.out());
+                    response.setMimeType("application/vnd.apple.mpegurl");
+                    return;
+                }
+
+                if (*segmentIndex >= getHlsSegmentCount(hlsParameters.inputParameters.duration))
+                    throw BadParameterGenericError{ "segment" };
+
+                resourceHandler = core::Service<transcoding::ITranscodingService>::get()->createSegmentResourceHandler(hlsParameters.inputParameters, hlsParameters.outputParameters, *segmentIndex);
+            }
+            else
+            {
+                resourceHandler = Wt::cpp17::any_cast<std::shared_ptr<core::IResourceHandler>>(continuation->data());
+            }
+
+            continuation = resourceHandler->processRequest(request, response);
+            if (continuation)
+                continuation->setData(resourceHandler);
+        }
+        catch (const av::Exception& e)
+        {
+            response.setStatus(404); // report not found if something wrong happened
+            LMS_LOG(API_SUBSONIC, ERROR, "Caught Av exception: " << e.what());
+        }
+    }
+
     void handleGetCoverArt(RequestContext& context, const Wt::Http::Request& /*request*/, Wt::Http::Response& response)
     {
         // Mandatory params
@@ -33,5 +33,6 @@ namespace lms::api::subsonic
 
     void handleDownload(RequestContext& context, const Wt::Http::Request& request, Wt::Http::Response& response);
     void handleStream(RequestContext& context, const Wt::Http::Request& request, Wt::Http::Response& response);
+    void handleHls(RequestContext& context, const Wt::Http::Request& request, Wt::Http::Response& response);
     void handleGetCoverArt(RequestContext& context, const Wt::Http::Request& request, Wt::Http::Response& response);
 } // namespace lms::api::subsonic
@@ -49,6 +49,21 @@ namespace lms::api::subsonic
                 throw RequestedDataNotFoundError{};
             }
         }
+
+        void addPlaylistEntryNodes(RequestContext& context, Response::Node& playlistNode, const db::TrackList::pointer& trackList)
+        {
+            std::vector<Track::pointer> tracks;
+            {
+                auto entries{ trackList->getEntries() };
+                tracks.reserve(entries.results.size());
+                for (const TrackListEntry::pointer& entry : entries.results)
+                    tracks.push_back(entry->getTrack());
+            }
+
+            const std::vector<SongUserData> songUserData{ getSongUserData(context, tracks) };
+            for (std::size_t i{}; i < tracks.size(); ++i)
+                playlistNode.addArrayChild("entry", createSongNode(context, tracks[i], songUserData[i], context.user));
+        }
     } // namespace
 
     Response handleGetPlaylistsRequest(RequestContext& context)
@@ -106,9 +121,7 @@ namespace lms::api::subsonic
         Response response{ Response::createOkResponse(context.serverProtocolVersion) };
         Response::Node playlistNode{ createPlaylistNode(context, trackList) };
 
-        auto entries{ trackList->getEntries() };
-        for (const TrackListEntry::pointer& entry : entries.results)
-            playlistNode.addArrayChild("entry", createSongNode(context, entry->getTrack(), context.user));
+        addPlaylistEntryNodes(context, playlistNode, trackList);
 
         response.addNode("playlist", std::move(playlistNode));
 
@@ -159,9 +172,7 @@ namespace lms::api::subsonic
         Response response{ Response::createOkResponse(context.serverProtocolVersion) };
         Response::Node playlistNode{ createPlaylistNode(context, trackList) };
 
-        auto entries{ trackList->getEntries() };
-        for (const TrackListEntry::pointer& entry : entries.results)
-            playlistNode.addArrayChild("entry", createSongNode(context, entry->getTrack(), context.user));
+        addPlaylistEntryNodes(context, playlistNode, trackList);
 
         response.addNode("playlist", std::move(playlistNode));
 
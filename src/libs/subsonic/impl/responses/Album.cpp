@@ -127,12 +127,14 @@ namespace lms::api::subsonic
                 albumNode.setAttribute("genre", clusters.front()->getName());
         }
 
-        if (const Wt::WDateTime dateTime{ core::Service<feedback::IFeedbackService>::get()->getStarredDateTime(context.user->getId(), release->getId()) }; dateTime.isValid())
-            albumNode.setAttribute("starred", core::stringUtils::toISO8601String(dateTime));
+        const ReleaseId releaseId{ release->getId() };
+        const feedback::IFeedbackService::Feedback feedback{ core::Service<feedback::IFeedbackService>::get()->getFeedbacks(context.user->getId(), std::span{ &releaseId, 1 }).front() };
+        if (feedback.starredDateTime.isValid())
+            albumNode.setAttribute("starred", core::stringUtils::toISO8601String(feedback.starredDateTime));
 
         // Always report user rating, even if legacy API only specified it for directories
-        if (const auto rating{ core::Service<feedback::IFeedbackService>::get()->getRating(context.user->getId(), release->getId()) })
-            albumNode.setAttribute("userRating", *rating);
+        if (feedback.rating)
+            albumNode.setAttribute("userRating", *feedback.rating);
 
         if (!context.enableOpenSubsonic)
             return albumNode;
@@ -104,11 +104,13 @@ namespace lms::api::subsonic
         const std::size_t count{ Release::getCount(context.dbSession, Release::FindParameters{}.setArtist(artist->getId())) };
         artistNode.setAttribute("albumCount", count);
 
-        if (const Wt::WDateTime dateTime{ core::Service<feedback::IFeedbackService>::get()->getStarredDateTime(context.user->getId(), artist->getId()) }; dateTime.isValid())
-            artistNode.setAttribute("starred", core::stringUtils::toISO8601String(dateTime));
+        const ArtistId artistId{ artist->getId() };
+        const feedback::IFeedbackService::Feedback feedback{ core::Service<feedback::IFeedbackService>::get()->getFeedbacks(context.user->getId(), std::span{ &artistId, 1 }).front() };
+        if (feedback.starredDateTime.isValid())
+            artistNode.setAttribute("starred", core::stringUtils::toISO8601String(feedback.starredDateTime));
 
-        if (const auto rating{ core::Service<feedback::IFeedbackService>::get()->getRating(context.user->getId(), artist->getId()) })
-            artistNode.setAttribute("userRating", *rating);
+        if (feedback.rating)
+            artistNode.setAttribute("userRating", *feedback.rating);
 
         // OpenSubsonic specific fields (must always be set)
         if (context.enableOpenSubsonic)
@@ -20,6 +20,7 @@
 #include "responses/Song.hpp"
 
 #include <filesystem>
+#include <span>
 #include <string_view>
 #include <system_error>
 
@@ -75,7 +76,30 @@ namespace lms::api::subsonic
         }
     } // namespace
 
+    std::vector<SongUserData> getSongUserData(RequestContext& context, std::span<const db::ObjectPtr<db::Track>> tracks)
+    {
+        std::vector<TrackId> trackIds;
+        trackIds.reserve(tracks.size());
+        for (const Track::pointer& track : tracks)
+            trackIds.push_back(track->getId());
+
+        const std::vector<scrobbling::IScrobblingService::TrackListenStats> listenStats{ core::Service<scrobbling::IScrobblingService>::get()->getListenStats(context.user->getId(), context.user->getScrobblingBackend(), trackIds) };
+        const std::vector<feedback::IFeedbackService::Feedback> feedbacks{ core::Service<feedback::IFeedbackService>::get()->getFeedbacks(context.user->getId(), trackIds) };
+
+        std::vector<SongUserData> res;
+        res.reserve(tracks.size());
+        for (std::size_t i{}; i < tracks.size(); ++i)
+            res.push_back(SongUserData{ listenStats[i], feedbacks[i] });
+
+        return res;
+    }
+
     Response::Node createSongNode(RequestContext& context, const Track::pointer& track, bool id3)
+    {
+        return createSongNode(context, track, getSongUserData(context, std::span{ &track, 1 }).front(), id3);
+    }
+
+    Response::Node createSongNode(RequestContext& context, const Track::pointer& track, const SongUserData& userData, bool id3)
     {
         LMS_SCOPED_TRACE_DETAILED("Subsonic", "CreateSong");
 
@@ -100,7 +124,7 @@ namespace lms::api::subsonic
             trackResponse.setAttribute("year", *originalYear);
         else if (const auto year{ track->getYear() })
             trackResponse.setAttribute("year", *year);
-        trackResponse.setAttribute("playCount", core::Service<scrobbling::IScrobblingService>::get()->getCount(context.user->getId(), track->getId()));
+        trackResponse.setAttribute("playCount", userData.listenStats.listenCount);
 
         // maybe not available if user just removed the library without rescanning
         if (const db::MediaLibrary::pointer library{ track->getMediaLibrary() })
@@ -160,11 +184,11 @@ namespace lms::api::subsonic
         trackResponse.setAttribute("type", "music");
         trackResponse.setAttribute("created", core::stringUtils::toISO8601String(track->getAddedTime()));
         trackResponse.setAttribute("contentType", core::getMimeType(track->getAbsoluteFilePath().extension()));
-        if (const auto rating{ core::Service<feedback::IFeedbackService>::get()->getRating(context.user->getId(), track->getId()) })
-            trackResponse.setAttribute("userRating", *rating);
+        if (userData.feedback.rating)
+            trackResponse.setAttribute("userRating", *userData.feedback.rating);
 
-        if (const Wt::WDateTime dateTime{ core::Service<feedback::IFeedbackService>::get()->getStarredDateTime(context.user->getId(), track->getId()) }; dateTime.isValid())
-            trackResponse.setAttribute("starred", core::stringUtils::toISO8601String(dateTime));
+        if (userData.feedback.starredDateTime.isValid())
+            trackResponse.setAttribute("starred", core::stringUtils::toISO8601String(userData.feedback.starredDateTime));
 
         // Report the first GENRE for this track
         std::vector<Cluster::pointer> genres;
@@ -189,10 +213,7 @@ namespace lms::api::subsonic
 
         trackResponse.setAttribute("mediaType", "song");
 
-        {
-            const Wt::WDateTime dateTime{ core::Service<scrobbling::IScrobblingService>::get()->getLastListenDateTime(context.user->getId(), track->getId()) };
-            trackResponse.setAttribute("played", dateTime.isValid() ? core::stringUtils::toISO8601String(dateTime) : "");
-        }
+        trackResponse.setAttribute("played", userData.listenStats.lastListenDateTime.isValid() ? core::stringUtils::toISO8601String(userData.listenStats.lastListenDateTime) : "");
 
         {
             std::optional<core::UUID> mbid{ track->getRecordingMBID() };
@@ -261,4 +282,4 @@ namespace lms::api::subsonic
 
         return trackResponse;
     }
-} // namespace lms::api::subsonic
\ No newline at end of file
+} // namespace lms::api::subsonic
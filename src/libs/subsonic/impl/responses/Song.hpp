@@ -19,7 +19,12 @@
 
 #pragma once
 
+#include <span>
+#include <vector>
+
 #include "database/Object.hpp"
+#include "services/feedback/IFeedbackService.hpp"
+#include "services/scrobbling/IScrobblingService.hpp"
 
 #include "SubsonicResponse.hpp"
 
@@ -34,5 +39,15 @@ namespace lms::api::subsonic
 {
     struct RequestContext;
 
+    struct SongUserData
+    {
+        scrobbling::IScrobblingService::TrackListenStats listenStats;
+        feedback::IFeedbackService::Feedback feedback;
+    };
+
+    // Fetches the listen stats and feedbacks of many tracks at once, same order as tracks
+    std::vector<SongUserData> getSongUserData(RequestContext& context, std::span<const db::ObjectPtr<db::Track>> tracks);
+
     Response::Node createSongNode(RequestContext& context, const db::ObjectPtr<db::Track>& track, bool id3);
+    Response::Node createSongNode(RequestContext& context, const db::ObjectPtr<db::Track>& track, const SongUserData& userData, bool id3);
 } // namespace lms::api::subsonic
\ No newline at end of file
@@ -41,6 +41,7 @@
 #include "services/auth/IAuthTokenService.hpp"
 #include "services/auth/IEnvService.hpp"
 #include "services/auth/IPasswordService.hpp"
+#include "services/catalog/ICatalogService.hpp"
 #include "services/feedback/IFeedbackService.hpp"
 #include "services/podcast/IPodcastService.hpp"
 #include "services/recommendation/IPlaylistGeneratorService.hpp"
@@ -326,7 +327,9 @@ namespace lms
             close(STDIN_FILENO);
 
             core::Service<core::IConfig> config{ core::createConfig(configFilePath) };
-            core::Service<core::logging::ILogger> logger{ createLogger(getLogMinSeverity(), config->getPath("log-file", "")) };
+            core::Service<core::logging::ILogger> logger{ config->getBool("log-async", false)
+                                                              ? core::logging::createAsyncLogger(getLogMinSeverity(), config->getPath("log-file", ""), config->getULong("log-async-max-pending-logs-per-thread", core::logging::defaultMaxPendingLogsPerThread))
+                                                              : core::logging::createLogger(getLogMinSeverity(), config->getPath("log-file", "")) };
             core::Service<core::tracing::ITraceLogger> traceLogger;
             if (const auto level{ getTracingLevel() })
                 traceLogger.assign(core::tracing::createTraceLogger(level.value(), config->getULong("tracing-buffer-size", core::tracing::MinBufferSizeInMBytes)));
@@ -425,7 +428,8 @@ namespace lms
 
             image::init(argv[0]);
             core::Service<artwork::IArtworkService> artworkService{ artwork::createArtworkService(*database, server.appRoot() + "/images/unknown-cover.svg", server.appRoot() + "/images/unknown-artist.svg") };
-            core::Service<recommendation::IRecommendationService> recommendationService{ recommendation::createRecommendationService(*database) };
+            core::Service<catalog::ICatalogService> catalogService{ catalog::createCatalogService(ioContext, *database) };
+            core::Service<recommendation::IRecommendationService> recommendationService{ recommendation::createRecommendationService(ioContext, *database) };
             core::Service<recommendation::IPlaylistGeneratorService> playlistGeneratorService{ recommendation::createPlaylistGeneratorService(*database, *recommendationService) };
             core::Service<scanner::IScannerService> scannerService{ scanner::createScannerService(*database, cachePath) };
             core::Service<transcoding::ITranscodingService> transcodingService{ transcoding::createTranscodingService(*database, *childProcessManagerService) };
@@ -437,6 +441,18 @@ namespace lms
                 artworkService->flushCache();
             });
 
+            scannerService->getEvents().scanComplete.connect([&](const scanner::ScanStats& stats) {
+                // Similarity indexes are rebuilt from the database content in the background, the current ones keep being served meanwhile
+                if (stats.getChangesCount() > 0)
+                    recommendationService->load();
+            });
+
+            scannerService->getEvents().scanComplete.connect([&](const scanner::ScanStats& stats) {
+                // Refreshed in the background, the stale snapshot is dropped right away so that the views are populated from the database meanwhile
+                if (stats.getChangesCount() > 0)
+                    catalogService->refresh();
+            });
+
             core::Service<feedback::IFeedbackService> feedbackService{ feedback::createFeedbackService(ioContext, *database) };
             core::Service<scrobbling::IScrobblingService> scrobblingService{ scrobbling::createScrobblingService(ioContext, *database) };
 
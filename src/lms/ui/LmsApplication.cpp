@@ -78,6 +78,7 @@ namespace lms::ui
 
             auto res{ std::make_shared<Wt::WMessageResourceBundle>() };
             res->use(appRoot + "admin-about");
+            res->use(appRoot + "admin-catalog");
             res->use(appRoot + "admin-db");
             res->use(appRoot + "admin-debugtools");
             res->use(appRoot + "admin-initwizard");
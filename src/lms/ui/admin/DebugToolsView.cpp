@@ -20,6 +20,7 @@
 #include "DebugToolsView.hpp"
 
 #include "admin/debug/Database.hpp"
+#include "debug/Catalog.hpp"
 #include "debug/Database.hpp"
 #include "debug/Tracing.hpp"
 
@@ -32,5 +33,6 @@ namespace lms::ui
 
         bindNew<Tracing>("tracing");
         bindNew<Database>("db");
+        bindNew<Catalog>("catalog");
     }
 } // namespace lms::ui
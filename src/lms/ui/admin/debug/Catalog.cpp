@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Catalog.hpp"
+
+#include <Wt/WPushButton.h>
+
+#include "core/Service.hpp"
+#include "services/catalog/ICatalogService.hpp"
+
+namespace lms::ui
+{
+    Catalog::Catalog()
+        : Wt::WTemplate{ Wt::WString::tr("Lms.Admin.DebugTools.Catalog.template") }
+    {
+        addFunction("tr", &Wt::WTemplate::Functions::tr);
+
+        Wt::WPushButton* updateBtn{ bindNew<Wt::WPushButton>("update-btn", Wt::WString::tr("Lms.Admin.DebugTools.Catalog.update")) };
+        updateBtn->clicked().connect([this] { refreshView(); });
+
+        refreshView();
+    }
+
+    void Catalog::refreshView()
+    {
+        const catalog::ICatalogService* catalogService{ core::Service<catalog::ICatalogService>::get() };
+        const auto snapshot{ catalogService ? catalogService->getSnapshot() : nullptr };
+
+        setCondition("if-loaded", snapshot != nullptr);
+        setCondition("if-not-loaded", snapshot == nullptr);
+        if (!snapshot)
+            return;
+
+        const catalog::ICatalogService::RefreshStats stats{ catalogService->getRefreshStats() };
+
+        bindString("objects", Wt::WString::tr("Lms.Admin.DebugTools.Catalog.objects-value").arg(snapshot->getTrackCount()).arg(snapshot->getReleaseCount()).arg(snapshot->getArtistCount()), Wt::TextFormat::Plain);
+        bindString("memory-usage", Wt::WString::tr("Lms.Admin.DebugTools.Catalog.memory-usage-value").arg(snapshot->getMemoryUsage() / 1024), Wt::TextFormat::Plain);
+        bindString("last-refresh", Wt::WString::tr("Lms.Admin.DebugTools.Catalog.last-refresh-value").arg(stats.lastRefreshDateTime.toString()).arg(stats.lastRefreshDuration.count()), Wt::TextFormat::Plain);
+        bindString("refresh-count", Wt::WString::fromUTF8(std::to_string(stats.refreshCount)), Wt::TextFormat::Plain);
+    }
+} // namespace lms::ui
@@ -24,6 +24,7 @@
 #include "database/objects/Artist.hpp"
 #include "database/objects/TrackList.hpp"
 #include "database/objects/User.hpp"
+#include "services/catalog/ICatalogService.hpp"
 #include "services/feedback/IFeedbackService.hpp"
 #include "services/scrobbling/IScrobblingService.hpp"
 
@@ -87,52 +88,16 @@ namespace lms::ui
             }
 
         case Mode::RecentlyAdded:
-            {
-                db::Artist::FindParameters params;
-                params.setFilters(getDbFilters());
-                params.setKeywords(getSearchKeywords());
-                params.setLinkType(_linkType);
-                params.setSortMethod(db::ArtistSortMethod::AddedDesc);
-                params.setRange(range);
-
-                {
-                    auto transaction{ LmsApp->getDbSession().createReadTransaction() };
-                    artists = db::Artist::findIds(LmsApp->getDbSession(), params);
-                }
-                break;
-            }
+            artists = findArtists(db::ArtistSortMethod::AddedDesc, range);
+            break;
 
         case Mode::RecentlyModified:
-            {
-                db::Artist::FindParameters params;
-                params.setFilters(getDbFilters());
-                params.setKeywords(getSearchKeywords());
-                params.setLinkType(_linkType);
-                params.setSortMethod(db::ArtistSortMethod::LastWrittenDesc);
-                params.setRange(range);
-
-                {
-                    auto transaction{ LmsApp->getDbSession().createReadTransaction() };
-                    artists = db::Artist::findIds(LmsApp->getDbSession(), params);
-                }
-                break;
-            }
+            artists = findArtists(db::ArtistSortMethod::LastWrittenDesc, range);
+            break;
 
         case Mode::All:
-            {
-                db::Artist::FindParameters params;
-                params.setFilters(getDbFilters());
-                params.setKeywords(getSearchKeywords());
-                params.setLinkType(_linkType);
-                params.setSortMethod(db::ArtistSortMethod::SortName);
-                params.setRange(range);
-
-                {
-                    auto transaction{ LmsApp->getDbSession().createReadTransaction() };
-                    artists = db::Artist::findIds(LmsApp->getDbSession(), params);
-                }
-                break;
-            }
+            artists = findArtists(db::ArtistSortMethod::SortName, range);
+            break;
         }
 
         if (range.offset + range.size == getMaxCount())
@@ -146,20 +111,34 @@ namespace lms::ui
         assert(getMode() == Mode::Random);
 
         if (!_randomArtists)
-        {
-            db::Artist::FindParameters params;
-            params.setFilters(getDbFilters());
-            params.setKeywords(getSearchKeywords());
-            params.setLinkType(_linkType);
-            params.setSortMethod(db::ArtistSortMethod::Random);
-            params.setRange(db::Range{ 0, getMaxCount() });
+            _randomArtists = findArtists(db::ArtistSortMethod::Random, db::Range{ 0, getMaxCount() });
 
+        return _randomArtists->getSubRange(range);
+    }
+
+    db::RangeResults<db::ArtistId> ArtistCollector::findArtists(db::ArtistSortMethod sortMethod, Range range)
+    {
+        // the catalog snapshot cannot handle keyword searches
+        if (getSearchKeywords().empty())
+        {
+            if (const catalog::ICatalogService* catalogService{ core::Service<catalog::ICatalogService>::get() })
             {
-                auto transaction{ LmsApp->getDbSession().createReadTransaction() };
-                _randomArtists = db::Artist::findIds(LmsApp->getDbSession(), params);
+                if (const auto snapshot{ catalogService->getSnapshot() })
+                {
+                    if (auto artists{ snapshot->findArtists(getDbFilters(), _linkType, sortMethod, range) })
+                        return std::move(*artists);
+                }
             }
         }
 
-        return _randomArtists->getSubRange(range);
+        db::Artist::FindParameters params;
+        params.setFilters(getDbFilters());
+        params.setKeywords(getSearchKeywords());
+        params.setLinkType(_linkType);
+        params.setSortMethod(sortMethod);
+        params.setRange(range);
+
+        auto transaction{ LmsApp->getDbSession().createReadTransaction() };
+        return db::Artist::findIds(LmsApp->getDbSession(), params);
     }
 } // namespace lms::ui
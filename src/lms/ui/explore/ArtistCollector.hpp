@@ -43,6 +43,7 @@ namespace lms::ui
 
     private:
         db::RangeResults<db::ArtistId> getRandomArtists(Range range);
+        db::RangeResults<db::ArtistId> findArtists(db::ArtistSortMethod sortMethod, Range range);
         std::optional<db::RangeResults<db::ArtistId>> _randomArtists;
         std::optional<db::TrackArtistLinkType> _linkType;
     };
@@ -23,6 +23,7 @@
 #include "database/Session.hpp"
 #include "database/objects/Release.hpp"
 #include "database/objects/User.hpp"
+#include "services/catalog/ICatalogService.hpp"
 #include "services/feedback/IFeedbackService.hpp"
 #include "services/scrobbling/IScrobblingService.hpp"
 
@@ -82,49 +83,16 @@ namespace lms::ui
             }
 
         case Mode::RecentlyAdded:
-            {
-                db::Release::FindParameters params;
-                params.setFilters(getDbFilters());
-                params.setKeywords(getSearchKeywords());
-                params.setSortMethod(db::ReleaseSortMethod::AddedDesc);
-                params.setRange(range);
-
-                {
-                    auto transaction{ LmsApp->getDbSession().createReadTransaction() };
-                    releases = db::Release::findIds(LmsApp->getDbSession(), params);
-                }
-                break;
-            }
+            releases = findReleases(db::ReleaseSortMethod::AddedDesc, range);
+            break;
 
         case Mode::RecentlyModified:
-            {
-                db::Release::FindParameters params;
-                params.setFilters(getDbFilters());
-                params.setKeywords(getSearchKeywords());
-                params.setSortMethod(db::ReleaseSortMethod::LastWrittenDesc);
-                params.setRange(range);
-
-                {
-                    auto transaction{ LmsApp->getDbSession().createReadTransaction() };
-                    releases = db::Release::findIds(LmsApp->getDbSession(), params);
-                }
-                break;
-            }
+            releases = findReleases(db::ReleaseSortMethod::LastWrittenDesc, range);
+            break;
 
         case Mode::All:
-            {
-                db::Release::FindParameters params;
-                params.setFilters(getDbFilters());
-                params.setSortMethod(db::ReleaseSortMethod::SortName);
-                params.setKeywords(getSearchKeywords());
-                params.setRange(range);
-
-                {
-                    auto transaction{ LmsApp->getDbSession().createReadTransaction() };
-                    releases = db::Release::findIds(LmsApp->getDbSession(), params);
-                }
-                break;
-            }
+            releases = findReleases(db::ReleaseSortMethod::SortName, range);
+            break;
         }
 
         if (range.offset + range.size == getMaxCount())
@@ -138,20 +106,34 @@ namespace lms::ui
         assert(getMode() == Mode::Random);
 
         if (!_randomReleases)
-        {
-            db::Release::FindParameters params;
-            params.setFilters(getDbFilters());
-            params.setKeywords(getSearchKeywords());
-            params.setSortMethod(db::ReleaseSortMethod::Random);
-            params.setRange(db::Range{ 0, getMaxCount() });
+            _randomReleases = findReleases(db::ReleaseSortMethod::Random, db::Range{ 0, getMaxCount() });
 
+        return _randomReleases->getSubRange(range);
+    }
+
+    db::RangeResults<db::ReleaseId> ReleaseCollector::findReleases(db::ReleaseSortMethod sortMethod, Range range)
+    {
+        // the catalog snapshot cannot handle keyword searches
+        if (getSearchKeywords().empty())
+        {
+            if (const catalog::ICatalogService* catalogService{ core::Service<catalog::ICatalogService>::get() })
             {
-                auto transaction{ LmsApp->getDbSession().createReadTransaction() };
-                _randomReleases = db::Release::findIds(LmsApp->getDbSession(), params);
+                if (const auto snapshot{ catalogService->getSnapshot() })
+                {
+                    if (auto releases{ snapshot->findReleases(getDbFilters(), sortMethod, range) })
+                        return std::move(*releases);
+                }
             }
         }
 
-        return _randomReleases->getSubRange(range);
+        db::Release::FindParameters params;
+        params.setFilters(getDbFilters());
+        params.setKeywords(getSearchKeywords());
+        params.setSortMethod(sortMethod);
+        params.setRange(range);
+
+        auto transaction{ LmsApp->getDbSession().createReadTransaction() };
+        return db::Release::findIds(LmsApp->getDbSession(), params);
     }
 
 } // namespace lms::ui
@@ -43,6 +43,7 @@ namespace lms::ui
 
     private:
         db::RangeResults<db::ReleaseId> getRandomReleases(Range range);
+        db::RangeResults<db::ReleaseId> findReleases(db::ReleaseSortMethod sortMethod, Range range);
         std::optional<db::RangeResults<db::ReleaseId>> _randomReleases;
     };
 } // namespace lms::ui
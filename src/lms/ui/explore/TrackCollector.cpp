@@ -24,6 +24,7 @@
 #include "database/objects/Track.hpp"
 #include "database/objects/TrackList.hpp"
 #include "database/objects/User.hpp"
+#include "services/catalog/ICatalogService.hpp"
 #include "services/feedback/IFeedbackService.hpp"
 #include "services/scrobbling/IScrobblingService.hpp"
 
@@ -83,48 +84,16 @@ namespace lms::ui
             }
 
         case Mode::RecentlyAdded:
-            {
-                db::Track::FindParameters params;
-                params.setFilters(getDbFilters());
-                params.setKeywords(getSearchKeywords());
-                params.setSortMethod(db::TrackSortMethod::AddedDesc);
-                params.setRange(range);
-
-                {
-                    auto transaction{ LmsApp->getDbSession().createReadTransaction() };
-                    tracks = db::Track::findIds(LmsApp->getDbSession(), params);
-                }
-                break;
-            }
+            tracks = findTracks(db::TrackSortMethod::AddedDesc, range);
+            break;
 
         case Mode::RecentlyModified:
-            {
-                db::Track::FindParameters params;
-                params.setFilters(getDbFilters());
-                params.setKeywords(getSearchKeywords());
-                params.setSortMethod(db::TrackSortMethod::LastWrittenDesc);
-                params.setRange(range);
-
-                {
-                    auto transaction{ LmsApp->getDbSession().createReadTransaction() };
-                    tracks = db::Track::findIds(LmsApp->getDbSession(), params);
-                }
-                break;
-            }
+            tracks = findTracks(db::TrackSortMethod::LastWrittenDesc, range);
+            break;
 
         case Mode::All:
-            {
-                db::Track::FindParameters params;
-                params.setFilters(getDbFilters());
-                params.setKeywords(getSearchKeywords());
-                params.setRange(range);
-
-                {
-                    auto transaction{ LmsApp->getDbSession().createReadTransaction() };
-                    tracks = db::Track::findIds(LmsApp->getDbSession(), params);
-                }
-                break;
-            }
+            tracks = findTracks(db::TrackSortMethod::None, range);
+            break;
         }
 
         if (range.offset + range.size == getMaxCount())
@@ -138,20 +107,34 @@ namespace lms::ui
         assert(getMode() == Mode::Random);
 
         if (!_randomTracks)
-        {
-            db::Track::FindParameters params;
-            params.setFilters(getDbFilters());
-            params.setKeywords(getSearchKeywords());
-            params.setSortMethod(db::TrackSortMethod::Random);
-            params.setRange(db::Range{ 0, getMaxCount() });
+            _randomTracks = findTracks(db::TrackSortMethod::Random, db::Range{ 0, getMaxCount() });
 
+        return _randomTracks->getSubRange(range);
+    }
+
+    db::RangeResults<db::TrackId> TrackCollector::findTracks(db::TrackSortMethod sortMethod, Range range)
+    {
+        // the catalog snapshot cannot handle keyword searches
+        if (getSearchKeywords().empty())
+        {
+            if (const catalog::ICatalogService* catalogService{ core::Service<catalog::ICatalogService>::get() })
             {
-                auto transaction{ LmsApp->getDbSession().createReadTransaction() };
-                _randomTracks = db::Track::findIds(LmsApp->getDbSession(), params);
+                if (const auto snapshot{ catalogService->getSnapshot() })
+                {
+                    if (auto tracks{ snapshot->findTracks(getDbFilters(), sortMethod, range) })
+                        return std::move(*tracks);
+                }
             }
         }
 
-        return _randomTracks->getSubRange(range);
+        db::Track::FindParameters params;
+        params.setFilters(getDbFilters());
+        params.setKeywords(getSearchKeywords());
+        params.setSortMethod(sortMethod);
+        params.setRange(range);
+
+        auto transaction{ LmsApp->getDbSession().createReadTransaction() };
+        return db::Track::findIds(LmsApp->getDbSession(), params);
     }
 
 } // namespace lms::ui
@@ -42,6 +42,7 @@ namespace lms::ui
 
     private:
         db::RangeResults<db::TrackId> getRandomTracks(Range range);
+        db::RangeResults<db::TrackId> findTracks(db::TrackSortMethod sortMethod, Range range);
         std::optional<db::RangeResults<db::TrackId>> _randomTracks;
     };
 } // namespace lms::ui
@@ -19,6 +19,11 @@
 
 #include "DownloadResource.hpp"
 
+#include <optional>
+#include <sstream>
+#include <string>
+
+#include <Wt/Http/Request.h>
 #include <Wt/Http/Response.h>
 #include <Wt/WDateTime.h>
 
@@ -60,6 +65,52 @@ namespace lms::ui
                     return;
                 }
 
+                if (const std::optional<std::uint64_t> totalSize{ zipper->getTotalSize() })
+                {
+                    // Allow clients to resume interrupted downloads
+                    response.addHeader("Accept-Ranges", "bytes");
+
+                    std::string etag;
+                    if (const std::optional<std::string> zipperETag{ zipper->getETag() })
+                    {
+                        etag = "\"" + *zipperETag + "\"";
+                        response.addHeader("ETag", etag);
+                    }
+
+                    // Only resume if the archive content has not changed since the interrupted download (we never send Last-Modified, so date validators never match)
+                    const std::string ifRange{ request.headerValue("If-Range") };
+                    const bool ignoreRanges{ !ifRange.empty() && (etag.empty() || ifRange != etag) };
+                    if (ignoreRanges)
+                        DL_RESOURCE_LOG(DEBUG, "If-Range mismatch, sending the whole archive");
+
+                    const Wt::Http::Request::ByteRangeSpecifier ranges{ request.getRanges(*totalSize) };
+                    if (!ignoreRanges && !ranges.isSatisfiable())
+                    {
+                        std::ostringstream contentRange;
+                        contentRange << "bytes */" << *totalSize;
+                        response.setStatus(416); // Requested range not satisfiable
+                        response.addHeader("Content-Range", contentRange.str());
+                        return;
+                    }
+
+                    if (!ignoreRanges && ranges.size() == 1)
+                    {
+                        DL_RESOURCE_LOG(DEBUG, "Range requested = " << ranges[0].firstByte() << "-" << ranges[0].lastByte());
+
+                        zipper->setRange(ranges[0].firstByte(), ranges[0].lastByte() + 1);
+
+                        std::ostringstream contentRange;
+                        contentRange << "bytes " << ranges[0].firstByte() << "-" << ranges[0].lastByte() << "/" << *totalSize;
+                        response.setStatus(206);
+                        response.addHeader("Content-Range", contentRange.str());
+                        response.setContentLength(ranges[0].lastByte() + 1 - ranges[0].firstByte());
+                    }
+                    else
+                    {
+                        response.setContentLength(*totalSize);
+                    }
+                }
+
                 response.setMimeType("application/zip");
             }
 
@@ -163,7 +214,8 @@ namespace lms::ui
                 files.emplace_back(zip::Entry{ fileName, track->getAbsoluteFilePath() });
             }
 
-            return zip::createArchiveZipper(files);
+            // Audio files are already compressed: just store them, so that the archive size is known up front
+            return zip::createStoreZipper(files);
         }
     } // namespace details
 
@@ -24,6 +24,7 @@
 #include <boost/program_options.hpp>
 
 #include "core/IConfig.hpp"
+#include "core/IOContextRunner.hpp"
 #include "core/ILogger.hpp"
 #include "core/Service.hpp"
 #include "core/SystemPaths.hpp"
@@ -148,12 +149,15 @@ int main(int argc, char* argv[])
         auto db{ db::createDb(config->getPath("working-dir", "/var/lms") / "lms.db") };
         Session session{ *db };
 
+        boost::asio::io_context ioContext;
+        core::IOContextRunner ioContextRunner{ ioContext, 1, "Recommendation" };
+
         std::cout << "Creating recommendation service..." << std::endl;
-        const auto recommendationService{ recommendation::createRecommendationService(*db) };
+        const auto recommendationService{ recommendation::createRecommendationService(ioContext, *db) };
         std::cout << "Recommendation service created!" << std::endl;
 
         std::cout << "Loading recommendation service..." << std::endl;
-        recommendationService->load();
+        recommendationService->waitForLoad(); // the service starts loading on creation
 
         unsigned maxSimilarityCount{ vm["max"].as<unsigned>() };
 
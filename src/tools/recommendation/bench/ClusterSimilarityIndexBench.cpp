@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2025 Emeric Poupon
+ *
+ * This file is part of LMS.
+ *
+ * LMS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * LMS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with LMS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "clusters/ClusterSimilarityIndex.hpp"
+
+namespace lms::recommendation
+{
+    namespace
+    {
+        // Synthetic library, shaped like a real one: a few huge genres, some moods, and one label per release
+        struct Library
+        {
+            static constexpr std::size_t trackCount{ 100'000 };
+            static constexpr std::size_t tracksPerRelease{ 10 };
+            static constexpr std::size_t releasesPerArtist{ 5 };
+            static constexpr std::size_t genreCount{ 300 };
+            static constexpr std::size_t moodCount{ 40 };
+
+            std::vector<std::vector<db::ClusterId::ValueType>> trackClusters; // sorted, for each track
+
+            Library()
+            {
+                std::mt19937 generator{ 42 };
+
+                std::vector<double> genreWeights(genreCount);
+                for (std::size_t i{}; i < genreCount; ++i)
+                    genreWeights[i] = 1. / static_cast<double>(i + 1);
+                std::discrete_distribution<std::size_t> genreDist{ std::cbegin(genreWeights), std::cend(genreWeights) };
+                std::uniform_int_distribution<std::size_t> moodDist{ 0, moodCount - 1 };
+                std::uniform_int_distribution<std::size_t> countDist{ 0, 2 };
+
+                trackClusters.resize(trackCount);
+                for (std::size_t trackIndex{}; trackIndex < trackCount; ++trackIndex)
+                {
+                    auto& clusters{ trackClusters[trackIndex] };
+
+                    const std::size_t genresPerTrack{ 1 + countDist(generator) };
+                    for (std::size_t i{}; i < genresPerTrack; ++i)
+                        clusters.push_back(static_cast<db::ClusterId::ValueType>(1 + genreDist(generator)));
+
+                    const std::size_t moodsPerTrack{ countDist(generator) };
+                    for (std::size_t i{}; i < moodsPerTrack; ++i)
+                        clusters.push_back(static_cast<db::ClusterId::ValueType>(1 + genreCount + moodDist(generator)));
+
+                    // label
+                    clusters.push_back(static_cast<db::ClusterId::ValueType>(1 + genreCount + moodCount + getReleaseIndex(trackIndex)));
+
+                    std::sort(std::begin(clusters), std::end(clusters));
+                    clusters.erase(std::unique(std::begin(clusters), std::end(clusters)), std::end(clusters));
+                }
+            }
+
+            static std::size_t getReleaseIndex(std::size_t trackIndex) { return trackIndex / tracksPerRelease; }
+            static std::size_t getArtistIndex(std::size_t trackIndex) { return getReleaseIndex(trackIndex) / releasesPerArtist; }
+            static db::TrackId getTrackId(std::size_t trackIndex) { return db::TrackId{ static_cast<db::TrackId::ValueType>(trackIndex + 1) }; }
+
+            ClusterSimilarityIndex buildIndex() const
+            {
+                ClusterSimilarityIndex::Builder builder;
+                for (std::size_t trackIndex{}; trackIndex < trackCount; ++trackIndex)
+                {
+                    const db::TrackId trackId{ getTrackId(trackIndex) };
+                    for (const db::ClusterId::ValueType clusterId : trackClusters[trackIndex])
+                        builder.addTrackCluster(trackId, db::ClusterId{ clusterId });
+
+                    builder.setTrackRelease(trackId, db::ReleaseId{ static_cast<db::ReleaseId::ValueType>(getReleaseIndex(trackIndex) + 1) });
+                    builder.addTrackArtist(trackId, db::ArtistId{ static_cast<db::ArtistId::ValueType>(getArtistIndex(trackIndex) + 1) }, db::TrackArtistLinkType::Artist);
+                }
+
+                return builder.build();
+            }
+
+            // Exact score, as computed by the database query
+            std::size_t computeScore(std::size_t trackIndex, const std::vector<db::ClusterId::ValueType>& queryClusters) const
+            {
+                const auto& clusters{ trackClusters[trackIndex] };
+                return std::count_if(std::cbegin(clusters), std::cend(clusters), [&](db::ClusterId::ValueType clusterId) { return std::binary_search(std::cbegin(queryClusters), std::cend(queryClusters), clusterId); });
+            }
+
+            // Fraction of the results that are as good as the exact top results (ties are randomly ordered, so ids cannot be directly compared)
+            double computeRecall(std::size_t queryTrackIndex, const std::vector<db::TrackId>& results, std::size_t maxCount) const
+            {
+                const auto& queryClusters{ trackClusters[queryTrackIndex] };
+
+                std::vector<std::size_t> scores;
+                scores.reserve(trackCount);
+                for (std::size_t trackIndex{}; trackIndex < trackCount; ++trackIndex)
+                {
+                    if (trackIndex != queryTrackIndex)
+                        scores.push_back(computeScore(trackIndex, queryClusters));
+                }
+
+                const std::size_t expectedCount{ std::min(maxCount, static_cast<std::size_t>(std::count_if(std::cbegin(scores), std::cend(scores), [](std::size_t score) { return score > 0; }))) };
+                if (expectedCount == 0)
+                    return 1;
+
+                std::nth_element(std::begin(scores), std::begin(scores) + (expectedCount - 1), std::end(scores), std::greater<>{});
+                const std::size_t minScore{ scores[expectedCount - 1] };
+
+                const std::size_t matchCount{ static_cast<std::size_t>(std::count_if(std::cbegin(results), std::cend(results), [&](db::TrackId trackId) {
+                    return computeScore(static_cast<std::size_t>(trackId.getValue() - 1), queryClusters) >= minScore;
+                })) };
+
+                return static_cast<double>(matchCount) / static_cast<double>(expectedCount);
+            }
+        };
+
+        const Library& getLibrary()
+        {
+            static const Library library;
+            return library;
+        }
+
+        std::vector<std::size_t> getQueryTrackIndexes(std::size_t count)
+        {
+            std::mt19937 generator{ 1337 };
+            std::uniform_int_distribution<std::size_t> dist{ 0, Library::trackCount - 1 };
+
+            std::vector<std::size_t> res(count);
+            for (std::size_t& trackIndex : res)
+                trackIndex = dist(generator);
+
+            return res;
+        }
+    } // namespace
+
+    static void BM_ClusterSimilarityIndex_build(benchmark::State& state)
+    {
+        const Library& library{ getLibrary() };
+
+        for (auto _ : state)
+        {
+            const ClusterSimilarityIndex index{ library.buildIndex() };
+            benchmark::DoNotOptimize(index.getTrackCount());
+        }
+    }
+
+    // Arg is the max cluster scan size (0 = exact)
+    static void BM_ClusterSimilarityIndex_findSimilarTracks(benchmark::State& state)
+    {
+        const Library& library{ getLibrary() };
+        const ClusterSimilarityIndex index{ library.buildIndex() };
+        const ClusterSimilarityIndex::SearchParameters params{ .maxCount = 50, .maxClusterScanSize = static_cast<std::size_t>(state.range(0)) };
+        const std::vector<std::size_t> queryTrackIndexes{ getQueryTrackIndexes(100) };
+
+        std::size_t queryIndex{};
+        for (auto _ : state)
+        {
+            const db::TrackId trackId{ Library::getTrackId(queryTrackIndexes[queryIndex++ % queryTrackIndexes.size()]) };
+            benchmark::DoNotOptimize(index.findSimilarTracks({ &trackId, 1 }, params));
+        }
+
+        double recall{};
+        for (const std::size_t queryTrackIndex : queryTrackIndexes)
+        {
+            const db::TrackId trackId{ Library::getTrackId(queryTrackIndex) };
+            recall += library.computeRecall(queryTrackIndex, index.findSimilarTracks({ &trackId, 1 }, params), params.maxCount);
+        }
+        state.counters["recall"] = recall / static_cast<double>(queryTrackIndexes.size());
+        state.counters["memoryMiB"] = static_cast<double>(index.getMemoryUsage()) / (1024 * 1024);
+    }
+
+    static void BM_ClusterSimilarityIndex_findSimilarReleases(benchmark::State& state)
+    {
+        const Library& library{ getLibrary() };
+        const ClusterSimilarityIndex index{ library.buildIndex() };
+        const ClusterSimilarityIndex::SearchParameters params{ .maxCount = 50, .maxClusterScanSize = static_cast<std::size_t>(state.range(0)) };
+        const std::vector<std::size_t> queryTrackIndexes{ getQueryTrackIndexes(100) };
+
+        std::size_t queryIndex{};
+        for (auto _ : state)
+        {
+            const db::ReleaseId releaseId{ static_cast<db::ReleaseId::ValueType>(Library::getReleaseIndex(queryTrackIndexes[queryIndex++ % queryTrackIndexes.size()]) + 1) };
+            benchmark::DoNotOptimize(index.findSimilarReleases(releaseId, params));
+        }
+    }
+
+    // Arg is the thread count
+    static void BM_ClusterSimilarityIndex_precomputeSimilarObjects(benchmark::State& state)
+    {
+        const Library& library{ getLibrary() };
+        const ClusterSimilarityIndex::SearchParameters params{ .maxCount = 50, .maxClusterScanSize = 10'000 };
+
+        std::size_t memoryUsage{};
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            ClusterSimilarityIndex index{ library.buildIndex() };
+            state.ResumeTiming();
+
+            index.precomputeSimilarObjects({ db::TrackArtistLinkType::Artist }, params, static_cast<std::size_t>(state.range(0)));
+            memoryUsage = index.getMemoryUsage();
+        }
+        state.counters["memoryMiB"] = static_cast<double>(memoryUsage) / (1024 * 1024);
+    }
+
+    static void BM_ClusterSimilarityIndex_findPrecomputedSimilarReleases(benchmark::State& state)
+    {
+        const Library& library{ getLibrary() };
+        ClusterSimilarityIndex index{ library.buildIndex() };
+        const ClusterSimilarityIndex::SearchParameters params{ .maxCount = 50, .maxClusterScanSize = 10'000 };
+        index.precomputeSimilarObjects({ db::TrackArtistLinkType::Artist }, params, std::thread::hardware_concurrency());
+        const std::vector<std::size_t> queryTrackIndexes{ getQueryTrackIndexes(100) };
+
+        std::size_t queryIndex{};
+        for (auto _ : state)
+        {
+            const db::ReleaseId releaseId{ static_cast<db::ReleaseId::ValueType>(Library::getReleaseIndex(queryTrackIndexes[queryIndex++ % queryTrackIndexes.size()]) + 1) };
+            benchmark::DoNotOptimize(index.findSimilarReleases(releaseId, params));
+        }
+    }
+
+    BENCHMARK(BM_ClusterSimilarityIndex_build)->Unit(benchmark::kMillisecond);
+    BENCHMARK(BM_ClusterSimilarityIndex_findSimilarTracks)->ArgName("maxClusterScanSize")->Arg(0)->Arg(1'000)->Arg(4'000)->Arg(10'000)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(BM_ClusterSimilarityIndex_findSimilarReleases)->ArgName("maxClusterScanSize")->Arg(0)->Arg(1'000)->Arg(10'000)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(BM_ClusterSimilarityIndex_precomputeSimilarObjects)->ArgName("threads")->Arg(1)->Arg(std::thread::hardware_concurrency())->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_ClusterSimilarityIndex_findPrecomputedSimilarReleases)->Unit(benchmark::kMicrosecond);
+} // namespace lms::recommendation
+
+BENCHMARK_MAIN();